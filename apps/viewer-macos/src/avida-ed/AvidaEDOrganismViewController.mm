@@ -83,9 +83,10 @@ static const CGFloat SPLIT_RIGHT_MIN = 202;
 
   if (snapshot >= 0 && snapshot < trace->SnapshotCount()) {
     curSnapshotIndex = snapshot;
-    [self setTaskCountsWithSnapshot:trace->Snapshot(snapshot)];
-    [self setStateDisplayWithSnapshot:trace->Snapshot(snapshot)];
-    [orgView setSnapshot:&trace->Snapshot(snapshot)];
+    Avida::Viewer::ConstHardwareSnapshotPtr current = trace->Snapshot(snapshot);
+    [self setTaskCountsWithSnapshot:*current];
+    [self setStateDisplayWithSnapshot:*current];
+    [orgView setSnapshot:current];
     [timelineView setCurrentPoint:snapshot];
   }
   
@@ -99,15 +100,15 @@ static const CGFloat SPLIT_RIGHT_MIN = 202;
     [btnForward setEnabled:YES];
     [btnEnd setEnabled:YES];
     [[[txtJustExec textStorage] mutableString] setString:@"(none)"];
-    [[[txtWillExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex).NextInstruction()]];
+    [[[txtWillExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex)->NextInstruction()]];
   } else if (curSnapshotIndex == (trace->SnapshotCount() - 1)) {
-    if (trace->Snapshot(snapshot).IsPostDivide()) [orgView addSubview:viewOffspringDrag];
+    if (trace->Snapshot(snapshot)->IsPostDivide()) [orgView addSubview:viewOffspringDrag];
     [self stopAnimation];
     [btnBack setEnabled:YES];
     [btnGo setEnabled:NO];
     [btnForward setEnabled:NO];
     [btnEnd setEnabled:NO];
-    [[[txtJustExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex - 1).NextInstruction()]];
+    [[[txtJustExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex - 1)->NextInstruction()]];
     [[[txtWillExec textStorage] mutableString] setString:@"(none)"];
   } else {
     [viewOffspringDrag removeFromSuperview];
@@ -115,8 +116,8 @@ static const CGFloat SPLIT_RIGHT_MIN = 202;
     [btnGo setEnabled:YES];
     [btnForward setEnabled:YES];
     [btnEnd setEnabled:YES];
-    [[[txtJustExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex - 1).NextInstruction()]];
-    [[[txtWillExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex).NextInstruction()]];
+    [[[txtJustExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex - 1)->NextInstruction()]];
+    [[[txtWillExec textStorage] mutableString] setString:[self descriptionOfInst:trace->Snapshot(curSnapshotIndex)->NextInstruction()]];
   }
 }
 
@@ -533,33 +534,20 @@ static const CGFloat SPLIT_RIGHT_MIN = 202;
     [timelineView clearEntries];
     [timelineView setLength:trace->SnapshotCount() - 1];
     
-    NSMutableSet* nameset = [[NSMutableSet alloc] initWithCapacity:[envActions entryCount]];
     for (NSUInteger i = 0; i < [envActions entryCount]; i++) {
-      [nameset addObject:[envActions entryAtIndex:i]];
-    }
-    
-    for (int i = 0; i < trace->SnapshotCount(); i++) {
-      NSMutableSet* foundset = [[NSMutableSet alloc] init];
-      for (NSString* entry_name in nameset) {
-        NSString* avida_name = entry_name;
-        if ([entry_name isEqual:@"oro"]) {
-          avida_name = @"or";
-        } else if ([entry_name isEqual:@"ant"]) {
-          avida_name = @"andn";
-        } else if ([entry_name isEqual:@"nan"]) {
-          avida_name = @"nand";
-        }
-        if (trace->Snapshot(i).FunctionCount([avida_name UTF8String]) > 0) {
-          [timelineView addEntryWithLabel:[[envActions valueOfEntry:entry_name forKey:@"Order"] stringValue] atLocation:i];
-          [foundset addObject:entry_name];
-        }
+      NSString* entry_name = [envActions entryAtIndex:i];
+      NSString* avida_name = entry_name;
+      if ([entry_name isEqual:@"oro"]) {
+        avida_name = @"or";
+      } else if ([entry_name isEqual:@"ant"]) {
+        avida_name = @"andn";
+      } else if ([entry_name isEqual:@"nan"]) {
+        avida_name = @"nand";
+      }
+      const int location = trace->FirstSnapshotWithFunction([avida_name UTF8String]);
+      if (location >= 0) {
+        [timelineView addEntryWithLabel:[[envActions valueOfEntry:entry_name forKey:@"Order"] stringValue] atLocation:location];
       }
-      
-      // Remove found entries from the search list
-      for (NSString* entry_name in foundset) [nameset removeObject:entry_name];
-      
-      // If nothing left to search for, then quit
-      if ([nameset count] == 0) break;
     }
     
     
@@ -585,7 +573,7 @@ static const CGFloat SPLIT_RIGHT_MIN = 202;
     [[[txtJustExec textStorage] mutableString] setString:@"(none)"];
     [[[txtWillExec textStorage] mutableString] setString:@"(none)"];
 
-    [orgView setSnapshot:NULL];
+    [orgView setSnapshot:Avida::Viewer::ConstHardwareSnapshotPtr(NULL)];
   }
 }
 
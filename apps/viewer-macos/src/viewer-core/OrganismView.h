@@ -38,12 +38,12 @@
 @interface OrganismView : NSView <NSDraggingDestination> {
   IBOutlet id<DropDelegate> dropDelegate;
   
-  const Avida::Viewer::HardwareSnapshot* snapshot;
+  Avida::Viewer::ConstHardwareSnapshotPtr snapshot;
   Avida::Viewer::GraphicsContext graphics_context;
 }
 
 @property (readwrite) id<DropDelegate> dropDelegate;
-@property (readwrite, nonatomic) const Avida::Viewer::HardwareSnapshot* snapshot;
+@property (readwrite, nonatomic) Avida::Viewer::ConstHardwareSnapshotPtr snapshot;
 
 - (void) resizeSubviewsWithOldSize:(NSSize)oldBoundsSize;
 
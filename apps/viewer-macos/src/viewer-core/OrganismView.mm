@@ -44,7 +44,6 @@
   self = [super initWithFrame:frame];
   if (self) {
     // Initialization code here.
-    snapshot = NULL;
   }
   
   return self;
@@ -163,11 +162,11 @@
 
 
 
-- (const Avida::Viewer::HardwareSnapshot*) snapshot {
+- (Avida::Viewer::ConstHardwareSnapshotPtr) snapshot {
   return snapshot;
 }
 
-- (void) setSnapshot:(const Avida::Viewer::HardwareSnapshot*)new_snapshot {
+- (void) setSnapshot:(Avida::Viewer::ConstHardwareSnapshotPtr)new_snapshot {
   snapshot = new_snapshot;
   [self setNeedsDisplay:YES];
 }
@@ -0,0 +1,134 @@
+/*
+ *  private/output/ColumnFormat.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputColumnFormat_h
+#define AvidaOutputColumnFormat_h
+
+#include <cstdio>
+#include <stdint.h>
+#include <vector>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::ColumnFormat - on disk layout of columnar data files (.adc), shared by ColumnFile and ColumnFileReader
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Layout, in host byte order (files written with a different byte order are rejected):
+    //   sFileHeader
+    //   (sColumnHeader, char[name_size])[num_columns]
+    //   chunks, each:
+    //     sChunkHeader
+    //     sBlockHeader[num_columns + 1]    block 0 is the update column, followed by each data column in order
+    //     block data, in the same order
+    //   sIndexHeader                       the index and trailer are rewritten after the last chunk on every flush
+    //   sIndexEntry[num_chunks]
+    //   sTrailer
+    //
+    // Block encoding, before compression:
+    //   int     int32 differences from the previous row (the first row from zero), byte transposed
+    //   double  float64 values, byte transposed
+    //   string  uint32 lengths[num_rows], followed by the concatenated characters
+    // Byte transposition groups the n-th byte of every value together, so slowly varying series compress well.  A
+    // block is deflated (zlib) when that makes it smaller; stored_size == raw_size indicates an uncompressed block.
+    //
+    // A file whose trailer is missing (i.e. the run did not flush) can be recovered by walking the chunk headers.
+
+    namespace ColumnFormat
+    {
+      struct sFileHeader
+      {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t num_columns;
+        uint32_t reserved;
+      };
+
+      struct sColumnHeader
+      {
+        uint32_t type;        // ColumnFile::ColumnType
+        uint32_t name_size;
+      };
+
+      struct sChunkHeader
+      {
+        char magic[4];
+        uint32_t num_rows;
+        int32_t first_update;
+        int32_t last_update;
+      };
+
+      struct sBlockHeader
+      {
+        uint32_t raw_size;
+        uint32_t stored_size;
+      };
+
+      struct sIndexHeader
+      {
+        char magic[4];
+        uint32_t num_chunks;
+      };
+
+      struct sIndexEntry
+      {
+        uint64_t offset;
+        uint32_t num_rows;
+        int32_t first_update;
+        int32_t last_update;
+        uint32_t reserved;
+      };
+
+      struct sTrailer
+      {
+        uint64_t index_offset;
+        char magic[8];
+      };
+
+      extern const char FILE_MAGIC[8];
+      extern const char CHUNK_MAGIC[4];
+      extern const char INDEX_MAGIC[4];
+      extern const char TRAILER_MAGIC[8];
+
+      const uint32_t VERSION = 1;
+      const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+
+      void EncodeInts(const std::vector<int32_t>& values, std::vector<char>& out);
+      void DecodeInts(const std::vector<char>& in, int num_rows, std::vector<int32_t>& values);
+      void EncodeDoubles(const std::vector<double>& values, std::vector<char>& out);
+      void DecodeDoubles(const std::vector<char>& in, int num_rows, std::vector<double>& values);
+
+      // Replaces raw with the stored form of the block, returning the stored size
+      uint32_t Compress(std::vector<char>& raw);
+      // Restores the raw form of a stored block; fails if the block is compressed and zlib is not available
+      bool Decompress(const std::vector<char>& stored, uint32_t raw_size, std::vector<char>& raw);
+
+      bool Seek(FILE* fp, uint64_t offset);
+      bool Truncate(FILE* fp, uint64_t size);
+    };
+
+  };
+};
+
+#endif
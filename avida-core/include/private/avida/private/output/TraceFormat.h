@@ -0,0 +1,128 @@
+/*
+ *  private/output/TraceFormat.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputTraceFormat_h
+#define AvidaOutputTraceFormat_h
+
+#include <cstdio>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::TraceFormat - binary mini traces (.trcb), written by cHardwareBinaryTracer and decoded by avida-trace
+    // ------------------------------------------------------------------------------------------------------------
+    //
+    // Layout:
+    //   the text header of the mini trace (comment lines and a blank line, as in the text format)
+    //   sFileHeader                           in host byte order from here on
+    //   (uint32_t name_size, char[name_size])[num_insts]    instruction names, by opcode
+    //   sEntry...                             to the end of the file
+    //
+    // Each entry is one line of the text trace: the hardware status before an instruction executes, followed by
+    // whether it executed.  Either part may be missing, as in the text trace (e.g. a status with no result when the
+    // organism dies, or the lone result written when an organism divides).  PrintStatus() produces the text form of a
+    // status for both the text and the binary traces, so decoding reproduces the text trace exactly.
+
+    namespace TraceFormat
+    {
+      const int MAX_REGISTERS = 16;
+      const int MAX_NOPS = 16;
+
+      enum eLayout {
+        LAYOUT_EXPERIMENTAL = 0,   // cHardwareExperimental
+        LAYOUT_BCR,                // cHardwareBCR, adds the micro-op
+        LAYOUT_GP8                 // cHardwareGP8, adds the micro-op and the queued actions
+      };
+
+      struct sStatus
+      {
+        int32_t cycle;
+        int32_t micro_op;
+        int32_t update;
+        int32_t queue_eat;
+        int32_t queue_move;
+        int32_t queue_rotate;
+        int32_t queue_rotate_num;
+        int32_t thread;
+        int32_t heads[4];            // IP, read, write, flow
+        int32_t last_output;
+        int32_t forage_target;
+        int32_t group;               // -99 when the organism holds no opinion
+        int32_t cell;
+        int32_t av_cell;
+        int32_t facing;
+        int32_t faced_occupied;
+        int32_t inst;                // opcode of the instruction about to be executed
+        int32_t registers[MAX_REGISTERS];
+        int32_t reg_origins[MAX_REGISTERS];
+        double merit;
+        double bonus;
+        uint8_t layout;              // eLayout
+        uint8_t num_registers;
+        uint8_t use_avatar;
+        uint8_t faced_hill;
+        uint8_t faced_wall;
+        uint8_t queue_rotate_reverse;
+        uint8_t num_nops;
+        uint8_t reserved;
+        char nops[MAX_NOPS];         // trailing nop modifiers, as letters
+      };
+
+      struct sEntry
+      {
+        int32_t exec_success;
+        uint8_t has_status;
+        uint8_t has_success;
+        uint8_t reserved[2];
+        sStatus status;
+      };
+
+      struct sFileHeader
+      {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t num_insts;
+        uint32_t entry_size;
+      };
+
+      // Starts with a NUL so that it can not occur within the text header
+      extern const char FILE_MAGIC[8];
+
+      const uint32_t VERSION = 1;
+      const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+
+      // Text form of a status, without the execution result that ends the line
+      void PrintStatus(std::ostream& fp, const sStatus& status, const char* inst_name);
+
+      // Writes the text trace held in a binary trace; on failure, error describes the problem
+      bool Decode(FILE* in, std::ostream& out, std::string& error);
+    };
+
+  };
+};
+
+#endif
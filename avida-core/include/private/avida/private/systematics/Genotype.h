@@ -125,6 +125,38 @@ namespace Avida {
       
       bool Serialize(ArchivePtr ar) const;
       bool LegacySave(void* df) const;
+      
+      // The fields written by LegacySave, in order, with their values formatted as they appear in the text save
+      struct LegacyField
+      {
+        Apto::String key;
+        Apto::String descr;
+        Apto::String value;
+        
+        LegacyField() { ; }
+        LegacyField(const Apto::String& in_key, const Apto::String& in_descr, const Apto::String& in_value)
+          : key(in_key), descr(in_descr), value(in_value) { ; }
+      };
+      void LegacySaveFields(Apto::Array<LegacyField, Apto::Smart>& fields) const;
+      
+      // The saved fields a genotype is restored from, see GenotypeArbiter::LegacyLoad
+      struct LegacyLoadFields
+      {
+        Apto::String src_args;
+        int hw_type;
+        Apto::String inst_set;
+        GeneticRepresentationPtr sequence;
+        int gen_born;
+        int update_born;
+        int update_deactivated;
+        int depth;
+        Apto::String parents;
+        
+        LegacyLoadFields() : hw_type(0), gen_born(-1), update_born(-1), update_deactivated(-1), depth(0) { ; }
+        
+        // Parses the value of a saved field, returns false if the key is not one of the fields above
+        bool Set(const char* key, const char* value);
+      };
 
       void RemoveActiveReference() const;
       
@@ -142,7 +174,7 @@ namespace Avida {
     private:
       // Methods called by GenotypeArbiter
       Genotype(GenotypeArbiterPtr mgr, GroupID in_id, UnitPtr founder, Update update, ConstGroupMembershipPtr parents);
-      Genotype(GenotypeArbiterPtr mgr, GroupID in_id, void* props);
+      Genotype(GenotypeArbiterPtr mgr, GroupID in_id, const LegacyLoadFields& fields);
 
       void NotifyNewUnit(UnitPtr u);
       void UpdateReset();
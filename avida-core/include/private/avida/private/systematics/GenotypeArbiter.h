@@ -31,6 +31,8 @@
 
 #include "avida/private/systematics/Genotype.h"
 
+#include <stdint.h>
+
 
 namespace Avida {
   namespace Systematics {
@@ -47,15 +49,32 @@ namespace Avida {
         EVENT_REMOVE_THRESHOLD
       };
       
-      static const int HASH_SIZE = 3203;
-      
     private:
+      // Active genotypes are indexed by genome hash in an open addressed table (linear probing, power of two capacity).
+      // Distinct genotypes may share a hash (collisions, or identical genomes from different sources), so lookups
+      // continue along the probe sequence until an empty slot.  Removed entries are left as tombstones until the next
+      // rehash.
+      struct ActiveEntry
+      {
+        uint64_t hash;
+        GenotypePtr genotype;
+        bool removed;
+        
+        ActiveEntry() : hash(0), removed(false) { ; }
+      };
+      
+      static const int INITIAL_TABLE_SIZE = 4096;
+      
+
       // Config Settings
       int m_threshold;
       bool m_disable_class;
       
       // Internal Data Structures
-      Apto::List<GenotypePtr, Apto::SparseVector> m_active_hash[HASH_SIZE];
+      Apto::Array<ActiveEntry> m_active_table;
+      int m_active_used;
+      int m_active_removed;
+      Apto::Map<GroupID, GenotypePtr> m_id_index;
       Apto::Array<Apto::List<GenotypePtr, Apto::SparseVector>, Apto::ManagedPointer> m_active_sz;
       Apto::List<GenotypePtr, Apto::SparseVector> m_historic;
       GenotypePtr m_coalescent;
@@ -130,9 +149,18 @@ namespace Avida {
       bool Serialize(ArchivePtr ar) const;
       bool LegacySave(void* df) const;
       GroupPtr LegacyLoad(void* props);
+      GroupPtr LegacyLoad(const Genotype::LegacyLoadFields& fields);
       
       IteratorPtr Begin();
       
+      // Genotypes with no living organisms that are still held in the historic list, in LegacySave order
+      void GetHistoricGenotypes(Apto::Array<GenotypePtr, Apto::Smart>& genotypes) const;
+      
+      // Checkpoint restore, genotypes keep their saved ids and the id sequence continues where the checkpoint left off
+      GroupPtr LegacyLoad(void* props, int group_id);
+      int GetNextID() const { return m_next_id; }
+      void SetNextID(int next_id) { m_next_id = next_id; }
+      
       
       // Data::Provider
       Data::ConstDataSetPtr Provides() const;
@@ -157,7 +185,11 @@ namespace Avida {
       template <class T> Data::PackagePtr packageData(const T&) const;
       Data::ProviderPtr activateProvider(World*);
       
-      unsigned int hashGenome(const InstructionSequence& genome) const;
+      uint64_t hashGenome(GenotypePtr genotype) const;
+      void insertActive(GenotypePtr genotype, uint64_t hash);
+      void removeActive(GenotypePtr genotype, uint64_t hash);
+      GenotypePtr findActive(UnitPtr u, uint64_t hash) const;
+      void rehashActive(int capacity);
       Apto::String nameGenotype(int size);
       
       void removeGenotype(GenotypePtr genotype);
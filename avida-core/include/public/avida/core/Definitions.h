@@ -62,6 +62,8 @@ enum eTIMESLICE
   SLICE_DEME_PROB_MERIT,
   SLICE_PROB_DEMESIZE_PROB_MERIT,
   SLICE_PROB_INTEGRATED_MERIT,
+  SLICE_PROB_MERIT_FENWICK,
+  SLICE_PROB_MERIT_ALIAS,
 };
 
 enum ePOSITION_OFFSPRING
@@ -26,6 +26,7 @@
 #define InstructionSequence_h
 
 #include <cassert>
+#include <stdint.h>
 
 #include "apto/platform.h"
 #include "avida/core/GeneticRepresentation.h"
@@ -68,13 +69,35 @@ namespace Avida {
   class InstructionSequence : public GeneticRepresentation
   {
   protected:
-    Apto::Array<Instruction> m_seq;
+    // Instruction storage, shared by copies of a sequence until one of them is modified (copy-on-write).  The array
+    // size is the capacity, each sharing sequence tracks its own active size.
+    class InstructionBuffer : public Apto::RefCountObject<Apto::ThreadSafe>
+    {
+    public:
+      Apto::Array<Instruction> seq;
+      
+      LIB_EXPORT inline explicit InstructionBuffer(int capacity = 0) : seq(capacity) { ; }
+    };
+    typedef Apto::SmartPtr<InstructionBuffer, Apto::InternalRCObject> InstructionBufferPtr;
+    
+    InstructionBufferPtr m_buf;
     int m_active_size;
     
+    // Content hash, stored when a sequence is built or copied and invalidated by every (potentially) modifying access.
+    // It is never written through const access, so a sequence shared between threads can be hashed concurrently.
+    uint64_t m_hash;
+    bool m_hash_valid;
+    
+    // Count of (potentially) modifying accesses, lets derived classes tell when state they derive from the sequence
+    // has gone stale
+    unsigned int m_mod_count;
+    
   public:
-    LIB_EXPORT inline InstructionSequence() : m_active_size(0) { ; }
+    LIB_EXPORT inline InstructionSequence()
+      : m_buf(new InstructionBuffer), m_active_size(0), m_hash(0), m_hash_valid(false), m_mod_count(0) { ; }
     LIB_EXPORT InstructionSequence(const InstructionSequence& seq);
-    LIB_EXPORT inline explicit InstructionSequence(int size) : m_seq(size), m_active_size(size) { ; }
+    LIB_EXPORT inline explicit InstructionSequence(int size)
+      : m_buf(new InstructionBuffer(size)), m_active_size(size), m_hash(0), m_hash_valid(false), m_mod_count(0) { ; }
     LIB_EXPORT explicit InstructionSequence(const Apto::String& str);
     LIB_EXPORT virtual ~InstructionSequence();
     
@@ -82,8 +105,15 @@ namespace Avida {
     // Accessors
     LIB_EXPORT inline int GetSize() const { return m_active_size; }
     
-    LIB_EXPORT inline Instruction& operator[](int idx) { assert(idx >= 0 && idx < m_active_size);  return m_seq[idx]; }
-    LIB_EXPORT inline const Instruction& operator[](int idx) const { assert(idx >= 0 && idx < m_active_size);  return m_seq[idx]; }
+    LIB_EXPORT inline Instruction& operator[](int idx)
+      { assert(idx >= 0 && idx < m_active_size); invalidateHash(); copyOnWrite(); return m_buf->seq[idx]; }
+    LIB_EXPORT inline const Instruction& operator[](int idx) const { assert(idx >= 0 && idx < m_active_size);  return m_buf->seq[idx]; }
+    
+    // True when this sequence shares its storage with another copy
+    LIB_EXPORT inline bool IsShared() const { return m_buf->RefCount() != 1; }
+    
+    // 64-bit hash of the active sequence, recomputed only while the sequence has been modified since it was copied
+    LIB_EXPORT inline uint64_t Hash() const { return (m_hash_valid) ? m_hash : calcHash(); }
 
 
     // GeneticRepresentation Interface
@@ -139,6 +169,11 @@ namespace Avida {
     
     
   protected:
+    LIB_EXPORT inline void invalidateHash() { m_hash_valid = false; m_mod_count++; }
+    LIB_EXPORT inline void copyOnWrite() { if (m_buf->RefCount() != 1) detachBuffer(m_buf->seq.GetSize(), m_active_size); }
+    LIB_EXPORT void detachBuffer(int capacity, int num_copy);
+    LIB_EXPORT uint64_t calcHash() const;
+    
     LIB_EXPORT virtual void adjustCapacity(int new_size);
     LIB_EXPORT virtual void prepareInsert(int pos, int num_sites);
   };
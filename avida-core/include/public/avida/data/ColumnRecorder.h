@@ -0,0 +1,61 @@
+/*
+ *  data/ColumnRecorder.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaDataColumnRecorder_h
+#define AvidaDataColumnRecorder_h
+
+#include "avida/data/Recorder.h"
+#include "avida/output/ColumnFile.h"
+
+
+namespace Avida {
+  namespace Data {
+
+    // Data::ColumnRecorder - Records a set of data values into a columnar binary file (Output::ColumnFile)
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // One row is written every interval updates, with one typed column per data id.  Column specifications take the
+    // form 'data_id' or 'data_id:type', where type is int, double (default) or string.
+
+    class ColumnRecorder : public Recorder
+    {
+    private:
+      Output::ColumnFilePtr m_file;
+      Apto::Array<DataID> m_data_ids;
+      Apto::Array<int> m_columns;   // file column of each data id
+      DataSetPtr m_requested;
+      int m_interval;
+
+    public:
+      LIB_EXPORT ColumnRecorder(Output::ColumnFilePtr file, int interval = 1);
+
+      // Adds a column for the specified data value, must be called before the recorder is attached
+      LIB_EXPORT bool AddColumn(const Apto::String& column_spec, Feedback& feedback);
+
+      // Data::Recorder Interface
+      LIB_EXPORT ConstDataSetPtr RequestedData() const;
+      LIB_EXPORT void NotifyData(Update current_update, DataRetrievalFunctor retrieve_data);
+    };
+
+  };
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ *  output/ColumnFile.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputColumnFile_h
+#define AvidaOutputColumnFile_h
+
+#include "avida/output/Socket.h"
+
+#include <cstdio>
+#include <stdint.h>
+#include <vector>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::ColumnFile - Chunked, typed, columnar binary data file (see private/output/ColumnFormat.h)
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Rows are buffered per column and written as a compressed chunk every chunk_rows rows.  Flush() writes any
+    // partial chunk followed by the chunk index, so the file is complete and indexed after every flush; the index is
+    // overwritten by the next chunk.  Files are read with Output::ColumnFileReader.
+
+    class ColumnFile : public Socket
+    {
+    public:
+      enum ColumnType {
+        INT_COLUMN = 0,
+        DOUBLE_COLUMN,
+        STRING_COLUMN
+      };
+
+      static const int DEFAULT_CHUNK_ROWS = 4096;
+
+    private:
+      struct Column
+      {
+        Apto::String name;
+        ColumnType type;
+        std::vector<int32_t> ints;
+        std::vector<double> doubles;
+        std::vector<Apto::String> strings;
+      };
+
+      struct ChunkEntry
+      {
+        uint64_t offset;
+        int num_rows;
+        Update first_update;
+        Update last_update;
+      };
+
+      mutable Apto::Mutex m_mutex;
+
+      FILE* m_fp;
+      bool m_good;
+      const int m_chunk_rows;
+
+      Apto::Array<Column*> m_columns;
+      std::vector<int32_t> m_updates;
+      bool m_header_written;
+
+      uint64_t m_data_end;        // end of the last chunk, where the index is written
+      Apto::Array<ChunkEntry, Apto::Smart> m_chunks;
+
+
+    public:
+      LIB_EXPORT static ColumnFilePtr CreateWithPath(World* world, Apto::String path, Feedback* feedback = NULL,
+                                                     int chunk_rows = DEFAULT_CHUNK_ROWS);
+
+      LIB_EXPORT ~ColumnFile();
+
+      LIB_EXPORT inline const OutputID& Name() const { return m_output_id; }
+      LIB_EXPORT inline bool Good() const { Apto::MutexAutoLock lock(m_mutex); return m_good; }
+
+      // Columns must be defined before the first row is written; returns the column index, or -1 once rows exist
+      LIB_EXPORT int AddColumn(const Apto::String& name, ColumnType type);
+      LIB_EXPORT inline int NumColumns() const { return m_columns.GetSize(); }
+      LIB_EXPORT inline ColumnType ColumnDataType(int column) const { return m_columns[column]->type; }
+
+      // Each column receives at most one value per row, converted to the column type; Endl() completes the row, giving
+      // columns that were not written a default value (0 or empty)
+      LIB_EXPORT void Write(int column, int value);
+      LIB_EXPORT void Write(int column, double value);
+      LIB_EXPORT void Write(int column, const Apto::String& value);
+      LIB_EXPORT void Endl(Update update);
+
+      LIB_EXPORT void Flush();
+
+    private:
+      LIB_LOCAL ColumnFile(World* world, const OutputID& output_id, int chunk_rows);
+
+      LIB_LOCAL bool writeHeader();
+      LIB_LOCAL bool writeChunk();
+      LIB_LOCAL bool writeIndex();
+    };
+
+  };
+};
+
+#endif
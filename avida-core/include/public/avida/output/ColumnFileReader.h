@@ -0,0 +1,99 @@
+/*
+ *  output/ColumnFileReader.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputColumnFileReader_h
+#define AvidaOutputColumnFileReader_h
+
+#include "avida/output/ColumnFile.h"
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::ColumnFileReader - Random access to the columns of a file written by Output::ColumnFile
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Only the chunk index is loaded on open.  Reading a column over an update range touches just the chunks that
+    // overlap the range, and within them only the update block and the requested column's block.  Files without an
+    // index (from a run that did not exit cleanly) are indexed by walking the chunk headers, up to the last complete
+    // chunk.
+
+    class ColumnFileReader
+    {
+    private:
+      struct ChunkInfo
+      {
+        uint64_t offset;
+        int num_rows;
+        Update first_update;
+        Update last_update;
+      };
+
+      FILE* m_fp;
+      uint64_t m_file_size;
+      uint64_t m_data_start;      // offset of the first chunk
+      bool m_recovered;
+
+      Apto::Array<Apto::String> m_names;
+      Apto::Array<ColumnFile::ColumnType> m_types;
+      Apto::Array<ChunkInfo, Apto::Smart> m_chunks;
+      int m_num_rows;
+
+      ColumnFileReader(const ColumnFileReader&); // @not_implemented
+      ColumnFileReader& operator=(const ColumnFileReader&); // @not_implemented
+
+    public:
+      LIB_EXPORT ColumnFileReader();
+      LIB_EXPORT ~ColumnFileReader() { Close(); }
+
+      LIB_EXPORT bool Open(const Apto::String& path, Feedback& feedback);
+      LIB_EXPORT void Close();
+
+      LIB_EXPORT inline int NumColumns() const { return m_names.GetSize(); }
+      LIB_EXPORT inline const Apto::String& ColumnName(int column) const { return m_names[column]; }
+      LIB_EXPORT inline ColumnFile::ColumnType ColumnDataType(int column) const { return m_types[column]; }
+      LIB_EXPORT int ColumnIndex(const Apto::String& name) const; // -1 if not present
+
+      LIB_EXPORT inline int NumRows() const { return m_num_rows; }
+      LIB_EXPORT inline int NumChunks() const { return m_chunks.GetSize(); }
+      LIB_EXPORT inline bool WasRecovered() const { return m_recovered; } // true if the index had to be rebuilt
+      LIB_EXPORT Update FirstUpdate() const;
+      LIB_EXPORT Update LastUpdate() const;
+
+      // Each read appends the rows whose update falls within [first, last]; numeric columns may be read as either
+      // int or double, and any column may be read as strings.  Returns false if the file could not be decoded.
+      LIB_EXPORT bool ReadUpdates(Update first, Update last, Apto::Array<Update, Apto::Smart>& updates);
+      LIB_EXPORT bool ReadInts(int column, Update first, Update last, Apto::Array<int, Apto::Smart>& values);
+      LIB_EXPORT bool ReadDoubles(int column, Update first, Update last, Apto::Array<double, Apto::Smart>& values);
+      LIB_EXPORT bool ReadStrings(int column, Update first, Update last, Apto::Array<Apto::String, Apto::Smart>& values);
+
+    private:
+      LIB_LOCAL bool readIndex();
+      LIB_LOCAL bool scanChunks();
+      LIB_LOCAL bool readBlock(const ChunkInfo& chunk, int block, std::vector<char>& raw);
+      LIB_LOCAL bool readChunkUpdates(const ChunkInfo& chunk, std::vector<int32_t>& updates);
+      template <class T> LIB_LOCAL bool readColumn(int column, Update first, Update last, Apto::Array<T, Apto::Smart>& values);
+    };
+
+  };
+};
+
+#endif
@@ -26,6 +26,7 @@
 #define AvidaOutputFile_h
 
 #include "avida/output/Socket.h"
+#include "avida/output/Writer.h"
 
 #include <fstream>
 #include <sstream>
@@ -49,6 +50,7 @@ namespace Avida {
       int m_num_cols;
       
       std::ofstream m_fp;
+      Writer::Buffer* m_buffer;   // when writing asynchronously, replaces the stream buffer of m_fp
 
       
     public:
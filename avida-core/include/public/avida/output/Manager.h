@@ -28,6 +28,7 @@
 #include "apto/platform.h"
 #include "avida/core/World.h"
 #include "avida/output/Types.h"
+#include "avida/output/Writer.h"
 
 
 namespace Avida {
@@ -48,6 +49,8 @@ namespace Avida {
       Apto::Map<OutputID, SocketWeakRef> m_sockets;
       Apto::Map<OutputID, SocketPtr> m_static_sockets;
       
+      WriterPtr m_writer;
+      
     public:
       LIB_EXPORT Manager(const Apto::String& output_path);
       LIB_EXPORT ~Manager();
@@ -59,7 +62,12 @@ namespace Avida {
       LIB_EXPORT bool IsOpen(const OutputID& output_id) const;
       LIB_EXPORT bool Close(const OutputID& output_id);
       
-      LIB_EXPORT void FlushAll();
+      LIB_EXPORT void FlushAll(); // Flushes all open sockets, waiting for the asynchronous writer to finish
+      LIB_EXPORT void HandOffAll(); // Queues a flush of every open file with the asynchronous writer, without waiting
+      
+      // Files opened after this call are written by a dedicated I/O thread (see Output::Writer)
+      LIB_EXPORT void EnableAsyncWriter(int num_blocks, int block_size = Writer::DEFAULT_BLOCK_SIZE);
+      LIB_EXPORT inline WriterPtr AsyncWriter() const { return m_writer; }
       
       LIB_EXPORT bool AttachTo(World* world);
       LIB_EXPORT static ManagerPtr Of(World* world);
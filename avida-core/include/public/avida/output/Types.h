@@ -33,9 +33,12 @@ namespace Avida {
     // Class Declarations
     // --------------------------------------------------------------------------------------------------------------
     
+    class ColumnFile;
+    class ColumnFileReader;
     class File;
     class Manager;
     class Socket;
+    class Writer;
     
     
     // Type Declarations
@@ -43,9 +46,11 @@ namespace Avida {
     
     typedef Apto::String OutputID;
     typedef Socket* SocketWeakRef;
+    typedef Apto::SmartPtr<ColumnFile, Apto::InternalRCObject> ColumnFilePtr;
     typedef Apto::SmartPtr<File, Apto::InternalRCObject> FilePtr;
     typedef Apto::SmartPtr<Manager, Apto::InternalRCObject> ManagerPtr;
     typedef Apto::SmartPtr<Socket, Apto::InternalRCObject> SocketPtr;
+    typedef Apto::SmartPtr<Writer, Apto::InternalRCObject> WriterPtr;
   };
 };
 
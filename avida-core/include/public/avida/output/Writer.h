@@ -0,0 +1,163 @@
+/*
+ *  output/Writer.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputWriter_h
+#define AvidaOutputWriter_h
+
+#include "apto/platform.h"
+#include "apto/core/Thread.h"
+#include "avida/output/Types.h"
+
+#include <streambuf>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::Writer - Dedicated I/O thread that performs the disk writes for output files
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Each open file formats into its own block through a Writer::Buffer.  When the block fills (or the file is flushed
+    // or closed, or an update ends) it is appended to the write queue and the file continues in a block taken from a
+    // fixed pool, so the pool size bounds the amount of data waiting to be written.  A file only waits (a stall) when
+    // the pool is empty, i.e. when output is produced faster than the disk accepts it.
+    //
+    // Files are opened on the calling thread, so failures are reported immediately; writes, flushes and the final close
+    // happen on the I/O thread in the order they were queued.  Paths ending in '.gz' are compressed by the I/O thread
+    // when Avida is built with zlib.
+
+    class Writer : public Apto::RefCountObject<Apto::ThreadSafe>
+    {
+    public:
+      static const int DEFAULT_BLOCK_SIZE = 65536;
+
+      struct Stats
+      {
+        int blocks_written;
+        double bytes_written;
+        int max_queued;       // largest number of blocks waiting to be written
+        int stalls;           // number of times a file waited for a free block
+        double stall_time;    // seconds spent waiting for free blocks
+        int write_errors;
+      };
+
+    private:
+      struct Target;
+      struct Block
+      {
+        char* data;
+        int size;
+        Target* target;
+        bool flush;
+        bool close;
+      };
+
+    public:
+      class Buffer : public std::streambuf
+      {
+        friend class Writer;
+      private:
+        WriterPtr m_writer;
+        Target* m_target;
+        Block* m_block;
+        bool m_unflushed;       // data has been handed off since the last flush
+
+        Buffer(WriterPtr writer, Target* target);
+        Buffer(); // @not_implemented
+        Buffer(const Buffer&); // @not_implemented
+        Buffer& operator=(const Buffer&); // @not_implemented
+
+      public:
+        LIB_EXPORT ~Buffer(); // Queues any remaining data and closes the file
+
+        // Queues the data formatted so far, optionally flushing the file once it has been written.  Does nothing
+        // when there is neither new data nor unflushed data to write.
+        LIB_EXPORT void HandOff(bool flush);
+
+      protected:
+        int overflow(int c);
+        int sync();
+      };
+
+    private:
+      friend class Buffer;
+      
+      class IOThread : public Apto::Thread
+      {
+      private:
+        Writer* m_writer;
+        void Run();
+      public:
+        IOThread(Writer* writer) : m_writer(writer) { ; }
+      };
+
+      const int m_block_size;
+
+      Apto::Mutex m_mutex;
+      Apto::ConditionVariable m_work_cond;  // signaled when a block is queued
+      Apto::ConditionVariable m_free_cond;  // signaled when a block is returned to the pool
+      Apto::ConditionVariable m_idle_cond;  // signaled after each block is written
+
+      Apto::Array<Block*> m_free;
+      int m_num_free;
+      Apto::Array<Block*> m_queue;          // circular
+      int m_queue_head;
+      int m_queue_count;
+      bool m_busy;                          // the I/O thread is writing a block
+      bool m_terminate;
+
+      Apto::Map<OutputID, int> m_closing;   // files with a queued close, by output id
+
+      Stats m_stats;
+      IOThread* m_thread;
+
+
+    public:
+      LIB_EXPORT Writer(int num_blocks, int block_size = DEFAULT_BLOCK_SIZE);
+      LIB_EXPORT ~Writer();
+
+      // Returns NULL if the file could not be opened
+      LIB_EXPORT Buffer* Open(const OutputID& output_id, bool append);
+
+      // Waits until all queued data has been written and flushed
+      LIB_EXPORT void Wait();
+
+      LIB_EXPORT Stats GetStats();
+      LIB_EXPORT int GetNumQueued();
+      LIB_EXPORT void ResetStats();
+
+    private:
+      Block* newBlock();
+      static void deleteBlock(Block* block);
+
+      Block* submit(Block* block, Target* target, bool flush, bool close);
+      void pushQueue(Block* block);
+
+      void processBlocks();
+      void writeBlock(Block& block);
+
+      static double currentTime();
+    };
+
+  };
+};
+
+#endif
@@ -37,11 +37,16 @@ class cWorld;
 namespace Avida {
   namespace Viewer {    
     
+    namespace Private { class SnapshotArena; };
+    
+    
     // HardwareSnapshot
     // --------------------------------------------------------------------------------------------------------------  
     
     class HardwareSnapshot
     {
+      friend class Private::SnapshotArena;
+      
     private:
       const cInstSet* m_inst_set;
       
@@ -123,12 +128,16 @@ namespace Avida {
 
     // OrganismTrace
     // --------------------------------------------------------------------------------------------------------------  
+    //
+    // The hardware state after every executed instruction is stored compactly, as periodic keyframes and the changes
+    // in between, and snapshots are rebuilt on request.  The few most recently requested snapshots are kept for reuse;
+    // callers share ownership of the snapshots returned, which stay valid for as long as they hold on to them.
     
     class OrganismTrace
     {      
     private:
       GenomePtr m_genome;
-      Apto::Array<HardwareSnapshot*> m_snapshots;
+      Private::SnapshotArena* m_arena;
       GenomePtr m_offspring_genome;
       
     public:
@@ -138,8 +147,15 @@ namespace Avida {
       LIB_EXPORT inline ConstGenomePtr OrganismGenome() const { return m_genome; }
       LIB_EXPORT inline ConstGenomePtr OffspringGenome() const { return m_offspring_genome; }
       
-      LIB_EXPORT inline int SnapshotCount() const { return m_snapshots.GetSize(); }
-      LIB_EXPORT inline const HardwareSnapshot& Snapshot(int idx) const { return *m_snapshots[idx]; }      
+      LIB_EXPORT int SnapshotCount() const;
+      LIB_EXPORT ConstHardwareSnapshotPtr Snapshot(int idx) const;
+      
+      // Index of the first snapshot in which the function has been performed, or -1 if it never is
+      LIB_EXPORT int FirstSnapshotWithFunction(const Apto::String& function) const;
+      
+    private:
+      OrganismTrace(const OrganismTrace&); // @not_implemented
+      OrganismTrace& operator=(const OrganismTrace&); // @not_implemented
     };
     
   };
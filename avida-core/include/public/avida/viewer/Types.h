@@ -53,6 +53,7 @@ namespace Avida {
     typedef Apto::SmartPtr<Freezer> FreezerPtr;
     typedef Apto::SmartPtr<Graphic> GraphicPtr;
     typedef Apto::SmartPtr<const Graphic> ConstGraphicPtr;
+    typedef Apto::SmartPtr<const HardwareSnapshot> ConstHardwareSnapshotPtr;
     typedef Apto::SmartPtr<OrganismTrace> OrganismTracePtr;
     
 
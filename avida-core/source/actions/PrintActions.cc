@@ -24,10 +24,12 @@
 #include "avida/core/Feedback.h"
 #include "avida/core/InstructionSequence.h"
 #include "avida/core/WorldDriver.h"
+#include "avida/data/ColumnRecorder.h"
 #include "avida/data/Manager.h"
 #include "avida/data/Package.h"
 #include "avida/data/Recorder.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
@@ -48,12 +50,14 @@
 #include "cInstSet.h"
 #include "cMigrationMatrix.h"
 #include "cOrganism.h"
+#include "cOrganismPool.h"
 #include "cPhenPlastGenotype.h"
 #include "cPhenPlastUtil.h"
 #include "cPlasticPhenotype.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
 #include "cStats.h"
+#include "cTestResultCache.h"
 #include "cWorld.h"
 #include "cUserFeedback.h"
 #include "cParasite.h"
@@ -258,6 +262,139 @@ public:
   }
 };
 
+class cActionPrintOutputWriterData : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintOutputWriterData(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "output_writer.dat"; else m_filename = largs.PopWord();
+  }
+  static const cString GetDescription() { return "Arguments: [string fname=\"output_writer.dat\"]"; }
+  void Process(cAvidaContext&)
+  {
+    Avida::Output::WriterPtr writer = Avida::Output::Manager::Of(m_world->GetNewWorld())->AsyncWriter();
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Activity of the asynchronous output writer since the last print");
+    df->WriteComment("(stalls occur when output is produced faster than it can be written)");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    
+    if (!writer) {
+      df->Write(0, "Writer Enabled");
+      df->Endl();
+      return;
+    }
+    
+    Avida::Output::Writer::Stats stats = writer->GetStats();
+    df->Write(1, "Writer Enabled");
+    df->Write(stats.blocks_written, "Blocks Written");
+    df->Write(stats.bytes_written, "Bytes Written");
+    df->Write(writer->GetNumQueued(), "Blocks Currently Queued");
+    df->Write(stats.max_queued, "Maximum Blocks Queued");
+    df->Write(stats.stalls, "Stalls");
+    df->Write(stats.stall_time, "Time Stalled (seconds)");
+    df->Write(stats.write_errors, "Write Errors");
+    df->Endl();
+    
+    writer->ResetStats();
+  }
+};
+
+class cActionPrintHardwarePoolData : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintHardwarePoolData(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "hardware_pool.dat"; else m_filename = largs.PopWord();
+  }
+  static const cString GetDescription() { return "Arguments: [string fname=\"hardware_pool.dat\"]"; }
+  void Process(cAvidaContext&)
+  {
+    cHardwareManager::sPoolStats stats = m_world->GetHardwareManager().GetPoolStats();
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Virtual CPU allocation and reuse since the start of the run (see HARDWARE_POOL_SIZE)");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    df->Write(m_world->GetConfig().HARDWARE_POOL_SIZE.Get(), "Pool Size");
+    df->Write(stats.allocated, "Hardware Allocated");
+    df->Write(stats.reused, "Hardware Reused");
+    df->Write(stats.returned, "Hardware Returned to Pool");
+    df->Write(stats.freed, "Hardware Freed (pool full)");
+    df->Write(stats.idle, "Hardware Currently Pooled");
+    df->Endl();
+  }
+};
+
+class cActionPrintOrganismPoolData : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintOrganismPoolData(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "organism_pool.dat"; else m_filename = largs.PopWord();
+  }
+  static const cString GetDescription() { return "Arguments: [string fname=\"organism_pool.dat\"]"; }
+  void Process(cAvidaContext&)
+  {
+    cOrganismPool::sPoolStats stats = m_world->GetOrganismPool().GetPoolStats();
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Organism allocation and reuse since the start of the run (see ORGANISM_POOL_SIZE)");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    df->Write(m_world->GetConfig().ORGANISM_POOL_SIZE.Get(), "Pool Size");
+    df->Write(stats.allocated, "Organisms Allocated");
+    df->Write(stats.reused, "Organisms Reused");
+    df->Write(stats.returned, "Organisms Returned to Pool");
+    df->Write(stats.freed, "Organisms Freed (pool full)");
+    df->Write(stats.idle, "Organisms Currently Pooled");
+    df->Endl();
+  }
+};
+
+class cActionPrintTestCacheData : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintTestCacheData(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "test_cache.dat"; else m_filename = largs.PopWord();
+  }
+  static const cString GetDescription() { return "Arguments: [string fname=\"test_cache.dat\"]"; }
+  void Process(cAvidaContext&)
+  {
+    cTestResultCache* cache = m_world->GetTestResultCache();
+    cTestResultCache::sStats stats = { 0, 0, 0, 0 };
+    if (cache) stats = cache->GetStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Test CPU result cache use since the start of the run (see TEST_CACHE_SIZE)");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    df->Write((cache) ? cache->GetCapacity() : 0, "Cache Size");
+    df->Write((cache && cache->IsPersistent()) ? 1 : 0, "Persistent (file backed)");
+    df->Write(static_cast<long>(stats.hits), "Hits");
+    df->Write(static_cast<long>(stats.misses), "Misses");
+    df->Write((lookups) ? static_cast<double>(stats.hits) / static_cast<double>(lookups) : 0.0, "Hit Rate");
+    df->Write(static_cast<long>(stats.stores), "Results Stored");
+    df->Write(static_cast<long>(stats.uncacheable), "Uncacheable Tests");
+    df->Endl();
+  }
+};
+
 class cActionPrintResourceLocData : public cAction
 {
 private:
@@ -415,6 +552,48 @@ public:
   }
 };
 
+// Records data values into a columnar binary file (see Output::ColumnFile), starting when the event first fires.  The
+// file is read with the avida-columns utility.
+class cActionRecordColumns : public cAction
+{
+private:
+  Data::RecorderPtr m_recorder;
+  bool m_attached;
+  
+public:
+  cActionRecordColumns(cWorld* world, const cString& args, Feedback& feedback) : cAction(world, args), m_attached(false)
+  {
+    cString largs(args);
+    cString filename = largs.PopWord();
+    int interval = largs.PopWord().AsInt();
+    
+    Avida::Output::ColumnFilePtr file = Avida::Output::ColumnFile::CreateWithPath(world->GetNewWorld(), (const char*)filename, &feedback);
+    if (!file) return;
+    
+    Apto::SmartPtr<Data::ColumnRecorder, Apto::InternalRCObject> recorder(new Data::ColumnRecorder(file, interval));
+    while (largs.GetSize()) {
+      if (!recorder->AddColumn((const char*)largs.PopWord(), feedback)) return;
+    }
+    m_recorder = recorder;
+  }
+  
+  static const cString GetDescription()
+  {
+    return "Arguments: <string fname> <int interval> <string data_id[:int|double|string]> [...]";
+  }
+  
+  void Process(cAvidaContext&)
+  {
+    if (m_attached || !m_recorder) return;
+    
+    if (!m_world->GetDataManager()->AttachRecorder(m_recorder)) {
+      m_world->GetDriver().Feedback().Error("RecordColumns: unable to attach recorder, unknown data id requested");
+      m_world->GetDriver().Abort(Avida::INVALID_CONFIG);
+    }
+    m_attached = true;
+  }
+};
+
 class cActionPrintFromMessageInstructionData : public cAction, public Data::Recorder
 {
 private:
@@ -5347,6 +5526,11 @@ void RegisterPrintActions(cActionLibrary* action_lib)
   action_lib->Register<cActionPrintParasitePhenotypeData>("PrintParasitePhenotypeData");
   action_lib->Register<cActionPrintHostPhenotypeData>("PrintHostPhenotypeData");
   action_lib->Register<cActionPrintPhenotypeStatus>("PrintPhenotypeStatus");
+  action_lib->Register<cActionRecordColumns>("RecordColumns");
+  action_lib->Register<cActionPrintOutputWriterData>("PrintOutputWriterData");
+  action_lib->Register<cActionPrintHardwarePoolData>("PrintHardwarePoolData");
+  action_lib->Register<cActionPrintOrganismPoolData>("PrintOrganismPoolData");
+  action_lib->Register<cActionPrintTestCacheData>("PrintTestCacheData");
   
   action_lib->Register<cActionPrintDemeTestamentStats>("PrintDemeTestamentStats");
 	action_lib->Register<cActionPrintCurrentMeanDemeDensity>("PrintCurrentMeanDemeDensity");
@@ -21,10 +21,15 @@
 
 #include "SaveLoadActions.h"
 
+#include "avida/output/Manager.h"
+
+#include "apto/core/FileSystem.h"
+
 #include "cAction.h"
 #include "cActionLibrary.h"
 #include "cArgContainer.h"
 #include "cArgSchema.h"
+#include "cBinaryPopulationFile.h"
 #include "cPopulation.h"
 #include "cStats.h"
 #include "cStringUtil.h"
@@ -46,7 +51,7 @@
  */
 class cActionLoadPopulation : public cAction
 {
-private:
+protected:
   cString m_filename;
   int m_update;
   int m_cellid_offset;
@@ -130,7 +135,7 @@ public:
 
 class cActionSavePopulation : public cAction
 {
-private:
+protected:
   cString m_filename;
   bool m_save_historic;
   bool m_save_group_info;
@@ -176,6 +181,86 @@ public:
 };
 
 
+/*
+ Binary (.bpop) equivalent of LoadPopulation, taking the same arguments.  Binary population files are written by
+ SavePopulationBinary or converted from structured population saves with ConvertPopulationSave.
+ */
+class cActionLoadPopulationBinary : public cActionLoadPopulation
+{
+public:
+  cActionLoadPopulationBinary(cWorld* world, const cString& args, Feedback& feedback) : cActionLoadPopulation(world, args, feedback) { ; }
+  
+  void Process(cAvidaContext& ctx)
+  {
+    // set the update if requested
+    if (m_update >= 0) m_world->GetStats().SetCurrentUpdate(m_update);
+    
+    if (!m_world->GetPopulation().LoadPopulationBinary(m_filename, ctx, m_cellid_offset, m_lineage_offset, m_load_groups, m_load_birth_cells, m_load_avatars, m_load_rebirth, m_load_parent_dat, m_load_traceq)) {
+      m_world->GetDriver().Feedback().Error("failed to load population");
+      m_world->GetDriver().Abort(Avida::INVALID_CONFIG);
+    }
+  }
+};
+
+
+/*
+ Binary (.bpop) equivalent of SavePopulation, taking the same arguments.
+ */
+class cActionSavePopulationBinary : public cActionSavePopulation
+{
+public:
+  cActionSavePopulationBinary(cWorld* world, const cString& args, Feedback& feedback) : cActionSavePopulation(world, args, feedback) { ; }
+  
+  void Process(cAvidaContext&)
+  {
+    int update = m_world->GetStats().GetUpdate();
+    cString filename = cStringUtil::Stringf("%s-%d.bpop", (const char*)m_filename, update);
+    m_world->GetPopulation().SavePopulationBinary(filename, m_save_historic, m_save_group_info, m_save_avatars, m_save_rebirth);
+  }
+};
+
+
+/*
+ Converts a population save between the structured text (.spop) and binary (.bpop) formats.  Files ending in .bpop
+ are converted to text, anything else is treated as a structured population save and converted to binary.
+ 
+ Parameters:
+   infile (string)
+     The population save to convert, relative to the working directory.
+   outfile (string)
+     The file to write, relative to the data directory.
+ */
+class cActionConvertPopulationSave : public cAction
+{
+private:
+  cString m_infile;
+  cString m_outfile;
+  
+public:
+  cActionConvertPopulationSave(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs.GetSize()) m_infile = largs.PopWord();
+    if (largs.GetSize()) m_outfile = largs.PopWord();
+  }
+  
+  static const cString GetDescription() { return "Arguments: <cString infile> <cString outfile>"; }
+  
+  void Process(cAvidaContext& ctx)
+  {
+    Apto::String in_path = Apto::FileSystem::GetAbsolutePath(Apto::String((const char*)m_infile), Apto::String((const char*)m_world->GetWorkingDir()));
+    Apto::String out_path = Avida::Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath((const char*)m_outfile);
+    
+    bool success = false;
+    if (m_infile.GetSize() > 5 && m_infile.Substring(m_infile.GetSize() - 5, 5) == ".bpop") {
+      success = cBinaryPopulationFile::ConvertBinaryToText(m_world->GetNewWorld(), in_path, out_path, ctx.Driver().Feedback());
+    } else {
+      success = cBinaryPopulationFile::ConvertTextToBinary(in_path, out_path, ctx.Driver().Feedback());
+    }
+    if (!success) ctx.Driver().Feedback().Error("failed to convert population save '%s'", (const char*)m_infile);
+  }
+};
+
 class cActionLoadStructuredSystematicsGroup : public cAction
 {
 private:
@@ -281,13 +366,85 @@ public:
   }
 };
 
+/*
+ Saves the complete state of the world (organisms and their CPUs, genotypes, resources, statistics, and the pending
+ event list) so that the run can be resumed with LoadCheckpoint and continue exactly as the original run does.  The
+ checkpoint is written at the next sync point, see CHECKPOINT_SYNC_INTERVAL, once all events of that update have been
+ processed; saving does not change the course of the run.  Configurations the checkpoint does not cover (see
+ CHECKPOINT_SYNC_INTERVAL) are reported as errors, and no file is written.
+ 
+ Parameters:
+   filename (string) [default: "checkpoint"]
+     The name of the file to write, relative to the data directory; the update it is written at is appended.
+ */
+class cActionSaveCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  
+public:
+  cActionSaveCheckpoint(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("checkpoint")
+  {
+    cString largs(args);
+    if (largs.GetSize()) m_filename = largs.PopWord();
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string filename='checkpoint']"; }
+  
+  void Process(cAvidaContext&)
+  {
+    Apto::String path = Avida::Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath((const char*)m_filename);
+    m_world->RequestCheckpointSave((const char*)path);
+  }
+};
+
+/*
+ Resumes a run from a checkpoint written by SaveCheckpoint.  The world must be configured as it was when the
+ checkpoint was saved (including CHECKPOINT_SYNC_INTERVAL) and must not contain any organisms.  The saved event list replaces the current one, so the
+ events file of the resumed run should contain only this event, at update 0.
+ 
+ Parameters:
+   filename (string)
+     The checkpoint to load, relative to the working directory.
+ */
+class cActionLoadCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  
+public:
+  cActionLoadCheckpoint(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("")
+  {
+    cString largs(args);
+    if (largs.GetSize()) m_filename = largs.PopWord();
+  }
+  
+  static const cString GetDescription() { return "Arguments: <string filename>"; }
+  
+  void Process(cAvidaContext& ctx)
+  {
+    if (!m_filename.GetSize()) {
+      ctx.Driver().Feedback().Error("LoadCheckpoint requires a filename");
+      ctx.Driver().Abort(Avida::INVALID_CONFIG);
+      return;
+    }
+    Apto::String path = Apto::FileSystem::GetAbsolutePath(Apto::String((const char*)m_filename), Apto::String((const char*)m_world->GetWorkingDir()));
+    m_world->RequestCheckpointLoad((const char*)path);
+  }
+};
+
 void RegisterSaveLoadActions(cActionLibrary* action_lib)
 {
   action_lib->Register<cActionLoadParasiteGenotypeList>("LoadParasiteGenotypeList");
   action_lib->Register<cActionLoadHostGenotypeList>("LoadHostGenotypeList");
   action_lib->Register<cActionLoadPopulation>("LoadPopulation");
   action_lib->Register<cActionSavePopulation>("SavePopulation");
+  action_lib->Register<cActionLoadPopulationBinary>("LoadPopulationBinary");
+  action_lib->Register<cActionSavePopulationBinary>("SavePopulationBinary");
+  action_lib->Register<cActionConvertPopulationSave>("ConvertPopulationSave");
   action_lib->Register<cActionLoadStructuredSystematicsGroup>("LoadStructuredSystematicsGroup");
   action_lib->Register<cActionSaveStructuredSystematicsGroup>("SaveStructuredSystematicsGroup");
   action_lib->Register<cActionSaveFlameData>("SaveFlameData");
+  action_lib->Register<cActionSaveCheckpoint>("SaveCheckpoint");
+  action_lib->Register<cActionLoadCheckpoint>("LoadCheckpoint");
 }
@@ -46,8 +46,11 @@
 #include "cAnalyzeTreeStats_CumulativeStemminess.h"
 #include "cAnalyzeTreeStats_Gamma.h"
 #include "cAvidaContext.h"
+#include "cBatchDistance.h"
+#include "cBatchRecalculation.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
+#include "cGenotypeIndex.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
@@ -1067,37 +1070,31 @@ void cAnalyze::FindLineage(cString cur_string)
     return;
   }
   
-  // Otherwise, trace back through the id numbers to mark all of those
-  // in the ancestral lineage...
+  // Otherwise, follow the parent links of the batch index to mark all of
+  // those in the ancestral lineage...
   
   // Construct a list of genotypes found...
   
+  const cGenotypeIndex& index = batch[cur_batch].GetIndex();
+  const int num_genotypes = index.GetSize();
+  Apto::Array<bool> in_lineage(num_genotypes);
+  in_lineage.SetAll(false);
+  
   tListPlus<cAnalyzeGenotype> found_list;
   found_list.Push(found_gen);
-  int next_id = found_gen->GetParentID();
-  bool found = true;
-  while (found == true) {
-    found = false;
-    
-    tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-    while ((found_gen = batch_it.Next()) != NULL) {
-      if (found_gen->GetID() == next_id) {
-        batch_it.Remove();
-        found_list.Push(found_gen);
-        next_id = found_gen->GetParentID();
-        found = true;
-        break;
-      }
-    }
+  for (int pos = index.Find(found_gen->GetParentID()); pos >= 0; pos = index.GetParent(pos)) {
+    in_lineage[pos] = true;
+    found_list.Push(index.GetGenotype(pos));
   }
   
   // We now have all of the genotypes in this lineage, delete everything
   // else.
   
-  const int total_removed = batch[cur_batch].List().GetSize();
-  while (batch[cur_batch].List().GetSize() > 0) {
-    delete batch[cur_batch].List().Pop();
+  const int total_removed = num_genotypes - (found_list.GetSize() - 1);
+  for (int pos = 0; pos < num_genotypes; pos++) {
+    if (!in_lineage[pos]) delete index.GetGenotype(pos);
   }
+  batch[cur_batch].List().Clear();
   
   // And fill it back in with the good stuff.
   int total_kept = found_list.GetSize();
@@ -1293,10 +1290,13 @@ void cAnalyze::FindClade(cString cur_string)
     return;
   }
   
-  // Do this the brute force way... scan for one step at a time.
-  
   // Construct a list of genotypes found...
   
+  const cGenotypeIndex& index = batch[cur_batch].GetIndex();
+  const int num_genotypes = index.GetSize();
+  Apto::Array<bool> in_clade(num_genotypes);
+  in_clade.SetAll(false);
+  
   tListPlus<cAnalyzeGenotype> found_list; // Found and finished.
   tListPlus<cAnalyzeGenotype> scan_list;  // Found, but need to scan for children.
   scan_list.Push(found_gen);
@@ -1308,23 +1308,23 @@ void cAnalyze::FindClade(cString cur_string)
     int parent_id = found_gen->GetID();
     found_list.Push(found_gen);
     
-    // Seach for all of the children of this genotype...
-    tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-    while ((found_gen = batch_it.Next()) != NULL) {
-      // If we found a child, place it into the scan list.
-      if (found_gen->GetParentID() == parent_id) {
-        batch_it.Remove();
-        scan_list.Push(found_gen);
-      }
+    // Place all of the children of this genotype not yet found into the scan list.
+    const int num_children = index.GetNumChildren(parent_id);
+    for (int i = 0; i < num_children; i++) {
+      const int child = index.GetChild(parent_id, i);
+      if (in_clade[child]) continue;
+      in_clade[child] = true;
+      scan_list.Push(index.GetGenotype(child));
     }
   }
   
   // We now have all of the genotypes in this clade, delete everything else.
   
-  const int total_removed = batch[cur_batch].List().GetSize();
-  while (batch[cur_batch].List().GetSize() > 0) {
-    delete batch[cur_batch].List().Pop();
+  const int total_removed = num_genotypes - (found_list.GetSize() - 1);
+  for (int pos = 0; pos < num_genotypes; pos++) {
+    if (!in_clade[pos]) delete index.GetGenotype(pos);
   }
+  batch[cur_batch].List().Clear();
   
   // And fill it back in with the good stuff.
   int total_kept = found_list.GetSize();
@@ -1353,66 +1353,55 @@ void cAnalyze::FindLastCommonAncestor(cString)
   cout << "Finding last common ancestor of batch " << cur_batch << endl;
   
   if (m_world->GetVerbosity() >= VERBOSE_ON) {
-    cout << "  Connecting genotypes to parents. " << endl;
-  }
-  
-  // Connect each genotype to its parent.
-  tListIterator<cAnalyzeGenotype> child_it(batch[cur_batch].List());
-  cAnalyzeGenotype * on_child = NULL;
-  while ((on_child = child_it.Next()) != NULL) {
-    tListIterator<cAnalyzeGenotype> parent_it(batch[cur_batch].List());
-    cAnalyzeGenotype * on_parent = NULL;
-    while ((on_parent = parent_it.Next()) != NULL) {
-      if (on_child->GetParentID() == on_parent->GetID()) {
-        on_child->LinkParent(on_parent);
-        break;
-      }
-    }
+    cout << "  Indexing genotypes by parent. " << endl;
   }
+  
+  const cGenotypeIndex& index = batch[cur_batch].GetIndex();
+  const int num_genotypes = index.GetSize();
 
   if (m_world->GetVerbosity() >= VERBOSE_ON) {
     cout << "  Finding earliest genotype. " << endl;
   }
   
   // Find the genotype without a parent (there should only be one)
-  tListIterator<cAnalyzeGenotype> first_lca_it(batch[cur_batch].List());
-  cAnalyzeGenotype * lca = NULL;
-  cAnalyzeGenotype * test_lca = NULL;
-  while ((test_lca = first_lca_it.Next()) != NULL) {
-    if (!test_lca->GetParent()) {
+  int lca = -1;
+  for (int pos = 0; pos < num_genotypes; pos++) {
+    if (index.GetParent(pos) < 0) {
       // It is an error to get two genotypes without a parent
-      if (lca != NULL) {
+      if (lca >= 0) {
         cout << "Error: More than one genotype does not have a parent. " << endl;
-        cout << "Genotype 1: " << test_lca->GetID() << endl;
-        cout << "Genotype 2: " << lca->GetID() << endl;
+        cout << "Genotype 1: " << index.GetGenotype(pos)->GetID() << endl;
+        cout << "Genotype 2: " << index.GetGenotype(lca)->GetID() << endl;
         return;
       }
-      lca = test_lca;
+      lca = pos;
     }
   }
   
+  if (lca < 0) {
+    cout << "Error: Every genotype has a parent in the batch. " << endl;
+    return;
+  }
+  
   if (m_world->GetVerbosity() >= VERBOSE_ON) {
     cout << "  Following children to last common ancestor. " << endl;
   }
   
   // Follow the children from this parent until we find a genotype with 
   // more than one child. This is the last common ancestor.
-  while (lca->GetChildList().GetSize() == 1) {
-    lca = lca->GetChildList().Pop();
+  while (index.GetNumChildren(index.GetGenotype(lca)->GetID()) == 1) {
+    lca = index.GetChild(index.GetGenotype(lca)->GetID(), 0);
   }
   
   // Delete everything else.
-  tListIterator<cAnalyzeGenotype> delete_batch_it(batch[cur_batch].List());
-  cAnalyzeGenotype * delete_genotype = NULL;
-  while ((delete_genotype = delete_batch_it.Next()) != NULL) {
-    if (delete_genotype->GetID() != lca->GetID()) {
-      delete delete_genotype;
-    }
+  cAnalyzeGenotype* lca_genotype = index.GetGenotype(lca);
+  for (int pos = 0; pos < num_genotypes; pos++) {
+    if (pos != lca) delete index.GetGenotype(pos);
   }
   
   // And fill it back in with the good stuff.
   batch[cur_batch].List().Clear();
-  batch[cur_batch].List().PushRear(lca);
+  batch[cur_batch].List().PushRear(lca_genotype);
 }
 
 
@@ -3220,63 +3209,29 @@ void cAnalyze::CommandPrintDistances(cString cur_string)
   fout << "# 5: Frac distances above threshold (" << dist_threshold << ")" << endl;
   fout << endl;
   
-  // Loop through all pairs of organisms.
-  int dist_total = 0;
-  int dist_max = 0;
-  int pair_count = 0;
-  int threshold_pair_count = 0;
+  // Compute the distances between all pairs of genotypes.
+  cBatchDistance distances(cBatchDistance::EDIT_DISTANCE, batch[cur_batch].List());
+  distances.SetThreshold(dist_threshold);
+  distances.Run(m_jobqueue);
+  
+  double pair_count = distances.GetTotalPairs();
 	double count = 0;
 	
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  tListIterator<cAnalyzeGenotype> batch_it1(batch[cur_batch].List());
-
-  int watermark = 0;
-  
-  while ((genotype1 = batch_it1.Next()) != NULL) {
+  // Pair each genotype with itself for a distance of 0.
+  cAnalyzeGenotype * genotype = NULL;
+  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+  while ((genotype = batch_it.Next()) != NULL) {
 		count ++;
-    const int gen1_count = genotype1->GetNumCPUs();
-
-    // Pair this genotype with itself for a distance of 0.
-    pair_count += gen1_count * (gen1_count - 1) / 2;
-
-    // Loop through the other genotypes this one can be paired with.
-    tListIterator<cAnalyzeGenotype> batch_it2(batch_it1);
-    while ((genotype2 = batch_it2.Next()) != NULL) {
-      const int gen2_count = genotype2->GetNumCPUs();
-      const int cur_pairs = gen1_count * gen2_count;
-      
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int cur_dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      dist_total += cur_pairs * cur_dist;
-      if (cur_dist > dist_max) dist_max = cur_dist;
-      pair_count += cur_pairs;
-      if (cur_dist >= dist_threshold) threshold_pair_count += cur_pairs;
-
-      if (pair_count > watermark) {
-	cout << watermark << endl;
-	watermark += 100000;
-      }
-    }
+    const int gen_count = genotype->GetNumCPUs();
+    pair_count += gen_count * (gen_count - 1) / 2;
   }
   
 	count = (count * (count-1) ) /2;
-  fout << pair_count << " "
-	     << ((double) dist_total) / count << " " 
-       << ((double) dist_total) / (double) pair_count << " "
-       << dist_max << " "
-       << ((double) threshold_pair_count) / (double) pair_count << " "
+  fout << static_cast<long long>(pair_count) << " "
+	     << distances.GetTotalDistance() / count << " " 
+       << distances.GetTotalDistance() / pair_count << " "
+       << distances.GetMaxDistance() << " "
+       << distances.GetThresholdPairs() / pair_count << " "
        << endl;
 }
 
@@ -5908,44 +5863,9 @@ void cAnalyze::CommandHamming(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-
   double total_dist = 0;
   double total_count = 0;
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindHammingDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
-  }
+  BatchUtil_SumDistances(batch1, batch2, false, total_dist, total_count);
   
   
   // Calculate the final answer
@@ -5986,44 +5906,9 @@ void cAnalyze::CommandLevenstein(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
   double total_dist = 0;
   double total_count = 0;
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  // Loop through all of the genotypes in each batch...
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
-  }
+  BatchUtil_SumDistances(batch1, batch2, true, total_dist, total_count);
   
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
@@ -8883,19 +8768,8 @@ void cAnalyze::BatchRecalculate(cString cur_string)
     cerr << "warning: " << msg << endl;
   }
   
-  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-  cAnalyzeGenotype * genotype = NULL;
-  cAnalyzeGenotype * last_genotype = NULL;
-  while ((genotype = batch_it.Next()) != NULL) {    
-    // If the previous genotype was the parent of this one, pass in a pointer
-    // to it for improved recalculate (such as distance to parent, etc.)
-    if (last_genotype != NULL && genotype->GetParentID() == last_genotype->GetID()) {
-      genotype->Recalculate(m_ctx, &test_info, last_genotype);
-    } else {
-      genotype->Recalculate(m_ctx, &test_info);
-    }
-    last_genotype = genotype;
-  }
+  cBatchRecalculation recalc(batch[cur_batch].List(), test_info);
+  recalc.Run(m_ctx, m_jobqueue);
     
   return;
 }
@@ -8976,19 +8850,8 @@ void cAnalyze::BatchRecalculateWithArgs(cString cur_string)
     cerr << "warning: " << msg << endl;
   }
   
-  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-  cAnalyzeGenotype * genotype = NULL;
-  cAnalyzeGenotype * last_genotype = NULL;
-  while ((genotype = batch_it.Next()) != NULL) {    
-    // If the previous genotype was the parent of this one, pass in a pointer
-    // to it for improved recalculate (such as distance to parent, etc.)
-    if (last_genotype != NULL && genotype->GetParentID() == last_genotype->GetID()) {
-      genotype->Recalculate(m_ctx, &test_info, last_genotype, num_trials);
-    } else {
-      genotype->Recalculate(m_ctx, &test_info, NULL, num_trials);
-    }
-    last_genotype = genotype;
-  }
+  cBatchRecalculation recalc(batch[cur_batch].List(), test_info, num_trials);
+  recalc.Run(m_ctx, m_jobqueue);
   
   return;
 }
@@ -9367,6 +9230,37 @@ int cAnalyze::BatchUtil_GetMaxLength(int batch_id)
 }
 
 
+// Sums the distances between all organisms in one batch and all organisms in the other.  When both are the same batch,
+// each pair of genotypes counts in both orders and a genotype with n organisms is paired with itself (n - 1)^2 times.
+void cAnalyze::BatchUtil_SumDistances(int batch1, int batch2, bool use_edit_distance, double& total_dist,
+                                      double& total_count)
+{
+  const cBatchDistance::eMetric metric = (use_edit_distance) ? cBatchDistance::EDIT_DISTANCE : cBatchDistance::HAMMING_DISTANCE;
+  
+  if (batch1 != batch2) {
+    cBatchDistance distances(metric, batch[batch1].List(), batch[batch2].List());
+    distances.Run(m_jobqueue);
+    total_dist = distances.GetTotalDistance();
+    total_count = distances.GetTotalPairs();
+    return;
+  }
+  
+  // Within a single batch each pair of genotypes only needs to be compared once...
+  cBatchDistance distances(metric, batch[batch1].List());
+  distances.Run(m_jobqueue);
+  total_dist = 2.0 * distances.GetTotalDistance();
+  total_count = 2.0 * distances.GetTotalPairs();
+  
+  // ...and each genotype contributes its organisms paired with one another at distance 0.
+  tListIterator<cAnalyzeGenotype> batch_it(batch[batch1].List());
+  cAnalyzeGenotype* genotype = NULL;
+  while ((genotype = batch_it.Next()) != NULL) {
+    const int count = genotype->GetNumCPUs();
+    total_count += (count - 1) * (count - 1);
+  }
+}
+
+
 void cAnalyze::CommandForeach(cString cur_string,
                               tList<cAnalyzeCommand> & clist)
 {
@@ -181,6 +181,7 @@ private:
   
   // Batch management...
   int BatchUtil_GetMaxLength(int batch_id = -1);
+  void BatchUtil_SumDistances(int batch1, int batch2, bool use_edit_distance, double& total_dist, double& total_count);
   
   // Command helpers...
   void CommandDetail_Header(std::ostream& fp, int format_type,
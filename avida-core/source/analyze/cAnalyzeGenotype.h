@@ -232,6 +232,10 @@ public:
   void SetCPUTestInfo(cCPUTestInfo& in_cpu_test_info) { m_cpu_test_info = in_cpu_test_info; }
   
   void Recalculate(cAvidaContext& ctx, cCPUTestInfo* test_info = NULL, cAnalyzeGenotype* parent_genotype = NULL, int num_trials = 1);
+  // Recalculate is RecalculatePhenotype followed by CalcParentStats; the phenotypes of a batch are independent and
+  // may be computed concurrently, the parent stats depend on the parent having been recalculated first.
+  void RecalculatePhenotype(cAvidaContext& ctx, cCPUTestInfo* test_info = NULL, int num_trials = 1);
+  void CalcParentStats(cAnalyzeGenotype* parent_genotype);
   void PrintTasks(std::ofstream& fp, int min_task = 0, int max_task = -1);
   void PrintTasksQuality(std::ofstream& fp, int min_task = 0, int max_task = -1);
   void PrintInternalTasks(std::ofstream& fp, int min_task = 0, int max_task = -1);
@@ -137,6 +137,7 @@ void cAnalyzeJobQueue::singleThreadedJobExecution(cAnalyzeJob* job)
 {
   Apto::RNG::AvidaRNG rng(GetSeedForJob(job->GetID()));
   cAvidaContext ctx(&m_world->GetDriver(), rng);
+  ctx.SetAnalyzeMode();
   job->Run(ctx);
   delete job;
 }
@@ -0,0 +1,278 @@
+/*
+ *  cBatchDistance.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cBatchDistance.h"
+
+#include "avida/core/Genome.h"
+#include "avida/core/InstructionSequence.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+#include "tAnalyzeJobBatch.h"
+#include "tList.h"
+
+#include <climits>
+#include <cstring>
+
+#if APTO_PLATFORM(WINDOWS) && defined(AddJob)
+# undef AddJob
+#endif
+
+using namespace Avida;
+
+
+// Genotype pairs compared by a single queued job
+static const int DISTANCE_JOB_PAIRS = 16384;
+
+// Instructions are stored as single bytes
+static const int NUM_SYMBOLS = 256;
+
+static const uint64_t WORD_HIGH_BIT = (uint64_t)1 << 63;
+static const uint64_t BYTE_LOW_BITS = 0x0101010101010101ULL;
+
+
+static int hammingDistance(const Apto::Array<unsigned char>& seq1, const Apto::Array<unsigned char>& seq2)
+{
+  const int size1 = seq1.GetSize();
+  const int size2 = seq2.GetSize();
+  const int overlap = Apto::Min(size1, size2);
+
+  // Anything protruding past the overlap counts toward the distance, as in InstructionSequence::FindHammingDistance
+  int distance = size1 + size2 - 2 * overlap;
+  if (!overlap) return distance;
+
+  const unsigned char* sites1 = &seq1[0];
+  const unsigned char* sites2 = &seq2[0];
+
+  int i = 0;
+  for (; i + 8 <= overlap; i += 8) {
+    uint64_t word1, word2;
+    memcpy(&word1, sites1 + i, sizeof(uint64_t));
+    memcpy(&word2, sites2 + i, sizeof(uint64_t));
+    uint64_t diff = word1 ^ word2;
+    if (!diff) continue;
+
+    // Fold every bit of each byte down onto the byte's low bit, then add up the low bits
+    diff |= diff >> 4;
+    diff |= diff >> 2;
+    diff |= diff >> 1;
+    diff &= BYTE_LOW_BITS;
+    distance += static_cast<int>((diff * BYTE_LOW_BITS) >> 56);
+  }
+  for (; i < overlap; i++) if (sites1[i] != sites2[i]) distance++;
+
+  return distance;
+}
+
+
+// Match masks of a pattern for Myers' algorithm: bit k of peq[symbol * num_blocks + k / 64] is set when site k of the
+// pattern is that symbol
+static void buildMatchMasks(const Apto::Array<unsigned char>& pattern, Apto::Array<uint64_t>& peq)
+{
+  const int num_blocks = (pattern.GetSize() + 63) / 64;
+  peq.Resize(NUM_SYMBOLS * num_blocks);
+  peq.SetAll(0);
+  for (int k = 0; k < pattern.GetSize(); k++) peq[pattern[k] * num_blocks + k / 64] |= (uint64_t)1 << (k % 64);
+}
+
+// Myers' bit-vector edit distance, extended to patterns longer than a word by carrying the horizontal delta from one
+// block of 64 pattern sites into the next.  The pv/mv arrays hold the positive/negative vertical deltas of the
+// current column and must have room for one word per block.
+static int editDistance(const Apto::Array<uint64_t>& peq, int pattern_size, const Apto::Array<unsigned char>& text,
+                        Apto::Array<uint64_t>& pv, Apto::Array<uint64_t>& mv)
+{
+  const int text_size = text.GetSize();
+  if (!pattern_size) return text_size;
+
+  const int num_blocks = (pattern_size + 63) / 64;
+  const uint64_t last_bit = (uint64_t)1 << ((pattern_size - 1) % 64);
+
+  // The first column is 0, 1, 2, ... down the pattern, so every vertical delta starts at +1
+  for (int b = 0; b < num_blocks; b++) {
+    pv[b] = ~(uint64_t)0;
+    mv[b] = 0;
+  }
+
+  int score = pattern_size;
+  for (int j = 0; j < text_size; j++) {
+    const uint64_t* eq_col = &peq[text[j] * num_blocks];
+    int carry = 1;  // the top row is 0, 1, 2, ... along the text
+
+    for (int b = 0; b < num_blocks; b++) {
+      const uint64_t pv_b = pv[b];
+      const uint64_t mv_b = mv[b];
+      uint64_t eq = eq_col[b];
+
+      const uint64_t xv = eq | mv_b;
+      if (carry < 0) eq |= 1;
+      const uint64_t xh = (((eq & pv_b) + pv_b) ^ pv_b) | eq;
+      uint64_t ph = mv_b | ~(xh | pv_b);
+      uint64_t mh = pv_b & xh;
+
+      // Horizontal delta at the bottom of this block (only bits up to the pattern end are meaningful)
+      const uint64_t out_bit = (b == num_blocks - 1) ? last_bit : WORD_HIGH_BIT;
+      int out = 0;
+      if (ph & out_bit) out = 1;
+      else if (mh & out_bit) out = -1;
+
+      ph <<= 1;
+      mh <<= 1;
+      if (carry < 0) mh |= 1;
+      else if (carry > 0) ph |= 1;
+      pv[b] = mh | ~(xv | ph);
+      mv[b] = ph & xv;
+
+      carry = out;
+    }
+
+    score += carry;
+  }
+
+  return score;
+}
+
+
+class cBatchDistance::cJob
+{
+private:
+  cBatchDistance& m_calc;
+  const int m_begin;
+  const int m_end;
+
+public:
+  double m_total_dist;
+  double m_total_pairs;
+  double m_threshold_pairs;
+  int m_max_dist;
+
+  cJob(cBatchDistance& calc, int begin, int end)
+    : m_calc(calc), m_begin(begin), m_end(end), m_total_dist(0.0), m_total_pairs(0.0), m_threshold_pairs(0.0)
+    , m_max_dist(0) { ; }
+
+  void Calculate(cAvidaContext&)
+  {
+    const Apto::Array<sSequence>& rows = m_calc.m_rows;
+    const Apto::Array<sSequence>& cols = (m_calc.m_all_pairs) ? m_calc.m_rows : m_calc.m_cols;
+    const bool use_edit = (m_calc.m_metric == EDIT_DISTANCE);
+
+    Apto::Array<uint64_t> peq;
+    Apto::Array<uint64_t> pv;
+    Apto::Array<uint64_t> mv;
+
+    for (int i = m_begin; i < m_end; i++) {
+      const sSequence& row = rows[i];
+      if (use_edit) {
+        buildMatchMasks(row.sites, peq);
+        const int num_blocks = (row.sites.GetSize() + 63) / 64;
+        if (pv.GetSize() < num_blocks) {
+          pv.Resize(num_blocks);
+          mv.Resize(num_blocks);
+        }
+      }
+
+      for (int j = (m_calc.m_all_pairs) ? (i + 1) : 0; j < cols.GetSize(); j++) {
+        const sSequence& col = cols[j];
+        const int dist = (use_edit) ? editDistance(peq, row.sites.GetSize(), col.sites, pv, mv)
+                                    : hammingDistance(row.sites, col.sites);
+        const double num_pairs = static_cast<double>(row.num_cpus) * static_cast<double>(col.num_cpus);
+
+        m_total_dist += num_pairs * dist;
+        m_total_pairs += num_pairs;
+        if (dist >= m_calc.m_threshold) m_threshold_pairs += num_pairs;
+        if (dist > m_max_dist) m_max_dist = dist;
+      }
+    }
+  }
+};
+
+
+cBatchDistance::cBatchDistance(eMetric metric, tList<cAnalyzeGenotype>& genotypes)
+  : m_metric(metric), m_all_pairs(true), m_threshold(INT_MAX)
+  , m_total_dist(0.0), m_total_pairs(0.0), m_threshold_pairs(0.0), m_max_dist(0)
+{
+  loadSequences(genotypes, m_rows);
+}
+
+cBatchDistance::cBatchDistance(eMetric metric, tList<cAnalyzeGenotype>& genotypes1, tList<cAnalyzeGenotype>& genotypes2)
+  : m_metric(metric), m_all_pairs(false), m_threshold(INT_MAX)
+  , m_total_dist(0.0), m_total_pairs(0.0), m_threshold_pairs(0.0), m_max_dist(0)
+{
+  loadSequences(genotypes1, m_rows);
+  loadSequences(genotypes2, m_cols);
+}
+
+
+void cBatchDistance::Run(cAnalyzeJobQueue& queue)
+{
+  const int num_rows = m_rows.GetSize();
+  const int num_cols = (m_all_pairs) ? num_rows : m_cols.GetSize();
+
+  // Group consecutive rows into jobs; with all pairs the rows get shorter toward the end of the list
+  tList<cJob> job_list;
+  tAnalyzeJobBatch<cJob> jobbatch(queue);
+  int begin = 0;
+  int job_pairs = 0;
+  for (int i = 0; i < num_rows; i++) {
+    job_pairs += (m_all_pairs) ? (num_cols - i - 1) : num_cols;
+    if (job_pairs >= DISTANCE_JOB_PAIRS || i == num_rows - 1) {
+      cJob* job = new cJob(*this, begin, i + 1);
+      job_list.PushRear(job);
+      jobbatch.AddJob(job, &cJob::Calculate);
+      begin = i + 1;
+      job_pairs = 0;
+    }
+  }
+  jobbatch.RunBatch();
+
+  m_total_dist = 0.0;
+  m_total_pairs = 0.0;
+  m_threshold_pairs = 0.0;
+  m_max_dist = 0;
+
+  cJob* job = NULL;
+  while ((job = job_list.Pop())) {
+    m_total_dist += job->m_total_dist;
+    m_total_pairs += job->m_total_pairs;
+    m_threshold_pairs += job->m_threshold_pairs;
+    if (job->m_max_dist > m_max_dist) m_max_dist = job->m_max_dist;
+    delete job;
+  }
+}
+
+
+void cBatchDistance::loadSequences(tList<cAnalyzeGenotype>& genotypes, Apto::Array<sSequence>& sequences)
+{
+  sequences.Resize(genotypes.GetSize());
+
+  tListIterator<cAnalyzeGenotype> list_it(genotypes);
+  for (int i = 0; i < sequences.GetSize(); i++) {
+    cAnalyzeGenotype* genotype = list_it.Next();
+
+    ConstInstructionSequencePtr seq_p;
+    ConstGeneticRepresentationPtr rep_p = genotype->GetGenome().Representation();
+    seq_p.DynamicCastFrom(rep_p);
+    const InstructionSequence& seq = *seq_p;
+
+    sequences[i].sites.Resize(seq.GetSize());
+    for (int k = 0; k < seq.GetSize(); k++) sequences[i].sites[k] = static_cast<unsigned char>(seq[k].GetOp());
+    sequences[i].num_cpus = genotype->GetNumCPUs();
+  }
+}
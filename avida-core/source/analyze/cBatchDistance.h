@@ -0,0 +1,87 @@
+/*
+ *  cBatchDistance.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cBatchDistance_h
+#define cBatchDistance_h
+
+#include "apto/core.h"
+
+class cAnalyzeJobQueue;
+class cAnalyzeGenotype;
+template <class T> class tList;
+
+
+// Sums the Hamming or Levenshtein distances between genotype pairs, each weighted by the number of organism pairs it
+// represents (the product of the two genotypes' CPU counts).  Either every unordered pair of distinct genotypes in
+// one list is compared, or every genotype in one list against every genotype in another.
+//
+// Sequences are packed into bytes once up front.  Hamming distances compare eight sites per word; edit distances use
+// Myers' bit-vector algorithm, building the match masks of each row genotype once and reusing them for the whole row.
+// Rows are split into jobs of roughly equal pair counts and run across the analyze job queue.  Each job keeps its own
+// sums, which are combined in job order, so results do not depend on the number of threads.
+
+class cBatchDistance
+{
+public:
+  enum eMetric { HAMMING_DISTANCE, EDIT_DISTANCE };
+
+private:
+  struct sSequence
+  {
+    Apto::Array<unsigned char> sites;
+    int num_cpus;
+  };
+
+  eMetric m_metric;
+  Apto::Array<sSequence> m_rows;
+  Apto::Array<sSequence> m_cols;
+  bool m_all_pairs;             // compare m_rows against itself, pairs (i, j) with i < j only
+  int m_threshold;
+
+  double m_total_dist;
+  double m_total_pairs;
+  double m_threshold_pairs;
+  int m_max_dist;
+
+  class cJob;
+
+  cBatchDistance(); // @not_implemented
+  cBatchDistance(const cBatchDistance&); // @not_implemented
+  cBatchDistance& operator=(const cBatchDistance&); // @not_implemented
+
+public:
+  cBatchDistance(eMetric metric, tList<cAnalyzeGenotype>& genotypes);
+  cBatchDistance(eMetric metric, tList<cAnalyzeGenotype>& genotypes1, tList<cAnalyzeGenotype>& genotypes2);
+
+  // Organism pairs at or above the threshold distance are counted separately
+  void SetThreshold(int threshold) { m_threshold = threshold; }
+
+  void Run(cAnalyzeJobQueue& queue);
+
+  double GetTotalDistance() const { return m_total_dist; }
+  double GetTotalPairs() const { return m_total_pairs; }
+  double GetThresholdPairs() const { return m_threshold_pairs; }
+  int GetMaxDistance() const { return m_max_dist; }
+
+private:
+  static void loadSequences(tList<cAnalyzeGenotype>& genotypes, Apto::Array<sSequence>& sequences);
+};
+
+#endif
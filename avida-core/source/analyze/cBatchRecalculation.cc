@@ -0,0 +1,96 @@
+/*
+ *  cBatchRecalculation.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cBatchRecalculation.h"
+
+#include "apto/rng.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+#include "tAnalyzeJobBatch.h"
+#include "tList.h"
+
+#if APTO_PLATFORM(WINDOWS) && defined(AddJob)
+# undef AddJob
+#endif
+
+
+// Number of genotypes handled by a single queued job; test CPU runs dominate, so this only amortizes queue overhead
+static const int RECALCULATE_JOB_SIZE = 16;
+
+
+class cBatchRecalculation::cJob
+{
+private:
+  cBatchRecalculation& m_recalc;
+  const int m_begin;
+  const int m_end;
+  
+public:
+  cJob(cBatchRecalculation& recalc, int begin, int end) : m_recalc(recalc), m_begin(begin), m_end(end) { ; }
+  
+  void Recalculate(cAvidaContext& ctx)
+  {
+    // Each job gets its own copy of the test info, test CPUs write their results into it
+    cCPUTestInfo test_info(m_recalc.m_test_info);
+    Apto::Random& job_rng = ctx.GetRandom();
+    
+    for (int i = m_begin; i < m_end; i++) {
+      Apto::RNG::AvidaRNG rng(m_recalc.m_seeds[i]);
+      ctx.SetRandom(rng);
+      m_recalc.m_genotypes[i]->RecalculatePhenotype(ctx, &test_info, m_recalc.m_num_trials);
+    }
+    
+    ctx.SetRandom(job_rng);
+  }
+};
+
+
+cBatchRecalculation::cBatchRecalculation(tList<cAnalyzeGenotype>& genotypes, const cCPUTestInfo& test_info, int num_trials)
+  : m_genotypes(genotypes.GetSize()), m_seeds(genotypes.GetSize()), m_test_info(test_info), m_num_trials(num_trials)
+{
+  tListIterator<cAnalyzeGenotype> list_it(genotypes);
+  for (int i = 0; i < m_genotypes.GetSize(); i++) m_genotypes[i] = list_it.Next();
+}
+
+
+void cBatchRecalculation::Run(cAvidaContext& ctx, cAnalyzeJobQueue& queue)
+{
+  const int num_genotypes = m_genotypes.GetSize();
+  for (int i = 0; i < num_genotypes; i++) m_seeds[i] = ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed());
+  
+  tList<cJob> job_list;
+  tAnalyzeJobBatch<cJob> jobbatch(queue);
+  for (int begin = 0; begin < num_genotypes; begin += RECALCULATE_JOB_SIZE) {
+    cJob* job = new cJob(*this, begin, Apto::Min(begin + RECALCULATE_JOB_SIZE, num_genotypes));
+    job_list.Push(job);
+    jobbatch.AddJob(job, &cJob::Recalculate);
+  }
+  jobbatch.RunBatch();
+  cJob* job = NULL;
+  while ((job = job_list.Pop())) delete job;
+  
+  // If the previous genotype was the parent of this one, use it for the parent stats.  These build on the parent's
+  // recalculated values (including its ancestor distance), so they must be calculated in list order.
+  for (int i = 1; i < num_genotypes; i++) {
+    if (m_genotypes[i]->GetParentID() == m_genotypes[i - 1]->GetID()) m_genotypes[i]->CalcParentStats(m_genotypes[i - 1]);
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ *  cBatchRecalculation.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cBatchRecalculation_h
+#define cBatchRecalculation_h
+
+#include "apto/core.h"
+
+#include "cCPUTestInfo.h"
+
+class cAnalyzeJobQueue;
+class cAnalyzeGenotype;
+class cAvidaContext;
+template <class T> class tList;
+
+
+// Recalculates the phenotypes of a genotype list across the analyze job queue.  Each genotype is run with its own
+// random number seed, drawn in list order before any job starts, so the results do not depend on the number of
+// threads or on the order in which jobs are picked up.  Parent stats (fitness ratio, parent and ancestor distance)
+// chain through the list and are calculated serially once all phenotypes are done.
+
+class cBatchRecalculation
+{
+private:
+  Apto::Array<cAnalyzeGenotype*> m_genotypes;
+  Apto::Array<int> m_seeds;
+  cCPUTestInfo m_test_info;
+  int m_num_trials;
+
+  class cJob;
+
+  cBatchRecalculation(); // @not_implemented
+  cBatchRecalculation(const cBatchRecalculation&); // @not_implemented
+  cBatchRecalculation& operator=(const cBatchRecalculation&); // @not_implemented
+
+public:
+  cBatchRecalculation(tList<cAnalyzeGenotype>& genotypes, const cCPUTestInfo& test_info, int num_trials = 1);
+
+  void Run(cAvidaContext& ctx, cAnalyzeJobQueue& queue);
+};
+
+#endif
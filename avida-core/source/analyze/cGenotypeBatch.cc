@@ -22,9 +22,10 @@
 #include "cGenotypeBatch.h"
 
 #include "cAnalyzeGenotype.h"
+#include "cGenotypeIndex.h"
 
 
-cGenotypeBatch::cGenotypeBatch(const cGenotypeBatch& rhs) : m_list(rhs.m_list), m_name(rhs.m_name), m_is_lineage(rhs.m_is_lineage), m_is_aligned(rhs.m_is_aligned)
+cGenotypeBatch::cGenotypeBatch(const cGenotypeBatch& rhs) : m_list(rhs.m_list), m_name(rhs.m_name), m_is_lineage(rhs.m_is_lineage), m_is_aligned(rhs.m_is_aligned), m_index(NULL)
 {
   if (rhs.m_lineage_head) {
     m_lineage_head = new cAnalyzeGenotype(*(rhs.m_lineage_head));
@@ -43,6 +44,7 @@ cGenotypeBatch::~cGenotypeBatch()
   
   delete m_lineage_head;
   delete m_clade_head;
+  delete m_index;
 }
 
 cGenotypeBatch& cGenotypeBatch::operator=(const cGenotypeBatch& rhs)
@@ -55,6 +57,7 @@ cGenotypeBatch& cGenotypeBatch::operator=(const cGenotypeBatch& rhs)
   m_name =       rhs.m_name;
   m_is_lineage = rhs.m_is_lineage;
   m_is_aligned = rhs.m_is_aligned;
+  invalidateIndex();
 
   // pointery bits
   delete m_lineage_head;
@@ -71,6 +74,20 @@ cGenotypeBatch& cGenotypeBatch::operator=(const cGenotypeBatch& rhs)
 }
 
 
+const cGenotypeIndex& cGenotypeBatch::GetIndex(bool with_ancestor_table) const
+{
+  if (!m_index) m_index = new cGenotypeIndex(m_list);
+  if (with_ancestor_table) m_index->BuildAncestorTable();
+  return *m_index;
+}
+
+void cGenotypeBatch::invalidateIndex() const
+{
+  delete m_index;
+  m_index = NULL;
+}
+
+
 cAnalyzeGenotype* cGenotypeBatch::FindGenotypeNumCPUs() const
 {
   return new cAnalyzeGenotype(*(m_list.FindMax(&cAnalyzeGenotype::GetNumCPUs)));
@@ -183,40 +200,45 @@ cAnalyzeGenotype* cGenotypeBatch::FindLastCommonAncestor()
   // Finds the last common ancestor among all current organisms that are still alive,
   // i.e. have an update_died of -1.
   
-  // Connect each genotype to its parent.
-  tListIterator<cAnalyzeGenotype> it(m_list);
-  tListIterator<cAnalyzeGenotype> parent_it(m_list);
-  cAnalyzeGenotype* on_child = NULL;
-  while ((on_child = it.Next())) {
-    parent_it.Reset();
-    cAnalyzeGenotype* on_parent = NULL;
-    while ((on_parent = parent_it.Next())) {
-      if (on_child->GetParentID() == on_parent->GetID()) {
-        on_child->LinkParent(on_parent);
-        break;
-      }
-    }
-  }
+  const cGenotypeIndex& index = GetIndex();
     
   // Find the genotype without a parent (there should only be one)
-  it.Reset();
-  cAnalyzeGenotype* lca = NULL;
-  cAnalyzeGenotype* test_lca = NULL;
-  while ((test_lca = it.Next())) {
-    if (!test_lca->GetParent()) {
+  int lca = -1;
+  for (int i = 0; i < index.GetSize(); i++) {
+    if (index.GetParent(i) < 0) {
       // It is an error to get two genotypes without a parent
-      if (lca) return NULL;
-      lca = test_lca;
+      if (lca >= 0) return NULL;
+      lca = i;
     }
   }
+  if (lca < 0) return NULL;
   
   // Follow the children from this parent until we find a genotype with more than one child.
   // This is the last common ancestor.
-  while (lca->GetChildList().GetSize() == 1) {
-    lca = lca->GetChildList().Pop();
+  while (index.GetNumChildren(index.GetGenotype(lca)->GetID()) == 1) {
+    lca = index.GetChild(index.GetGenotype(lca)->GetID(), 0);
   }
   
-  return new cAnalyzeGenotype(*lca);
+  return new cAnalyzeGenotype(*index.GetGenotype(lca));
+}
+
+
+cAnalyzeGenotype* cGenotypeBatch::FindCommonAncestor(cAnalyzeGenotype* genotype1, cAnalyzeGenotype* genotype2) const
+{
+  if (genotype1 && genotype2) return FindCommonAncestor(genotype1->GetID(), genotype2->GetID());
+  
+  return NULL;
+}
+
+cAnalyzeGenotype* cGenotypeBatch::FindCommonAncestor(int genotype_id1, int genotype_id2) const
+{
+  // Pairwise queries tend to come in bulk, so pay for the ancestor table once up front
+  const cGenotypeIndex& index = GetIndex(true);
+  
+  int ancestor = index.CommonAncestor(index.Find(genotype_id1), index.Find(genotype_id2));
+  if (ancestor < 0) return NULL;
+  
+  return new cAnalyzeGenotype(*index.GetGenotype(ancestor));
 }
 
 
@@ -231,12 +253,12 @@ cGenotypeBatch* cGenotypeBatch::FindLineage(cAnalyzeGenotype* end_genotype) cons
 cGenotypeBatch* cGenotypeBatch::FindLineage(int end_genotype_id) const
 {
   cGenotypeBatch* batch = new cGenotypeBatch;
-  cAnalyzeGenotype* found_gen = FindGenotypeID(end_genotype_id);
+  const cGenotypeIndex& index = GetIndex();
   
-  while ((found_gen)) {
+  for (int pos = index.Find(end_genotype_id); pos >= 0; pos = index.GetParent(pos)) {
+    cAnalyzeGenotype* found_gen = new cAnalyzeGenotype(*index.GetGenotype(pos));
     batch->m_list.Push(found_gen);
     batch->m_lineage_head = found_gen;
-    found_gen = FindGenotypeID(found_gen->GetParentID());
   }
     
   return batch;
@@ -355,27 +377,33 @@ cGenotypeBatch* cGenotypeBatch::FindClade(cAnalyzeGenotype* start_genotype) cons
 cGenotypeBatch* cGenotypeBatch::FindClade(int start_genotype_id) const
 {
   cGenotypeBatch* batch = new cGenotypeBatch;
-  tList<cAnalyzeGenotype> list(m_list);
+  const cGenotypeIndex& index = GetIndex();
+  const int start_pos = index.Find(start_genotype_id);
+  
+  if (start_pos < 0) return batch;
+  
+  Apto::Array<bool> in_clade(index.GetSize());
+  in_clade.SetAll(false);
+  in_clade[start_pos] = true;
+  
+  cAnalyzeGenotype* found_gen = new cAnalyzeGenotype(*index.GetGenotype(start_pos));
+  batch->m_list.Push(found_gen);
+  batch->m_clade_head = found_gen;
+  
   Apto::Array<int, Apto::Smart> scan_list;
-  cAnalyzeGenotype* found_gen = FindGenotypeID(start_genotype_id);
- 
-  if ((found_gen)) {
-    batch->m_list.Push(found_gen);
-    batch->m_clade_head = found_gen;
-    scan_list.Push(found_gen->GetID());
-  }
+  scan_list.Push(start_genotype_id);
   
   while (scan_list.GetSize()) {
     int parent_id = scan_list.Pop();
     
-    // Seach for all of the offspring of this genotype...
-    tListIterator<cAnalyzeGenotype> it(list);
-    while ((found_gen = it.Next()) != NULL) {
-      if (found_gen->GetParentID() == parent_id) {
-        it.Remove();
-        scan_list.Push(found_gen->GetID());
-        batch->m_list.Push(new cAnalyzeGenotype(*found_gen));
-      }
+    // Collect all of the offspring of this genotype...
+    const int num_children = index.GetNumChildren(parent_id);
+    for (int i = 0; i < num_children; i++) {
+      const int child = index.GetChild(parent_id, i);
+      if (in_clade[child]) continue;
+      in_clade[child] = true;
+      scan_list.Push(index.GetGenotype(child)->GetID());
+      batch->m_list.Push(new cAnalyzeGenotype(*index.GetGenotype(child)));
     }
   }
 
@@ -402,25 +430,47 @@ void cGenotypeBatch::RemoveClade(int start_genotype_id)
       }
     }
     while ((genotype = it.Next())) { it.Remove(); delete genotype; }
+    invalidateIndex();
   } else {
-    Apto::Array<int, Apto::Smart> scan_list;
-    cAnalyzeGenotype* found_gen = PopGenotypeID(start_genotype_id);
+    const cGenotypeIndex& index = GetIndex();
+    const int start_pos = index.Find(start_genotype_id);
+    
+    if (start_pos < 0) {
+      clearFlags();
+      return;
+    }
     
-    if ((found_gen)) scan_list.Push(found_gen->GetID());
+    Apto::Array<bool> in_clade(index.GetSize());
+    in_clade.SetAll(false);
+    in_clade[start_pos] = true;
+    
+    Apto::Array<int, Apto::Smart> scan_list;
+    scan_list.Push(start_genotype_id);
     
     while (scan_list.GetSize()) {
       int parent_id = scan_list.Pop();
       
-      // Seach for all of the offspring of this genotype...
-      tListIterator<cAnalyzeGenotype> it(m_list);
-      while ((found_gen = it.Next()) != NULL) {
-        if (found_gen->GetParentID() == parent_id) {
-          it.Remove();
-          scan_list.Push(found_gen->GetID());
-          delete found_gen;
-        }
+      // Mark all of the offspring of this genotype...
+      const int num_children = index.GetNumChildren(parent_id);
+      for (int i = 0; i < num_children; i++) {
+        const int child = index.GetChild(parent_id, i);
+        if (in_clade[child]) continue;
+        in_clade[child] = true;
+        scan_list.Push(index.GetGenotype(child)->GetID());
       }
     }
+    
+    // ...and remove the whole clade in a single pass (index positions follow list order)
+    tListIterator<cAnalyzeGenotype> it(m_list);
+    cAnalyzeGenotype* genotype = NULL;
+    for (int pos = 0; (genotype = it.Next()); pos++) {
+      if (in_clade[pos]) {
+        it.Remove();
+        delete genotype;
+      }
+    }
+    
+    clearFlags();
   }
 }
 
@@ -33,6 +33,7 @@
 // cGenotypeBatch      : Collection of cAnalyzeGenotypes
 
 class cAnalyzeGenotype;
+class cGenotypeIndex;
 
 
 class cGenotypeBatch
@@ -44,19 +45,24 @@ private:
   cAnalyzeGenotype* m_clade_head;
   bool m_is_lineage;
   bool m_is_aligned;
+  mutable cGenotypeIndex* m_index;
   
 public:
-  cGenotypeBatch() : m_name(""), m_lineage_head(NULL), m_clade_head(NULL), m_is_lineage(false), m_is_aligned(false) { ; }
+  cGenotypeBatch()
+    : m_name(""), m_lineage_head(NULL), m_clade_head(NULL), m_is_lineage(false), m_is_aligned(false), m_index(NULL) { ; }
   cGenotypeBatch(const cGenotypeBatch&);
   ~cGenotypeBatch();
 
   cGenotypeBatch& operator=(const cGenotypeBatch&);
 
-  tListPlus<cAnalyzeGenotype>& List() { return m_list; }
+  tListPlus<cAnalyzeGenotype>& List() { invalidateIndex(); return m_list; }
   cString& Name() { return m_name; }
   const cString& GetName() const { return m_name; }
   
   int GetSize() { return m_list.GetSize(); }
+
+  // Built on first use, discarded whenever the list is handed out for modification
+  const cGenotypeIndex& GetIndex(bool with_ancestor_table = false) const;
   
   bool IsLineage() { return m_is_lineage || (m_lineage_head); }
   bool IsClade() { return (m_clade_head); }
@@ -65,7 +71,7 @@ public:
   void SetLineage(bool _val = true) { m_is_lineage = _val; }
   void SetAligned(bool _val = true) { m_is_aligned = _val; }
   
-  void MergeWith(cGenotypeBatch* batch) { m_list.Append(batch->m_list); }
+  void MergeWith(cGenotypeBatch* batch) { invalidateIndex(); m_list.Append(batch->m_list); }
   
   cAnalyzeGenotype* FindGenotypeNumCPUs() const;
   cAnalyzeGenotype* PopGenotypeNumCPUs();
@@ -88,6 +94,8 @@ public:
   inline cAnalyzeGenotype* PopOrganismRandom(Apto::Random* rng) { return PopOrganismRandom(*rng); }
   
   cAnalyzeGenotype* FindLastCommonAncestor();
+  cAnalyzeGenotype* FindCommonAncestor(cAnalyzeGenotype* genotype1, cAnalyzeGenotype* genotype2) const;
+  cAnalyzeGenotype* FindCommonAncestor(int genotype_id1, int genotype_id2) const;
   
   cGenotypeBatch* FindLineage(cAnalyzeGenotype* end_genotype) const;
   cGenotypeBatch* FindLineage(int end_genotype_id) const;
@@ -106,7 +114,12 @@ public:
 
   
 private:
-  inline void clearFlags() { m_lineage_head = NULL; m_is_lineage = false; m_clade_head = NULL; m_is_aligned = false; }
+  inline void clearFlags()
+  {
+    m_lineage_head = NULL; m_is_lineage = false; m_clade_head = NULL; m_is_aligned = false;
+    invalidateIndex();
+  }
+  void invalidateIndex() const;
 };
 
 
@@ -0,0 +1,204 @@
+/*
+ *  cGenotypeIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGenotypeIndex.h"
+
+#include "cAnalyzeGenotype.h"
+
+#include <cassert>
+
+
+cGenotypeIndex::cGenotypeIndex(const tList<cAnalyzeGenotype>& list) : m_num_levels(0)
+{
+  const int num_genotypes = list.GetSize();
+  m_genotypes.Resize(num_genotypes);
+
+  tLWConstListIterator<cAnalyzeGenotype> it(list);
+  for (int i = 0; i < num_genotypes; i++) {
+    m_genotypes[i] = it.Next();
+
+    // Only the first occurrence of an ID is indexed, as the linear scans this replaces would have found it first
+    int found = -1;
+    if (!m_id_map.Get(m_genotypes[i]->GetID(), found)) m_id_map.Set(m_genotypes[i]->GetID(), i);
+  }
+
+  m_parent.Resize(num_genotypes);
+  for (int i = 0; i < num_genotypes; i++) m_parent[i] = Find(m_genotypes[i]->GetParentID());
+
+  computeDepths();
+  buildChildGroups();
+}
+
+
+int cGenotypeIndex::Find(int genotype_id) const
+{
+  int pos = -1;
+  if (m_id_map.Get(genotype_id, pos)) return pos;
+  return -1;
+}
+
+
+int cGenotypeIndex::GetNumChildren(int parent_id) const
+{
+  int group = -1;
+  if (!m_child_groups.Get(parent_id, group)) return 0;
+  return m_child_start[group + 1] - m_child_start[group];
+}
+
+int cGenotypeIndex::GetChild(int parent_id, int child_num) const
+{
+  int group = -1;
+  if (!m_child_groups.Get(parent_id, group)) return -1;
+  assert(child_num >= 0 && child_num < m_child_start[group + 1] - m_child_start[group]);
+  return m_children[m_child_start[group] + child_num];
+}
+
+
+void cGenotypeIndex::BuildAncestorTable()
+{
+  if (m_num_levels > 0) return;
+
+  const int num_genotypes = m_genotypes.GetSize();
+  int max_depth = 0;
+  for (int i = 0; i < num_genotypes; i++) if (m_depth[i] > max_depth) max_depth = m_depth[i];
+
+  // Enough levels that 2^(levels - 1) covers the deepest lineage
+  int num_levels = 1;
+  while ((1 << (num_levels - 1)) < max_depth) num_levels++;
+
+  m_ancestors.Resize(num_levels * num_genotypes);
+  for (int i = 0; i < num_genotypes; i++) m_ancestors[i] = m_parent[i];
+  for (int level = 1; level < num_levels; level++) {
+    const int* prev = &m_ancestors[(level - 1) * num_genotypes];
+    int* cur = &m_ancestors[level * num_genotypes];
+    for (int i = 0; i < num_genotypes; i++) cur[i] = (prev[i] < 0) ? -1 : prev[prev[i]];
+  }
+
+  m_num_levels = num_levels;
+}
+
+
+int cGenotypeIndex::GetAncestor(int pos, int generations) const
+{
+  if (pos < 0 || generations > m_depth[pos]) return -1;
+
+  if (m_num_levels > 0) {
+    const int num_genotypes = m_genotypes.GetSize();
+    for (int level = 0; generations > 0 && pos >= 0; level++, generations >>= 1) {
+      if (generations & 1) pos = m_ancestors[level * num_genotypes + pos];
+    }
+    return pos;
+  }
+
+  while (generations-- > 0 && pos >= 0) pos = m_parent[pos];
+  return pos;
+}
+
+
+int cGenotypeIndex::CommonAncestor(int pos1, int pos2) const
+{
+  if (pos1 < 0 || pos2 < 0) return -1;
+
+  // Bring both genotypes to the same depth...
+  if (m_depth[pos1] > m_depth[pos2]) pos1 = GetAncestor(pos1, m_depth[pos1] - m_depth[pos2]);
+  else if (m_depth[pos2] > m_depth[pos1]) pos2 = GetAncestor(pos2, m_depth[pos2] - m_depth[pos1]);
+  if (pos1 == pos2) return pos1;
+
+  // ...then climb until the next step would join the two lineages.
+  if (m_num_levels > 0) {
+    const int num_genotypes = m_genotypes.GetSize();
+    for (int level = m_num_levels - 1; level >= 0; level--) {
+      const int anc1 = m_ancestors[level * num_genotypes + pos1];
+      const int anc2 = m_ancestors[level * num_genotypes + pos2];
+      if (anc1 != anc2) {
+        pos1 = anc1;
+        pos2 = anc2;
+      }
+    }
+    return m_parent[pos1];  // -1 when the lineages have different roots
+  }
+
+  while (pos1 != pos2 && pos1 >= 0) {
+    pos1 = m_parent[pos1];
+    pos2 = m_parent[pos2];
+  }
+  return pos1;
+}
+
+
+void cGenotypeIndex::computeDepths()
+{
+  const int num_genotypes = m_genotypes.GetSize();
+  m_depth.Resize(num_genotypes, -1);  // -1 = unknown, -2 = on the path currently being resolved
+
+  Apto::Array<int, Apto::Smart> path;
+  for (int i = 0; i < num_genotypes; i++) {
+    if (m_depth[i] >= 0) continue;
+
+    // Climb until reaching a root or a genotype whose depth is already known
+    int cur = i;
+    while (cur >= 0 && m_depth[cur] == -1) {
+      m_depth[cur] = -2;
+      path.Push(cur);
+      cur = m_parent[cur];
+    }
+
+    // Returning to the current path means the parent IDs form a cycle, treat the top of the path as a root
+    if (cur >= 0 && m_depth[cur] == -2) {
+      m_parent[path[path.GetSize() - 1]] = -1;
+      cur = -1;
+    }
+
+    int depth = (cur >= 0) ? m_depth[cur] : -1;
+    for (int j = path.GetSize() - 1; j >= 0; j--) m_depth[path[j]] = ++depth;
+    path.Resize(0);
+  }
+}
+
+
+void cGenotypeIndex::buildChildGroups()
+{
+  const int num_genotypes = m_genotypes.GetSize();
+
+  // Assign each parent ID a group and count its children
+  Apto::Array<int> group_of(num_genotypes);
+  Apto::Array<int, Apto::Smart> group_size;
+  for (int i = 0; i < num_genotypes; i++) {
+    const int parent_id = m_genotypes[i]->GetParentID();
+    int group = -1;
+    if (!m_child_groups.Get(parent_id, group)) {
+      group = group_size.GetSize();
+      m_child_groups.Set(parent_id, group);
+      group_size.Push(0);
+    }
+    group_of[i] = group;
+    group_size[group]++;
+  }
+
+  const int num_groups = group_size.GetSize();
+  m_child_start.Resize(num_groups + 1);
+  m_child_start[0] = 0;
+  for (int g = 0; g < num_groups; g++) m_child_start[g + 1] = m_child_start[g] + group_size[g];
+
+  // Fill the groups, preserving list order within each
+  m_children.Resize(num_genotypes);
+  for (int g = 0; g < num_groups; g++) group_size[g] = m_child_start[g];
+  for (int i = 0; i < num_genotypes; i++) m_children[group_size[group_of[i]]++] = i;
+}
@@ -0,0 +1,84 @@
+/*
+ *  cGenotypeIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGenotypeIndex_h
+#define cGenotypeIndex_h
+
+#include "apto/core.h"
+
+#include "tList.h"
+
+class cAnalyzeGenotype;
+
+
+// cGenotypeIndex - parent/child structure of a list of cAnalyzeGenotypes, built once in linear time.
+//
+// Genotypes are addressed by their position in the source list.  Genotype IDs resolve to the first genotype in the
+// list carrying that ID, matching the old front-to-back scans.  Children are grouped by parent ID, so the offspring
+// of a genotype that is not itself in the list (e.g. one popped off the batch) can still be enumerated.  Parent
+// links that would close a cycle are cut so that every genotype has a finite depth.
+
+class cGenotypeIndex
+{
+private:
+  Apto::Array<cAnalyzeGenotype*> m_genotypes;
+  Apto::Map<int, int> m_id_map;         // genotype ID -> position
+  Apto::Array<int> m_parent;            // position of parent, -1 if not in the list
+  Apto::Array<int> m_depth;             // number of ancestors present in the list
+
+  Apto::Map<int, int> m_child_groups;   // parent ID -> child group
+  Apto::Array<int> m_child_start;       // child group -> first entry in m_children (one extra terminal entry)
+  Apto::Array<int> m_children;          // child positions, in list order within each group
+
+  int m_num_levels;
+  Apto::Array<int> m_ancestors;         // binary lifting table, m_ancestors[level * size + pos] = 2^level-th ancestor
+
+  cGenotypeIndex(); // @not_implemented
+  cGenotypeIndex(const cGenotypeIndex&); // @not_implemented
+  cGenotypeIndex& operator=(const cGenotypeIndex&); // @not_implemented
+
+public:
+  explicit cGenotypeIndex(const tList<cAnalyzeGenotype>& list);
+
+  int GetSize() const { return m_genotypes.GetSize(); }
+  cAnalyzeGenotype* GetGenotype(int pos) const { return m_genotypes[pos]; }
+
+  int Find(int genotype_id) const;
+  int GetParent(int pos) const { return m_parent[pos]; }
+  int GetDepth(int pos) const { return m_depth[pos]; }
+
+  int GetNumChildren(int parent_id) const;
+  int GetChild(int parent_id, int child_num) const;
+
+  // Building the ancestor table costs O(n log n) time and memory; afterwards GetAncestor and CommonAncestor are
+  // O(log n) instead of proportional to the depth of the genotypes involved.
+  void BuildAncestorTable();
+  bool HasAncestorTable() const { return (m_num_levels > 0); }
+
+  int GetAncestor(int pos, int generations) const;
+  int CommonAncestor(int pos1, int pos2) const;
+
+private:
+  void computeDepths();
+  void buildChildGroups();
+};
+
+
+#endif
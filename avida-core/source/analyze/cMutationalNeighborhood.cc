@@ -165,13 +165,13 @@ void cMutationalNeighborhood::ProcessInitialize(cAvidaContext& ctx)
   // Generate base information
   cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
   cCPUTestInfo test_info;
-  testcpu->TestGenome(ctx, test_info, m_base_genome);
+  cCPUTestResult result;
+  testcpu->TestGenome(ctx, test_info, m_base_genome, result);
   
-  cPhenotype& phenotype = test_info.GetColonyOrganism()->GetPhenotype();
-  m_base_fitness = test_info.GetColonyFitness();
-  m_base_merit = phenotype.GetMerit().GetDouble();
-  m_base_gestation = phenotype.GetGestationTime();
-  m_base_tasks = phenotype.GetLastTaskCount();
+  m_base_fitness = result.GetColonyFitness();
+  m_base_merit = result.GetColonyMerit();
+  m_base_gestation = result.GetColonyGestation();
+  m_base_tasks = result.GetColonyTaskCount();
   
   m_neut_min = m_base_fitness * nHardware::FITNESS_NEUTRAL_MIN;
   m_neut_max = m_base_fitness * nHardware::FITNESS_NEUTRAL_MAX;
@@ -294,10 +294,11 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
                                                      const Genome& mod_genome, sStep& odata, int cur_site)
 {
   // Run the modified genome through the Test CPU
-  testcpu->TestGenome(ctx, test_info, mod_genome);
+  cCPUTestResult result;
+  testcpu->TestGenome(ctx, test_info, mod_genome, result);
   
   // Collect the calculated fitness
-  double test_fitness = test_info.GetColonyFitness();
+  double test_fitness = result.GetColonyFitness();
   
   
   odata.total_fitness += test_fitness;
@@ -322,7 +323,7 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) odata.site_count[cur_site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = result.GetColonyTaskCount();
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -504,10 +505,11 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
                                                      const sPendFit& cur, const sPendFit& oth)
 {
   // Run the modified genome through the Test CPU
-  testcpu->TestGenome(ctx, test_info, mod_genome);
+  cCPUTestResult result;
+  testcpu->TestGenome(ctx, test_info, mod_genome, result);
   
   // Collect the calculated fitness
-  double test_fitness = test_info.GetColonyFitness();
+  double test_fitness = result.GetColonyFitness();
   
   tdata.total_fitness += test_fitness;
   tdata.total_sqr_fitness += test_fitness * test_fitness;
@@ -531,7 +533,7 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) tdata.site_count[cur.site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = result.GetColonyTaskCount();
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -35,14 +35,15 @@ const double MEMORY_SHRINK_TEST_FACTOR = 4.0;
 
 
 Avida::InstructionSequence::InstructionSequence(const InstructionSequence& seq)
-: GeneticRepresentation(seq), m_seq(seq.GetSize()), m_active_size(seq.GetSize())
+: GeneticRepresentation(seq), m_buf(seq.m_buf), m_active_size(seq.GetSize()), m_hash(seq.Hash())
+, m_hash_valid(true), m_mod_count(0)
 {
-  for (int i = 0; i < m_active_size; i++)  m_seq[i] = seq[i];
 }
 
 Avida::InstructionSequence::InstructionSequence(const Apto::String& str)
+  : m_buf(new InstructionBuffer(str.GetSize())), m_hash(0), m_hash_valid(false), m_mod_count(0)
 {
-  m_seq.ResizeClear(str.GetSize());
+  Apto::Array<Instruction>& seq = m_buf->seq;
   int size = 0;
   for (int i = 0; i < str.GetSize(); i++) {
     if (str[i] == '_') continue;
@@ -51,16 +52,18 @@ Avida::InstructionSequence::InstructionSequence(const Apto::String& str)
       case '-':
       case '~':
       case '?':
-        if (!m_seq[size].SetSymbol(str.Substring(i, 2))) continue;
+        if (!seq[size].SetSymbol(str.Substring(i, 2))) continue;
         i++;
         break;
       default:
-        if (!m_seq[size].SetSymbol(str.Substring(i, 1))) continue;
+        if (!seq[size].SetSymbol(str.Substring(i, 1))) continue;
     }
     size++;
   }
   m_active_size = size;
-  m_seq.Resize(size);
+  seq.Resize(size);
+  m_hash = calcHash();
+  m_hash_valid = true;
 }
 
 Avida::InstructionSequence::~InstructionSequence() { ; }
@@ -153,23 +156,34 @@ void Avida::InstructionSequence::adjustCapacity(int new_size)
 {
   assert(new_size > 0);
   
-  // Make sure we're really changing the size...
-  if (new_size == m_active_size) return;
+  // All resizing paths go through here, followed by writes to the sequence
+  invalidateHash();
   
-  const int array_size = m_seq.GetSize();
+  const int array_size = m_buf->seq.GetSize();
+  int new_array_size = array_size;
   
   // Determine if we need to adjust the allocated array sizes...
-  if (new_size > array_size || new_size * MEMORY_SHRINK_TEST_FACTOR < array_size) {
-    int new_array_size = (int) (new_size * MEMORY_INCREASE_FACTOR);
+  if (new_size != m_active_size && (new_size > array_size || new_size * MEMORY_SHRINK_TEST_FACTOR < array_size)) {
+    new_array_size = (int) (new_size * MEMORY_INCREASE_FACTOR);
     const int new_array_min = new_size + MEMORY_INCREASE_MINIMUM;
 		if (new_array_min > new_array_size) new_array_size = new_array_min;
-    m_seq.Resize(new_array_size);
   }
   
+  // Shared storage is copied straight into a buffer of the new capacity
+  if (m_buf->RefCount() != 1) detachBuffer(new_array_size, Apto::Min(m_active_size, new_size));
+  else if (new_array_size != array_size) m_buf->seq.Resize(new_array_size);
+  
   // And just change the m_active_size once we're sure it will be in range.
   m_active_size = new_size;
 }
 
+void Avida::InstructionSequence::detachBuffer(int capacity, int num_copy)
+{
+  InstructionBufferPtr buf(new InstructionBuffer(capacity));
+  for (int i = 0; i < num_copy; i++) buf->seq[i] = m_buf->seq[i];
+  m_buf = buf;
+}
+
 void Avida::InstructionSequence::prepareInsert(int pos, int num_sites)
 {
   assert(pos >= 0 && pos <= m_active_size); // Must insert at a legal position!
@@ -181,7 +195,8 @@ void Avida::InstructionSequence::prepareInsert(int pos, int num_sites)
   adjustCapacity(new_size);
   
   // Shift any sites needed...
-  for (int i = old_size - 1; i >= pos; i--) m_seq[i + num_sites] = m_seq[i];
+  Apto::Array<Instruction>& seq = m_buf->seq;
+  for (int i = old_size - 1; i >= pos; i--) seq[i + num_sites] = seq[i];
 }
 
 
@@ -189,7 +204,9 @@ void Avida::InstructionSequence::Copy(int to, int from)
 {
   assert(to   >= 0   && to   < m_active_size);
   assert(from >= 0   && from < m_active_size);
-  m_seq[to] = m_seq[from];
+  invalidateHash();
+  copyOnWrite();
+  m_buf->seq[to] = m_buf->seq[from];
 }
  
 
@@ -197,7 +214,7 @@ void Avida::InstructionSequence::Copy(int to, int from)
 Apto::String Avida::InstructionSequence::AsString() const
 {
   Apto::StringBuffer out_string;
-  for (int i = 0; i < m_active_size; i++) out_string += m_seq[i].GetSymbol();
+  for (int i = 0; i < m_active_size; i++) out_string += m_buf->seq[i].GetSymbol();
 
   return Apto::String(out_string);
 }
@@ -223,25 +240,25 @@ void Avida::InstructionSequence::Resize(int new_size)
   const int old_size = m_active_size;
   adjustCapacity(new_size);
   
-  for (int i = old_size; i < new_size; i++) m_seq[i].SetOp(0);
+  for (int i = old_size; i < new_size; i++) m_buf->seq[i].SetOp(0);
 }
 
 void Avida::InstructionSequence::Insert(int pos, const Instruction& inst)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
   
   prepareInsert(pos, 1);
-  m_seq[pos] = inst;
+  m_buf->seq[pos] = inst;
 }
 
 void Avida::InstructionSequence::Insert(int pos, const InstructionSequence& seq)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
   
   prepareInsert(pos, seq.GetSize());
-  for (int i = 0; i < seq.GetSize(); i++) m_seq[i + pos] = seq[i];
+  for (int i = 0; i < seq.GetSize(); i++) m_buf->seq[i + pos] = seq[i];
 }
 
 void Avida::InstructionSequence::Remove(int pos, int num_sites)
@@ -251,7 +268,9 @@ void Avida::InstructionSequence::Remove(int pos, int num_sites)
   assert(pos + num_sites <= m_active_size); // Cannot extend past end of sequence
   
   const int new_size = m_active_size - num_sites;
-  for (int i = pos; i < new_size; i++) m_seq[i] = m_seq[i + num_sites];
+  copyOnWrite();
+  Apto::Array<Instruction>& seq = m_buf->seq;
+  for (int i = pos; i < new_size; i++) seq[i] = seq[i + num_sites];
   adjustCapacity(new_size);
 }
 
@@ -262,13 +281,15 @@ void Avida::InstructionSequence::Replace(int pos, int num_sites, const Instructi
   assert(pos + num_sites <= m_active_size); // Cannot extend past end!
   
   const int size_change = seq.GetSize() - num_sites;
+  invalidateHash();
   
   // First, get the size right
   if (size_change > 0) prepareInsert(pos, size_change);
   else if (size_change < 0) Remove(pos, -size_change);
+  else copyOnWrite();
   
   // Now just copy everything over!
-  for (int i = 0; i < seq.GetSize(); i++) m_seq[i + pos] = seq[i];
+  for (int i = 0; i < seq.GetSize(); i++) m_buf->seq[i + pos] = seq[i];
 }
 
 
@@ -345,11 +366,12 @@ void Avida::InstructionSequence::Rotate(int n)
 
 void Avida::InstructionSequence::operator=(const InstructionSequence& other_seq)
 {
+  // Share the other sequence's storage, it is copied by whichever sequence is modified first
+  m_buf = other_seq.m_buf;
   m_active_size = other_seq.m_active_size;
-  m_seq.ResizeClear(m_active_size);
-  
-  // Now that both code arrays are the same size, copy the other one over
-  for (int i = 0; i < m_active_size; i++) m_seq[i] = other_seq[i];
+  m_hash = other_seq.Hash();
+  m_hash_valid = true;
+  m_mod_count++;
 }
 
 
@@ -361,19 +383,57 @@ bool Avida::InstructionSequence::operator==(const GeneticRepresentation& other_s
   // Make sure the sizes are the same.
   if (m_active_size != seq->m_active_size) return false;
   
+  // Differing hashes prove the sequences differ, but only use them when both are already known
+  if (m_hash_valid && seq->m_hash_valid && m_hash != seq->m_hash) return false;
+  
+  // Sequences sharing storage are equal
+  if (&(*m_buf) == &(*seq->m_buf)) return true;
+  
   // Then go through line by line.
   for (int i = 0; i < m_active_size; i++)
-    if (m_seq[i] != (*seq)[i]) return false;
+    if (m_buf->seq[i] != (*seq)[i]) return false;
   
   return true;
 }
 
 
+uint64_t Avida::InstructionSequence::calcHash() const
+{
+  // Instructions are consumed eight at a time as a single 64-bit word, each word mixed in with a multiply-xorshift
+  // step, and the result finalized with the MurmurHash3 64-bit avalanche.  The length is folded into the seed so that
+  // trailing null instructions still change the hash.
+  const uint64_t MUL = 0x9E3779B97F4A7C15ull;
+  uint64_t h = MUL ^ ((uint64_t)m_active_size * 0xC2B2AE3D27D4EB4Full);
+  const Apto::Array<Instruction>& seq = m_buf->seq;
+  
+  int i = 0;
+  for (; i + 8 <= m_active_size; i += 8) {
+    uint64_t word = 0;
+    for (int j = 0; j < 8; j++) word |= (uint64_t)seq[i + j].GetOp() << (8 * j);
+    h = (h ^ word) * MUL;
+    h ^= h >> 29;
+  }
+  if (i < m_active_size) {
+    uint64_t word = 0;
+    for (int j = 0; i + j < m_active_size; j++) word |= (uint64_t)seq[i + j].GetOp() << (8 * j);
+    h = (h ^ word) * MUL;
+    h ^= h >> 29;
+  }
+  
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+
 int Avida::InstructionSequence::FindInst(const Instruction& inst, int start_index) const
 {
   assert(start_index < m_active_size);  // Starting search after sequence end.
   
-  for(int i = start_index; i < m_active_size; i++) if (m_seq[i] == inst) return i;
+  for(int i = start_index; i < m_active_size; i++) if (m_buf->seq[i] == inst) return i;
   
   // Search failed
   return -1;  
@@ -383,7 +443,7 @@ int Avida::InstructionSequence::FindInst(const Instruction& inst, int start_inde
 int Avida::InstructionSequence::CountInst(const Instruction& inst) const
 {
   int count = 0;
-  for (int i = 0; i < m_active_size; i++) if (m_seq[i] == inst) count++;
+  for (int i = 0; i < m_active_size; i++) if (m_buf->seq[i] == inst) count++;
   return count;  
 }
 
@@ -436,7 +496,7 @@ Avida::InstructionSequence Avida::InstructionSequence::Crop(int start, int end)
   
   const int out_length = end - start;
   InstructionSequence out_seq(out_length);
-  for (int i = 0; i < out_length; i++) out_seq[i] = m_seq[i+start];
+  for (int i = 0; i < out_length; i++) out_seq[i] = m_buf->seq[i+start];
   
   return out_seq;
 }
@@ -454,8 +514,8 @@ Avida::InstructionSequence Avida::InstructionSequence::Cut(int start, int end) c
   assert(out_length > 0);             // Can't cut everything!
   
   InstructionSequence out_seq(out_length);
-  for (int i = 0; i < start; i++) out_seq[i] = m_seq[i];
-  for (int i = start; i < out_length; i++) out_seq[i] = m_seq[i + cut_length];
+  for (int i = 0; i < start; i++) out_seq[i] = m_buf->seq[i];
+  for (int i = start; i < out_length; i++) out_seq[i] = m_buf->seq[i + cut_length];
   
   return out_seq;
 }  
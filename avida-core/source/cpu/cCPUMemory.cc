@@ -22,19 +22,51 @@
 
 #include "cCPUMemory.h"
 
+#include "cStateArchive.h"
+
 using namespace std;
 using namespace Avida;
 
-cCPUMemory::cCPUMemory(const cCPUMemory& in_memory) : InstructionSequence(in_memory), m_flag_array(in_memory.GetSize())
+cCPUMemory::cCPUMemory(const cCPUMemory& in_memory)
+  : InstructionSequence(in_memory), m_flag_array(in_memory.GetSize()), m_label_index_mods(0), m_label_index_valid(false)
 {
   for (int i = 0; i < m_flag_array.GetSize(); i++) m_flag_array[i] = in_memory.m_flag_array[i];
 }
 
 
+void cCPUMemory::CheckpointState(cStateArchive& ar)
+{
+  ar.Tag("cCPUMemory");
+  int size = m_active_size;
+  ar.Transfer(size);
+  if (!ar.IsGood() || size < 0) return;
+  if (ar.IsLoading()) Reset(size);
+  else copyOnWrite();
+  
+  for (int i = 0; i < size; i++) {
+    int op = m_buf->seq[i].GetOp();
+    ar.Transfer(op);
+    if (op < 0 || op >= 256) {
+      ar.Fail("invalid instruction in checkpoint");
+      return;
+    }
+    m_buf->seq[i].SetOp(op);
+    ar.Transfer(m_flag_array[i]);
+  }
+}
+
+
 void cCPUMemory::adjustCapacity(int new_size)
 {
   InstructionSequence::adjustCapacity(new_size);
-  if (m_seq.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_seq.GetSize()); 
+  if (m_buf->seq.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_buf->seq.GetSize()); 
+}
+
+
+void cCPUMemory::shareSequence(const InstructionSequence& seq)
+{
+  InstructionSequence::operator=(seq);
+  if (m_flag_array.GetSize() < m_active_size) m_flag_array.Resize(m_buf->seq.GetSize());
 }
 
 
@@ -49,7 +81,8 @@ void cCPUMemory::prepareInsert(int pos, int num_sites)
   adjustCapacity(new_size);
   
   // Shift any sites needed...
-  for (int i = old_size - 1; i >= pos; i--) m_seq[i + num_sites] = m_seq[i];
+  Apto::Array<Instruction>& seq = m_buf->seq;
+  for (int i = old_size - 1; i >= pos; i--) seq[i + num_sites] = seq[i];
   for (int i = old_size - 1; i >= pos; i--) m_flag_array[i + num_sites] = m_flag_array[i];
 }
 
@@ -71,7 +104,7 @@ void cCPUMemory::Resize(int new_size)
   adjustCapacity(new_size);
   
   for (int i = old_size; i < new_size; i++) {
-    m_seq[i].SetOp(0);
+    m_buf->seq[i].SetOp(0);
     m_flag_array[i] = 0;
   }
 }
@@ -88,14 +121,41 @@ void cCPUMemory::ResizeOld(int new_size)
 }
 
 
+void cCPUMemory::SetInst(int pos, const Instruction& inst)
+{
+  assert(pos >= 0);
+  assert(pos < m_active_size);
+  
+  const bool index_current = m_label_index_valid && m_label_index_mods == m_mod_count;
+  InstructionSequence::operator[](pos) = inst;
+  if (index_current) {
+    m_label_index.Update(pos, inst);
+    m_label_index_mods = m_mod_count;
+  }
+}
+
+
+const cLabelIndex& cCPUMemory::GetLabelIndex(const cInstSet& inst_set) const
+{
+  if (!m_label_index_valid || m_label_index_mods != m_mod_count || m_label_index.GetInstSet() != &inst_set) {
+    m_label_index.Build(*this, inst_set);
+    m_label_index_mods = m_mod_count;
+    m_label_index_valid = true;
+  }
+  return m_label_index;
+}
+
+
 void cCPUMemory::Copy(int to, int from)
 {
   assert(to >= 0);
-  assert(to < m_seq.GetSize());
+  assert(to < m_active_size);
   assert(from >= 0);
-  assert(from < m_seq.GetSize());
+  assert(from < m_active_size);
   
-  m_seq[to] = m_seq[from];
+  invalidateHash();
+  copyOnWrite();
+  m_buf->seq[to] = m_buf->seq[from];
   m_flag_array[to] = m_flag_array[from];
 }
 
@@ -103,21 +163,21 @@ void cCPUMemory::Copy(int to, int from)
 void cCPUMemory::Insert(int pos, const Instruction& inst)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
 
   prepareInsert(pos, 1);
-  m_seq[pos] = inst;
+  m_buf->seq[pos] = inst;
   m_flag_array[pos] = 0;
 }
 
 void cCPUMemory::Insert(int pos, const InstructionSequence& genome)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
 
   prepareInsert(pos, genome.GetSize());
   for (int i = 0; i < genome.GetSize(); i++) {
-    m_seq[i + pos] = genome[i];
+    m_buf->seq[i + pos] = genome[i];
     m_flag_array[i + pos] = 0;
   }
 }
@@ -129,8 +189,10 @@ void cCPUMemory::Remove(int pos, int num_sites)
   assert(pos + num_sites <= m_active_size); // Cannot extend past end of genome.
 
   const int new_size = m_active_size - num_sites;
+  copyOnWrite();
+  Apto::Array<Instruction>& seq = m_buf->seq;
   for (int i = pos; i < new_size; i++) {
-    m_seq[i] = m_seq[i + num_sites];
+    seq[i] = seq[i + num_sites];
     m_flag_array[i] = m_flag_array[i + num_sites];
   }
   adjustCapacity(new_size);
@@ -143,14 +205,16 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   assert(pos + num_sites <= m_active_size); // Cannot extend past end!
   
   const int size_change = genome.GetSize() - num_sites;
+  invalidateHash();
   
   // First, get the size right
   if (size_change > 0) prepareInsert(pos, size_change);
   else if (size_change < 0) Remove(pos, -size_change);
+  else copyOnWrite();
   
   // Now just copy everything over!
   for (int i = 0; i < genome.GetSize(); i++) {
-    m_seq[i + pos] = genome[i];
+    m_buf->seq[i + pos] = genome[i];
     m_flag_array[i + pos] = 0;
   }
 }
@@ -158,24 +222,14 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
 
 void cCPUMemory::operator=(const cCPUMemory& other_memory)
 {
-  adjustCapacity(other_memory.m_active_size);
-  
-  // Fill in the new information...
-  for (int i = 0; i < m_active_size; i++) {
-    m_seq[i] = other_memory.m_seq[i];
-    m_flag_array[i] = other_memory.m_flag_array[i];
-  }
+  shareSequence(other_memory);
+  for (int i = 0; i < m_active_size; i++) m_flag_array[i] = other_memory.m_flag_array[i];
 }
 
 
 void cCPUMemory::operator=(const InstructionSequence& other_genome)
 {
-  adjustCapacity(other_genome.GetSize());
-  
-  // Fill in the new information...
-  for (int i = 0; i < m_active_size; i++) {
-    m_seq[i] = other_genome[i];
-    m_flag_array[i] = 0;
-  }
+  // The genome's storage is shared until the first write to this memory
+  shareSequence(other_genome);
+  for (int i = 0; i < m_active_size; i++) m_flag_array[i] = 0;
 }
-
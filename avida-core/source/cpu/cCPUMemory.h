@@ -25,6 +25,10 @@
 
 #include "avida/core/InstructionSequence.h"
 
+#include "cLabelIndex.h"
+
+class cInstSet;
+class cStateArchive;
 
 class cCPUMemory : public Avida::InstructionSequence
 {
@@ -39,15 +43,23 @@ private:
 	static const unsigned char MASK_UNUSED2  = 0x80; // unused bit
   
   Apto::Array<unsigned char> m_flag_array;
+  
+  mutable cLabelIndex m_label_index;
+  mutable unsigned int m_label_index_mods;  // m_mod_count the index reflects
+  mutable bool m_label_index_valid;
 
   void adjustCapacity(int new_size);
   void prepareInsert(int pos, int num_sites);
+  void shareSequence(const InstructionSequence& seq);
 
 public:
   cCPUMemory(const cCPUMemory& in_memory);
-  cCPUMemory(const InstructionSequence& in_genome) : InstructionSequence(in_genome), m_flag_array(in_genome.GetSize()) { ; }
-  explicit cCPUMemory(int size = 1)  : InstructionSequence(size), m_flag_array(size) { ClearFlags(); }
-  cCPUMemory(const Apto::String& in_string) : InstructionSequence(in_string), m_flag_array(in_string.GetSize()) { ; }
+  cCPUMemory(const InstructionSequence& in_genome)
+    : InstructionSequence(in_genome), m_flag_array(in_genome.GetSize()), m_label_index_mods(0), m_label_index_valid(false) { ; }
+  explicit cCPUMemory(int size = 1)
+    : InstructionSequence(size), m_flag_array(size), m_label_index_mods(0), m_label_index_valid(false) { ClearFlags(); }
+  cCPUMemory(const Apto::String& in_string)
+    : InstructionSequence(in_string), m_flag_array(in_string.GetSize()), m_label_index_mods(0), m_label_index_valid(false) { ; }
   ~cCPUMemory() { ; }
 
   inline bool FlagCopied(int pos) const     { return (MASK_COPIED   & m_flag_array[pos]) != 0; }
@@ -74,8 +86,10 @@ public:
   
   void Clear()
 	{
+		invalidateHash();
+		copyOnWrite();
 		for (int i = 0; i < m_active_size; i++) {
-			m_seq[i].SetOp(0);
+			m_buf->seq[i].SetOp(0);
 			m_flag_array[i] = 0;
 		}
 	}
@@ -84,6 +98,13 @@ public:
   void ResizeOld(int new_size); // Reset size, save contents, init to previous
     
   
+  // Writes a single site.  Unlike writes through operator[], this keeps the label index up to date.
+  void SetInst(int pos, const Avida::Instruction& inst);
+  
+  // Nop and label positions under the given instruction set, built on first use and after any modification other
+  // than SetInst
+  const cLabelIndex& GetLabelIndex(const cInstSet& inst_set) const;
+  
   void Resize(int new_size);
   void Copy(int to, int from);
   void Insert(int pos, const Avida::Instruction& inst);
@@ -93,6 +114,8 @@ public:
 
   void operator=(const cCPUMemory& other_memory);
   void operator=(const InstructionSequence& other_genome);
+  
+  void CheckpointState(cStateArchive& ar);
 };
 
 #endif
@@ -23,6 +23,7 @@
 #include "cCPUStack.h"
 
 #include <cassert>
+#include "cStateArchive.h"
 #include "cString.h"
 
 using namespace std;
@@ -63,6 +64,14 @@ void cCPUStack::SaveState(ostream& fp)
   fp<<endl;
 }
 
+void cCPUStack::CheckpointState(cStateArchive& ar)
+{
+  ar.Tag("cCPUStack");
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) ar.Transfer(stack[i]);
+  ar.Transfer(stack_pointer);
+  if (stack_pointer >= nHardware::STACK_SIZE) ar.Fail("invalid stack pointer in checkpoint");
+}
+
 void cCPUStack::LoadState(istream & fp)
 {
   assert(fp.good());
@@ -29,6 +29,8 @@
 #include "nHardware.h"
 #endif
 
+class cStateArchive;
+
 class cCPUStack
 {
 private:
@@ -53,6 +55,7 @@ public:
 
   void SaveState(std::ostream& fp);
   void LoadState(std::istream & fp);
+  void CheckpointState(cStateArchive& ar);
 };
 
 
@@ -122,3 +122,18 @@ cPhenotype& cCPUTestInfo::GetTestPhenotype(int level)
   assert(org_array[level] != NULL);
   return org_array[level]->GetPhenotype();
 }
+
+
+void cCPUTestResult::Set(cCPUTestInfo& test_info)
+{
+  m_is_viable = test_info.IsViable();
+  m_max_depth = test_info.GetMaxDepth();
+  m_depth_found = test_info.GetDepthFound();
+  m_genotype_fitness = test_info.GetGenotypeFitness();
+  m_colony_fitness = test_info.GetColonyFitness();
+
+  cPhenotype& phenotype = test_info.GetColonyOrganism()->GetPhenotype();
+  m_colony_merit = phenotype.GetMerit().GetDouble();
+  m_colony_gestation = phenotype.GetGestationTime();
+  m_colony_tasks = phenotype.GetLastTaskCount();
+}
@@ -124,6 +124,41 @@ public:
 };
 
 
+// cCPUTestResult - summary outcome of a test, which remains valid after the test organisms are gone.  Tests run
+// through cTestCPU with a result may be answered from the world's cTestResultCache without running at all.
+class cCPUTestResult
+{
+  friend class cTestResultCache;
+private:
+  bool m_is_viable;
+  int m_max_depth;
+  int m_depth_found;
+  double m_genotype_fitness;
+  double m_colony_fitness;
+  double m_colony_merit;
+  int m_colony_gestation;
+  Apto::Array<int> m_colony_tasks;
+
+public:
+  cCPUTestResult()
+    : m_is_viable(false), m_max_depth(-1), m_depth_found(-1), m_genotype_fitness(0.0), m_colony_fitness(0.0)
+    , m_colony_merit(0.0), m_colony_gestation(0) { ; }
+
+  void Set(cCPUTestInfo& test_info);
+
+  bool IsViable() const { return m_is_viable; }
+  int GetMaxDepth() const { return m_max_depth; }
+  int GetDepthFound() const { return m_depth_found; }
+  double GetGenotypeFitness() const { return m_genotype_fitness; }
+  double GetColonyFitness() const { return m_colony_fitness; }
+
+  // Colony organism phenotype, as GetColonyOrganism() of the test info (set even when the genome is not viable)
+  double GetColonyMerit() const { return m_colony_merit; }
+  int GetColonyGestation() const { return m_colony_gestation; }
+  const Apto::Array<int>& GetColonyTaskCount() const { return m_colony_tasks; }
+};
+
+
 inline cOrganism* cCPUTestInfo::GetTestOrganism(int level)
 {
   assert(org_array[level] != NULL);
@@ -22,6 +22,7 @@
 
 #include "cCodeLabel.h"
 
+#include "cStateArchive.h"
 
 #include <cmath>
 #include <vector>
@@ -47,6 +48,21 @@ void cCodeLabel::ReadString(const cString& label_str)
 }
 
 
+void cCodeLabel::CheckpointState(cStateArchive& ar)
+{
+  ar.Tag("cCodeLabel");
+  int size = m_nops.GetSize();
+  ar.Transfer(size);
+  if (!ar.IsGood()) return;
+  if (ar.IsLoading()) m_nops.Resize(size);
+  for (int i = 0; i < size; i++) {
+    int nop = m_nops[i];
+    ar.Transfer(nop);
+    m_nops[i] = nop;
+  }
+}
+
+
 // This function returns true if the sub_label can be found within
 // the label affected.
 int cCodeLabel::FindSublabel(const cCodeLabel& sub_label) const
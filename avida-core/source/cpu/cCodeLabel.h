@@ -28,6 +28,8 @@
 #include "cString.h"
 #include "nHardware.h"
 
+class cStateArchive;
+
 /**
  * The cCodeLabel class is used to identify a label within the genotype of
  * a creature, and aid in its manipulation.
@@ -52,6 +54,7 @@ public:
   inline cCodeLabel& operator=(const cCodeLabel& in_lbl) { m_nops = in_lbl.m_nops; return *this; }
 
   void ReadString(const cString& label_str);
+  void CheckpointState(cStateArchive& ar);
   
   int FindSublabel(const cCodeLabel& sub_label) const;
   inline bool Contains(const cCodeLabel& sub_label) const { return (FindSublabel(sub_label) >= 0); }
@@ -29,14 +29,17 @@
 #include "cCodeLabel.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
+#include "cHardwareBinaryTracer.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
 #include "cHeadCPU.h"
 #include "cInstSet.h"
+#include "cMutationSampler.h"
 #include "cOrganism.h"
 #include "cPhenotype.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
+#include "cStateArchive.h"
 #include "cStats.h"
 #include "cTestCPU.h"
 #include "cWorld.h"
@@ -68,6 +71,19 @@ cHardwareBase::cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* in
 }
 
 
+void cHardwareBase::recycleBase(cOrganism* in_organism)
+{
+  assert(in_organism != NULL);
+  m_organism = in_organism;
+  m_tracer = HardwareTracerPtr(NULL);
+  m_minitrace = false;
+  m_microtrace = false;
+  m_topnavtrace = false;
+  m_reprotrace = false;
+  m_task_switching_cost = 0;
+  m_ext_mem.Resize(0);
+}
+
 void cHardwareBase::Reset(cAvidaContext& ctx)
 {
   m_organism->HardwareReset(ctx);
@@ -119,6 +135,31 @@ void cHardwareBase::Reset(cAvidaContext& ctx)
   internalReset();
 }
 
+void cHardwareBase::CheckpointState(cStateArchive& ar)
+{
+  ar.Fail("hardware type does not support checkpointing");
+}
+
+void cHardwareBase::checkpointBaseState(cStateArchive& ar)
+{
+  // The per-instruction cost arrays are included since first time and energy costs are consumed as the organism runs
+  ar.Tag("cHardwareBase");
+  ar.Transfer(m_inst_cost);
+  ar.Transfer(m_female_cost);
+  ar.Transfer(m_inst_ft_cost);
+  ar.Transfer(m_inst_energy_cost);
+  ar.Transfer(m_inst_res_cost);
+  ar.Transfer(m_inst_fem_res_cost);
+  ar.Transfer(m_inst_bonus_cost);
+  ar.Transfer(m_thread_inst_cost);
+  ar.Transfer(m_thread_inst_post_cost);
+  ar.Transfer(m_active_thread_costs);
+  ar.Transfer(m_active_thread_post_costs);
+  ar.Transfer(m_task_switching_cost);
+  ar.Transfer(m_ext_mem);
+  ar.Transfer(m_implicit_repro_active);
+}
+
 void cHardwareBase::ResizeCostArrays(int new_size)
 {
   m_active_thread_costs.Resize(new_size);
@@ -1086,9 +1127,6 @@ bool cHardwareBase::Divide_TestFitnessMeasures1(cAvidaContext& ctx)
 
 int cHardwareBase::PointMutate(cAvidaContext& ctx, double override_mut_rate)
 {
-  const int max_genome_size = m_world->GetConfig().MAX_GENOME_SIZE.Get();
-  const int min_genome_size = m_world->GetConfig().MIN_GENOME_SIZE.Get();
-  
   cCPUMemory& memory = GetMemory();
   int totalMutations = 0;
   
@@ -1120,49 +1158,90 @@ int cHardwareBase::PointMutate(cAvidaContext& ctx, double override_mut_rate)
   // Point Insert Mutations (per site)
   if (m_organism->GetPointInsProb() > 0.0) {
     int num_mut = ctx.GetRandom().GetRandBinomial(memory.GetSize(), m_organism->GetPointInsProb());
-    
-    // If would make creature too big, insert up to max_genome_size
-    if (num_mut + memory.GetSize() > max_genome_size) {
-      num_mut = max_genome_size - memory.GetSize();
-    }
-    
-    // If we have lines to insert...
-    if (num_mut > 0) {
-      // Build a sorted list of the sites where mutations occured
-      Apto::Array<int> mut_sites(num_mut);
-      for (int i = 0; i < num_mut; i++) mut_sites[i] = ctx.GetRandom().GetUInt(memory.GetSize() + 1);
-      Apto::QSort(mut_sites);
-      
-      // Actually do the mutations (in reverse sort order)
-      for (int i = mut_sites.GetSize() - 1; i >= 0; i--) {
-        memory.Insert(mut_sites[i], m_inst_set->GetRandomInst(ctx));
-      }
-      
-      totalMutations += num_mut;
-    }
+    totalMutations += doPointInsertions(ctx, num_mut);
   }
   
-  
   // Point Deletion Mutations (per site)
   if (m_organism->GetPointDelProb() > 0) {
     int num_mut = ctx.GetRandom().GetRandBinomial(memory.GetSize(), m_organism->GetPointDelProb());
-    
-    // If would make creature too small, delete down to min_genome_size
-    if (memory.GetSize() - num_mut < min_genome_size) {
-      num_mut = memory.GetSize() - min_genome_size;
-    }
-    
-    // If we have lines to delete...
-    for (int i = 0; i < num_mut; i++) {
-      int site = ctx.GetRandom().GetUInt(memory.GetSize());
-      memory.Remove(site);
-    }
-    
-    totalMutations += num_mut;
+    totalMutations += doPointDeletions(ctx, num_mut);
   }
   return totalMutations;
 }
 
+// As above, with each kind of mutation drawn by a sampler that carries on from one organism to the next, so that the
+// random number generator is only consulted where mutations occur.  Substitutions hit the sites the sampler selects;
+// the number of insertions and deletions is sampled the same way, and they are then placed as above.
+int cHardwareBase::PointMutate(cAvidaContext& ctx, cMutationSampler& sub_sampler, cMutationSampler& ins_sampler,
+                               cMutationSampler& del_sampler)
+{
+  cCPUMemory& memory = GetMemory();
+  int totalMutations = 0;
+  
+  // Point Substitution Mutations (per site)
+  const int size = memory.GetSize();
+  const double mut_rate = m_organism->GetPointMutProb();
+  int site = sub_sampler.Next(ctx, mut_rate, size);
+  while (site < size) {
+    memory[site] = m_inst_set->GetRandomInst(ctx);
+    totalMutations++;
+    site += 1 + sub_sampler.Next(ctx, mut_rate, size - site - 1);
+  }
+  
+  // Point Insert Mutations (per site)
+  totalMutations += doPointInsertions(ctx, ins_sampler.Count(ctx, m_organism->GetPointInsProb(), memory.GetSize()));
+  
+  // Point Deletion Mutations (per site)
+  totalMutations += doPointDeletions(ctx, del_sampler.Count(ctx, m_organism->GetPointDelProb(), memory.GetSize()));
+  
+  return totalMutations;
+}
+
+int cHardwareBase::doPointInsertions(cAvidaContext& ctx, int num_mut)
+{
+  cCPUMemory& memory = GetMemory();
+  const int max_genome_size = m_world->GetConfig().MAX_GENOME_SIZE.Get();
+  
+  // If would make creature too big, insert up to max_genome_size
+  if (num_mut + memory.GetSize() > max_genome_size) {
+    num_mut = max_genome_size - memory.GetSize();
+  }
+  
+  // If we have lines to insert...
+  if (num_mut <= 0) return 0;
+  
+  // Build a sorted list of the sites where mutations occured
+  Apto::Array<int> mut_sites(num_mut);
+  for (int i = 0; i < num_mut; i++) mut_sites[i] = ctx.GetRandom().GetUInt(memory.GetSize() + 1);
+  Apto::QSort(mut_sites);
+  
+  // Actually do the mutations (in reverse sort order)
+  for (int i = mut_sites.GetSize() - 1; i >= 0; i--) {
+    memory.Insert(mut_sites[i], m_inst_set->GetRandomInst(ctx));
+  }
+  
+  return num_mut;
+}
+
+int cHardwareBase::doPointDeletions(cAvidaContext& ctx, int num_mut)
+{
+  cCPUMemory& memory = GetMemory();
+  const int min_genome_size = m_world->GetConfig().MIN_GENOME_SIZE.Get();
+  
+  // If would make creature too small, delete down to min_genome_size
+  if (memory.GetSize() - num_mut < min_genome_size) {
+    num_mut = memory.GetSize() - min_genome_size;
+  }
+  
+  // If we have lines to delete...
+  for (int i = 0; i < num_mut; i++) {
+    int site = ctx.GetRandom().GetUInt(memory.GetSize());
+    memory.Remove(site);
+  }
+  
+  return num_mut;
+}
+
 
 
 tBuffer<int>& cHardwareBase::GetInputBuf() 
@@ -1235,6 +1314,19 @@ bool cHardwareBase::Inst_DefaultEnergyUsage(cAvidaContext& ctx)
 }
 
 
+// Executes up to max_inst instructions back to back, stopping early if the organism dies
+int cHardwareBase::ProcessBurst(cAvidaContext& ctx, int max_inst)
+{
+  const cPhenotype& phenotype = m_organism->GetPhenotype();
+  int executed = 0;
+  while (executed < max_inst) {
+    executed++;
+    if (!SingleProcess(ctx) || phenotype.GetToDelete()) break;
+  }
+  return executed;
+}
+
+
 // This method will test to see if all costs have been paid associated
 // with executing an instruction and only return true when that instruction
 // should proceed.
@@ -1427,7 +1519,11 @@ void cHardwareBase::InsertGenomeFragment(const InstructionSequence& fragment) {
 
 void cHardwareBase::SetMiniTrace(const cString& filename)
 {
-  m_tracer = HardwareTracerPtr(new cHardwareStatusPrinter(m_world->GetNewWorld(), (const char*)filename, true));
+  if (m_world->GetConfig().MINI_TRACE_FORMAT.Get() == 1) {
+    m_tracer = HardwareTracerPtr(new cHardwareBinaryTracer(m_world->GetNewWorld(), (const char*)filename));
+  } else {
+    m_tracer = HardwareTracerPtr(new cHardwareStatusPrinter(m_world->GetNewWorld(), (const char*)filename, true));
+  }
   m_minitrace = true;
 }
 
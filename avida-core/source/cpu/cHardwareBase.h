@@ -40,10 +40,14 @@ class cCodeLabel;
 class cCPUMemory;
 class cHeadCPU;
 class cMutation;
+class cMutationSampler;
 class cOrganism;
+class cStateArchive;
 class cString;
 class cWorld;
 
+namespace Avida { namespace Output { namespace TraceFormat { struct sStatus; }; }; };
+
 using namespace std;
 using namespace Avida;
 
@@ -123,6 +127,10 @@ public:
   cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* inst_set);
   virtual ~cHardwareBase() { ; }
   
+  // Rebinds pooled hardware to a newly constructed organism, restoring the state the constructor sets up while keeping
+  // the capacity of the memory, thread and cost arrays (see cHardwareManager::Create)
+  virtual void Recycle(cAvidaContext& ctx, cOrganism* in_organism) = 0;
+  
   // interrupt types
   enum interruptTypes {MSG_INTERRUPT = 0, MOVE_INTERRUPT};
   
@@ -135,6 +143,7 @@ public:
   void Reset(cAvidaContext& ctx);
   virtual bool SingleProcess(cAvidaContext& ctx, bool speculative = false) = 0;
   virtual void ProcessBonusInst(cAvidaContext& ctx, const Instruction& inst) = 0;
+  int ProcessBurst(cAvidaContext& ctx, int max_inst);  // returns the number of instructions executed
 
   int Divide_DoMutations(cAvidaContext& ctx, double mut_multiplier = 1.0, const int maxmut = INT_MAX);
   bool Divide_TestFitnessMeasures(cAvidaContext& ctx);
@@ -145,6 +154,9 @@ public:
   virtual void PrintStatus(std::ostream& fp) = 0;
   virtual void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) = 0;
   virtual void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) = 0;
+  // Fills in the status printed by PrintMiniTraceStatus, for binary mini traces; false if the hardware has none
+  virtual bool RecordMiniTraceStatus(cAvidaContext& ctx, Avida::Output::TraceFormat::sStatus& status)
+    { (void)ctx; (void)status; return false; }
   void SetTrace(HardwareTracerPtr tracer) { m_tracer = tracer; }
   void SetMiniTrace(const cString& filename);
   void SetMicroTrace() { m_microtrace = true; } 
@@ -217,6 +229,8 @@ public:
     
   // --------  Mutation  --------
   virtual int PointMutate(cAvidaContext& ctx, double override_mut_rate = 0.0);
+  int PointMutate(cAvidaContext& ctx, cMutationSampler& sub_sampler, cMutationSampler& ins_sampler,
+                  cMutationSampler& del_sampler);
 
   
   // --------  Input/Output Buffers  --------
@@ -227,6 +241,9 @@ public:
   // --------  State Transfer  --------
   virtual void InheritState(cHardwareBase&) { ; }
   
+  // Saves or restores the complete execution state, hardware types that do not support checkpointing fail the archive
+  virtual void CheckpointState(cStateArchive& ar);
+  
   
   // --------  Alarm  --------
   virtual bool Jump_To_Alarm_Label(int) { return false; }
@@ -244,6 +261,8 @@ public:
   
 protected:
   void ResizeCostArrays(int new_size);
+  void recycleBase(cOrganism* in_organism);
+  void checkpointBaseState(cStateArchive& ar);
 
   // --------  Core Execution Methods  --------
   bool SingleProcess_PayPreCosts(cAvidaContext& ctx, const Instruction& cur_inst, const int thread_id);
@@ -277,6 +296,8 @@ protected:
   void doSlipMutation(cAvidaContext& ctx, InstructionSequence& genome, int from = -1);
   void doTransMutation(cAvidaContext& ctx, InstructionSequence& genome, int from = -1);
   void doLGTMutation(cAvidaContext& ctx, InstructionSequence& genome);
+  int doPointInsertions(cAvidaContext& ctx, int num_mut);
+  int doPointDeletions(cAvidaContext& ctx, int num_mut);
   
 
   // --------  Organism Execution Property Calculation  --------
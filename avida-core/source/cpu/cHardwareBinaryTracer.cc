@@ -0,0 +1,134 @@
+/*
+ *  cHardwareBinaryTracer.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cHardwareBinaryTracer.h"
+
+#include "avida/systematics/Group.h"
+
+#include "cAvidaContext.h"
+#include "cHardwareBase.h"
+#include "cInstSet.h"
+#include "cOrganism.h"
+#include "cString.h"
+
+#include <cstring>
+
+using namespace Avida::Output;
+
+
+cHardwareBinaryTracer::cHardwareBinaryTracer(Avida::World* world, const Apto::String& filename)
+  : m_file(File::CreateWithPath(world, filename)), m_header_done(false), m_entries(BUFFER_ENTRIES), m_num_entries(0)
+{
+}
+
+cHardwareBinaryTracer::~cHardwareBinaryTracer()
+{
+  flush();
+}
+
+
+void cHardwareBinaryTracer::TraceHardware(cAvidaContext& ctx, cHardwareBase& hardware, bool, bool mini,
+                                          const int exec_success)
+{
+  cOrganism* organism = hardware.GetOrganism();
+
+  if (!organism || !mini) return;
+
+  bool in_setup = false;
+  if (!m_header_done) {
+    writeHeader(hardware);
+    in_setup = true;
+  }
+
+  if (exec_success == -2 || in_setup) {
+    TraceFormat::sEntry& entry = nextEntry();
+    if (hardware.RecordMiniTraceStatus(ctx, entry.status)) entry.has_status = 1;
+    else m_num_entries--;  // hardware without a mini trace status
+  }
+  if (exec_success != -2) recordSuccess(exec_success);
+}
+
+void cHardwareBinaryTracer::PrintSuccess(cOrganism*, const int exec_success)
+{
+  recordSuccess(exec_success);
+}
+
+void cHardwareBinaryTracer::TraceTestCPU(int, int, const cOrganism&)
+{
+  // Mini traces are not taken of test CPUs
+}
+
+
+void cHardwareBinaryTracer::writeHeader(cHardwareBase& hardware)
+{
+  cOrganism* organism = hardware.GetOrganism();
+  Apto::String genotype_name = organism->SystematicsGroup("genotype")->Properties().Get("genotype").StringValue();
+  hardware.SetupMiniTraceFileHeader(*m_file, organism->SystematicsGroup("genotype")->ID(), genotype_name);
+  m_file->FlushComments();
+
+  const cInstSet& inst_set = hardware.GetInstSet();
+  TraceFormat::sFileHeader header;
+  memcpy(header.magic, TraceFormat::FILE_MAGIC, sizeof(header.magic));
+  header.version = TraceFormat::VERSION;
+  header.byte_order = TraceFormat::BYTE_ORDER_MARK;
+  header.num_insts = inst_set.GetSize();
+  header.entry_size = sizeof(TraceFormat::sEntry);
+
+  std::ofstream& fp = m_file->OFStream();
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (int i = 0; i < inst_set.GetSize(); i++) {
+    const cString& name = inst_set.GetName(i);
+    const uint32_t name_size = name.GetSize();
+    fp.write(reinterpret_cast<const char*>(&name_size), sizeof(name_size));
+    fp.write(name, name_size);
+  }
+
+  m_header_done = true;
+}
+
+
+TraceFormat::sEntry& cHardwareBinaryTracer::nextEntry()
+{
+  if (m_num_entries == BUFFER_ENTRIES) flush();
+
+  TraceFormat::sEntry& entry = m_entries[m_num_entries++];
+  memset(&entry, 0, sizeof(entry));
+  return entry;
+}
+
+void cHardwareBinaryTracer::recordSuccess(int exec_success)
+{
+  // The result completes the line of the last status, unless that already has one
+  if (!m_num_entries || !m_entries[m_num_entries - 1].has_status || m_entries[m_num_entries - 1].has_success) {
+    nextEntry();
+  }
+
+  TraceFormat::sEntry& entry = m_entries[m_num_entries - 1];
+  entry.exec_success = exec_success;
+  entry.has_success = 1;
+}
+
+void cHardwareBinaryTracer::flush()
+{
+  if (!m_num_entries) return;
+
+  m_file->OFStream().write(reinterpret_cast<const char*>(&m_entries[0]), sizeof(TraceFormat::sEntry) * m_num_entries);
+  m_num_entries = 0;
+}
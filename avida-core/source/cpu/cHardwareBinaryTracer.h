@@ -0,0 +1,66 @@
+/*
+ *  cHardwareBinaryTracer.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cHardwareBinaryTracer_h
+#define cHardwareBinaryTracer_h
+
+#include "avida/output/File.h"
+#include "avida/private/output/TraceFormat.h"
+
+#include "cHardwareTracer.h"
+
+class cAvidaContext;
+
+
+// cHardwareBinaryTracer - mini tracer that records fixed size entries instead of text (MINI_TRACE_FORMAT 1)
+//
+// Entries collect in a buffer held by the tracer (i.e. per organism) and are handed to the output file a buffer at a
+// time, from where the output writer takes them to disk.  See Output::TraceFormat for the file layout; avida-trace
+// turns the file back into the text trace.
+
+class cHardwareBinaryTracer : public cHardwareTracer
+{
+private:
+  static const int BUFFER_ENTRIES = 1024;
+
+  Avida::Output::FilePtr m_file;
+  bool m_header_done;
+  Apto::Array<Avida::Output::TraceFormat::sEntry> m_entries;
+  int m_num_entries;
+
+  cHardwareBinaryTracer(const cHardwareBinaryTracer&); // @not_implemented
+  cHardwareBinaryTracer& operator=(const cHardwareBinaryTracer&); // @not_implemented
+
+public:
+  cHardwareBinaryTracer(Avida::World* world, const Apto::String& filename);
+  ~cHardwareBinaryTracer();
+
+  void TraceHardware(cAvidaContext& ctx, cHardwareBase& hardware, bool bonus, bool mini, int exec_success);
+  void PrintSuccess(cOrganism* organism, int exec_success);
+  void TraceTestCPU(int time_used, int time_allocated, const cOrganism& organism);
+
+private:
+  void writeHeader(cHardwareBase& hardware);
+  Avida::Output::TraceFormat::sEntry& nextEntry();
+  void recordSuccess(int exec_success);
+  void flush();
+};
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "cHardwareCPU.h"
 
+#include "avida/core/Feedback.h"
 #include "avida/core/WorldDriver.h"
 #include "avida/output/File.h"
 
@@ -43,6 +44,7 @@
 #include "cReactionLib.h"
 #include "cReactionProcess.h"
 #include "cResource.h"
+#include "cStateArchive.h"
 #include "cStateGrid.h"
 #include "cStringUtil.h"
 #include "cTestCPU.h"
@@ -769,8 +771,6 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
 : cHardwareBase(world, in_organism, in_inst_set)
 , m_last_cell_data(false, 0)
 {
-  m_functions = s_inst_slib->GetFunctions();
-  
   m_spec_die = false;
   m_epigenetic_state = false;
   
@@ -782,6 +782,10 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   
   m_slip_read_head = !m_world->GetConfig().SLIP_COPY_MODE.Get();
   
+  m_task_switch_penalty = m_world->GetConfig().TASK_SWITCH_PENALTY_TYPE.Get();
+  
+  selectDispatch();
+  
   // Initialize memory...
   const Genome& in_genome = in_organism->GetGenome();
   ConstInstructionSequencePtr in_seq_p;
@@ -792,6 +796,21 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   internalReset();
 }
 
+void cHardwareCPU::Recycle(cAvidaContext& ctx, cOrganism* in_organism)
+{
+  recycleBase(in_organism);
+  m_spec_die = false;
+  m_epigenetic_state = false;
+  
+  const Genome& in_genome = in_organism->GetGenome();
+  ConstInstructionSequencePtr in_seq_p;
+  in_seq_p.DynamicCastFrom(in_genome.Representation());
+  m_memory = *in_seq_p;
+  
+  Reset(ctx);
+  internalReset();
+}
+
 bool cHardwareCPU::checkNoMutList(cHeadCPU to)
 {
     //Anya's code for head to head experiments
@@ -840,9 +859,10 @@ void cHardwareCPU::internalReset()
     m_promoter_index = -1; // Meaning the last promoter was nothing
     m_promoter_offset = 0;
     m_promoters.Resize(0);
-    for (int i=0; i< m_memory.GetSize(); i++)
+    const cCPUMemory& memory = m_memory;
+    for (int i=0; i< memory.GetSize(); i++)
     {
-      if (m_memory[i] == promoter_inst)
+      if (memory[i] == promoter_inst)
       {
         int code = Numberate(i-1, -1, m_world->GetConfig().PROMOTER_CODE_SIZE.Get());
         m_promoters.Push( cPromoter(i,code) );
@@ -897,13 +917,127 @@ void cHardwareCPU::cLocalThread::Reset(cHardwareBase* in_hardware, int in_id)
     
 }
 
+void cHardwareCPU::cLocalThread::CheckpointState(cStateArchive& ar)
+{
+  ar.Tag("cLocalThread");
+  ar.Transfer(m_id);
+  ar.Transfer(m_promoter_inst_executed);
+  ar.Transfer(m_messageTriggerType);
+  for (int i = 0; i < NUM_REGISTERS; i++) ar.Transfer(reg[i]);
+  for (int i = 0; i < NUM_HEADS; i++) heads[i].CheckpointState(ar);
+  stack.CheckpointState(ar);
+  ar.Transfer(cur_stack);
+  ar.Transfer(cur_head);
+  if (cur_head >= NUM_HEADS) ar.Fail("invalid active head in checkpoint");
+  read_label.CheckpointState(ar);
+  next_label.CheckpointState(ar);
+}
+
+void cHardwareCPU::CheckpointState(cStateArchive& ar)
+{
+  // Memory must be restored before the threads, whose heads refer into it
+  checkpointBaseState(ar);
+  ar.Tag("cHardwareCPU");
+  m_memory.CheckpointState(ar);
+  m_global_stack.CheckpointState(ar);
+  
+  int num_threads = m_threads.GetSize();
+  ar.Transfer(num_threads);
+  if (!ar.IsGood()) return;
+  if (num_threads < 1) {
+    ar.Fail("invalid thread count in checkpoint");
+    return;
+  }
+  if (ar.IsLoading()) {
+    m_threads.Resize(num_threads);
+    for (int i = 0; i < num_threads; i++) m_threads[i].Reset(this, i);
+  }
+  for (int i = 0; i < num_threads; i++) m_threads[i].CheckpointState(ar);
+  ar.Transfer(m_thread_id_chart);
+  ar.Transfer(m_cur_thread);
+  if (m_cur_thread < 0 || m_cur_thread >= num_threads) ar.Fail("invalid current thread in checkpoint");
+  
+  m_mal_active = ar.TransferValue<bool>(m_mal_active);
+  m_advance_ip = ar.TransferValue<bool>(m_advance_ip);
+  m_executedmatchstrings = ar.TransferValue<bool>(m_executedmatchstrings);
+  m_spec_die = ar.TransferValue<bool>(m_spec_die);
+  
+  ar.Transfer(m_promoter_index);
+  ar.Transfer(m_promoter_offset);
+  int num_promoters = m_promoters.GetSize();
+  ar.Transfer(num_promoters);
+  if (!ar.IsGood()) return;
+  if (ar.IsLoading()) m_promoters.Resize(num_promoters);
+  for (int i = 0; i < num_promoters; i++) {
+    ar.Transfer(m_promoters[i].m_pos);
+    ar.Transfer(m_promoters[i].m_bit_code);
+    ar.Transfer(m_promoters[i].m_regulation);
+  }
+  
+  ar.Transfer(m_epigenetic_state);
+  for (int i = 0; i < NUM_REGISTERS; i++) ar.Transfer(m_epigenetic_saved_reg[i]);
+  m_epigenetic_saved_stack.CheckpointState(ar);
+}
+
 void cHardwareCPU::SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype) { (void)df, (void)gen_id, (void)genotype; }
 
 
+void cHardwareCPU::DecodeInstSet(cInstSet& inst_set)
+{
+  inst_set.SetDecoded(new cDispatchTable);
+}
+
+void cHardwareCPU::cDispatchTable::Decode(const cInstSet& inst_set)
+{
+  assert(inst_set.GetInstLib() == s_inst_slib);
+  
+  const tMethod* lib_functions = s_inst_slib->GetFunctions();
+  const tMethod null_function = lib_functions[s_inst_slib->GetInstNull()];
+  
+  for (int i = 0; i < inst_set.GetSize(); i++) functions[i] = lib_functions[inst_set.GetLibFunctionIndex(Instruction(i))];
+  for (int i = inst_set.GetSize(); i <= MAX_INSTSET_SIZE; i++) functions[i] = null_function;
+}
+
+void cHardwareCPU::selectDispatch()
+{
+  // Instruction sets are decoded when the hardware manager loads them, and copies of them along with the copy
+  const cDispatchTable* table = dynamic_cast<const cDispatchTable*>(m_inst_set->GetDecoded());
+  assert(table != NULL);
+  m_functions = table->functions;
+  m_dispatch_revision = m_inst_set->GetRevision();
+  
+  const bool costs = m_has_any_costs || m_inst_set->HasProbFail() || m_inst_set->HasAddlTimeCosts();
+  const bool promoters = m_promoters_enabled || m_constitutive_regulation;
+  
+  if (!m_world->GetConfig().SPECIALIZED_DISPATCH.Get() || (costs && promoters && m_task_switch_penalty)) {
+    m_single_process = &cHardwareCPU::singleProcess<true, true, true>;
+  } else if (costs) {
+    if (promoters) m_single_process = &cHardwareCPU::singleProcess<true, true, false>;
+    else if (m_task_switch_penalty) m_single_process = &cHardwareCPU::singleProcess<true, false, true>;
+    else m_single_process = &cHardwareCPU::singleProcess<true, false, false>;
+  } else if (promoters) {
+    if (m_task_switch_penalty) m_single_process = &cHardwareCPU::singleProcess<false, true, true>;
+    else m_single_process = &cHardwareCPU::singleProcess<false, true, false>;
+  } else {
+    if (m_task_switch_penalty) m_single_process = &cHardwareCPU::singleProcess<false, false, true>;
+    else m_single_process = &cHardwareCPU::singleProcess<false, false, false>;
+  }
+}
+
+
 // This function processes the very next command in the genome, and is made
 // to be as optimized as possible.  This is the heart of avida.
 
 bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
+{
+  // Instruction properties may be altered at run time (i.e. SetProbFail), reselect when that happens
+  if (m_dispatch_revision != m_inst_set->GetRevision()) selectDispatch();
+  
+  return (this->*m_single_process)(ctx, speculative);
+}
+
+template <bool COSTS, bool PROMOTERS, bool TASK_SWITCH>
+bool cHardwareCPU::singleProcess(cAvidaContext& ctx, bool speculative)
 {
   assert(!speculative || (speculative && !m_thread_slicing_parallel));
   
@@ -921,11 +1055,11 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
   cPhenotype& phenotype = m_organism->GetPhenotype();
   
   // First instruction - check whether we should be starting at a promoter, when enabled.
-  if (phenotype.GetCPUCyclesUsed() == 0 && m_promoters_enabled) Inst_Terminate(ctx);
+  if (PROMOTERS && m_promoters_enabled && phenotype.GetCPUCyclesUsed() == 0) Inst_Terminate(ctx);
   
   // Count the cpu cycles used
   phenotype.IncCPUCyclesUsed();
-  if (!m_world->GetConfig().NO_CPU_CYCLE_TIME.Get()) phenotype.IncTimeUsed();
+  if (!m_no_cpu_cycle_time) phenotype.IncTimeUsed();
   
   int num_threads = m_threads.GetSize();
   
@@ -967,23 +1101,23 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
     
     // Test if costs have been paid and it is okay to execute this now...
     bool exec = true;
-    if (m_has_any_costs) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);
+    if (COSTS && m_has_any_costs) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);
     
     // Constitutive regulation applied here
-    if (m_constitutive_regulation) Inst_SenseRegulate(ctx); 
+    if (PROMOTERS && m_constitutive_regulation) Inst_SenseRegulate(ctx); 
     
     // If there are no active promoters and a certain mode is set, then don't execute any further instructions
-    if (m_promoters_enabled && m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2 && m_promoter_index == -1) exec = false;
+    if (PROMOTERS && m_promoters_enabled && m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2 && m_promoter_index == -1) exec = false;
     
     // Now execute the instruction...
     if (exec == true) {
       // NOTE: This call based on the cur_inst must occur prior to instruction
       //       execution, because this instruction reference may be invalid after
       //       certain classes of instructions (namely divide instructions) @DMB
-      const int time_cost = m_inst_set->GetAddlTimeCost(cur_inst);
+      const int time_cost = COSTS ? m_inst_set->GetAddlTimeCost(cur_inst) : 0;
       
       // Prob of exec (moved from SingleProcess_PayCosts so that we advance IP after a fail)
-      if (m_inst_set->GetProbFail(cur_inst) > 0.0) {
+      if (COSTS && m_inst_set->GetProbFail(cur_inst) > 0.0) {
         exec = !( ctx.GetRandom().P(m_inst_set->GetProbFail(cur_inst)) );
       }
       
@@ -994,10 +1128,10 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       getIP().SetFlagExecuted();
       
       // Add to the promoter inst executed count before executing the inst (in case it is a terminator)
-      if (m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
+      if (PROMOTERS && m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
       
       if (exec == true) {
-        if (SingleProcess_ExecuteInst(ctx, cur_inst)) { 
+        if (executeInst<TASK_SWITCH>(ctx, cur_inst) && COSTS) { 
           SingleProcess_PayPostResCosts(ctx, cur_inst); 
           SingleProcess_SetPostCPUCosts(ctx, cur_inst, m_cur_thread); 
         }
@@ -1011,10 +1145,10 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       if (m_advance_ip == true) ip.Advance();
       
       // Pay the time cost of the instruction now
-      phenotype.IncTimeUsed(time_cost);
+      if (COSTS) phenotype.IncTimeUsed(time_cost);
       
       // In the promoter model, we may force termination after a certain number of inst have been executed
-      if (m_promoters_enabled) {
+      if (PROMOTERS && m_promoters_enabled) {
         const double processivity = m_world->GetConfig().PROMOTER_PROCESSIVITY.Get();
         if (ctx.GetRandom().P(1 - processivity)) Inst_Terminate(ctx);
         if (m_world->GetConfig().PROMOTER_INST_MAX.Get() && (m_threads[m_cur_thread].GetPromoterInstExecuted() >= m_world->GetConfig().PROMOTER_INST_MAX.Get())) 
@@ -1058,23 +1192,27 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
 // This method will handle the actual execution of an instruction
 // within a single process, once that function has been finalized.
 bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst) 
+{
+  if (m_task_switch_penalty) return executeInst<true>(ctx, cur_inst);
+  return executeInst<false>(ctx, cur_inst);
+}
+
+template <bool TASK_SWITCH>
+bool cHardwareCPU::executeInst(cAvidaContext& ctx, const Instruction& cur_inst) 
 {
   // Copy Instruction locally to handle stochastic effects
   Instruction actual_inst = cur_inst;
   
-  // Get a pointer to the corresponding method...
-  int inst_idx = m_inst_set->GetLibFunctionIndex(actual_inst);
-  
   // instruction execution count incremented
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
-  // And execute it.
-  const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
+  // And execute it, the dispatch table is indexed directly by op
+  const bool exec_success = (this->*(m_functions[actual_inst.GetOp()]))(ctx);
   
   // NOTE: Organism may be dead now if instruction executed killed it (such as some divides, "die", or "explode")
   
   // Add in a cycle cost for switching which task is performed
-  if (m_world->GetConfig().TASK_SWITCH_PENALTY_TYPE.Get()) {
+  if (TASK_SWITCH && m_task_switch_penalty) {
     if (m_organism->GetPhenotype().GetNumNewUniqueReactions()) {
       int cost = m_organism->GetPhenotype().GetNumNewUniqueReactions() * m_world->GetConfig().TASK_SWITCH_PENALTY.Get();
       IncrementTaskSwitchingCost(cost);
@@ -1215,6 +1353,99 @@ cHeadCPU cHardwareCPU::FindLabel(int direction)
 // to find search label's match inside another label.
 
 int cHardwareCPU::FindLabel_Forward(const cCodeLabel & search_label,
+                                    const cCPUMemory & search_memory, int pos)
+{
+  const int method = m_world->GetConfig().LABEL_SEARCH_METHOD.Get();
+  if (method == 0) return scanLabel_Forward(search_label, search_memory, pos);
+  
+  const int found_pos = indexLabel_Forward(search_label, search_memory, pos);
+  if (method == 2) checkLabelSearch(search_label, search_memory, pos, found_pos, scanLabel_Forward(search_label, search_memory, pos));
+  return found_pos;
+}
+
+int cHardwareCPU::indexLabel_Forward(const cCodeLabel & search_label,
+                                     const cCPUMemory & search_memory, int pos)
+{
+  assert (pos < search_memory.GetSize() && pos >= 0);
+  
+  const cLabelIndex& labels = search_memory.GetLabelIndex(*m_inst_set);
+  const int search_start = pos;
+  const int label_size = search_label.GetSize();
+  
+  // Move off the template we are on.
+  pos += label_size;
+  
+  // Check each label (run of nops) that reaches past this point in turn.  The
+  // one we are in the middle of is only checked from the search start on.
+  while ((pos = labels.NextNop(pos)) < labels.GetSize()) {
+    const int start_pos = Apto::Max(labels.NopRunStart(pos), search_start);
+    const int end_pos = labels.NopRunEnd(pos);
+    
+    // See if this label has the proper sub-label within it; if so, return
+    // the position just after the first match.
+    for (int offset = start_pos; offset + label_size <= end_pos; offset++) {
+      if (labels.Matches(search_label, offset)) return offset + label_size;
+    }
+    
+    // We haven't found it; move on to just after the current label.
+    pos = end_pos;
+  }
+  
+  // The label was not found.
+  return -1;
+}
+
+// Search backwards for search_label from _before_ position pos in the
+// memory.  Return the first line _after_ the the found label.  It is okay
+// to find search label's match inside another label.
+
+int cHardwareCPU::FindLabel_Backward(const cCodeLabel & search_label,
+                                     const cCPUMemory & search_memory, int pos)
+{
+  const int method = m_world->GetConfig().LABEL_SEARCH_METHOD.Get();
+  if (method == 0) return scanLabel_Backward(search_label, search_memory, pos);
+  
+  const int found_pos = indexLabel_Backward(search_label, search_memory, pos);
+  if (method == 2) checkLabelSearch(search_label, search_memory, pos, found_pos, scanLabel_Backward(search_label, search_memory, pos));
+  return found_pos;
+}
+
+int cHardwareCPU::indexLabel_Backward(const cCodeLabel & search_label,
+                                      const cCPUMemory & search_memory, int pos)
+{
+  assert (pos < search_memory.GetSize());
+  
+  const cLabelIndex& labels = search_memory.GetLabelIndex(*m_inst_set);
+  const int search_start = pos;
+  const int label_size = search_label.GetSize();
+  
+  // Move off the template we are on.
+  pos -= label_size;
+  
+  // Check each label (run of nops) from this point back in turn.  The one we
+  // are in the middle of is only checked up to the search start.
+  while ((pos = labels.PrevNop(pos)) >= 0) {
+    const int start_pos = labels.NopRunStart(pos);
+    const int end_pos = Apto::Min(labels.NopRunEnd(pos), search_start);
+    
+    // See if this label has the proper sub-label within it; if so, return
+    // the position just after the label it was found in.
+    for (int offset = start_pos; offset + label_size <= end_pos; offset++) {
+      if (labels.Matches(search_label, offset)) return end_pos;
+    }
+    
+    // We haven't found it; move on to just before the current label.
+    pos = start_pos - 1;
+  }
+  
+  // The label was not found.
+  return -1;
+}
+
+// Reference searches (LABEL_SEARCH_METHOD 0), stepping through the memory
+// a label length at a time and asking the instruction set about each site.
+
+int cHardwareCPU::scanLabel_Forward(const cCodeLabel & search_label,
                                     const InstructionSequence & search_genome, int pos)
 {
   assert (pos < search_genome.GetSize() && pos >= 0);
@@ -1272,7 +1503,6 @@ int cHardwareCPU::FindLabel_Forward(const cCodeLabel & search_label,
       // the label we found it in, and break out.
       
       if (found_label == true) {
-        // pos = end_pos;
         pos = label_size + offset;
         break;
       }
@@ -1292,11 +1522,7 @@ int cHardwareCPU::FindLabel_Forward(const cCodeLabel & search_label,
   return pos;
 }
 
-// Search backwards for search_label from _before_ position pos in the
-// memory.  Return the first line _after_ the the found label.  It is okay
-// to find search label's match inside another label.
-
-int cHardwareCPU::FindLabel_Backward(const cCodeLabel & search_label,
+int cHardwareCPU::scanLabel_Backward(const cCodeLabel & search_label,
                                      const InstructionSequence & search_genome, int pos)
 {
   assert (pos < search_genome.GetSize());
@@ -1370,6 +1596,18 @@ int cHardwareCPU::FindLabel_Backward(const cCodeLabel & search_label,
   return pos;
 }
 
+// LABEL_SEARCH_METHOD 2: stop the run when the indexed search disagrees with the reference one
+void cHardwareCPU::checkLabelSearch(const cCodeLabel& search_label, const cCPUMemory& search_memory, int pos,
+                                    int found_pos, int scan_pos)
+{
+  if (found_pos == scan_pos) return;
+  
+  m_world->GetDriver().Feedback().Error("label search for '%s' from %d in '%s' found %d, reference search found %d",
+                                        (const char*)search_label.AsString(), pos,
+                                        (const char*)search_memory.AsString(), found_pos, scan_pos);
+  m_world->GetDriver().Abort(Avida::INTERNAL_ERROR);
+}
+
 // Search for 'in_label' anywhere in the hardware.
 cHeadCPU cHardwareCPU::FindLabel(const cCodeLabel & in_label, int direction)
 {
@@ -3332,9 +3570,10 @@ void cHardwareCPU::Divide_DoTransposons(cAvidaContext& ctx)
   InstructionSequence& child_genome = *child_seq_p;
   
   // Count the number of transposons that are marked as executed
+  const cCPUMemory& memory = m_memory;
   int tr_count = 0;
-  for (int i = 0; i < m_memory.GetSize(); i++) {
-    if (m_memory.FlagExecuted(i) && (m_memory[i] == transposon_inst)) tr_count++;
+  for (int i = 0; i < memory.GetSize(); i++) {
+    if (memory.FlagExecuted(i) && (memory[i] == transposon_inst)) tr_count++;
   }
   
   for (int i = 0; i < tr_count; i++) {
@@ -7936,8 +8175,9 @@ int cHardwareCPU::Numberate(int _pos, int _dir, int _num_bits)
   j %= m_memory.GetSize();
   assert(j >=0);
   assert(j < m_memory.GetSize());
+  const cCPUMemory& memory = m_memory;
   while (code_size < _num_bits) {
-    unsigned int inst_code = (unsigned int) GetInstSet().GetInstructionCode(m_memory[j]);
+    unsigned int inst_code = (unsigned int) GetInstSet().GetInstructionCode(memory[j]);
     // shift bits in, one by one ... excuse the counter variable pun
     for (int code_on = 0; (code_size < _num_bits) && (code_on < m_world->GetConfig().INST_CODE_LENGTH.Get()); code_on++) {
       if (_dir < 0) {
@@ -87,6 +87,7 @@ protected:
     void operator=(const cLocalThread& in_thread);
 
     void Reset(cHardwareBase* in_hardware, int in_id);
+    void CheckpointState(cStateArchive& ar);
     int GetID() const { return m_id; }
     void SetID(int in_id) { m_id = in_id; }
     int GetPromoterInstExecuted() { return m_promoter_inst_executed; }
@@ -102,8 +103,23 @@ protected:
   static tInstLib<tMethod>* initInstLib(void);
 
 
+  // Instruction methods indexed directly by op, built once per instruction set (unused ops map to the null inst)
+  class cDispatchTable : public cInstSet::cDecoded
+  {
+  public:
+    tMethod functions[MAX_INSTSET_SIZE + 1];
+    
+    cInstSet::cDecoded* Create() const { return new cDispatchTable; }
+    void Decode(const cInstSet& inst_set);
+  };
+  
+  typedef bool (cHardwareCPU::*tProcessMethod)(cAvidaContext& ctx, bool speculative);
+  
+
   // --------  Member Variables  --------
-  const tMethod* m_functions;
+  const tMethod* m_functions;       // dispatch table of the instruction set, indexed by op
+  tProcessMethod m_single_process;  // SingleProcess specialized for the features in use
+  int m_dispatch_revision;          // instruction set revision m_single_process was selected for
 
   cCPUMemory m_memory;          // Memory...
   cCPUStack m_global_stack;     // A stack that all threads share.
@@ -126,6 +142,8 @@ protected:
     bool m_constitutive_regulation:1;
 
     bool m_slip_read_head:1;
+    
+    bool m_task_switch_penalty:1;
   };
 
   // <-- Promoter model
@@ -155,6 +173,11 @@ protected:
 
   bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
   
+  // Template parameters compile out the checks for features that are disabled, see selectDispatch()
+  template <bool COSTS, bool PROMOTERS, bool TASK_SWITCH> bool singleProcess(cAvidaContext& ctx, bool speculative);
+  template <bool TASK_SWITCH> bool executeInst(cAvidaContext& ctx, const Instruction& cur_inst);
+  void selectDispatch();
+  
   // --------  Stack Manipulation...  --------
   inline void StackPush(int value);
   inline int StackPop();
@@ -173,8 +196,13 @@ protected:
   cCodeLabel& GetLabel() { return m_threads[m_cur_thread].next_label; }
   void ReadLabel(int max_size=cCodeLabel::MAX_LENGTH);
   cHeadCPU FindLabel(int direction);
-  int FindLabel_Forward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
-  int FindLabel_Backward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
+  int FindLabel_Forward(const cCodeLabel & search_label, const cCPUMemory& search_memory, int pos);
+  int FindLabel_Backward(const cCodeLabel & search_label, const cCPUMemory& search_memory, int pos);
+  int indexLabel_Forward(const cCodeLabel & search_label, const cCPUMemory& search_memory, int pos);
+  int indexLabel_Backward(const cCodeLabel & search_label, const cCPUMemory& search_memory, int pos);
+  int scanLabel_Forward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
+  int scanLabel_Backward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
+  void checkLabelSearch(const cCodeLabel& search_label, const cCPUMemory& search_memory, int pos, int found_pos, int scan_pos);
   cHeadCPU FindLabel(const cCodeLabel & in_label, int direction);
   void FindLabelInMemory(const cCodeLabel& label, cHeadCPU& search_head);
 
@@ -237,9 +265,11 @@ protected:
 public:
   cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareCPU() { ; }
+  void Recycle(cAvidaContext& ctx, cOrganism* in_organism);
 
   static tInstLib<tMethod>* GetInstLib() { return s_inst_slib; }
   static cString GetDefaultInstFilename() { return "instset-heads.cfg"; }
+  static void DecodeInstSet(cInstSet& inst_set);
 
   bool SingleProcess(cAvidaContext& ctx, bool speculative = false);
   void ProcessBonusInst(cAvidaContext& ctx, const Instruction& inst);
@@ -252,6 +282,7 @@ public:
   void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) { (void)ctx, (void)fp; }
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) { (void)fp, (void)exec_success; }
+  void CheckpointState(cStateArchive& ar);
 
   // --------  Stack Manipulation...  --------
   inline int GetStack(int depth=0, int stack_id=-1, int in_thread=-1) const;
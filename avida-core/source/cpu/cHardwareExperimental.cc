@@ -26,6 +26,7 @@
 #include "avida/core/Feedback.h"
 #include "avida/core/WorldDriver.h"
 #include "avida/output/File.h"
+#include "avida/private/output/TraceFormat.h"
 
 #include "avida/private/systematics/SexualAncestry.h"
 
@@ -43,6 +44,7 @@
 #include "tInstLibEntry.h"
 
 #include <climits>
+#include <cstring>
 #include <fstream>
 
 using namespace std;
@@ -461,6 +463,21 @@ cHardwareExperimental::cHardwareExperimental(cAvidaContext& ctx, cWorld* world,
   Reset(ctx);                            // Setup the rest of the hardware...
 }
 
+void cHardwareExperimental::Recycle(cAvidaContext& ctx, cOrganism* in_organism)
+{
+  recycleBase(in_organism);
+  m_sensor.Rebind(in_organism);
+  m_spec_die = false;
+  m_last_cell_data = std::make_pair(false, 0);
+  
+  const Genome& in_genome = in_organism->GetGenome();
+  ConstInstructionSequencePtr in_seq_p;
+  in_seq_p.DynamicCastFrom(in_genome.Representation());
+  
+  m_memory = *in_seq_p;
+  Reset(ctx);
+}
+
 
 void cHardwareExperimental::internalReset()
 {
@@ -488,8 +505,9 @@ void cHardwareExperimental::internalReset()
     
     m_promoters.Resize(0);
     
-    for (int i=0; i < m_memory.GetSize(); i++) {
-      if (m_inst_set->IsPromoter(m_memory[i])) {
+    const cCPUMemory& memory = m_memory;
+    for (int i=0; i < memory.GetSize(); i++) {
+      if (m_inst_set->IsPromoter(memory[i])) {
         int code = Numberate(i - 1, -1, m_world->GetConfig().PROMOTER_CODE_SIZE.Get());
         m_promoters.Push(cPromoter(i, code));
       }
@@ -883,79 +901,72 @@ void cHardwareExperimental::SetupMiniTraceFileHeader(Avida::Output::File& df, co
 
 void cHardwareExperimental::PrintMiniTraceStatus(cAvidaContext& ctx, ostream& fp)
 {
+  Output::TraceFormat::sStatus status;
+  RecordMiniTraceStatus(ctx, status);
+  Output::TraceFormat::PrintStatus(fp, status, GetInstSet().GetName(status.inst));
+}
+
+bool cHardwareExperimental::RecordMiniTraceStatus(cAvidaContext& ctx, Output::TraceFormat::sStatus& status)
+{
+  memset(&status, 0, sizeof(status));
+  status.layout = Output::TraceFormat::LAYOUT_EXPERIMENTAL;
   // basic status info
-  fp << m_cycle_count << " ";
-  fp << m_world->GetStats().GetUpdate() << " ";
+  status.cycle = m_cycle_count;
+  status.update = m_world->GetStats().GetUpdate();
+  status.num_registers = NUM_REGISTERS;
   for (int i = 0; i < NUM_REGISTERS; i++) {
-    DataValue& reg = m_threads[m_cur_thread].reg[i];
-    fp << GetRegister(i) << " ";
-    fp << "(" << reg.originated << ") ";
-  }    
+    status.registers[i] = GetRegister(i);
+    status.reg_origins[i] = m_threads[m_cur_thread].reg[i].originated;
+  }
   // genome loc info
-  fp << m_cur_thread << " ";
-  fp << getIP().GetPosition() << " ";  
-  fp << getHead(nHardware::HEAD_READ).GetPosition() << " ";
-  fp << getHead(nHardware::HEAD_WRITE).GetPosition()  << " ";
-  fp << getHead(nHardware::HEAD_FLOW).GetPosition()   << " ";
+  status.thread = m_cur_thread;
+  status.heads[0] = getIP().GetPosition();
+  status.heads[1] = getHead(nHardware::HEAD_READ).GetPosition();
+  status.heads[2] = getHead(nHardware::HEAD_WRITE).GetPosition();
+  status.heads[3] = getHead(nHardware::HEAD_FLOW).GetPosition();
   // last output
-  fp << m_last_output << " ";
+  status.last_output = m_last_output;
   // phenotype/org status info
-  fp << m_organism->GetPhenotype().GetMerit().GetDouble() << " ";
-  fp << m_organism->GetPhenotype().GetCurBonus() << " ";
-  fp << m_organism->GetForageTarget() << " ";
-  if (m_organism->HasOpinion()) fp << m_organism->GetOpinion().first << " ";
-  else fp << -99 << " ";
+  status.merit = m_organism->GetPhenotype().GetMerit().GetDouble();
+  status.bonus = m_organism->GetPhenotype().GetCurBonus();
+  status.forage_target = m_organism->GetForageTarget();
+  status.group = (m_organism->HasOpinion()) ? m_organism->GetOpinion().first : -99;
   // environment info / things that affect movement
-  fp << m_organism->GetOrgInterface().GetCellID() << " ";
-  if (m_use_avatar) fp << m_organism->GetOrgInterface().GetAVCellID() << " ";
-  if (!m_use_avatar) fp << m_organism->GetOrgInterface().GetFacedDir() << " ";
-  else fp << m_organism->GetOrgInterface().GetAVFacing() << " ";
-  if (!m_use_avatar) fp << m_organism->IsNeighborCellOccupied() << " ";  
-  else fp << m_organism->GetOrgInterface().FacedHasAV() << " ";
+  status.cell = m_organism->GetOrgInterface().GetCellID();
+  status.use_avatar = (m_use_avatar) ? 1 : 0;
+  if (m_use_avatar) status.av_cell = m_organism->GetOrgInterface().GetAVCellID();
+  if (!m_use_avatar) status.facing = m_organism->GetOrgInterface().GetFacedDir();
+  else status.facing = m_organism->GetOrgInterface().GetAVFacing();
+  if (!m_use_avatar) status.faced_occupied = m_organism->IsNeighborCellOccupied();
+  else status.faced_occupied = m_organism->GetOrgInterface().FacedHasAV();
   const cResourceLib& resource_lib = m_world->GetEnvironment().GetResourceLib();
-  Apto::Array<double> cell_resource_levels;
-  if (!m_use_avatar) cell_resource_levels = m_organism->GetOrgInterface().GetFacedCellResources(ctx);
-  else cell_resource_levels = m_organism->GetOrgInterface().GetAVFacedResources(ctx);
-  int wall = 0;
-  int hill = 0;
   for (int i = 0; i < resource_lib.GetSize(); i++) {
     if (resource_lib.GetResource(i)->GetHabitat() == 2) {
       double wall_level = 0.0;
       if (!m_use_avatar) wall_level = m_organism->GetOrgInterface().GetFacedResourceVal(ctx, i);
       else wall_level = m_organism->GetOrgInterface().GetAVFacedResourceVal(ctx, i);
-      if (wall_level > 0) wall = 1;
+      if (wall_level > 0) status.faced_wall = 1;
     }
     else if (resource_lib.GetResource(i)->GetHabitat() == 1) {
       double hill_level = 0.0;
       if (!m_use_avatar) hill_level = m_organism->GetOrgInterface().GetFacedResourceVal(ctx, i);
       else hill_level = m_organism->GetOrgInterface().GetAVFacedResourceVal(ctx, i);
-      if (hill_level > 0)  hill = 1;
+      if (hill_level > 0) status.faced_hill = 1;
     }
-    if (hill == 1 && wall == 1) break;
+    if (status.faced_hill && status.faced_wall) break;
   }
-  fp << hill << " ";
-  fp << wall << " ";
   // instruction about to be executed
-  cString next_name(GetInstSet().GetName(IP().GetInst()));
-
-  fp << next_name << " ";
+  status.inst = IP().GetInst().GetOp();
   // any trailing nops (up to NUM_REGISTERS)
   cCPUMemory& memory = m_memory;
   int pos = getIP().GetPosition();
-  Apto::Array<int, Apto::Smart> seq;
-  seq.Resize(0);
   for (int i = 0; i < NUM_REGISTERS; i++) {
     pos += 1;
     if (pos >= memory.GetSize()) pos = 0;
-    if (m_inst_set->IsNop(memory[pos])) seq.Push(m_inst_set->GetNopMod(memory[pos])); 
+    if (m_inst_set->IsNop(memory[pos])) status.nops[status.num_nops++] = (char) m_inst_set->GetNopMod(memory[pos]) + 'A';
     else break;
   }
-  cString mod_string;
-  for (int j = 0; j < seq.GetSize(); j++) {
-    mod_string += (char) seq[j] + 'A';  
-  }  
-  if (mod_string.GetSize() != 0) fp << mod_string << " ";
-  else fp << "NoMods" << " ";
+  return true;
 }
 
 void cHardwareExperimental::PrintMiniTraceSuccess(ostream& fp, const int exec_sucess)
@@ -974,37 +985,34 @@ cHeadCPU cHardwareExperimental::FindLabelStart(bool mark_executed)
   if (search_label.GetSize() == 0) return ip;
   
   cCPUMemory& memory = m_memory;
+  const cLabelIndex& labels = memory.GetLabelIndex(*m_inst_set);
   int pos = 0;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
+  // Visit each 'label' instruction in turn
+  while ((pos = labels.NextLabel(pos)) < memory.GetSize()) {
+    pos++;
+    
+    // Check for direct matched label pattern, can be substring of 'label'ed target
+    // - must match all NOPs in search_label
+    // - extra NOPs in 'label'ed target are ignored
+    int size_matched = 0;
+    while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
+      if (!labels.IsNop(pos) || search_label[size_matched] != labels.GetNopMod(pos)) break;
+      size_matched++;
       pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        return cHeadCPU(this, pos - 1, ip.GetMemSpace());
+    }
+    
+    // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
+    if (size_matched == search_label.GetSize()) {
+      // Return Head pointed at last NOP of label sequence
+      if (mark_executed) {
+        size_matched++; // Increment size matched so that it includes the label instruction
+        const int start = pos - size_matched;
+        const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+        for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
       }
-      
-      continue; 
+      return cHeadCPU(this, pos - 1, ip.GetMemSpace());
     }
-    pos++;
   }
   
   // Return start point if not found
@@ -1020,31 +1028,30 @@ cHeadCPU cHardwareExperimental::FindNopSequenceStart(bool mark_executed)
   if (search_label.GetSize() == 0) return ip;
   
   cCPUMemory& memory = m_memory;
+  const cLabelIndex& labels = memory.GetLabelIndex(*m_inst_set);
   int pos = 0;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsNop(memory[pos])) { // start of sequence found
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        return cHeadCPU(this, pos - 1, ip.GetMemSpace());
+  // Visit each nop in turn (other than those passed over while matching)
+  while ((pos = labels.NextNop(pos)) < memory.GetSize()) {
+    // Check for direct matched label pattern, can be substring of 'label'ed target
+    // - must match all NOPs in search_label
+    // - extra NOPs in 'label'ed target are ignored
+    int size_matched = 0;
+    while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
+      if (!labels.IsNop(pos) || search_label[size_matched] != labels.GetNopMod(pos)) break;
+      size_matched++;
+      pos++;
+    }
+    
+    // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
+    if (size_matched == search_label.GetSize()) {
+      // Return Head pointed at last NOP of label sequence
+      if (mark_executed) {
+        const int start = pos - size_matched;
+        const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
+        for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
       }
+      return cHeadCPU(this, pos - 1, ip.GetMemSpace());
     }
     pos++;
   }
@@ -1062,11 +1069,13 @@ cHeadCPU cHardwareExperimental::FindLabelForward(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
+  const cLabelIndex& labels = ip.GetMemory().GetLabelIndex(*m_inst_set);
+  
   cHeadCPU pos(ip);
   pos++;
   
   while (pos.GetPosition() != ip.GetPosition()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
+    if (labels.IsLabel(pos.GetPosition())) { // starting label found
       const int label_start = pos.GetPosition();
       pos++;
       
@@ -1075,7 +1084,7 @@ cHeadCPU cHardwareExperimental::FindLabelForward(bool mark_executed)
       // - extra NOPs in 'label'ed target are ignored
       int size_matched = 0;
       while (size_matched < search_label.GetSize() && pos.GetPosition() != ip.GetPosition()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
+        if (!labels.IsNop(pos.GetPosition()) || search_label[size_matched] != labels.GetNopMod(pos.GetPosition())) break;
         size_matched++;
         pos++;
       }
@@ -1097,7 +1106,10 @@ cHeadCPU cHardwareExperimental::FindLabelForward(bool mark_executed)
       
       continue; 
     }
+    
+    // Skip ahead to the next 'label' instruction (or back around to the instruction pointer)
     pos++;
+    pos.AbsSet(labels.NextLabel(pos.GetPosition(), ip.GetPosition()));
   }
   
   // Return start point if not found
@@ -1163,11 +1175,13 @@ cHeadCPU cHardwareExperimental::FindNopSequenceForward(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
+  const cLabelIndex& labels = ip.GetMemory().GetLabelIndex(*m_inst_set);
+  
   cHeadCPU pos(ip);
   pos++;
   
   while (pos.GetPosition() != ip.GetPosition()) {
-    if (m_inst_set->IsNop(pos.GetInst())) { // starting label found
+    if (labels.IsNop(pos.GetPosition())) { // starting label found
       const int label_start = pos.GetPosition();
       
       // Check for direct matched nop sequence, can be substring of target
@@ -1175,7 +1189,7 @@ cHeadCPU cHardwareExperimental::FindNopSequenceForward(bool mark_executed)
       // - extra NOPs in target are ignored
       int size_matched = 0;
       while (size_matched < search_label.GetSize() && pos.GetPosition() != ip.GetPosition()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
+        if (!labels.IsNop(pos.GetPosition()) || search_label[size_matched] != labels.GetNopMod(pos.GetPosition())) break;
         size_matched++;
         pos++;
       }
@@ -1197,7 +1211,10 @@ cHeadCPU cHardwareExperimental::FindNopSequenceForward(bool mark_executed)
     }
     
     if (pos.GetPosition() == ip.GetPosition()) break;
+    
+    // Skip ahead to the next nop (or back around to the instruction pointer)
     pos++;
+    pos.AbsSet(labels.NextNop(pos.GetPosition(), ip.GetPosition()));
   }
   
   // Return start point if not found
@@ -2898,9 +2915,10 @@ int cHardwareExperimental::Numberate(int _pos, int _dir, int _num_bits)
   j %= m_memory.GetSize();
   assert(j >=0);
   assert(j < m_memory.GetSize());
+  const cCPUMemory& memory = m_memory;
   while (code_size < _num_bits)
   {
-    unsigned int inst_code = (unsigned int) GetInstSet().GetInstructionCode(m_memory[j]);
+    unsigned int inst_code = (unsigned int) GetInstSet().GetInstructionCode(memory[j]);
     // shift bits in, one by one ... excuse the counter variable pun
     for (int code_on = 0; (code_size < _num_bits) && (code_on < m_world->GetConfig().INST_CODE_LENGTH.Get()); code_on++)
     {
@@ -27,6 +27,7 @@
 #include "avida/core/Feedback.h"
 #include "avida/core/WorldDriver.h"
 #include "avida/output/File.h"
+#include "avida/private/output/TraceFormat.h"
 
 #include "cAvidaContext.h"
 #include "cHardwareManager.h"
@@ -41,6 +42,7 @@
 #include "tInstLibEntry.h"
 
 #include <climits>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 
@@ -259,6 +261,21 @@ cHardwareGP8::cHardwareGP8(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   Reset(ctx); // Setup the rest of the hardware...
 }
 
+void cHardwareGP8::Recycle(cAvidaContext& ctx, cOrganism* in_organism)
+{
+  recycleBase(in_organism);
+  m_sensor.Rebind(in_organism);
+  m_spec_die = false;
+  
+  const Genome& in_genome = in_organism->GetGenome();
+  ConstInstructionSequencePtr in_seq_p;
+  in_seq_p.DynamicCastFrom(in_genome.Representation());
+  
+  m_mem_array.Resize(1);
+  m_mem_array[0] = *in_seq_p;
+  Reset(ctx);
+}
+
 
 void cHardwareGP8::internalReset()
 {
@@ -754,74 +771,71 @@ void cHardwareGP8::SetupMiniTraceFileHeader(Avida::Output::File& df, const int g
 
 void cHardwareGP8::PrintMiniTraceStatus(cAvidaContext& ctx, ostream& fp)
 {
+  Output::TraceFormat::sStatus status;
+  RecordMiniTraceStatus(ctx, status);
+  Output::TraceFormat::PrintStatus(fp, status, GetInstSet().GetName(status.inst));
+}
+
+bool cHardwareGP8::RecordMiniTraceStatus(cAvidaContext& ctx, Output::TraceFormat::sStatus& status)
+{
+  memset(&status, 0, sizeof(status));
+  status.layout = Output::TraceFormat::LAYOUT_GP8;
   // basic status info
-  fp << m_cycle_count << " ";
-  fp << m_cur_uop << " ";
-  fp << m_world->GetStats().GetUpdate() << " ";
-  fp << m_hw_queue_eat << " ";
-  fp << m_hw_queue_move << " ";
-  fp << m_hw_queue_rotate;
-  fp << (m_hw_queue_rotate_reverse ? " (-" : " (");
-  fp << m_hw_queue_rotate_num << ") ";
+  status.cycle = m_cycle_count;
+  status.micro_op = m_cur_uop;
+  status.update = m_world->GetStats().GetUpdate();
+  status.queue_eat = m_hw_queue_eat;
+  status.queue_move = m_hw_queue_move;
+  status.queue_rotate = m_hw_queue_rotate;
+  status.queue_rotate_reverse = m_hw_queue_rotate_reverse;
+  status.queue_rotate_num = m_hw_queue_rotate_num;
+  status.num_registers = NUM_REGISTERS;
   for (int i = 0; i < NUM_REGISTERS; i++) {
-    DataValue& reg = m_threads[m_cur_thread].reg[i];
-    fp << getRegister(ctx, i) << " ";
-    fp << "(" << reg.originated << ") ";
-  }    
+    status.registers[i] = getRegister(ctx, i);
+    status.reg_origins[i] = m_threads[m_cur_thread].reg[i].originated;
+  }
   // genome loc info
-  fp << m_cur_thread << " ";
-  fp << getIP().Position() << " ";
-  fp << getHead(hREAD).Position() << " ";
-  fp << getHead(hWRITE).Position()  << " ";
-  fp << getHead(hFLOW).Position()   << " ";
+  status.thread = m_cur_thread;
+  status.heads[0] = getIP().Position();
+  status.heads[1] = getHead(hREAD).Position();
+  status.heads[2] = getHead(hWRITE).Position();
+  status.heads[3] = getHead(hFLOW).Position();
   // last output
-  fp << m_last_output << " ";
+  status.last_output = m_last_output;
   // phenotype/org status info
-  fp << m_organism->GetPhenotype().GetMerit().GetDouble() << " ";
-  fp << m_organism->GetPhenotype().GetCurBonus() << " ";
-  fp << m_organism->GetForageTarget() << " ";
-  if (m_organism->HasOpinion()) fp << m_organism->GetOpinion().first << " ";
-  else fp << -99 << " ";
+  status.merit = m_organism->GetPhenotype().GetMerit().GetDouble();
+  status.bonus = m_organism->GetPhenotype().GetCurBonus();
+  status.forage_target = m_organism->GetForageTarget();
+  status.group = (m_organism->HasOpinion()) ? m_organism->GetOpinion().first : -99;
   // environment info / things that affect movement
-  fp << m_organism->GetOrgInterface().GetCellID() << " ";
-  if (m_use_avatar) fp << m_organism->GetOrgInterface().GetAVCellID() << " ";
-  if (!m_use_avatar) fp << m_organism->GetOrgInterface().GetFacedDir() << " ";
-  else fp << m_organism->GetOrgInterface().GetAVFacing() << " ";
-  if (!m_use_avatar) fp << m_organism->IsNeighborCellOccupied() << " ";  
-  else fp << m_organism->GetOrgInterface().FacedHasAV() << " ";
+  status.cell = m_organism->GetOrgInterface().GetCellID();
+  status.use_avatar = (m_use_avatar) ? 1 : 0;
+  if (m_use_avatar) status.av_cell = m_organism->GetOrgInterface().GetAVCellID();
+  if (!m_use_avatar) status.facing = m_organism->GetOrgInterface().GetFacedDir();
+  else status.facing = m_organism->GetOrgInterface().GetAVFacing();
+  if (!m_use_avatar) status.faced_occupied = m_organism->IsNeighborCellOccupied();
+  else status.faced_occupied = m_organism->GetOrgInterface().FacedHasAV();
   const cResourceLib& resource_lib = m_world->GetEnvironment().GetResourceLib();
   Apto::Array<double> cell_resource_levels;
   if (!m_use_avatar) cell_resource_levels = m_organism->GetOrgInterface().GetFacedCellResources(ctx);
   else cell_resource_levels = m_organism->GetOrgInterface().GetAVFacedResources(ctx);
-  int wall = 0;
-  int hill = 0;
   for (int i = 0; i < cell_resource_levels.GetSize(); i++) {
-    if (resource_lib.GetResource(i)->GetHabitat() == 2 && cell_resource_levels[i] > 0) wall = 1;
-    if (resource_lib.GetResource(i)->GetHabitat() == 1 && cell_resource_levels[i] > 0) hill = 1;
-    if (hill == 1 && wall == 1) break;
+    if (resource_lib.GetResource(i)->GetHabitat() == 2 && cell_resource_levels[i] > 0) status.faced_wall = 1;
+    if (resource_lib.GetResource(i)->GetHabitat() == 1 && cell_resource_levels[i] > 0) status.faced_hill = 1;
+    if (status.faced_hill && status.faced_wall) break;
   }
-  fp << hill << " ";
-  fp << wall << " ";
   // instruction about to be executed
-  cString next_name(GetInstSet().GetName(getIP().GetInst()));
-  fp << next_name << " ";
+  status.inst = getIP().GetInst().GetOp();
   // any trailing nops (up to NUM_REGISTERS)
   cCPUMemory& memory = getIP().MemSpaceIsGene() ? m_genes[getIP().MemSpaceIndex()].memory : m_mem_array[getIP().MemSpaceIndex()];
   int pos = getIP().Position();
-  Apto::Array<int, Apto::Smart> seq;
-  seq.Resize(0);
   for (int i = 0; i < NUM_REGISTERS; i++) {
     pos += 1;
     if (pos >= memory.GetSize()) pos = 0;
-    if (m_inst_set->IsNop(memory[pos])) seq.Push(m_inst_set->GetNopMod(memory[pos])); 
+    if (m_inst_set->IsNop(memory[pos])) status.nops[status.num_nops++] = (char) m_inst_set->GetNopMod(memory[pos]) + 'A';
     else break;
   }
-  cString mod_string;
-  for (int j = 0; j < seq.GetSize(); j++) {
-    mod_string += (char) seq[j] + 'A';  
-  }  
-  if (mod_string.GetSize() != 0) fp << mod_string << " ";
-  else fp << "NoMods" << " ";
+  return true;
 }
 
 void cHardwareGP8::PrintMiniTraceSuccess(ostream& fp, const int exec_sucess)
@@ -844,38 +858,35 @@ void cHardwareGP8::FindLabelStart(Head& head, Head& default_pos, bool mark_execu
   }
   
   cCPUMemory& memory = head.GetMemory();
+  const cLabelIndex& labels = memory.GetLabelIndex(*m_inst_set);
   int pos = 0;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
+  // Visit each 'label' instruction in turn
+  while ((pos = labels.NextLabel(pos)) < memory.GetSize()) {
+    pos++;
+    
+    // Check for direct matched label pattern, can be substring of 'label'ed target
+    // - must match all NOPs in search_label
+    // - extra NOPs in 'label'ed target are ignored
+    int size_matched = 0;
+    while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
+      if (!labels.IsNop(pos) || search_label[size_matched] != labels.GetNopMod(pos)) break;
+      size_matched++;
       pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        head.SetPosition(pos - 1);
-        return;
+    }
+    
+    // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
+    if (size_matched == search_label.GetSize()) {
+      // Return Head pointed at last NOP of label sequence
+      if (mark_executed) {
+        size_matched++; // Increment size matched so that it includes the label instruction
+        const int start = pos - size_matched;
+        const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+        for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
       }
-      
-      continue; 
+      head.SetPosition(pos - 1);
+      return;
     }
-    pos++;
   }
   
   // Return start point if not found
@@ -893,32 +904,31 @@ void cHardwareGP8::FindNopSequenceStart(Head& head, Head& default_pos, bool mark
   }
   
   cCPUMemory& memory = head.GetMemory();
+  const cLabelIndex& labels = memory.GetLabelIndex(*m_inst_set);
   int pos = 0;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsNop(memory[pos])) { // start of sequence found
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        head.SetPosition(pos - 1);
-        return;
+  // Visit each nop in turn (other than those passed over while matching)
+  while ((pos = labels.NextNop(pos)) < memory.GetSize()) {
+    // Check for direct matched label pattern, can be substring of 'label'ed target
+    // - must match all NOPs in search_label
+    // - extra NOPs in 'label'ed target are ignored
+    int size_matched = 0;
+    while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
+      if (!labels.IsNop(pos) || search_label[size_matched] != labels.GetNopMod(pos)) break;
+      size_matched++;
+      pos++;
+    }
+    
+    // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
+    if (size_matched == search_label.GetSize()) {
+      // Return Head pointed at last NOP of label sequence
+      if (mark_executed) {
+        const int start = pos - size_matched;
+        const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
+        for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
       }
+      head.SetPosition(pos - 1);
+      return;
     }
     pos++;
   }
@@ -940,11 +950,13 @@ void cHardwareGP8::FindLabelForward(Head& head, Head& default_pos, bool mark_exe
   
   head.Adjust();
   
+  const cLabelIndex& labels = head.GetMemory().GetLabelIndex(*m_inst_set);
+  
   Head pos(head);
   pos++;
   
   while (pos.Position() != head.Position()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
+    if (labels.IsLabel(pos.Position())) { // starting label found
       const int label_start = pos.Position();
       pos++;
       
@@ -953,7 +965,7 @@ void cHardwareGP8::FindLabelForward(Head& head, Head& default_pos, bool mark_exe
       // - extra NOPs in 'label'ed target are ignored
       int size_matched = 0;
       while (size_matched < search_label.GetSize() && pos.Position() != head.Position()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
+        if (!labels.IsNop(pos.Position()) || search_label[size_matched] != labels.GetNopMod(pos.Position())) break;
         size_matched++;
         pos++;
       }
@@ -976,7 +988,10 @@ void cHardwareGP8::FindLabelForward(Head& head, Head& default_pos, bool mark_exe
       
       continue; 
     }
+    
+    // Skip ahead to the next 'label' instruction (or back around to the starting point)
     pos++;
+    pos.SetAbsPosition(labels.NextLabel(pos.Position(), head.Position()));
   }
   
   // Return start point if not found
@@ -1051,11 +1066,13 @@ void cHardwareGP8::FindNopSequenceForward(Head& head, Head& default_pos, bool ma
   
   head.Adjust();
   
+  const cLabelIndex& labels = head.GetMemory().GetLabelIndex(*m_inst_set);
+  
   Head pos(head);
   pos++;
   
   while (pos.Position() != head.Position()) {
-    if (m_inst_set->IsNop(pos.GetInst())) { // starting label found
+    if (labels.IsNop(pos.Position())) { // starting label found
       const int label_start = pos.Position();
       
       // Check for direct matched nop sequence, can be substring of target
@@ -1063,7 +1080,7 @@ void cHardwareGP8::FindNopSequenceForward(Head& head, Head& default_pos, bool ma
       // - extra NOPs in target are ignored
       int size_matched = 0;
       while (size_matched < search_label.GetSize() && pos.Position() != head.Position()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
+        if (!labels.IsNop(pos.Position()) || search_label[size_matched] != labels.GetNopMod(pos.Position())) break;
         size_matched++;
         pos++;
       }
@@ -1086,7 +1103,10 @@ void cHardwareGP8::FindNopSequenceForward(Head& head, Head& default_pos, bool ma
     }
     
     if (pos.Position() == head.Position()) break;
+    
+    // Skip ahead to the next nop (or back around to the starting point)
     pos++;
+    pos.SetAbsPosition(labels.NextNop(pos.Position(), head.Position()));
   }
   
   // Return start point if not found
@@ -117,6 +117,7 @@ private:
       { m_hw = hw; m_pos = pos; m_ms = ms; m_is_gene = is_gene; }
     
     inline cCPUMemory& GetMemory() { return (m_is_gene) ? m_hw->m_genes[m_ms].memory : m_hw->m_mem_array[m_ms]; }
+    inline const cCPUMemory& GetMemory() const { return (m_is_gene) ? m_hw->m_genes[m_ms].memory : m_hw->m_mem_array[m_ms]; }
     
     inline void Adjust();
     
@@ -135,12 +136,12 @@ private:
     
     inline void Advance() { m_pos++; Adjust(); }
     
-    inline const Instruction& GetInst() { return GetMemory()[m_pos]; }
-    inline const Instruction& GetInst(int offset) { return GetMemory()[m_pos + offset]; }
+    inline const Instruction& GetInst() const { return GetMemory()[m_pos]; }
+    inline const Instruction& GetInst(int offset) const { return GetMemory()[m_pos + offset]; }
     inline Instruction NextInst();
     inline Instruction PrevInst();
     
-    inline void SetInst(const Instruction& value) { GetMemory()[m_pos] = value; }
+    inline void SetInst(const Instruction& value) { GetMemory().SetInst(m_pos, value); }
     inline void InsertInst(const Instruction& inst) { GetMemory().Insert(m_pos, inst); }
     inline void RemoveInst() { GetMemory().Remove(m_pos); }
     
@@ -321,6 +322,7 @@ private:
 public:
   cHardwareGP8(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareGP8() { ; }
+  void Recycle(cAvidaContext& ctx, cOrganism* in_organism);
   
   static cInstLib* GetInstLib() { return s_inst_slib; }
   
@@ -336,6 +338,7 @@ public:
   void PrintStatus(std::ostream& fp);
   void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp);
+  bool RecordMiniTraceStatus(cAvidaContext& ctx, Output::TraceFormat::sStatus& status);
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success);
   
   // --------  Stack Manipulation  --------
@@ -728,12 +731,14 @@ inline bool cHardwareGP8::Head::operator==(const Head& rhs) const
 
 inline Instruction cHardwareGP8::Head::PrevInst()
 {
-  return (AtFront()) ? GetMemory()[GetMemory().GetSize() - 1] : GetMemory()[m_pos - 1];
+  const cCPUMemory& memory = GetMemory();
+  return (AtFront()) ? memory[memory.GetSize() - 1] : memory[m_pos - 1];
 }
 
 inline Instruction cHardwareGP8::Head::NextInst()
 {
-  return (AtEnd()) ? m_hw->GetInstSet().GetInstError() : GetMemory()[m_pos + 1];
+  const cCPUMemory& memory = GetMemory();
+  return (AtEnd()) ? m_hw->GetInstSet().GetInstError() : memory[m_pos + 1];
 }
 
 
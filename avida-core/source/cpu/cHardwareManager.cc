@@ -43,7 +43,7 @@ using namespace Avida;
 static const Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
 
 cHardwareManager::cHardwareManager(cWorld* world)
-: m_world(world)
+: m_world(world), m_pool_size(world->GetConfig().HARDWARE_POOL_SIZE.Get())
 {
   cString filename = world->GetConfig().INST_SET.Get();
   m_is_name_map.Set("(default)", 0);
@@ -52,6 +52,10 @@ cHardwareManager::cHardwareManager(cWorld* world)
 
 cHardwareManager::~cHardwareManager()
 {
+  for (int i = 0; i < m_hw_pools.GetSize(); i++) {
+    for (int j = 0; j < m_hw_pools[i]->idle.GetSize(); j++) delete m_hw_pools[i]->idle[j];
+    delete m_hw_pools[i];
+  }
   for (int i = 0; i < m_inst_sets.GetSize(); i++) delete m_inst_sets[i];
 }
 
@@ -147,9 +151,11 @@ bool cHardwareManager::loadInstSet(int hw_type, const Apto::String& name, int st
       return false;
   }  
   if (!inst_set->LoadWithStringList(sl, feedback)) return false;
+  if (hw_type == HARDWARE_TYPE_CPU_ORIGINAL) cHardwareCPU::DecodeInstSet(*inst_set);
   
   int inst_set_id = m_inst_sets.GetSize();
   m_inst_sets.Push(inst_set);
+  m_hw_pools.Push(new sHardwarePool);
   m_is_name_map.Set(name, inst_set_id);
   
   Apto::Array<cString> names(inst_set->GetSize());
@@ -256,6 +262,24 @@ cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, cons
   }
   
   cHardwareBase* hw = 0;
+  if (m_pool_size > 0) {
+    sHardwarePool& pool = *m_hw_pools[inst_set_id];
+    pool.mutex.Lock();
+    if (pool.idle.GetSize()) {
+      hw = pool.idle.Pop();
+      pool.stats.reused++;
+      pool.stats.idle--;
+    } else {
+      pool.stats.allocated++;
+    }
+    pool.mutex.Unlock();
+    
+    if (hw) {
+      hw->Recycle(ctx, org);
+      return hw;
+    }
+  }
+  
   switch (inst_set->GetHardwareType()) {
     case HARDWARE_TYPE_CPU_ORIGINAL:
       hw = new cHardwareCPU(ctx, m_world, org, inst_set);
@@ -282,12 +306,53 @@ cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, cons
   return hw;
 }
 
+void cHardwareManager::Release(cHardwareBase* hw)
+{
+  if (hw == NULL) return;
+  
+  if (m_pool_size > 0) {
+    for (int i = 0; i < m_inst_sets.GetSize(); i++) {
+      if (m_inst_sets[i] != &hw->GetInstSet()) continue;
+      
+      sHardwarePool& pool = *m_hw_pools[i];
+      Apto::MutexAutoLock lock(pool.mutex);
+      if (pool.idle.GetSize() < m_pool_size) {
+        pool.idle.Push(hw);
+        pool.stats.returned++;
+        pool.stats.idle++;
+        return;
+      }
+      pool.stats.freed++;
+      break;
+    }
+  }
+  
+  delete hw;
+}
+
+cHardwareManager::sPoolStats cHardwareManager::GetPoolStats() const
+{
+  sPoolStats total;
+  total.allocated = 0; total.reused = 0; total.returned = 0; total.freed = 0; total.idle = 0;
+  for (int i = 0; i < m_hw_pools.GetSize(); i++) {
+    Apto::MutexAutoLock lock(m_hw_pools[i]->mutex);
+    const sPoolStats& stats = m_hw_pools[i]->stats;
+    total.allocated += stats.allocated;
+    total.reused += stats.reused;
+    total.returned += stats.returned;
+    total.freed += stats.freed;
+    total.idle += stats.idle;
+  }
+  return total;
+}
+
 bool cHardwareManager::RegisterInstSet(const Apto::String& name, cInstSet* inst_set)
 {
   if (m_is_name_map.Has(name)) return false;
   
   int inst_set_id = m_inst_sets.GetSize();
   m_inst_sets.Push(inst_set);
+  m_hw_pools.Push(new sHardwarePool);
   m_is_name_map.Set(name, inst_set_id);  
   
   return true;
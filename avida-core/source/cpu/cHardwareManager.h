@@ -22,6 +22,8 @@
 #ifndef cHardwareManager_h
 #define cHardwareManager_h
 
+#include "apto/core.h"
+
 #include "cTestCPU.h"
 
 namespace Avida {
@@ -42,10 +44,34 @@ using namespace Avida;
 
 class cHardwareManager
 {
+public:
+  // Cumulative hardware pool counters, summed over all instruction sets
+  struct sPoolStats
+  {
+    int allocated;      // hardware constructed by Create
+    int reused;         // pooled hardware handed out by Create
+    int returned;       // hardware placed in a pool by Release
+    int freed;          // hardware deleted by Release
+    int idle;           // hardware currently held in the pools
+  };
+
 private:
+  // Idle hardware for one instruction set, which fixes the hardware type.  Organisms, with their embedded phenotypes,
+  // are pooled separately by cOrganismPool.
+  struct sHardwarePool
+  {
+    Apto::Mutex mutex;
+    Apto::Array<cHardwareBase*, Apto::Smart> idle;
+    sPoolStats stats;
+
+    sHardwarePool() { stats.allocated = 0; stats.reused = 0; stats.returned = 0; stats.freed = 0; stats.idle = 0; }
+  };
+
   cWorld* m_world;
   Apto::Array<cInstSet*> m_inst_sets;
+  Apto::Array<sHardwarePool*> m_hw_pools;     // parallel to m_inst_sets
   Apto::Map<Apto::String, int> m_is_name_map;
+  const int m_pool_size;
 
   
   cHardwareManager(); // @not_implemented
@@ -64,7 +90,11 @@ public:
   bool LoadInstSets(cUserFeedback* feedback = NULL);
   bool ConvertLegacyInstSetFile(cString filename, cStringList& str_list, cUserFeedback* feedback = NULL);
   
+  // Hardware is taken from the instruction set's pool when HARDWARE_POOL_SIZE is enabled, and must be handed back
+  // through Release rather than deleted
   cHardwareBase* Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg);
+  void Release(cHardwareBase* hw);
+  sPoolStats GetPoolStats() const;
   inline cTestCPU* CreateTestCPU(cAvidaContext& ctx) { return new cTestCPU(ctx, m_world); }
 
   inline bool IsInstSet(const Apto::String& name) const { return m_is_name_map.Has(name); }
@@ -148,6 +148,22 @@ cHardwareTransSMT::cHardwareTransSMT(cAvidaContext& ctx, cWorld* world, cOrganis
   Reset(ctx);                            // Setup the rest of the hardware...
 }
 
+void cHardwareTransSMT::Recycle(cAvidaContext& ctx, cOrganism* in_organism)
+{
+  recycleBase(in_organism);
+  
+  const Genome& org = in_organism->GetGenome();
+  ConstInstructionSequencePtr org_seq_p;
+  org_seq_p.DynamicCastFrom(org.Representation());
+  const InstructionSequence& org_genome = *org_seq_p;  
+
+  m_mem_array.Resize(1);
+  m_mem_array[0] = org_genome;
+  m_mem_array[0].Resize(m_mem_array[0].GetSize() + 1);
+  m_mem_array[0][m_mem_array[0].GetSize() - 1] = Instruction();
+  Reset(ctx);
+}
+
 void cHardwareTransSMT::internalReset()
 {
   // Setup the memory...
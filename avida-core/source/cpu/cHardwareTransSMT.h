@@ -180,6 +180,7 @@ protected:
 public:
   cHardwareTransSMT(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareTransSMT() { ; }
+  void Recycle(cAvidaContext& ctx, cOrganism* in_organism);
 
   static cInstLib* GetInstLib() { return s_inst_slib; }
   static cString GetDefaultInstFilename() { return "instset-transsmt.cfg"; }
@@ -22,9 +22,27 @@
 
 #include "cHeadCPU.h"
 
+#include "cStateArchive.h"
+
 #include <cassert>
 
 
+void cHeadCPU::CheckpointState(cStateArchive& ar)
+{
+  // The position is restored as saved, without adjustment, since heads may legitimately rest just past the end of memory
+  ar.Tag("cHeadCPU");
+  ar.Transfer(m_position);
+  ar.Transfer(m_mem_space);
+  if (ar.IsLoading() && ar.IsGood()) {
+    if (m_mem_space < 0 || m_mem_space >= m_hardware->GetNumMemSpaces()) {
+      ar.Fail("invalid head memory space in checkpoint");
+      return;
+    }
+    m_cached_ms = m_mem_space;
+    m_memory = &m_hardware->GetMemory(m_mem_space);
+  }
+}
+
 void cHeadCPU::fullAdjust(int mem_size)
 {
   assert(m_mem_space >= 0);
@@ -34,6 +34,7 @@
  **/
 
 class cCodeLabel;
+class cStateArchive;
 class cString;
 
 using namespace Avida;
@@ -70,6 +71,7 @@ public:
   inline void SetFullLocation(int loc) { m_position = loc & 0xFFFFFF; m_mem_space = (loc >> 24); Adjust(); }
   inline void Set(const cHeadCPU& in_head) { m_position = in_head.m_position; m_mem_space = in_head.m_mem_space; }
   inline void AbsSet(int new_pos) { m_position = new_pos; }
+  void CheckpointState(cStateArchive& ar);
 
   inline void Jump(int jump) { m_position += jump; Adjust(); }
   inline void AbsJump(int jump) { m_position += jump; }
@@ -83,7 +85,7 @@ public:
   inline Instruction GetPrevInst() const;
   inline Instruction GetNextInst() const;
 
-  inline void SetInst(const Instruction& value) { GetMemory()[m_position] = value; }
+  inline void SetInst(const Instruction& value) { GetMemory().SetInst(m_position, value); }
   inline void InsertInst(const Instruction& inst) { GetMemory().Insert(m_position, inst); }
   inline void RemoveInst() { GetMemory().Remove(m_position); }
 
@@ -53,8 +53,15 @@ cInstSet::cInstSet(const cInstSet& _in)
   , m_has_choosy_female_costs(_in.m_has_choosy_female_costs)
   , m_has_post_costs(_in.m_has_post_costs)
   , m_has_bonus_costs(_in.m_has_bonus_costs)
+  , m_has_prob_fail(_in.m_has_prob_fail)
+  , m_has_addl_time_costs(_in.m_has_addl_time_costs)
+  , m_revision(0)
+  , m_decoded((_in.m_decoded) ? _in.m_decoded->Create() : NULL)
+  , m_stack_size(_in.m_stack_size)
+  , m_uops_per_cycle(_in.m_uops_per_cycle)
 {
   m_mutation_index = new cOrderedWeightedIndex(*_in.m_mutation_index);
+  decode();
 }
 
 cInstSet& cInstSet::operator=(const cInstSet& _in)
@@ -74,6 +81,15 @@ cInstSet& cInstSet::operator=(const cInstSet& _in)
   m_has_choosy_female_costs = _in.m_has_choosy_female_costs;
   m_has_post_costs = _in.m_has_post_costs;
   m_has_bonus_costs = _in.m_has_bonus_costs;
+  m_has_prob_fail = _in.m_has_prob_fail;
+  m_has_addl_time_costs = _in.m_has_addl_time_costs;
+  m_stack_size = _in.m_stack_size;
+  m_uops_per_cycle = _in.m_uops_per_cycle;
+  
+  // Decoded data is rebuilt in place, hardware running this set may hold pointers into it
+  m_revision++;
+  if (m_decoded == NULL && _in.m_decoded != NULL) m_decoded = _in.m_decoded->Create();
+  decode();
 
   m_mutation_index = new cOrderedWeightedIndex(*_in.m_mutation_index);
   return *this;
@@ -115,6 +131,8 @@ Instruction cInstSet::ActivateNullInst()
   m_lib_name_map[inst_id].fem_res_cost = 0.0; 
   m_lib_name_map[inst_id].post_cost = 0;
   m_lib_name_map[inst_id].bonus_cost = 0.0;
+  m_revision++;
+  decode();
   
   return Instruction(inst_id);
 }
@@ -250,6 +268,8 @@ bool cInstSet::LoadWithStringList(const cStringList& sl, cUserFeedback* feedback
     if (m_lib_name_map[inst_id].choosy_female_cost) m_has_choosy_female_costs = true;
     if (m_lib_name_map[inst_id].post_cost > 1) m_has_post_costs = true;
     if (m_lib_name_map[inst_id].bonus_cost) m_has_bonus_costs = true;
+    if (m_lib_name_map[inst_id].prob_fail > 0.0) m_has_prob_fail = true;
+    if (m_lib_name_map[inst_id].addl_time_cost) m_has_addl_time_costs = true;
     
     // Parse the instruction code
     cString inst_code = args->GetString(0);
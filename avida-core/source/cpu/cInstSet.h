@@ -52,6 +52,18 @@ const int MAX_INSTSET_SIZE = 255;
 class cInstSet
 {
 public:
+  // Hardware specific data derived from the instruction set, such as a pre-decoded dispatch table (owned by the set).
+  // It is built when the set is loaded and rebuilt in place whenever the instructions change, since hardware keeps
+  // pointers into it.
+  class cDecoded
+  {
+  public:
+    virtual ~cDecoded() { ; }
+    
+    virtual cDecoded* Create() const = 0;  // new, not yet decoded, instance of the same type
+    virtual void Decode(const cInstSet& inst_set) = 0;
+  };
+  
   cWorld* m_world;
   cString m_name;
   int m_hw_type;
@@ -88,21 +100,29 @@ public:
   bool m_has_choosy_female_costs;
   bool m_has_post_costs;
   bool m_has_bonus_costs;
+  bool m_has_prob_fail;
+  bool m_has_addl_time_costs;
+  
+  int m_revision;           // incremented whenever instruction properties change after loading
+  cDecoded* m_decoded;
   
   int m_stack_size;
   int m_uops_per_cycle;
   
   cInstSet(); // @not_implemented
+  
+  void decode() { if (m_decoded) m_decoded->Decode(*this); }
 
 public:
   inline cInstSet(cWorld* world, const cString& name, int hw_type, cInstLib* inst_lib, int stack_size, int uops_per_cycle)
     : m_world(world), m_name(name), m_hw_type(hw_type), m_inst_lib(inst_lib), m_mutation_index(NULL)
     , m_has_costs(false), m_has_ft_costs(false), m_has_energy_costs(false), m_has_res_costs(false), m_has_fem_res_costs(false)
-    , m_has_female_costs(false), m_has_choosy_female_costs(false), m_has_post_costs(false), m_has_bonus_costs(false), m_stack_size(stack_size)
+    , m_has_female_costs(false), m_has_choosy_female_costs(false), m_has_post_costs(false), m_has_bonus_costs(false)
+    , m_has_prob_fail(false), m_has_addl_time_costs(false), m_revision(0), m_decoded(NULL), m_stack_size(stack_size)
     , m_uops_per_cycle(uops_per_cycle) { ; }
   cInstSet(const cInstSet&); 
   cInstSet& operator=(const cInstSet&); 
-  inline ~cInstSet() { if (m_mutation_index != NULL) delete m_mutation_index; }
+  inline ~cInstSet() { if (m_mutation_index != NULL) delete m_mutation_index; delete m_decoded; }
   
   const cString& GetInstSetName() const { return m_name; }
   int GetHardwareType() const { return m_hw_type; }
@@ -148,6 +168,12 @@ public:
   bool HasChoosyFemaleCosts() const { return m_has_choosy_female_costs; }
   bool HasPostCosts() const { return m_has_post_costs; }
   bool HasBonusCosts() const { return m_has_bonus_costs; }
+  bool HasProbFail() const { return m_has_prob_fail; }
+  bool HasAddlTimeCosts() const { return m_has_addl_time_costs; }
+  
+  int GetRevision() const { return m_revision; }
+  const cDecoded* GetDecoded() const { return m_decoded; }
+  void SetDecoded(cDecoded* decoded) { delete m_decoded; m_decoded = decoded; decode(); }
   
   int GetStackSize() const { return m_stack_size; }
   int GetUOpsPerCycle() const { return m_uops_per_cycle; }
@@ -168,8 +194,18 @@ public:
   Instruction ActivateNullInst();
   
   // Modification of instructions during run.
-  void SetProbFail(const Instruction& inst, double _prob_fail) { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; }
-  void SetRedundancy(const Instruction& inst, int _redundancy) { m_lib_name_map[inst.GetOp()].redundancy = _redundancy; m_mutation_index->SetWeight(inst.GetOp(), _redundancy);}
+  void SetProbFail(const Instruction& inst, double _prob_fail)
+  {
+    m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail;
+    if (_prob_fail > 0.0) m_has_prob_fail = true;
+    m_revision++;
+  }
+  void SetRedundancy(const Instruction& inst, int _redundancy)
+  {
+    m_lib_name_map[inst.GetOp()].redundancy = _redundancy;
+    m_mutation_index->SetWeight(inst.GetOp(), _redundancy);
+    m_revision++;
+  }
 
   // accessors for instruction library
   cInstLib* GetInstLib() { return m_inst_lib; }
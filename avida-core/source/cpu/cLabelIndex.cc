@@ -0,0 +1,169 @@
+/*
+ *  cLabelIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cLabelIndex.h"
+
+#include "cCodeLabel.h"
+#include "cInstSet.h"
+
+#include <cassert>
+
+
+void cLabelIndex::Build(const InstructionSequence& seq, const cInstSet& inst_set)
+{
+  m_inst_set = &inst_set;
+  m_size = seq.GetSize();
+
+  const int num_words = (m_size + 63) / 64;
+  m_nop_bits.Resize(num_words);
+  m_label_bits.Resize(num_words);
+  m_nop_bits.SetAll(0);
+  m_label_bits.SetAll(0);
+  m_nop_mods.Resize(m_size);
+
+  for (int i = 0; i < m_size; i++) setSite(i, seq[i]);
+}
+
+
+void cLabelIndex::Update(int pos, const Instruction& inst)
+{
+  assert(m_inst_set != NULL && pos >= 0 && pos < m_size);
+
+  const uint64_t bit = (uint64_t)1 << (pos & 63);
+  m_nop_bits[pos >> 6] &= ~bit;
+  m_label_bits[pos >> 6] &= ~bit;
+  setSite(pos, inst);
+}
+
+
+void cLabelIndex::setSite(int pos, const Instruction& inst)
+{
+  const uint64_t bit = (uint64_t)1 << (pos & 63);
+  if (m_inst_set->IsNop(inst)) {
+    m_nop_bits[pos >> 6] |= bit;
+    m_nop_mods[pos] = m_inst_set->GetNopMod(inst);
+  } else {
+    m_nop_mods[pos] = -1;
+  }
+  if (m_inst_set->IsLabel(inst)) m_label_bits[pos >> 6] |= bit;
+}
+
+
+int cLabelIndex::nextSet(const Apto::Array<uint64_t>& bits, int pos) const
+{
+  if (pos >= m_size) return m_size;
+
+  int word = pos >> 6;
+  uint64_t cur = bits[word] & (~(uint64_t)0 << (pos & 63));
+  while (!cur) {
+    if (++word == bits.GetSize()) return m_size;
+    cur = bits[word];
+  }
+
+  int found = word << 6;
+  while (!(cur & 1)) {
+    cur >>= 1;
+    found++;
+  }
+  return found;  // bits past the end are never set
+}
+
+int cLabelIndex::nextSetCircular(const Apto::Array<uint64_t>& bits, int pos, int stop) const
+{
+  if (pos == stop) return stop;
+
+  if (pos < stop) {
+    const int found = nextSet(bits, pos);
+    return (found < stop) ? found : stop;
+  }
+
+  // Through the end of the sequence, then around from the start
+  const int found = nextSet(bits, pos);
+  if (found < m_size) return found;
+  const int wrapped = nextSet(bits, 0);
+  return (wrapped < stop) ? wrapped : stop;
+}
+
+
+int cLabelIndex::PrevNop(int pos) const
+{
+  if (pos < 0) return -1;
+  if (pos >= m_size) pos = m_size - 1;
+
+  int word = pos >> 6;
+  uint64_t cur = m_nop_bits[word];
+  if ((pos & 63) != 63) cur &= ((uint64_t)1 << ((pos & 63) + 1)) - 1;
+  while (!cur) {
+    if (--word < 0) return -1;
+    cur = m_nop_bits[word];
+  }
+
+  int found = (word << 6) + 63;
+  while (!(cur & ((uint64_t)1 << 63))) {
+    cur <<= 1;
+    found--;
+  }
+  return found;
+}
+
+
+int cLabelIndex::NopRunStart(int pos) const
+{
+  assert(IsNop(pos));
+
+  while (pos > 0) {
+    // Whole words of nops are skipped at once
+    if ((pos & 63) == 0 && m_nop_bits[(pos >> 6) - 1] == ~(uint64_t)0) {
+      pos -= 64;
+      continue;
+    }
+    if (!IsNop(pos - 1)) break;
+    pos--;
+  }
+  return pos;
+}
+
+int cLabelIndex::NopRunEnd(int pos) const
+{
+  assert(IsNop(pos));
+
+  pos++;
+  while (pos < m_size) {
+    // Whole words of nops are skipped at once (bits past the end are never set)
+    if ((pos & 63) == 0 && m_nop_bits[pos >> 6] == ~(uint64_t)0) {
+      pos += 64;
+      continue;
+    }
+    if (!IsNop(pos)) break;
+    pos++;
+  }
+  return pos;
+}
+
+
+bool cLabelIndex::Matches(const cCodeLabel& label, int pos) const
+{
+  assert(pos >= 0 && pos + label.GetSize() <= m_size);
+
+  for (int i = 0; i < label.GetSize(); i++) {
+    if (label[i] != m_nop_mods[pos + i]) return false;
+  }
+  return true;
+}
@@ -0,0 +1,90 @@
+/*
+ *  cLabelIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cLabelIndex_h
+#define cLabelIndex_h
+
+#include "avida/core/InstructionSequence.h"
+
+#include <stdint.h>
+
+class cCodeLabel;
+class cInstSet;
+
+using namespace Avida;
+
+
+// cLabelIndex - nop and label instruction positions of a sequence under an instruction set
+//
+// One bit per site marks the nops, another the label instructions, so that searches skip 64 sites at a time through
+// code without any; the nop modifier of every nop is kept alongside.  Kept by cCPUMemory, see
+// cCPUMemory::GetLabelIndex().  Searches do not wrap around the end of the sequence unless given a stop position.
+
+class cLabelIndex
+{
+private:
+  const cInstSet* m_inst_set;
+  int m_size;
+  Apto::Array<uint64_t> m_nop_bits;
+  Apto::Array<uint64_t> m_label_bits;
+  Apto::Array<int> m_nop_mods;          // -1 for sites that are not nops
+
+  cLabelIndex(const cLabelIndex&); // @not_implemented
+  cLabelIndex& operator=(const cLabelIndex&); // @not_implemented
+
+public:
+  cLabelIndex() : m_inst_set(NULL), m_size(0) { ; }
+
+  void Build(const InstructionSequence& seq, const cInstSet& inst_set);
+  void Update(int pos, const Instruction& inst);
+
+  const cInstSet* GetInstSet() const { return m_inst_set; }
+  int GetSize() const { return m_size; }
+
+  inline bool IsNop(int pos) const { return (m_nop_bits[pos >> 6] >> (pos & 63)) & 1; }
+  inline bool IsLabel(int pos) const { return (m_label_bits[pos >> 6] >> (pos & 63)) & 1; }
+  inline int GetNopMod(int pos) const { return m_nop_mods[pos]; }
+
+  // First nop (label instruction) at or after pos, or GetSize() if there is none
+  int NextNop(int pos) const { return nextSet(m_nop_bits, pos); }
+  int NextLabel(int pos) const { return nextSet(m_label_bits, pos); }
+
+  // First nop (label instruction) walking forward from pos and around the end of the sequence, or stop if that is
+  // reached first
+  int NextNop(int pos, int stop) const { return nextSetCircular(m_nop_bits, pos, stop); }
+  int NextLabel(int pos, int stop) const { return nextSetCircular(m_label_bits, pos, stop); }
+
+  // Last nop at or before pos, or -1 if there is none
+  int PrevNop(int pos) const;
+
+  // Bounds of the run of nops containing pos: its first site, and the first site past it
+  int NopRunStart(int pos) const;
+  int NopRunEnd(int pos) const;
+
+  // True when the nops at pos onward spell out label (which must fit in the sequence)
+  bool Matches(const cCodeLabel& label, int pos) const;
+
+private:
+  void setSite(int pos, const Instruction& inst);
+  int nextSet(const Apto::Array<uint64_t>& bits, int pos) const;
+  int nextSetCircular(const Apto::Array<uint64_t>& bits, int pos, int stop) const;
+};
+
+#endif
@@ -32,6 +32,7 @@
 #include "cHardwareTracer.h"
 #include "cInstSet.h"
 #include "cOrganism.h"
+#include "cOrganismPool.h"
 #include "cPhenotype.h"
 #include "cResource.h"
 #include "cResourceCount.h"
@@ -39,6 +40,7 @@
 #include "cResourceLib.h"
 #include "cStringUtil.h"
 #include "cTestCPUInterface.h"
+#include "cTestResultCache.h"
 #include "cWorld.h"
 #include "tMatrix.h"
 
@@ -223,6 +225,66 @@ bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Gen
   return test_info.is_viable;
 }
 
+bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, cCPUTestResult& result)
+{
+  cTestResultCache* cache = m_world->GetTestResultCache();
+  if (!cache) {
+    TestGenome(ctx, test_info, genome);
+    result.Set(test_info);
+    return result.IsViable();
+  }
+  
+  if (!IsCacheable(test_info, genome)) {
+    cache->CountUncacheable();
+    TestGenome(ctx, test_info, genome);
+    result.Set(test_info);
+    return result.IsViable();
+  }
+  
+  const uint64_t options = TestOptionsHash(test_info);
+  if (cache->Lookup(genome, options, result)) {
+    test_info.Clear();
+    return result.IsViable();
+  }
+  
+  TestGenome(ctx, test_info, genome);
+  result.Set(test_info);
+  cache->Store(genome, options, result);
+  return result.IsViable();
+}
+
+bool cTestCPU::IsCacheable(const cCPUTestInfo& test_info, const Genome& genome) const
+{
+  // Traces must see the organisms run, and resource histories are not part of the key
+  if (test_info.m_tracer || test_info.m_res_method != RES_INITIAL) return false;
+  
+  // Random inputs, receive values and mutations would make the result one sample of many
+  if (test_info.use_random_inputs || !test_info.m_mut_rates.IsZero()) return false;
+  if (!test_info.use_manual_inputs && !m_world->GetEnvironment().HasFixedInputs(false)) return false;
+  
+  // ...as would instructions that fail at random
+  const cInstSet& inst_set = m_world->GetHardwareManager().GetInstSet(genome.Properties().Get("instset").StringValue());
+  if (inst_set.HasProbFail()) return false;
+  
+  return true;
+}
+
+uint64_t cTestCPU::TestOptionsHash(const cCPUTestInfo& test_info) const
+{
+  uint64_t hash = cTestResultCache::Mix(0, test_info.generation_tests);
+  hash = cTestResultCache::Mix(hash, test_info.m_cur_sg);
+  hash = cTestResultCache::Mix(hash, m_test_solo_res);
+  hash = cTestResultCache::MixDouble(hash, m_test_solo_res_lev);
+  hash = cTestResultCache::Mix(hash, test_info.use_manual_inputs);
+  if (test_info.use_manual_inputs) {
+    hash = cTestResultCache::Mix(hash, test_info.manual_inputs.GetSize());
+    for (int i = 0; i < test_info.manual_inputs.GetSize(); i++) {
+      hash = cTestResultCache::Mix(hash, test_info.manual_inputs[i]);
+    }
+  }
+  return hash;
+}
+
 bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth)
 {
   assert(cur_depth < test_info.generation_tests);
@@ -251,9 +313,9 @@ bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, cons
 
   // Setup the organism we're working with now.
   if (test_info.org_array[cur_depth] != NULL) {
-    delete test_info.org_array[cur_depth];
+    m_world->GetOrganismPool().Release(test_info.org_array[cur_depth]);
   }
-  cOrganism* organism = new cOrganism(m_world, ctx, genome, -1, Systematics::Source(Systematics::DIVISION, "", true));
+  cOrganism* organism = m_world->GetOrganismPool().Create(ctx, genome, -1, Systematics::Source(Systematics::DIVISION, "", true));
   
   // Copy the test mutation rates
   organism->MutationRates().Copy(test_info.MutationRates());
@@ -70,6 +70,8 @@ private:
 
   bool ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int cur_depth);
   bool TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth);
+  bool IsCacheable(const cCPUTestInfo& test_info, const Genome& genome) const;
+  uint64_t TestOptionsHash(const cCPUTestInfo& test_info) const;
 
   
   cTestCPU(); // @not_implemented
@@ -89,6 +91,10 @@ public:
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome);
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, std::ofstream& out_fp);
   
+  // Only the summary result is kept, which lets the test be answered from the world's test result cache (if enabled).
+  // When it is, test_info holds no test organisms afterwards.
+  bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, cCPUTestResult& result);
+  
   void PrintGenome(cAvidaContext& ctx, const Genome& genome, cString filename = "", int update = -1, bool for_groups = false, int last_birth_cell = 0, int last_group_id = -1, int last_forager_type = -1);
 
   inline int GetInput();
@@ -0,0 +1,441 @@
+/*
+ *  cTestResultCache.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cTestResultCache.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/core/Genome.h"
+#include "avida/core/InstructionSequence.h"
+#include "avida/core/Version.h"
+
+#include "apto/platform.h"
+
+#include "cAvidaConfig.h"
+#include "cCPUTestInfo.h"
+#include "cEnvironment.h"
+#include "cHardwareManager.h"
+#include "cInstSet.h"
+#include "cString.h"
+#include "cStringUtil.h"
+#include "cWorld.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if !APTO_PLATFORM(WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+
+static const char s_magic[8] = { 'A', 'V', 'I', 'D', 'A', 'T', 'R', 'C' };
+
+// Results depend on instruction semantics compiled into the binary, which no revision counter can see, so a table
+// file is only reused by the build that wrote it
+static void buildStamp(char (&stamp)[32])
+{
+  memset(stamp, 0, sizeof(stamp));
+  snprintf(stamp, sizeof(stamp), "%s %s %s", Avida::Version::String(), __DATE__, __TIME__);
+}
+
+// Settings that can not change the outcome of a test
+static const char* const s_context_skip[] = {
+  "VERBOSITY", "RANDOM_SEED", "ASYNC_OUTPUT_BLOCKS", "ORGANISM_STATS_METHOD", "ORGANISM_POOL_SIZE",
+  "HARDWARE_POOL_SIZE", "SENSOR_SKIP_METHOD", "LABEL_SEARCH_METHOD", "CHECKPOINT_SYNC_INTERVAL", "DATA_DIR",
+  "EVENT_FILE", "ANALYZE_FILE", "MAX_CONCURRENCY", "TEST_CACHE_SIZE", "TEST_CACHE_FILE", NULL
+};
+
+
+// FNV-1a over the bytes of a word, unrelated to Mix() so that testCheck() is independent of testKey()
+static inline uint64_t fnvWord(uint64_t h, uint64_t value)
+{
+  for (int i = 0; i < 8; i++) {
+    h ^= (value >> (8 * i)) & 0xFF;
+    h *= 0x100000001B3ull;
+  }
+  return h;
+}
+
+static inline uint64_t finalizeHash(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+
+cTestResultCache::cTestResultCache(cWorld* world)
+  : m_world(world), m_data(NULL), m_size(0), m_mapped(false), m_capacity(0), m_max_tasks(0), m_slot_size(0)
+  , m_context(0), m_config_revision(-1), m_num_inst_sets(-1), m_inst_set_revision(-1)
+{
+  m_stats.hits = 0;
+  m_stats.misses = 0;
+  m_stats.stores = 0;
+  m_stats.uncacheable = 0;
+}
+
+cTestResultCache::~cTestResultCache()
+{
+  close();
+}
+
+
+uint64_t cTestResultCache::Mix(uint64_t hash, uint64_t value)
+{
+  hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+  return hash ^ (hash >> 29);
+}
+
+uint64_t cTestResultCache::MixDouble(uint64_t hash, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(uint64_t));
+  return Mix(hash, bits);
+}
+
+
+bool cTestResultCache::Open(int capacity, const cString& path, Feedback& feedback)
+{
+  close();
+
+  if (path.GetSize()) {
+#if APTO_PLATFORM(WINDOWS)
+    feedback.Warning("test result cache files are not supported on this platform, keeping results in memory only");
+#else
+    if (openFile(capacity, path, feedback)) return true;
+    feedback.Warning("unable to use test result cache file '%s', keeping results in memory only", (const char*)path);
+#endif
+  }
+
+  if (capacity <= 0) {
+    feedback.Error("test result cache size must be positive");
+    return false;
+  }
+  setLayout(capacity, m_world->GetEnvironment().GetNumTasks());
+  m_data = reinterpret_cast<char*>(new uint64_t[m_size / sizeof(uint64_t)]);
+  memset(m_data, 0, m_size);
+  initHeader();
+  return true;
+}
+
+bool cTestResultCache::openFile(int capacity, const cString& path, Feedback& feedback)
+{
+#if APTO_PLATFORM(WINDOWS)
+  return false;
+#else
+  int fd = open((const char*)path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    feedback.Warning("unable to open test result cache file '%s'", (const char*)path);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // A new (empty) file is sized for the current environment; an existing one keeps its own layout
+  const bool created = (st.st_size == 0);
+  if (created) {
+    if (capacity <= 0) {
+      ::close(fd);
+      return false;
+    }
+    setLayout(capacity, m_world->GetEnvironment().GetNumTasks());
+    if (ftruncate(fd, m_size) != 0) {
+      feedback.Warning("unable to size test result cache file '%s'", (const char*)path);
+      ::close(fd);
+      return false;
+    }
+  } else {
+    m_size = st.st_size;
+  }
+
+  void* data = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    feedback.Warning("unable to map test result cache file '%s'", (const char*)path);
+    m_size = 0;
+    return false;
+  }
+  m_data = static_cast<char*>(data);
+  m_mapped = true;
+
+  if (created) {
+    initHeader();
+  } else if (!validate()) {
+    feedback.Warning("test result cache file '%s' is not valid, or was written by a different build or platform", (const char*)path);
+    close();
+    return false;
+  }
+  return true;
+#endif
+}
+
+bool cTestResultCache::validate()
+{
+  if (m_size < sizeof(sHeader)) return false;
+
+  const sHeader* header = reinterpret_cast<const sHeader*>(m_data);
+  if (memcmp(header->magic, s_magic, sizeof(s_magic)) != 0) return false;
+  if (header->byte_order != BYTE_ORDER_MARK || header->version != VERSION) return false;
+  char stamp[32];
+  buildStamp(stamp);
+  if (memcmp(header->build, stamp, sizeof(stamp)) != 0) return false;
+  if (header->capacity == 0) return false;
+
+  const size_t slot_size = (sizeof(sSlot) + (size_t)header->max_tasks * sizeof(int32_t) + 7) & ~(size_t)7;
+  if (header->slot_size != slot_size) return false;
+  if (m_size != sizeof(sHeader) + slot_size * header->capacity) return false;
+
+  setLayout(header->capacity, header->max_tasks);
+  return true;
+}
+
+void cTestResultCache::initHeader()
+{
+  sHeader* header = reinterpret_cast<sHeader*>(m_data);
+  memcpy(header->magic, s_magic, sizeof(s_magic));
+  header->version = VERSION;
+  header->byte_order = BYTE_ORDER_MARK;
+  header->capacity = m_capacity;
+  header->max_tasks = m_max_tasks;
+  header->slot_size = m_slot_size;
+  header->reserved = 0;
+  buildStamp(header->build);
+}
+
+void cTestResultCache::setLayout(int capacity, int max_tasks)
+{
+  m_capacity = capacity;
+  m_max_tasks = max_tasks;
+  m_slot_size = (sizeof(sSlot) + (size_t)max_tasks * sizeof(int32_t) + 7) & ~(size_t)7;
+  m_size = sizeof(sHeader) + m_slot_size * capacity;
+  m_slot_buf.Resize(m_slot_size / sizeof(uint64_t));
+}
+
+void cTestResultCache::close()
+{
+  if (m_data) {
+#if !APTO_PLATFORM(WINDOWS)
+    if (m_mapped) munmap(m_data, m_size);
+    else
+#endif
+    delete [] reinterpret_cast<uint64_t*>(m_data);
+  }
+  m_data = NULL;
+  m_size = 0;
+  m_mapped = false;
+  m_capacity = 0;
+}
+
+
+bool cTestResultCache::Lookup(const Genome& genome, uint64_t options, cCPUTestResult& result)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_data) return false;
+
+  const uint64_t key = testKey(genome, options);
+  const uint64_t check = testCheck(genome, options);
+  const int home = (int)(key % (uint64_t)m_capacity);
+  for (int i = 0; i < PROBE_LIMIT; i++) {
+    const sSlot* slot = slotAt((home + i) % m_capacity);
+    if (slot->key == 0) break;
+    if (slot->key != key) continue;
+
+    // Verify a private copy, another process may be writing this slot
+    memcpy(&m_slot_buf[0], slot, m_slot_size);
+    const sSlot* copy = reinterpret_cast<const sSlot*>(&m_slot_buf[0]);
+    if (copy->key != key || copy->checksum != slotChecksum() || copy->check != check ||
+        copy->genome_size != seq->GetSize() || copy->num_tasks < 0 || copy->num_tasks > m_max_tasks) {
+      break;
+    }
+
+    result.m_is_viable = (copy->is_viable != 0);
+    result.m_max_depth = copy->max_depth;
+    result.m_depth_found = copy->depth_found;
+    result.m_genotype_fitness = copy->genotype_fitness;
+    result.m_colony_fitness = copy->colony_fitness;
+    result.m_colony_merit = copy->colony_merit;
+    result.m_colony_gestation = copy->colony_gestation;
+    result.m_colony_tasks.Resize(copy->num_tasks);
+    const int32_t* tasks = reinterpret_cast<const int32_t*>(copy + 1);
+    for (int t = 0; t < copy->num_tasks; t++) result.m_colony_tasks[t] = tasks[t];
+
+    m_stats.hits++;
+    return true;
+  }
+
+  m_stats.misses++;
+  return false;
+}
+
+void cTestResultCache::Store(const Genome& genome, uint64_t options, const cCPUTestResult& result)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_data || result.m_colony_tasks.GetSize() > m_max_tasks) return;
+
+  const uint64_t key = testKey(genome, options);
+
+  memset(&m_slot_buf[0], 0, m_slot_size);
+  sSlot* entry = reinterpret_cast<sSlot*>(&m_slot_buf[0]);
+  entry->key = key;
+  entry->check = testCheck(genome, options);
+  entry->genome_size = seq->GetSize();
+  entry->is_viable = result.m_is_viable;
+  entry->max_depth = result.m_max_depth;
+  entry->depth_found = result.m_depth_found;
+  entry->genotype_fitness = result.m_genotype_fitness;
+  entry->colony_fitness = result.m_colony_fitness;
+  entry->colony_merit = result.m_colony_merit;
+  entry->colony_gestation = result.m_colony_gestation;
+  entry->num_tasks = result.m_colony_tasks.GetSize();
+  int32_t* tasks = reinterpret_cast<int32_t*>(entry + 1);
+  for (int t = 0; t < entry->num_tasks; t++) tasks[t] = result.m_colony_tasks[t];
+  entry->checksum = slotChecksum();
+
+  // Take the first free slot (or this key's old slot) in reach, otherwise replace whatever is in the home slot
+  const int home = (int)(key % (uint64_t)m_capacity);
+  int target = home;
+  for (int i = 0; i < PROBE_LIMIT; i++) {
+    const int index = (home + i) % m_capacity;
+    const uint64_t slot_key = slotAt(index)->key;
+    if (slot_key == 0 || slot_key == key) {
+      target = index;
+      break;
+    }
+  }
+  memcpy(slotAt(target), &m_slot_buf[0], m_slot_size);
+
+  m_stats.stores++;
+}
+
+void cTestResultCache::CountUncacheable()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  m_stats.uncacheable++;
+}
+
+
+cTestResultCache::sStats cTestResultCache::GetStats() const
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_stats;
+}
+
+
+void cTestResultCache::updateContext()
+{
+  cAvidaConfig& config = m_world->GetConfig();
+  const cHardwareManager& hw_mgr = m_world->GetHardwareManager();
+  int inst_set_revision = 0;
+  for (int i = 0; i < hw_mgr.GetNumInstSets(); i++) inst_set_revision += hw_mgr.GetInstSet(i).GetRevision();
+  if (config.GetRevision() == m_config_revision && hw_mgr.GetNumInstSets() == m_num_inst_sets &&
+      inst_set_revision == m_inst_set_revision) {
+    return;
+  }
+
+  // Every property of every instruction, since any of them can change how a test runs
+  uint64_t hash = config.Fingerprint(s_context_skip);
+  for (int i = 0; i < hw_mgr.GetNumInstSets(); i++) {
+    const cInstSet& inst_set = hw_mgr.GetInstSet(i);
+    hash = cStringUtil::Hash(inst_set.GetInstSetName(), hash);
+    hash = Mix(hash, inst_set.GetHardwareType());
+    hash = Mix(hash, inst_set.GetStackSize());
+    hash = Mix(hash, inst_set.GetUOpsPerCycle());
+    hash = Mix(hash, inst_set.GetNumNops());
+    for (int op = 0; op < inst_set.GetSize(); op++) {
+      Instruction inst(op);
+      hash = cStringUtil::Hash(inst_set.GetName(op), hash);
+      hash = Mix(hash, inst_set.GetRedundancy(inst));
+      hash = Mix(hash, inst_set.GetCost(inst));
+      hash = Mix(hash, inst_set.GetFTCost(inst));
+      hash = Mix(hash, inst_set.GetEnergyCost(inst));
+      hash = MixDouble(hash, inst_set.GetProbFail(inst));
+      hash = Mix(hash, inst_set.GetAddlTimeCost(inst));
+      hash = Mix(hash, inst_set.GetInstructionCode(inst));
+      hash = MixDouble(hash, inst_set.GetResCost(inst));
+      hash = MixDouble(hash, inst_set.GetFemResCost(inst));
+      hash = Mix(hash, inst_set.GetFemaleCost(inst));
+      hash = Mix(hash, inst_set.GetChoosyFemaleCost(inst));
+      hash = Mix(hash, inst_set.GetPostCost(inst));
+      hash = MixDouble(hash, inst_set.GetBonusCost(inst));
+    }
+  }
+
+  m_context = hash;
+  m_config_revision = config.GetRevision();
+  m_num_inst_sets = hw_mgr.GetNumInstSets();
+  m_inst_set_revision = inst_set_revision;
+}
+
+uint64_t cTestResultCache::testKey(const Genome& genome, uint64_t options)
+{
+  updateContext();
+
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+
+  uint64_t hash = Mix(m_context, m_world->GetEnvironment().GetFingerprint());
+  hash = Mix(hash, cStringUtil::Hash((const char*)genome.Properties().Get("instset").StringValue()));
+  hash = Mix(hash, genome.HardwareType());
+  hash = Mix(hash, seq->Hash());
+  hash = Mix(hash, seq->GetSize());
+  hash = finalizeHash(Mix(hash, options));
+  return (hash) ? hash : 1;  // 0 marks empty slots
+}
+
+uint64_t cTestResultCache::testCheck(const Genome& genome, uint64_t options)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+
+  // The inputs of testKey(), but hashed separately, and the sequence itself rather than its cached hash
+  uint64_t hash = fnvWord(0xCBF29CE484222325ull, m_context);
+  hash = fnvWord(hash, m_world->GetEnvironment().GetFingerprint());
+  hash = cStringUtil::Hash((const char*)genome.Properties().Get("instset").StringValue(), hash);
+  hash = fnvWord(hash, genome.HardwareType());
+  hash = fnvWord(hash, options);
+  const InstructionSequence& sequence = *seq;
+  for (int i = 0; i < sequence.GetSize(); i++) {
+    hash ^= sequence[i].GetOp();
+    hash *= 0x100000001B3ull;
+  }
+  return fnvWord(hash, sequence.GetSize());
+}
+
+uint64_t cTestResultCache::slotChecksum() const
+{
+  // Every word of the slot buffer except the checksum itself
+  uint64_t hash = Mix(0, m_slot_buf[0]);
+  for (int i = 2; i < m_slot_buf.GetSize(); i++) hash = Mix(hash, m_slot_buf[i]);
+  return finalizeHash(hash);
+}
@@ -0,0 +1,153 @@
+/*
+ *  cTestResultCache.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cTestResultCache_h
+#define cTestResultCache_h
+
+#include "avida/core/Types.h"
+
+#include "apto/core/Mutex.h"
+
+#include <stdint.h>
+
+class cCPUTestResult;
+class cString;
+class cWorld;
+
+using namespace Avida;
+
+
+// cTestResultCache - test CPU results, addressed by the content of everything that determines them
+//
+// Entries are keyed by a hash of the genome, its instruction set and hardware type, the environment (see
+// cEnvironment::GetFingerprint), the configuration and loaded instruction sets (with every per-instruction property),
+// and the options of the test.  Only tests whose outcome is fully determined by those are cached, see
+// cTestCPU::TestGenome.  Each slot also holds a second, independently computed hash of the same inputs, which must
+// match as well, so that a collision of keys does not return the result of another genome.
+//
+// The table is a fixed number of slots with short linear probing; when every slot in reach is taken the first one is
+// overwritten.  It is held either in memory or in a file mapped into memory, which is then shared with every other run
+// (or concurrent process) using the same file.  A checksum over each slot makes torn or stale slots read as misses.
+//
+// File layout, in host byte order (files written with a different byte order, or by a different build, are not used):
+//   sHeader
+//   sSlot + int32_t[max_tasks], padded to 8 bytes, times capacity
+
+class cTestResultCache
+{
+public:
+  struct sStats
+  {
+    uint64_t hits;          // tests answered from the table
+    uint64_t misses;        // cacheable tests that had to be run
+    uint64_t stores;        // results written to the table
+    uint64_t uncacheable;   // tests that could not use the table (tracing, random inputs, mutations, ...)
+  };
+
+private:
+  struct sHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t capacity;
+    uint32_t max_tasks;
+    uint32_t slot_size;
+    uint32_t reserved;
+    char build[32];         // version and compile time of the writing binary, see buildStamp()
+  };
+
+  struct sSlot
+  {
+    uint64_t key;           // 0 = empty
+    uint64_t checksum;      // over the rest of the slot, including the task counts that follow
+    uint64_t check;         // second hash of the test, see testCheck()
+    int32_t genome_size;
+    int32_t is_viable;
+    int32_t max_depth;
+    int32_t depth_found;
+    double genotype_fitness;
+    double colony_fitness;
+    double colony_merit;
+    int32_t colony_gestation;
+    int32_t num_tasks;
+  };
+
+  static const uint32_t VERSION = 3;
+  static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+  static const int PROBE_LIMIT = 8;
+
+  cWorld* m_world;
+
+  char* m_data;
+  size_t m_size;
+  bool m_mapped;
+  int m_capacity;
+  int m_max_tasks;
+  size_t m_slot_size;
+
+  mutable Apto::Mutex m_mutex;
+  Apto::Array<uint64_t> m_slot_buf;   // a slot is assembled and verified here, then copied in or out as a whole
+  uint64_t m_context;                 // configuration and instruction sets, see updateContext()
+  int m_config_revision;
+  int m_num_inst_sets;
+  int m_inst_set_revision;            // sum of the revisions of the loaded instruction sets
+  sStats m_stats;
+
+  cTestResultCache(); // @not_implemented
+  cTestResultCache(const cTestResultCache&); // @not_implemented
+  cTestResultCache& operator=(const cTestResultCache&); // @not_implemented
+
+public:
+  explicit cTestResultCache(cWorld* world);
+  ~cTestResultCache();
+
+  // Sets up a table of the given number of slots, in memory or, if a path is given, in that file.  An existing file
+  // keeps the layout it was created with; one that can not be used is reported and replaced by a table in memory.
+  bool Open(int capacity, const cString& path, Feedback& feedback);
+
+  int GetCapacity() const { return m_capacity; }
+  bool IsPersistent() const { return m_mapped; }
+
+  bool Lookup(const Genome& genome, uint64_t options, cCPUTestResult& result);
+  void Store(const Genome& genome, uint64_t options, const cCPUTestResult& result);
+  void CountUncacheable();
+
+  sStats GetStats() const;
+
+  // Hashing steps for building up test option values
+  static uint64_t Mix(uint64_t hash, uint64_t value);
+  static uint64_t MixDouble(uint64_t hash, double value);
+
+private:
+  void close();
+  bool openFile(int capacity, const cString& path, Feedback& feedback);
+  bool validate();
+  void initHeader();
+  void setLayout(int capacity, int max_tasks);
+
+  void updateContext();
+  uint64_t testKey(const Genome& genome, uint64_t options);
+  uint64_t testCheck(const Genome& genome, uint64_t options);
+  uint64_t slotChecksum() const;
+  inline sSlot* slotAt(int index) { return reinterpret_cast<sSlot*>(m_data + sizeof(sHeader) + m_slot_size * index); }
+};
+
+#endif
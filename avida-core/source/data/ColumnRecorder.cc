@@ -0,0 +1,89 @@
+/*
+ *  data/ColumnRecorder.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/data/ColumnRecorder.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/data/Package.h"
+
+
+Avida::Data::ColumnRecorder::ColumnRecorder(Output::ColumnFilePtr file, int interval)
+  : m_file(file), m_requested(new DataSet), m_interval((interval > 0) ? interval : 1)
+{
+}
+
+
+bool Avida::Data::ColumnRecorder::AddColumn(const Apto::String& column_spec, Feedback& feedback)
+{
+  DataID data_id = column_spec;
+  Output::ColumnFile::ColumnType type = Output::ColumnFile::DOUBLE_COLUMN;
+
+  for (int i = column_spec.GetSize() - 1; i >= 0; i--) {
+    if (column_spec[i] == ':') {
+      data_id = column_spec.Substring(0, i);
+      Apto::String type_str = column_spec.Substring(i + 1, column_spec.GetSize() - i - 1);
+      if (type_str == "int") type = Output::ColumnFile::INT_COLUMN;
+      else if (type_str == "double") type = Output::ColumnFile::DOUBLE_COLUMN;
+      else if (type_str == "string") type = Output::ColumnFile::STRING_COLUMN;
+      else {
+        feedback.Error("unknown column type '%s' for '%s'", (const char*)type_str, (const char*)data_id);
+        return false;
+      }
+      break;
+    }
+  }
+
+  const int column = m_file->AddColumn(data_id, type);
+  if (column < 0) {
+    feedback.Error("unable to add column '%s', rows have already been recorded", (const char*)data_id);
+    return false;
+  }
+
+  m_data_ids.Push(data_id);
+  m_columns.Push(column);
+  m_requested->Insert(data_id);
+  return true;
+}
+
+
+Avida::Data::ConstDataSetPtr Avida::Data::ColumnRecorder::RequestedData() const
+{
+  return m_requested;
+}
+
+
+void Avida::Data::ColumnRecorder::NotifyData(Update current_update, DataRetrievalFunctor retrieve_data)
+{
+  if (current_update % m_interval) return;
+
+  for (int i = 0; i < m_data_ids.GetSize(); i++) {
+    PackagePtr value = retrieve_data(m_data_ids[i]);
+    if (!value) continue;  // leaves the default value for this row
+
+    const int column = m_columns[i];
+    switch (m_file->ColumnDataType(column)) {
+      case Output::ColumnFile::INT_COLUMN:    m_file->Write(column, value->IntValue()); break;
+      case Output::ColumnFile::DOUBLE_COLUMN: m_file->Write(column, value->DoubleValue()); break;
+      case Output::ColumnFile::STRING_COLUMN: m_file->Write(column, value->StringValue()); break;
+    }
+  }
+  m_file->Endl(current_update);
+}
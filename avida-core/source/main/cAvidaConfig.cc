@@ -49,6 +49,7 @@ cAvidaConfig::cBaseConfigEntry::cBaseConfigEntry(const cString& _name,
 , default_value(_def)
 , description(_desc)
 , use_overide(true)
+, m_revision(NULL)
 {
   config_name[0] = _name;
   
@@ -135,6 +136,7 @@ bool cAvidaConfig::Load(const cString& filename, const cString& working_dir, cUs
     init_file.WarnUnused();
     feedback->Append(init_file.GetFeedback());
   }
+  m_revision++;
   return true;
 }
 
@@ -347,7 +349,7 @@ void cAvidaConfig::GenerateOverides()
       } else {
         fp << "  " << cur_type << " Get() const { return value; }" << endl;
         fp << "  void Set(" << cur_type
-        << " in_value) { value = in_value; }" << endl;
+        << " in_value) { if (!(value == in_value)) { value = in_value; Changed(); } }" << endl;
       }
       
       fp << "  cString AsString() { return cStringUtil::Convert(value); }" << endl;
@@ -381,6 +383,40 @@ bool cAvidaConfig::Get(const cString& entry, cString& ret) const
 }
 
 
+void cAvidaConfig::trackRevision()
+{
+  tListIterator<cBaseConfigGroup> group_it(m_group_list);
+  cBaseConfigGroup* cur_group;
+  while ((cur_group = group_it.Next()) != NULL) {
+    tListIterator<cBaseConfigEntry> entry_it(cur_group->GetEntryList());
+    cBaseConfigEntry* cur_entry;
+    while ((cur_entry = entry_it.Next()) != NULL) cur_entry->SetRevisionCounter(&m_revision);
+  }
+}
+
+
+uint64_t cAvidaConfig::Fingerprint(const char* const* skip_names) const
+{
+  uint64_t hash = cStringUtil::Hash("");
+  
+  tConstListIterator<cBaseConfigGroup> group_it(m_group_list);
+  const cBaseConfigGroup* cur_group;
+  while ((cur_group = group_it.Next()) != NULL) {
+    tConstListIterator<cBaseConfigEntry> entry_it(cur_group->GetEntryList());
+    const cBaseConfigEntry* cur_entry;
+    while ((cur_entry = entry_it.Next()) != NULL) {
+      bool skip = false;
+      for (int i = 0; skip_names[i] != NULL && !skip; i++) skip = (cur_entry->GetName() == skip_names[i]);
+      if (skip) continue;
+      
+      hash = cStringUtil::Hash(cur_entry->GetName(), hash);
+      hash = cStringUtil::Hash(cur_entry->AsString(), hash);
+    }
+  }
+  return hash;
+}
+
+
 bool cAvidaConfig::Set(const cString& entry, const cString& val)
 {
   // Loop through all groups, then all entries, searching for the specified entry.
@@ -393,6 +429,7 @@ bool cAvidaConfig::Set(const cString& entry, const cString& val)
     while ((cur_entry = entry_it.Next()) != NULL) {
       if (cur_entry->GetName() == entry) {
         cur_entry->LoadStr(val);
+        m_revision++;
         return true;
       }
     }
@@ -405,6 +442,7 @@ bool cAvidaConfig::Set(const cString& entry, const cString& val)
     while ((cur_entry = entry_it.Next())) {
       if (cur_entry->GetName() == entry) {
         cur_entry->LoadStr(val);
+        m_revision++;
         return true;
       }
     }
@@ -431,6 +469,7 @@ void cAvidaConfig::Set(Apto::Map<Apto::String, Apto::String>& sets)
         if (sets.Get(entry_name, val)) {
           cur_entry->LoadStr((const char*)val);
           sets.Remove(entry_name);
+          m_revision++;
           if (VERBOSITY.Get() > VERBOSE_NORMAL)
             cout << "CmdLine Set: " << entry_name << " " << val << endl;
           break;
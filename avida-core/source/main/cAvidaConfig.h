@@ -62,7 +62,8 @@ using namespace std;
 //     class that it can manage to.
 // 7 - Initialize the value of this setting to its default.
 // 8 - Insert the newly built object into the full list of settings objects.
-// 9 - Create Get() and Set() methods to act as accessors.
+// 9 - Create Get() and Set() methods to act as accessors.  Set() counts a
+//     change in the revision of the owning configuration.
 // 10 - Setup a method to return the value of this setting as a string.
 // 11 - Declare a variable of this class's type to use in the future.  Since
 //     accessors were declared above, we can refer to this setting by the
@@ -84,7 +85,7 @@ public:                                                                       \
     global_group_list.GetLast()->AddEntry(this);                      /* 8 */ \
   }                                                                           \
   TYPE Get() const { return value; }                                  /* 9 */ \
-  void Set(TYPE in_value) { value = in_value; }                               \
+  void Set(TYPE in_value) { if (!(value == in_value)) { value = in_value; Changed(); } } \
   cString AsString() const { return cStringUtil::Convert(value); }    /* 10 */\
 } NAME                                                                /* 11 */\
 
@@ -151,6 +152,11 @@ private:
     // those classes?
     bool use_overide;
     
+    int* m_revision;              // Revision of the owning configuration, see cAvidaConfig::GetRevision()
+    
+  protected:
+    void Changed() { if (m_revision) (*m_revision)++; }
+    
   public:
     cBaseConfigEntry(const cString& _name, const cString& _type, const cString& _def, const cString& _desc);
     virtual ~cBaseConfigEntry() { ; }
@@ -167,6 +173,7 @@ private:
     int GetNumNames() const { return config_name.GetSize(); }
 
     void AddAlias(const cString & alias) { config_name.Push(alias); }
+    void SetRevisionCounter(int* revision) { m_revision = revision; }
 
     virtual cString AsString() const = 0;
   };
@@ -254,14 +261,18 @@ private:
   static tList<cBaseConfigCustomFormat> global_format_list;
   tList<cBaseConfigGroup> m_group_list;
   tList<cBaseConfigCustomFormat> m_format_list;
+  int m_revision;   // incremented whenever settings are loaded or changed
+  
+  void trackRevision();
   
   
 public:
-  cAvidaConfig()
+  cAvidaConfig() : m_revision(0)
   {
     m_group_list.Transfer(global_group_list);
     m_format_list.Transfer(global_format_list);
     global_list_mutex.Unlock();
+    trackRevision();
   }
   ~cAvidaConfig() { ; }
   
@@ -282,6 +293,16 @@ public:
   CONFIG_ADD_VAR(VERBOSITY, int, 1, "0 = No output at all\n1 = Normal output\n2 = Verbose output, detailing progress\n3 = High level of details, as available\n4 = Print Debug Information, as applicable");
   CONFIG_ADD_VAR(RANDOM_SEED, int, -1, "Random number seed (-1 for based on time)");
   CONFIG_ADD_VAR(SPECULATIVE, bool, 1, "Enable speculative execution\n(pre-execute instructions that don't affect other organisms)");
+  CONFIG_ADD_VAR(BURST_SIZE, int, 0, "Number of instructions an organism executes each time it is scheduled\n0 or 1 = One instruction per scheduling (default)\nLarger bursts cut scheduling overhead; processor time remains proportional\nto merit over each update.  Overrides SPECULATIVE when enabled.");
+  CONFIG_ADD_VAR(SPATIAL_FLOW_METHOD, int, 0, "How diffusion and gravity move spatial resources between cells\n0 = Pairwise flow between each pair of neighboring cells (reference model)\n1 = Vectorized stencil over contiguous grid arrays\n    (matches the reference model up to floating point round-off)\n2 = Pairwise, with the vectorized stencil computed alongside; the run is aborted if\n    they differ by more than round-off");
+  CONFIG_ADD_VAR(ASYNC_OUTPUT_BLOCKS, int, 0, "Number of 64KB output blocks queued for the dedicated output writer thread\n0 = Disabled, output files are written directly by the update loop (default)\nWhen enabled, each file's output is handed to the writer at the end of every\nupdate rather than at every line; after a crash the output of the last update\nmay be missing");
+  CONFIG_ADD_VAR(ORGANISM_STATS_METHOD, int, 0, "How per organism statistics are gathered at the end of each update\n0 = Full scan of every organism (reference)\n1 = Incremental, only organisms that were born, divided, changed merit or mutation\n    rates, or performed tasks during the update are rescanned\n2 = Incremental, cross-checked against the full scan every update; mismatches are\n    reported as warnings and the full scan values are kept\n3 = As 2, but the run is aborted after an update with mismatches");
+  CONFIG_ADD_VAR(SENSOR_SKIP_METHOD, int, 1, "How look instructions walk past cells with nothing in them to report\n0 = Test every cell in the field of view (reference)\n1 = Pass over whole rows of cells with none of the resources looked for, or, once\n    something has been seen, with no whole edible units of them (default)\n2 = As 1, but every skipped cell is tested anyway and the run is aborted if any of\n    them would have been seen");
+  CONFIG_ADD_VAR(LABEL_SEARCH_METHOD, int, 1, "How original CPU hardware searches memory for labels\n0 = Step through the memory a label length at a time (reference)\n1 = Jump between runs of nops using an index of the memory (default)\n2 = As 1, but every search is repeated by stepping and the run is aborted if the\n    results differ");
+  CONFIG_ADD_VAR(HARDWARE_POOL_SIZE, int, 0, "Maximum number of idle virtual CPUs kept per instruction set for reuse by newborn\norganisms, which are reset rather than reconstructed.\n0 = Disabled, hardware is allocated for every birth and freed at every death");
+  CONFIG_ADD_VAR(ORGANISM_POOL_SIZE, int, 0, "Maximum number of idle organisms, with their phenotypes, kept for reuse by newborn\norganisms, which are reset rather than reconstructed.  Their virtual CPUs are\npooled separately (HARDWARE_POOL_SIZE).\n0 = Disabled, organisms are allocated for every birth and freed at every death");
+  CONFIG_ADD_VAR(MINI_TRACE_FORMAT, int, 0, "Format of the organism mini traces (minitraces/*.trc)\n0 = Text\n1 = Binary (.trcb), recorded in fixed size entries and decoded into the text format\n    by avida-trace");
+  CONFIG_ADD_VAR(CHECKPOINT_SYNC_INTERVAL, int, 0, "Updates between the points at which full state checkpoints (SaveCheckpoint) are written\nAt each point, after the event pass, the random number generator is reseeded from\nthe run's seed and the update, and the scheduler is rebuilt from the current merits,\nso saving does not change the run and resumed runs continue exactly as it does.\nCheckpoints cover original (heads) CPU organisms in a single deme; parasites,\navatars, other hardware types, demes and deme resources, gradient resources,\nstateful tasks, messaging and opinions, sexual reproduction (offspring waiting in the\nbirth chamber), and the full soup eldest birth method are reported as errors when\nsaving.\n0 = Disabled, SaveCheckpoint is refused");
   CONFIG_ADD_VAR(POPULATION_CAP, int, 0, "Carrying capacity in number of organisms (use 0 for no cap)");
   CONFIG_ADD_VAR(POP_CAP_ELDEST, int, 0, "Carrying capacity in number of organisms (use 0 for no cap). Will kill oldest organism in population, but still use birth method to place new offspring."); 
   
@@ -360,6 +381,7 @@ public:
   CONFIG_ADD_VAR(META_COPY_MUT, double, 0.0, "Prob. of copy mutation rate changing (per gen)");
   CONFIG_ADD_VAR(META_STD_DEV, double, 0.0, "Standard deviation of meta mutation size.");
   CONFIG_ADD_VAR(MUT_RATE_SOURCE, int, 1, "1 = Mutation rates determined by environment.\n2 = Mutation rates inherited from parent.");
+  CONFIG_ADD_VAR(MUTATION_SAMPLING_METHOD, int, 0, "How copy and point mutations are drawn\n0 = Random number test per copy, binomial count per organism for point mutations (reference)\n1 = Geometric skip sampling; the random number generator is only used where a mutation\n    occurs.  Point substitutions hit distinct sites, and fixed seed runs differ from method 0");
   
   
   // -------- Birth and Death config options --------
@@ -464,6 +486,7 @@ public:
   CONFIG_ADD_GROUP(ARCHETECTURE_GROUP, "Details on how CPU should work");
   CONFIG_ADD_VAR(IO_EXPIRE, bool, 1, "Is the expiration functionality of '-expire' I/O instructions enabled?");
   CONFIG_ADD_VAR(POISON_PENALTY, double, 0.01, "Metabolic rate penalty applied when the 'poison' instruction is executed.");
+  CONFIG_ADD_VAR(SPECIALIZED_DISPATCH, bool, 1, "Use an instruction loop specialized to the features in use (original CPU only)?\n0 = always run the generic loop, which checks every feature.");
 
   
   // -------- Pprocessing of multiple, distributed populations config options --------
@@ -538,7 +561,7 @@ public:
   // -------- Time Slicing config options --------
   CONFIG_ADD_GROUP(TIME_GROUP, "Time Slicing");
   CONFIG_ADD_VAR(AVE_TIME_SLICE, int, 30, "Average number of CPU-cycles per org per update");
-  CONFIG_ADD_VAR(SLICING_METHOD, int, 1, "0 = CONSTANT: all organisms receive equal number of CPU cycles\n1 = PROBABILISTIC: CPU cycles distributed randomly, proportional to merit.\n2 = INTEGRATED: CPU cycles given out deterministicly, proportional to merit\n3 = DEME_PROBABALISTIC: Demes receive fixed number of CPU cycles, awarded probabalistically to members\n4 = CROSS_DEME_PROBABALISTIC: Demes receive CPU cycles proportional to living population size, awarded probabalistically to members");
+  CONFIG_ADD_VAR(SLICING_METHOD, int, 1, "0 = CONSTANT: all organisms receive equal number of CPU cycles\n1 = PROBABILISTIC: CPU cycles distributed randomly, proportional to merit.\n2 = INTEGRATED: CPU cycles given out deterministicly, proportional to merit\n3 = DEME_PROBABALISTIC: Demes receive fixed number of CPU cycles, awarded probabalistically to members\n4 = CROSS_DEME_PROBABALISTIC: Demes receive CPU cycles proportional to living population size, awarded probabalistically to members\n6 = PROBABILISTIC_FENWICK: as PROBABILISTIC, drawn from a Fenwick tree with merit changes applied in batches\n7 = PROBABILISTIC_ALIAS: as PROBABILISTIC, mostly drawn in constant time from an alias table rebuilt lazily");
   CONFIG_ADD_VAR(BASE_MERIT_METHOD, int, 4, "How should merit be initialized?\n0 = Constant (merit independent of size)\n1 = Merit proportional to copied size\n2 = Merit prop. to executed size\n3 = Merit prop. to full size\n4 = Merit prop. to min of executed or copied size\n5 = Merit prop. to sqrt of the minimum size\n6 = Merit prop. to num times MERIT_BONUS_INST is in genome.");
   CONFIG_ADD_VAR(BASE_CONST_MERIT, int, 100, "Base merit valse for BASE_MERIT_METHOD 0");
   CONFIG_ADD_VAR(MERIT_BONUS_INST, int, 0, "Instruction ID to count for BASE_MERIT_METHOD 6"); 
@@ -588,6 +611,8 @@ public:
   CONFIG_ADD_GROUP(GENEOLOGY_GROUP, "Geneology");
   CONFIG_ADD_VAR(THRESHOLD, int, 3, "Number of organisms in a genotype needed for it\n  to be considered viable.");
   CONFIG_ADD_VAR(TEST_CPU_TIME_MOD, int, 20, "Time allocated in test CPUs (multiple of length)");
+  CONFIG_ADD_VAR(TEST_CACHE_SIZE, int, 0, "Number of test CPU results kept for reuse by landscaping and other analyses\nthat test the same genomes repeatedly (only tests without random inputs or\nmutations are cached)\n0 = Disabled");
+  CONFIG_ADD_VAR(TEST_CACHE_FILE, cString, "", "File holding the test CPU result cache, shared by every run that uses it\n(an existing file keeps the size it was created with; files written by another build are not used)\nEmpty = results are kept in memory for this run only");
   
 
   // -------- Organism Network config options --------
@@ -893,6 +918,12 @@ public:
   bool Set(const cString& entry, const cString& val);
   void Set(Apto::Map<Apto::String, Apto::String>& sets);
   
+  // Changes whenever a setting is loaded, set by name, or changed through the typed Set() of its entry
+  int GetRevision() const { return m_revision; }
+  
+  // Hash of the names and values of all settings except those in the NULL terminated skip list
+  uint64_t Fingerprint(const char* const* skip_names) const;
+  
   void GenerateOverides();
 };
 
@@ -0,0 +1,484 @@
+/*
+ *  cBinaryPopulationFile.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cBinaryPopulationFile.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/core/InstructionSequence.h"
+#include "avida/output/File.h"
+
+#include "apto/platform.h"
+
+#include "cInitFile.h"
+#include "cString.h"
+#include "cStringList.h"
+#include "cStringUtil.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#if !APTO_PLATFORM(WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+
+static const char s_magic[8] = { 'A', 'V', 'I', 'D', 'A', 'P', 'O', 'P' };
+
+// Genome sequences are stored apart from the other genotype fields, see SetSequence
+static const char* s_sequence_key = "sequence";
+static const char* s_sequence_descr = "Genome Sequence";
+
+// Largest count or string offset a (32-bit) record field can hold
+static const uint64_t MAX_RECORD_VALUE = 0xFFFFFFFFull;
+
+static const char* s_column_keys[cBinaryPopulationFile::NUM_COLUMNS] = {
+  "cells", "gest_offset", "lineage", "group_id", "forager_type", "birth_cell", "avatar_cell", "av_bcell",
+  "parent_ft", "parent_is_teach", "parent_merit"
+};
+
+static const char* s_column_descrs[cBinaryPopulationFile::NUM_COLUMNS] = {
+  "Occupied Cell IDs", "Gestation (CPU) Cycle Offsets", "Lineage Label", "Current Group IDs", "Current Forager Types",
+  "Birth Cells", "Current Avatar Cell Locations", "Avatar Birth Cell", "Parent forager type", "Was Parent a Teacher",
+  "Parent Merit"
+};
+
+
+const char* cBinaryPopulationFile::ColumnKey(int col)
+{
+  assert(col >= 0 && col < NUM_COLUMNS);
+  return s_column_keys[col];
+}
+
+const char* cBinaryPopulationFile::ColumnDescription(int col)
+{
+  assert(col >= 0 && col < NUM_COLUMNS);
+  return s_column_descrs[col];
+}
+
+int cBinaryPopulationFile::ColumnForKey(const Apto::String& key)
+{
+  for (int col = 0; col < NUM_COLUMNS; col++) if (key == s_column_keys[col]) return col;
+  return -1;
+}
+
+
+static inline size_t alignTo8(size_t offset) { return (offset + 7) & ~(size_t)7; }
+
+
+cBinaryPopulationFile::Writer::Writer(unsigned int column_mask) : m_column_mask(column_mask & ALL_COLUMNS)
+{
+  // Offset 0 is always the empty string
+  m_strings.push_back('\0');
+  m_string_offsets.Set("", 0);
+}
+
+uint32_t cBinaryPopulationFile::Writer::addString(const Apto::String& str)
+{
+  uint32_t offset = 0;
+  if (m_string_offsets.Get(str, offset)) return offset;
+
+  offset = m_strings.size();
+  m_strings.insert(m_strings.end(), (const char*)str, (const char*)str + str.GetSize());
+  m_strings.push_back('\0');
+  m_string_offsets.Set(str, offset);
+  return offset;
+}
+
+void cBinaryPopulationFile::Writer::BeginGenotype(unsigned int flags)
+{
+  sGenotype genotype;
+  genotype.first_value = m_values.size();
+  genotype.num_values = 0;
+  genotype.first_org = m_parent_merit.size();
+  genotype.num_orgs = 0;
+  genotype.flags = flags;
+  genotype.seq_size = 0;
+  genotype.seq_offset = 0;
+  m_genotypes.push_back(genotype);
+}
+
+void cBinaryPopulationFile::Writer::AddProperty(const Apto::String& key, const Apto::String& descr, const Apto::String& value)
+{
+  assert(m_genotypes.size());
+
+  uint32_t key_id = 0;
+  if (!m_key_ids.Get(key, key_id)) {
+    sKey new_key;
+    new_key.name = addString(key);
+    new_key.descr = addString(descr);
+    key_id = m_keys.size();
+    m_keys.push_back(new_key);
+    m_key_ids.Set(key, key_id);
+  }
+
+  sValue new_value;
+  new_value.key = key_id;
+  new_value.str = addString(value);
+  m_values.push_back(new_value);
+  m_genotypes.back().num_values++;
+}
+
+void cBinaryPopulationFile::Writer::SetSequence(const Avida::InstructionSequence& seq)
+{
+  assert(m_genotypes.size());
+
+  sGenotype& genotype = m_genotypes.back();
+  genotype.flags |= GENOTYPE_SEQUENCE;
+  genotype.seq_offset = m_ops.size();
+  genotype.seq_size = seq.GetSize();
+  for (int i = 0; i < seq.GetSize(); i++) m_ops.push_back(seq[i].GetOp());
+}
+
+void cBinaryPopulationFile::Writer::AddOrganism(const int values[NUM_INT_COLUMNS], double parent_merit)
+{
+  assert(m_genotypes.size());
+
+  for (int col = 0; col < NUM_INT_COLUMNS; col++) m_columns[col].push_back(values[col]);
+  m_parent_merit.push_back(parent_merit);
+  m_genotypes.back().num_orgs++;
+}
+
+bool cBinaryPopulationFile::Writer::Write(const Apto::String& path, Avida::Feedback& feedback) const
+{
+  const size_t num_orgs = m_parent_merit.size();
+
+  // Records hold 32-bit counts and string offsets
+  if (m_strings.size() > MAX_RECORD_VALUE || m_values.size() > MAX_RECORD_VALUE ||
+      m_genotypes.size() > MAX_RECORD_VALUE || num_orgs > MAX_RECORD_VALUE) {
+    feedback.Error("population too large for binary population file '%s'", (const char*)path);
+    return false;
+  }
+
+  sHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, s_magic, sizeof(s_magic));
+  header.version = VERSION;
+  header.byte_order = BYTE_ORDER_MARK;
+  header.num_keys = m_keys.size();
+  header.num_genotypes = m_genotypes.size();
+  header.num_values = m_values.size();
+  header.num_organisms = num_orgs;
+  header.column_mask = m_column_mask;
+  header.strings_offset = sizeof(sHeader) + (uint64_t)m_keys.size() * sizeof(sKey) +
+                          (uint64_t)m_genotypes.size() * sizeof(sGenotype) + (uint64_t)m_values.size() * sizeof(sValue);
+  header.strings_size = m_strings.size();
+  header.ops_offset = header.strings_offset + header.strings_size;
+  header.ops_size = m_ops.size();
+  header.columns_offset = alignTo8(header.ops_offset + header.ops_size);
+
+  std::ofstream fp((const char*)path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fp.good()) {
+    feedback.Error("unable to open binary population file '%s' for writing", (const char*)path);
+    return false;
+  }
+
+  fp.write((const char*)&header, sizeof(header));
+  if (m_keys.size()) fp.write((const char*)&m_keys[0], m_keys.size() * sizeof(sKey));
+  if (m_genotypes.size()) fp.write((const char*)&m_genotypes[0], m_genotypes.size() * sizeof(sGenotype));
+  if (m_values.size()) fp.write((const char*)&m_values[0], m_values.size() * sizeof(sValue));
+  fp.write(&m_strings[0], m_strings.size());
+  if (m_ops.size()) fp.write((const char*)&m_ops[0], m_ops.size());
+
+  const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  fp.write(padding, header.columns_offset - (header.ops_offset + header.ops_size));
+
+  if (num_orgs) {
+    for (int col = 0; col < NUM_INT_COLUMNS; col++) fp.write((const char*)&m_columns[col][0], num_orgs * sizeof(int32_t));
+    fp.write((const char*)&m_parent_merit[0], num_orgs * sizeof(double));
+  }
+
+  fp.close();
+  if (fp.fail()) {
+    feedback.Error("error writing binary population file '%s'", (const char*)path);
+    return false;
+  }
+  return true;
+}
+
+
+cBinaryPopulationFile::Reader::Reader()
+  : m_data(NULL), m_size(0), m_mapped(false), m_header(NULL), m_keys(NULL), m_genotypes(NULL), m_values(NULL)
+  , m_strings(NULL), m_ops(NULL), m_columns(NULL), m_parent_merit(NULL)
+{
+}
+
+bool cBinaryPopulationFile::Reader::Open(const Apto::String& path, Avida::Feedback& feedback)
+{
+  Close();
+
+#if APTO_PLATFORM(WINDOWS)
+  std::ifstream fp((const char*)path, std::ios::in | std::ios::binary);
+  if (!fp.good()) {
+    feedback.Error("unable to open binary population file '%s'", (const char*)path);
+    return false;
+  }
+  fp.seekg(0, std::ios::end);
+  m_size = fp.tellg();
+  fp.seekg(0, std::ios::beg);
+  m_data = new char[m_size];
+  fp.read(m_data, m_size);
+  if (fp.fail()) {
+    feedback.Error("error reading binary population file '%s'", (const char*)path);
+    Close();
+    return false;
+  }
+#else
+  int fd = open((const char*)path, O_RDONLY);
+  if (fd < 0) {
+    feedback.Error("unable to open binary population file '%s'", (const char*)path);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    feedback.Error("unable to read binary population file '%s'", (const char*)path);
+    close(fd);
+    return false;
+  }
+  m_size = st.st_size;
+  void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    feedback.Error("unable to map binary population file '%s'", (const char*)path);
+    m_size = 0;
+    return false;
+  }
+  m_data = static_cast<char*>(data);
+  m_mapped = true;
+#endif
+
+  if (!validate(feedback)) {
+    feedback.Error("invalid binary population file '%s'", (const char*)path);
+    Close();
+    return false;
+  }
+  return true;
+}
+
+bool cBinaryPopulationFile::Reader::validate(Avida::Feedback& feedback)
+{
+  if (m_size < sizeof(sHeader)) return false;
+
+  const sHeader* header = reinterpret_cast<const sHeader*>(m_data);
+  if (memcmp(header->magic, s_magic, sizeof(s_magic)) != 0) return false;
+  if (header->byte_order != BYTE_ORDER_MARK) {
+    feedback.Error("binary population file was written on a machine with a different byte order");
+    return false;
+  }
+  if (header->version != VERSION) {
+    feedback.Error("unsupported binary population file version %u", header->version);
+    return false;
+  }
+
+  const uint64_t tables_end = sizeof(sHeader) + (uint64_t)header->num_keys * sizeof(sKey) +
+                              (uint64_t)header->num_genotypes * sizeof(sGenotype) +
+                              (uint64_t)header->num_values * sizeof(sValue);
+  if (header->strings_offset != tables_end || header->strings_size == 0 || header->strings_size > MAX_RECORD_VALUE) return false;
+  if (header->ops_offset != header->strings_offset + header->strings_size) return false;
+  if (header->ops_size > m_size || header->ops_offset + header->ops_size > header->columns_offset) return false;
+  if (header->columns_offset % 8 != 0 || header->columns_offset > m_size) return false;
+  const uint64_t columns_size = (uint64_t)header->num_organisms * (NUM_INT_COLUMNS * sizeof(int32_t) + sizeof(double));
+  if (columns_size > m_size - header->columns_offset) return false;
+
+  m_header = header;
+  m_keys = reinterpret_cast<const sKey*>(m_data + sizeof(sHeader));
+  m_genotypes = reinterpret_cast<const sGenotype*>(m_keys + header->num_keys);
+  m_values = reinterpret_cast<const sValue*>(m_genotypes + header->num_genotypes);
+  m_strings = m_data + header->strings_offset;
+  m_ops = reinterpret_cast<const unsigned char*>(m_data + header->ops_offset);
+  m_columns = reinterpret_cast<const int32_t*>(m_data + header->columns_offset);
+  m_parent_merit = reinterpret_cast<const double*>(m_columns + (size_t)NUM_INT_COLUMNS * header->num_organisms);
+
+  // Verify all cross references so that the accessors never need to
+  if (m_strings[header->strings_size - 1] != '\0') return false;
+  for (uint32_t i = 0; i < header->num_keys; i++) {
+    if (m_keys[i].name >= header->strings_size || m_keys[i].descr >= header->strings_size) return false;
+  }
+  for (uint32_t i = 0; i < header->num_values; i++) {
+    if (m_values[i].key >= header->num_keys || m_values[i].str >= header->strings_size) return false;
+  }
+  for (uint32_t i = 0; i < header->num_genotypes; i++) {
+    const sGenotype& g = m_genotypes[i];
+    if ((size_t)g.first_value + g.num_values > header->num_values) return false;
+    if ((size_t)g.first_org + g.num_orgs > header->num_organisms) return false;
+    if (g.seq_offset > header->ops_size || g.seq_size > header->ops_size - g.seq_offset) return false;
+  }
+
+  return true;
+}
+
+void cBinaryPopulationFile::Reader::GetSequence(int g, Avida::InstructionSequence& seq) const
+{
+  const sGenotype& genotype = m_genotypes[g];
+  const unsigned char* ops = m_ops + genotype.seq_offset;
+  seq.Resize(genotype.seq_size);
+  for (uint32_t i = 0; i < genotype.seq_size; i++) seq[i].SetOp(ops[i]);
+}
+
+void cBinaryPopulationFile::Reader::Close()
+{
+  if (m_data) {
+#if APTO_PLATFORM(WINDOWS)
+    delete [] m_data;
+#else
+    if (m_mapped) munmap(m_data, m_size);
+#endif
+  }
+  m_data = NULL;
+  m_size = 0;
+  m_mapped = false;
+  m_header = NULL;
+  m_keys = NULL;
+  m_genotypes = NULL;
+  m_values = NULL;
+  m_strings = NULL;
+  m_ops = NULL;
+  m_columns = NULL;
+  m_parent_merit = NULL;
+}
+
+
+// Field descriptions are only present in the comment header of a text save ("# 12: Update Born")
+static void readFieldDescriptions(const Apto::String& path, Apto::Map<int, Apto::String>& descrs)
+{
+  std::ifstream fp((const char*)path);
+  char line[1024];
+  while (fp.getline(line, sizeof(line)) || fp.gcount()) {
+    if (fp.fail()) fp.clear();  // overlong line, the remainder is read as the next line
+    if (line[0] == '\0') continue;
+    if (line[0] != '#') break;
+
+    int field = 0;
+    int consumed = 0;
+    if (sscanf(line, "# %d: %n", &field, &consumed) == 1 && consumed > 0) descrs.Set(field, line + consumed);
+  }
+}
+
+bool cBinaryPopulationFile::ConvertTextToBinary(const Apto::String& in_path, const Apto::String& out_path,
+                                                Avida::Feedback& feedback)
+{
+  cInitFile input_file(cString((const char*)in_path), cString(""), feedback);
+  if (!input_file.WasOpened()) return false;
+
+  Apto::Map<int, Apto::String> field_descrs;
+  readFieldDescriptions(in_path, field_descrs);
+
+  const cStringList& format = input_file.GetFormat();
+  Apto::Array<Apto::String> keys(format.GetSize());
+  Apto::Array<Apto::String> descrs(format.GetSize());
+  unsigned int column_mask = 0;
+  for (int i = 0; i < format.GetSize(); i++) {
+    keys[i] = (const char*)format.GetLine(i);
+    if (!field_descrs.Get(i + 1, descrs[i])) descrs[i] = keys[i];
+    int col = ColumnForKey(keys[i]);
+    if (col >= 0) column_mask |= (1u << col);
+  }
+
+  Writer writer(column_mask);
+  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
+    Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props = input_file.GetLineAsDict(line_id);
+
+    Apto::Array<int> columns[NUM_INT_COLUMNS];
+    Apto::Array<double> parent_merit;
+    int num_orgs = 0;
+    for (int col = 0; col < NUM_COLUMNS; col++) {
+      Apto::String value;
+      props->Get(s_column_keys[col], value);
+      cString colstr((const char*)value);
+      if (col == COL_PARENT_MERIT) {
+        while (colstr.GetSize()) parent_merit.Push(colstr.Pop(',').AsDouble());
+        num_orgs = Apto::Max(num_orgs, parent_merit.GetSize());
+      } else {
+        while (colstr.GetSize()) columns[col].Push(colstr.Pop(',').AsInt());
+        num_orgs = Apto::Max(num_orgs, columns[col].GetSize());
+      }
+    }
+
+    unsigned int flags = 0;
+    if (num_orgs) flags |= GENOTYPE_CURRENT;
+    if (num_orgs && props->Has("gest_offset") && !columns[COL_GEST_OFFSET].GetSize()) flags |= GENOTYPE_PARASITE;
+    writer.BeginGenotype(flags);
+
+    for (int i = 0; i < keys.GetSize(); i++) {
+      if (ColumnForKey(keys[i]) >= 0 || !props->Has(keys[i])) continue;
+      if (keys[i] == s_sequence_key) writer.SetSequence(Avida::InstructionSequence(props->Get(keys[i])));
+      else writer.AddProperty(keys[i], descrs[i], props->Get(keys[i]));
+    }
+
+    // Columns not present for a genotype are stored with the defaults used by cPopulation::SavePopulation
+    const int defaults[NUM_INT_COLUMNS] = { 0, 0, -1, -1, -1, 0, -1, -1, -1, 0 };
+    int values[NUM_INT_COLUMNS];
+    for (int org = 0; org < num_orgs; org++) {
+      for (int col = 0; col < NUM_INT_COLUMNS; col++) {
+        values[col] = (org < columns[col].GetSize()) ? columns[col][org] : defaults[col];
+      }
+      writer.AddOrganism(values, (org < parent_merit.GetSize()) ? parent_merit[org] : 1.0);
+    }
+  }
+
+  return writer.Write(out_path, feedback);
+}
+
+bool cBinaryPopulationFile::ConvertBinaryToText(Avida::World* world, const Apto::String& in_path,
+                                                const Apto::String& out_path, Avida::Feedback& feedback)
+{
+  Reader reader;
+  if (!reader.Open(in_path, feedback)) return false;
+
+  Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(world, out_path);
+  df->SetFileType("genotype_data");
+  df->WriteComment("Structured Population Save");
+  df->WriteTimeStamp();
+
+  for (int g = 0; g < reader.GetNumGenotypes(); g++) {
+    for (int i = 0; i < reader.GetNumProperties(g); i++) {
+      df->Write(reader.GetPropertyValue(g, i), reader.GetPropertyDescription(g, i), reader.GetPropertyKey(g, i));
+    }
+    if (reader.HasSequence(g)) {
+      Avida::InstructionSequence seq;
+      reader.GetSequence(g, seq);
+      df->Write((const char*)seq.AsString(), s_sequence_descr, s_sequence_key);
+    }
+
+    if (reader.IsCurrent(g)) {
+      const int num_orgs = reader.GetNumOrganisms(g);
+      for (int col = 0; col < NUM_COLUMNS; col++) {
+        if (!reader.HasColumn(col)) continue;
+
+        cString colstr;
+        if (col == COL_PARENT_MERIT) {
+          const double* merit = reader.GetParentMerit(g);
+          // Full precision, so that converting back reproduces the stored values exactly
+          for (int org = 0; org < num_orgs; org++) colstr += cStringUtil::Stringf((org) ? ",%.17g" : "%.17g", merit[org]);
+        } else if (col != COL_GEST_OFFSET || !reader.IsParasite(g)) {
+          const int32_t* values = reader.GetColumn(g, col);
+          for (int org = 0; org < num_orgs; org++) colstr += cStringUtil::Stringf((org) ? ",%d" : "%d", values[org]);
+        }
+        df->Write(colstr, s_column_descrs[col], s_column_keys[col]);
+      }
+    }
+    df->Endl();
+  }
+
+  return true;
+}
@@ -0,0 +1,233 @@
+/*
+ *  cBinaryPopulationFile.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cBinaryPopulationFile_h
+#define cBinaryPopulationFile_h
+
+#include "avida/core/Types.h"
+
+#include <stdint.h>
+#include <vector>
+
+
+// cBinaryPopulationFile - binary population checkpoint (.bpop), the counterpart of the structured .spop save
+//
+// The file holds the same information as a structured population save.  Genotype fields (id, merit, ...) are stored
+// as strings exactly as they appear in the text save.  The genome sequence is stored as one instruction op byte per
+// site, so that loading builds it directly rather than parsing the instruction symbols.  The per-organism lists
+// (cells, gest_offset, lineage, ...) are stored as fixed width columns instead of comma separated strings, which is
+// where the text format spends nearly all of its size and parse time.
+//
+// Layout, in host byte order (files written with a different byte order are rejected):
+//   sHeader
+//   sKey[num_keys]                 field name and description, in first seen order
+//   sGenotype[num_genotypes]       genotype records, organisms of a genotype are contiguous in the columns
+//   sValue[num_values]             genotype field values
+//   char[strings_size]             NUL terminated strings, each distinct string stored once
+//   unsigned char[ops_size]        genome sequences, at ops_offset
+//   int32_t[NUM_INT_COLUMNS][num_organisms]    at columns_offset (8 byte aligned)
+//   double[num_organisms]                      parent merit column
+//
+// Records refer to strings with 32-bit offsets, so the string table is limited to 4GB; Writer::Write fails on larger
+// populations rather than writing a corrupt file.  Section offsets are 64-bit.
+
+class cBinaryPopulationFile
+{
+public:
+  class Writer;
+  class Reader;
+  friend class Writer;
+  friend class Reader;
+
+  enum eColumn {
+    COL_CELL = 0,
+    COL_GEST_OFFSET,
+    COL_LINEAGE,
+    COL_GROUP_ID,
+    COL_FORAGER_TYPE,
+    COL_BIRTH_CELL,
+    COL_AVATAR_CELL,
+    COL_AV_BCELL,
+    COL_PARENT_FT,
+    COL_PARENT_IS_TEACH,
+    NUM_INT_COLUMNS,
+    COL_PARENT_MERIT = NUM_INT_COLUMNS,
+    NUM_COLUMNS
+  };
+
+  enum {
+    GENOTYPE_PARASITE = 0x1,  // no gestation offsets are saved for parasite genotypes
+    GENOTYPE_CURRENT = 0x2,   // genotype has living organisms (otherwise historic)
+    GENOTYPE_SEQUENCE = 0x4   // genotype has a genome sequence
+  };
+
+  static const unsigned int ALL_COLUMNS = (1u << NUM_COLUMNS) - 1;
+
+
+private:
+  struct sHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t num_keys;
+    uint32_t num_genotypes;
+    uint32_t num_values;
+    uint32_t num_organisms;
+    uint32_t column_mask;
+    uint32_t reserved;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t ops_offset;
+    uint64_t ops_size;
+    uint64_t columns_offset;
+  };
+
+  struct sKey
+  {
+    uint32_t name;
+    uint32_t descr;
+  };
+
+  struct sGenotype
+  {
+    uint32_t first_value;
+    uint32_t num_values;
+    uint32_t first_org;
+    uint32_t num_orgs;
+    uint32_t flags;
+    uint32_t seq_size;
+    uint64_t seq_offset;
+  };
+
+  struct sValue
+  {
+    uint32_t key;
+    uint32_t str;
+  };
+
+  static const uint32_t VERSION = 2;
+  static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+
+public:
+  // Writer - accumulates a population in memory and writes it out in a single pass
+  //
+  // Strings are pooled as they are added, so the sequence of a genotype and repeated values such as the source or
+  // instruction set name occupy the string table only once.
+  class Writer
+  {
+  private:
+    unsigned int m_column_mask;
+
+    std::vector<char> m_strings;
+    Apto::Map<Apto::String, uint32_t> m_string_offsets;
+
+    std::vector<sKey> m_keys;
+    Apto::Map<Apto::String, uint32_t> m_key_ids;
+
+    std::vector<sGenotype> m_genotypes;
+    std::vector<sValue> m_values;
+    std::vector<unsigned char> m_ops;
+
+    // Written out as contiguous blocks, hence std::vector rather than Apto::Array
+    std::vector<int32_t> m_columns[NUM_INT_COLUMNS];
+    std::vector<double> m_parent_merit;
+
+    uint32_t addString(const Apto::String& str);
+
+  public:
+    Writer(unsigned int column_mask = ALL_COLUMNS);
+
+    // Properties and organisms that follow are attached to the most recently begun genotype
+    void BeginGenotype(unsigned int flags);
+    void AddProperty(const Apto::String& key, const Apto::String& descr, const Apto::String& value);
+    void SetSequence(const Avida::InstructionSequence& seq);
+    void AddOrganism(const int values[NUM_INT_COLUMNS], double parent_merit);
+
+    bool Write(const Apto::String& path, Avida::Feedback& feedback) const;
+  };
+
+
+  // Reader - memory maps a saved population; all pointers returned remain valid until the reader is closed
+  class Reader
+  {
+  private:
+    char* m_data;
+    size_t m_size;
+    bool m_mapped;
+
+    const sHeader* m_header;
+    const sKey* m_keys;
+    const sGenotype* m_genotypes;
+    const sValue* m_values;
+    const char* m_strings;
+    const unsigned char* m_ops;
+    const int32_t* m_columns;
+    const double* m_parent_merit;
+
+    bool validate(Avida::Feedback& feedback);
+
+    Reader(const Reader&); // @not_implemented
+    Reader& operator=(const Reader&); // @not_implemented
+
+  public:
+    Reader();
+    ~Reader() { Close(); }
+
+    bool Open(const Apto::String& path, Avida::Feedback& feedback);
+    void Close();
+
+    inline unsigned int GetColumnMask() const { return m_header->column_mask; }
+    inline bool HasColumn(int col) const { return (m_header->column_mask & (1u << col)) != 0; }
+
+    inline int GetNumGenotypes() const { return m_header->num_genotypes; }
+    inline bool IsParasite(int g) const { return (m_genotypes[g].flags & GENOTYPE_PARASITE) != 0; }
+    inline bool IsCurrent(int g) const { return (m_genotypes[g].flags & GENOTYPE_CURRENT) != 0; }
+    inline bool HasSequence(int g) const { return (m_genotypes[g].flags & GENOTYPE_SEQUENCE) != 0; }
+
+    inline int GetNumProperties(int g) const { return m_genotypes[g].num_values; }
+    inline const char* GetPropertyKey(int g, int i) const
+      { return m_strings + m_keys[m_values[m_genotypes[g].first_value + i].key].name; }
+    inline const char* GetPropertyDescription(int g, int i) const
+      { return m_strings + m_keys[m_values[m_genotypes[g].first_value + i].key].descr; }
+    inline const char* GetPropertyValue(int g, int i) const
+      { return m_strings + m_values[m_genotypes[g].first_value + i].str; }
+
+    void GetSequence(int g, Avida::InstructionSequence& seq) const;
+
+    inline int GetNumOrganisms(int g) const { return m_genotypes[g].num_orgs; }
+    inline const int32_t* GetColumn(int g, int col) const
+      { return m_columns + (size_t)col * m_header->num_organisms + m_genotypes[g].first_org; }
+    inline const double* GetParentMerit(int g) const { return m_parent_merit + m_genotypes[g].first_org; }
+  };
+
+
+  static const char* ColumnKey(int col);
+  static const char* ColumnDescription(int col);
+  static int ColumnForKey(const Apto::String& key);  // -1 if the key is a genotype field
+
+  // Converters between the text (.spop) and binary (.bpop) population formats, both paths must be absolute
+  static bool ConvertTextToBinary(const Apto::String& in_path, const Apto::String& out_path, Avida::Feedback& feedback);
+  static bool ConvertBinaryToText(Avida::World* world, const Apto::String& in_path, const Apto::String& out_path,
+                                  Avida::Feedback& feedback);
+};
+
+#endif
@@ -70,6 +70,10 @@ public:
   void ClearEntry(cBirthEntry& entry);
   
   int GetWaitingOffspringNumber(int which_mating_type, int hw_type);
+  
+  // True once any sexual (or waiting asexual) offspring has been submitted; selection handlers, and the offspring
+  // they hold, are only created then
+  bool IsInUse() const { return m_handler_map.GetSize() > 0; }
   void PrintBirthChamber(const cString& filename, int hw_type);
 
 private:
@@ -76,6 +76,8 @@ cDeme::cDeme()
   , avg_founder_generation(0.0)
   , generations_per_lifetime(0.0)
   , deme_resource_count(0)
+  , m_res_clock(NULL)
+  , m_res_clock_synced(0)
   , m_germline_genotype_id(0)
   , points(0)
   , migrations_out(0)
@@ -165,6 +167,8 @@ cDeme& cDeme::operator=(const cDeme& in_deme)
   migrations_out                      = in_deme.migrations_out;
   migrations_in                       = in_deme.migrations_in;
   suicides                            = in_deme.suicides;
+  m_res_clock                         = in_deme.m_res_clock;
+  m_res_clock_synced                  = in_deme.m_res_clock_synced;
 //m_network                           = in_deme.m_network;
   m_inputs                            = in_deme.m_inputs;
   m_input_buf                         = in_deme.m_input_buf;
@@ -334,11 +338,13 @@ int cDeme::GetNumOrgsWithOpinion() const
 
 void cDeme::ProcessPreUpdate()
 {
+  SyncResourceClock();
   deme_resource_count.SetSpatialUpdate(m_world->GetStats().GetUpdate());
 }
 
 void cDeme::ProcessUpdate(cAvidaContext& ctx)
 {
+  SyncResourceClock();
   // test deme predicate
   for (int i = 0; i < deme_pred_list.GetSize(); i++) {
     if (deme_pred_list[i]->GetName() == "cDemeResourceThreshold") {
@@ -481,6 +487,7 @@ void cDeme::OrganismDeath(cPopulationCell& cell)
 
 void cDeme::Reset(cAvidaContext& ctx, bool resetResources, double deme_energy)
 {
+  SyncResourceClock();
   double additional_resource = 0.0;
   // Handle energy model
   if (m_world->GetConfig().ENERGY_ENABLED.Get())
@@ -701,12 +708,14 @@ void cDeme::UpdateDemeMerit(cDeme& source) {
 
 
 void cDeme::ModifyDemeResCount(cAvidaContext& ctx, const Apto::Array<double>& res_change, const int absolute_cell_id) {
+  SyncResourceClock();
   // find relative cell_id in deme resource count
   const int relative_cell_id = GetRelativeCellID(absolute_cell_id);
   deme_resource_count.ModifyCell(ctx, res_change, relative_cell_id);
 }
 
 void cDeme::SetupDemeRes(int id, cResource * res, int verbosity, cWorld* world) {               
+  SyncResourceClock();
   const double decay = 1.0 - res->GetOutflow();
   //addjust the resources cell list pointer here if we want CELL env. commands to be replicated in each deme
   
@@ -751,6 +760,7 @@ double cDeme::GetCellEnergy(int absolute_cell_id, cAvidaContext& ctx) const
 {
   assert(cell_ids[0] <= absolute_cell_id);
   assert(absolute_cell_id <= cell_ids[cell_ids.GetSize()-1]);
+  SyncResourceClock();
 
   double total_energy = 0.0;
   int relative_cell_id = GetRelativeCellID(absolute_cell_id);
@@ -771,6 +781,7 @@ double cDeme::GetAndClearCellEnergy(int absolute_cell_id, cAvidaContext& ctx)
 {
   assert(cell_ids[0] <= absolute_cell_id);
   assert(absolute_cell_id <= cell_ids[cell_ids.GetSize()-1]);
+  SyncResourceClock();
   
   double total_energy = 0.0;
   int relative_cell_id = GetRelativeCellID(absolute_cell_id);
@@ -794,6 +805,7 @@ void cDeme::GiveBackCellEnergy(int absolute_cell_id, double value, cAvidaContext
 {
   assert(cell_ids[0] <= absolute_cell_id);
   assert(absolute_cell_id <= cell_ids[cell_ids.GetSize()-1]);
+  SyncResourceClock();
   
   int relative_cell_id = GetRelativeCellID(absolute_cell_id);
   Apto::Array<double> cell_resources = deme_resource_count.GetCellResources(relative_cell_id, ctx);
@@ -1137,6 +1149,7 @@ void cDeme::AddPheromone(int absolute_cell_id, double value, cAvidaContext& ctx)
 {
   assert(cell_ids[0] <= absolute_cell_id);
   assert(absolute_cell_id <= cell_ids[cell_ids.GetSize()-1]);
+  SyncResourceClock();
   
   //  cPopulation& pop = m_world->GetPopulation();
   
@@ -1171,6 +1184,7 @@ double cDeme::GetSpatialResource(int rel_cellid, int resource_id, cAvidaContext&
   assert(rel_cellid < GetSize());
   assert(resource_id >= 0);
   assert(resource_id < deme_resource_count.GetSize());
+  SyncResourceClock();
   
   Apto::Array<double> cell_resources = deme_resource_count.GetCellResources(rel_cellid, ctx);
   return cell_resources[resource_id];
@@ -1182,6 +1196,7 @@ void cDeme::AdjustSpatialResource(cAvidaContext& ctx, int rel_cellid, int resour
   assert(rel_cellid < GetSize());
   assert(resource_id >= 0);
   assert(resource_id < deme_resource_count.GetSize());
+  SyncResourceClock();
   
   Apto::Array<double> res_change;
   res_change.Resize(deme_resource_count.GetSize(), 0);
@@ -1192,6 +1207,7 @@ void cDeme::AdjustSpatialResource(cAvidaContext& ctx, int rel_cellid, int resour
 
 void cDeme::AdjustResource(cAvidaContext& ctx, int resource_id, double amount)
 {
+  SyncResourceClock();
   double new_amount = deme_resource_count.Get(ctx, resource_id) + amount;
   deme_resource_count.Set(ctx, resource_id, new_amount);
 }
@@ -21,6 +21,7 @@
 #ifndef cDeme_h
 #define cDeme_h
 
+#include <cassert>
 #include <set>
 #include <vector>
 
@@ -45,6 +46,29 @@ class cDemePredicate;
 class cReactionResult; //@JJB**
 class cTaskState; //@JJB**
 
+/*! Resource time that has elapsed for every deme in a population but has not yet been applied to their resource
+counts.  Executing an instruction only advances the clock; each deme catches up the first time its resources are
+used, so the per-instruction cost does not depend on the number of demes.  Steps must all have the same size, the
+population flushes every deme before the step size changes and at the end of each update. */
+
+class cDemeResourceClock
+{
+private:
+  int m_steps;
+  double m_step_size;
+
+public:
+  cDemeResourceClock() : m_steps(0), m_step_size(0.0) { ; }
+
+  int GetSteps() const { return m_steps; }
+  double GetStepSize() const { return m_step_size; }
+
+  bool CanAdvance(double step_size) const { return m_steps == 0 || step_size == m_step_size; }
+  void Advance(double step_size, int steps = 1) { assert(CanAdvance(step_size)); m_step_size = step_size; m_steps += steps; }
+  void Reset() { m_steps = 0; }
+};
+
+
 /*! Demes are groups of cells in the population that are somehow bound together
 as a unit.  The deme object is used from within cPopulation to manage these 
 groups. */
@@ -115,7 +139,9 @@ private:
 
   cDeme(const cDeme&); // @not_implemented
   
-  cResourceCount deme_resource_count; //!< Resources available to the deme
+  mutable cResourceCount deme_resource_count; //!< Resources available to the deme (mutable to apply pending time)
+  const cDemeResourceClock* m_res_clock; //!< Pending resource time shared by the population's demes, if any
+  mutable int m_res_clock_synced; //!< Number of m_res_clock steps already applied to deme_resource_count
   Apto::Array<int> energy_res_ids; //!< IDs of energy resources
   
   Apto::Array<cDemeCellEvent, Apto::Smart> cell_events;
@@ -260,21 +286,34 @@ public:
   //! Called when an organism living in a cell in this deme is about to be killed.
   void OrganismDeath(cPopulationCell& cell);
   
-  const cResourceCount& GetDemeResourceCount() const { return deme_resource_count; }
-  cResourceCount& GetDemeResources() { return deme_resource_count; }
-  void SetResource(cAvidaContext& ctx, int id, double new_level) { deme_resource_count.Set(ctx, id, new_level); }
+  const cResourceCount& GetDemeResourceCount() const { SyncResourceClock(); return deme_resource_count; }
+  cResourceCount& GetDemeResources() { SyncResourceClock(); return deme_resource_count; }
+  void SetResource(cAvidaContext& ctx, int id, double new_level) { SyncResourceClock(); deme_resource_count.Set(ctx, id, new_level); }
   double GetSpatialResource(int rel_cellid, int resource_id, cAvidaContext& ctx) const;
   void AdjustSpatialResource(cAvidaContext& ctx, int rel_cellid, int resource_id, double amount);
   void AdjustResource(cAvidaContext& ctx, int resource_id, double amount);
-  void SetDemeResourceCount(const cResourceCount in_res) { deme_resource_count = in_res; }
-  void ResizeSpatialGrids(const int in_x, const int in_y) { deme_resource_count.ResizeSpatialGrids(in_x, in_y); }
+  void SetDemeResourceCount(const cResourceCount in_res) { SyncResourceClock(); deme_resource_count = in_res; }
+  void ResizeSpatialGrids(const int in_x, const int in_y) { SyncResourceClock(); deme_resource_count.ResizeSpatialGrids(in_x, in_y); }
   void ModifyDemeResCount(cAvidaContext& ctx, const Apto::Array<double> & res_change, const int absolute_cell_id);
   double GetCellEnergy(int absolute_cell_id, cAvidaContext& ctx) const; 
   double GetAndClearCellEnergy(int absolute_cell_id, cAvidaContext& ctx); 
   void GiveBackCellEnergy(int absolute_cell_id, double value, cAvidaContext& ctx); 
   void SetupDemeRes(int id, cResource * res, int verbosity, cWorld* world);                 
-  void UpdateDemeRes(cAvidaContext& ctx) { deme_resource_count.GetResources(ctx); } 
+  void UpdateDemeRes(cAvidaContext& ctx) { SyncResourceClock(); deme_resource_count.GetResources(ctx); } 
   void Update(double time_step) { deme_resource_count.Update(time_step); }
+
+  //! Attach the population's shared resource clock; time advanced on it is applied lazily to this deme's resources.
+  void SetResourceClock(const cDemeResourceClock* clock) { m_res_clock = clock; m_res_clock_synced = (clock) ? clock->GetSteps() : 0; }
+  //! Apply any resource time pending on the shared clock to this deme's resource count.
+  void SyncResourceClock() const
+  {
+    if (m_res_clock && m_res_clock_synced != m_res_clock->GetSteps()) {
+      deme_resource_count.Update((m_res_clock->GetSteps() - m_res_clock_synced) * m_res_clock->GetStepSize());
+      m_res_clock_synced = m_res_clock->GetSteps();
+    }
+  }
+  //! Apply pending resource time and rewind to the start of the clock, called for every deme before the clock is reset.
+  void FlushResourceClock() { SyncResourceClock(); m_res_clock_synced = 0; }
   int GetRelativeCellID(int absolute_cell_id) const { return absolute_cell_id % GetSize(); } //!< assumes all demes are the same size
   int GetAbsoluteCellID(int relative_cell_id) const { return relative_cell_id + (_id * GetSize()); } //!< assumes all demes are the same size
 	
@@ -297,8 +336,8 @@ public:
   double GetTotalEnergyTestament() { return total_energy_testament; }
   void IncreaseTotalEnergyTestament(double increment) { total_energy_testament += increment; }
   
-  void IncTimeUsed(double merit) 
-    { time_used++; cur_normalized_time_used += 1.0/merit/(double)cur_org_count; }
+  void IncTimeUsed(double merit, int steps = 1) 
+    { time_used += steps; cur_normalized_time_used += (double)steps/merit/(double)cur_org_count; }
   int GetTimeUsed() { return time_used; }
   int GetGestationTime() { return gestation_time; }
   double GetNormalizedTimeUsed() { return cur_normalized_time_used; }
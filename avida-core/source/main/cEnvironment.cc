@@ -53,7 +53,8 @@ using namespace Avida;
 
 cEnvironment::cEnvironment(cWorld* world) : m_world(world) , m_tasklib(world),
 m_input_size(INPUT_SIZE_DEFAULT), m_output_size(OUTPUT_SIZE_DEFAULT), m_true_rand(false),
-m_use_specific_inputs(false), m_specific_inputs(), m_mask(0), m_hammers(false), m_paths(false)
+m_use_specific_inputs(false), m_specific_inputs(), m_mask(0), m_hammers(false), m_paths(false),
+m_definition_hash(cStringUtil::Hash(""))
 {
   mut_rates.Setup(world);
   if (m_world->GetConfig().DEFAULT_GROUP.Get() != -1) possible_group_ids.insert(m_world->GetConfig().DEFAULT_GROUP.Get());
@@ -1144,6 +1145,8 @@ bool cEnvironment::LoadLine(cString line, Feedback& feedback)
 /* Routine to read in a line from the enviroment file and hand that line
  line to the approprate routine to process it.                         */
 {
+  recordChange(line);
+  
   cString type = line.PopWord();      // Determine type of this entry.
   type.ToUpper();                     // Make type case insensitive.
 
@@ -1283,6 +1286,7 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
 
   // Do setup for reaction tests...
   m_tasklib.SetupTests(taskctx);
+  const int logic_id = taskctx.GetLogicId();
 
   // Loop through all reactions to see if any have been triggered...
   const int num_reactions = reaction_lib.GetSize();
@@ -1297,6 +1301,14 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
     cTaskEntry* cur_task = cur_reaction->GetTask();
     assert(cur_task != NULL);
 
+    // Logic tasks that can not be satisfied by this output are skipped outright, unless a phenotypic plasticity bonus
+    // may force the task to be marked anyway
+    const bool logic_match = cur_task->IsLogicTask() && cur_task->MatchesLogicId(logic_id);
+    if (cur_task->IsLogicTask() && !logic_match && context_phenotype == NULL &&
+        !HasPhenPlastBonus(cur_reaction->GetProcesses())) {
+      continue;
+    }
+
     taskctx.SetTaskEntry(cur_task); // Set task entry in the context, so that tasks can reference task settings
     const int task_id = cur_task->GetID();
     const int task_cnt = task_count[task_id];
@@ -1330,7 +1342,7 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
       }
     }
 
-    const double task_quality = m_tasklib.TestOutput(taskctx);
+    const double task_quality = cur_task->IsLogicTask() ? (logic_match ? 1.0 : 0.0) : m_tasklib.TestOutput(taskctx);
     assert(task_quality >= 0.0);
 
     // If this task wasn't performed, move on to the next one.
@@ -1527,6 +1539,16 @@ bool cEnvironment::TestContextRequisites(const cReaction* cur_reaction,
 
 
 
+bool cEnvironment::HasPhenPlastBonus(const tList<cReactionProcess>& req_proc)
+{
+  tLWConstListIterator<cReactionProcess> proc_it(req_proc);
+  cReactionProcess* cur_proc;
+  while ((cur_proc = proc_it.Next()) != NULL) {
+    if (cur_proc->GetPhenPlastBonusMethod() != DEFAULT) return true;
+  }
+  return false;
+}
+
 double cEnvironment::GetTaskProbability(cAvidaContext& ctx, cTaskContext& taskctx,
                                         const tList<cReactionProcess>& req_proc, bool& force_mark_task) const
 {
@@ -1835,6 +1857,7 @@ bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, dou
       assert(cur_reaction != NULL);
       cur_reaction->ModifyValue(value);
     }
+    recordChange(cStringUtil::Stringf("value ALL %.17g", value));
 
     return true;
   }
@@ -1854,6 +1877,7 @@ bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, dou
       cReaction* cur_reaction = reaction_lib.GetReaction(reaction_ids[i]);
       assert(cur_reaction != NULL);
       cur_reaction->ModifyValue(value);
+      recordChange(cStringUtil::Stringf("value %s %.17g", (const char*)cur_reaction->GetName(), value));
     }
     return true;
   }
@@ -1861,6 +1885,7 @@ bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, dou
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->ModifyValue(value);
+  recordChange(cStringUtil::Stringf("value %s %.17g", (const char*)name, value));
   return true;
 }
 
@@ -1869,6 +1894,7 @@ bool cEnvironment::SetReactionValueMult(const cString& name, double value_mult)
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->MultiplyValue(value_mult);
+  recordChange(cStringUtil::Stringf("value_mult %s %.17g", (const char*)name, value_mult));
   return true;
 }
 
@@ -1877,6 +1903,7 @@ bool cEnvironment::SetReactionInst(const cString& name, cString inst_name)
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->ModifyInst(inst_name);
+  recordChange(cStringUtil::Stringf("inst %s %s", (const char*)name, (const char*)inst_name));
   return true;
 }
 
@@ -1884,6 +1911,7 @@ bool cEnvironment::SetReactionMinTaskCount(const cString& name, int min_count)
 {
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
+  recordChange(cStringUtil::Stringf("min_task_count %s %d", (const char*)name, min_count));
   return found_reaction->SetMinTaskCount( min_count );
 }
 
@@ -1891,6 +1919,7 @@ bool cEnvironment::SetReactionMaxTaskCount(const cString& name, int max_count)
 {
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
+  recordChange(cStringUtil::Stringf("max_task_count %s %d", (const char*)name, max_count));
   return found_reaction->SetMaxTaskCount( max_count );
 }
 
@@ -1898,6 +1927,7 @@ bool cEnvironment::SetReactionMinCount(const cString& name, int reaction_min_cou
 {
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
+  recordChange(cStringUtil::Stringf("min_count %s %d", (const char*)name, reaction_min_count));
   return found_reaction->SetMinReactionCount( reaction_min_count );
 }
 
@@ -1905,6 +1935,7 @@ bool cEnvironment::SetReactionMaxCount(const cString& name, int reaction_max_cou
 {
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
+  recordChange(cStringUtil::Stringf("max_count %s %d", (const char*)name, reaction_max_count));
   return found_reaction->SetMaxReactionCount( reaction_max_count );
 }
 
@@ -1918,6 +1949,7 @@ bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
     if (m_tasklib.GetTask(i).GetName() == task)
     {
       found_reaction->SetTask( m_tasklib.GetTaskReference(i) );
+      recordChange(cStringUtil::Stringf("task %s %s", (const char*)name, (const char*)task));
       return true;
     }
   }
@@ -1930,6 +1962,7 @@ bool cEnvironment::SetResourceInflow(const cString& name, double _inflow )
   cResource* found_resource = resource_lib.GetResource(name);
   if (found_resource == NULL) return false;
   found_resource->SetInflow( _inflow );
+  recordChange(cStringUtil::Stringf("inflow %s %.17g", (const char*)name, _inflow));
   return true;
 }
 
@@ -1938,6 +1971,7 @@ bool cEnvironment::SetResourceOutflow(const cString& name, double _outflow )
   cResource* found_resource = resource_lib.GetResource(name);
   if (found_resource == NULL) return false;
   found_resource->SetOutflow( _outflow );
+  recordChange(cStringUtil::Stringf("outflow %s %.17g", (const char*)name, _outflow));
   return true;
 }
 
@@ -1945,9 +1979,28 @@ bool cEnvironment::ChangeResource(cReaction* reaction, const cString& res, int p
 {
   cReactionProcess* process = reaction->GetProcess(process_num);
   process->SetResource(m_world->GetEnvironment().GetResourceLib().GetResource(res));
+  recordChange(cStringUtil::Stringf("resource %s %d %s", (const char*)reaction->GetName(), process_num, (const char*)res));
   return true;
 }
 
+uint64_t cEnvironment::GetFingerprint() const
+{
+  // Specific inputs are set directly rather than through definition lines
+  uint64_t hash = m_definition_hash;
+  if (m_use_specific_inputs) {
+    for (int i = 0; i < m_specific_inputs.GetSize(); i++) {
+      hash = cStringUtil::Hash(cStringUtil::Stringf("%d", m_specific_inputs[i]), hash);
+    }
+    hash = cStringUtil::Hash(cStringUtil::Stringf("mask %u", m_mask), hash);
+  }
+  return hash;
+}
+
+void cEnvironment::recordChange(const cString& desc)
+{
+  m_definition_hash = cStringUtil::Hash(desc, m_definition_hash);
+}
+
 /*
  helper function that checks if this is a valid group id. The ids are specified
  in the environment file as tasks.
@@ -34,6 +34,7 @@
 #include "tList.h"
 
 #include <set>
+#include <stdint.h>
 
 
 namespace Avida {
@@ -83,6 +84,8 @@ private:
   bool m_hammers;
   bool m_paths;
   
+  uint64_t m_definition_hash;   // running hash of every definition line and later change, see GetFingerprint()
+  
   cEnvironment(); // @not_implemented
   cEnvironment(const cEnvironment&); // @not_implemented
   cEnvironment& operator=(const cEnvironment&); // @not_implemented
@@ -99,6 +102,7 @@ public:
   void SetSpecificInputs(const Apto::Array<int> in_input_array) { m_use_specific_inputs = true; m_specific_inputs = in_input_array; }
   void SetSpecificRandomMask(unsigned int mask) { m_mask = mask; }
   void SwapInputs(cAvidaContext& ctx, Apto::Array<int>& src_input_array, Apto::Array<int>& dest_input_array) const;
+  bool HasFixedInputs(bool random) const { return (m_use_specific_inputs) ? (m_mask == 0) : !random; }
 
 
   bool TestInput(cReactionResult& result, const tBuffer<int>& inputs,
@@ -164,8 +168,12 @@ public:
   bool HasHammer() { return m_hammers; }
   bool HasPath() { return m_paths; }
   std::set<int> GetHabitats() { return possible_habitats; }
+  
+  // Environments loaded from the same definition lines, changed in the same ways since, have the same fingerprint
+  uint64_t GetFingerprint() const;
 
 private:
+  void recordChange(const cString& desc);
   
   bool ParseSetting(cString entry, cString& var_name, cString& var_value, const cString& var_type, Feedback& feedback);
   bool AssertInputInt(const cString& input, const cString& name, const cString& type, Feedback& feedback);
@@ -186,6 +194,7 @@ private:
   double GetTaskProbability(cAvidaContext& ctx, cTaskContext& taskctx,
 
                             const tList<cReactionProcess>& req_proc, bool& force_mark_task) const;
+  static bool HasPhenPlastBonus(const tList<cReactionProcess>& req_proc);
   
   bool TestRequisites(cTaskContext& taskctx, const cReaction* cur_reaction, int task_count,
                       const Apto::Array<int>& reaction_count, const bool on_divide = false, bool is_parasite=false) const;
@@ -26,10 +26,12 @@
 
 #include "cActionLibrary.h"
 #include "cInitFile.h"
+#include "cStateArchive.h"
 #include "cStats.h"
 #include "cString.h"
 #include "cWorld.h"
 
+#include <algorithm>
 #include <cfloat>           // for DBL_MIN
 #include <iostream>
 
@@ -42,6 +44,33 @@ const double cEventList::TRIGGER_ALL = 0.0;
 const double cEventList::TRIGGER_ONCE = DBL_MAX;
 
 
+cEventList::cEventList(cWorld* world) : m_world(world), m_head(NULL), m_tail(NULL), m_num_events(0), m_next_order(0)
+{
+  for (int i = 0; i < NUM_TRIGGER_TYPES; i++) m_last_trigger[i] = -DBL_MAX;
+}
+
+
+// Trigger value at which an event becomes due; events set to begin, and immediate ones, are due at any value
+double cEventList::queueKey(const cEventListEntry* entry)
+{
+  if (entry->GetTrigger() == IMMEDIATE || entry->GetStart() == TRIGGER_BEGIN) return -DBL_MAX;
+  return entry->GetStart();
+}
+
+// Events sharing a trigger value are ordered as they appear in the list, so that the queues pop them deterministically
+bool cEventList::queueBefore(const cEventListEntry* entry1, const cEventListEntry* entry2)
+{
+  const double key1 = queueKey(entry1);
+  const double key2 = queueKey(entry2);
+  return (key1 < key2 || (key1 == key2 && entry1->GetOrder() < entry2->GetOrder()));
+}
+
+bool cEventList::orderBefore(const cEventListEntry* entry1, const cEventListEntry* entry2)
+{
+  return (entry1->GetOrder() < entry2->GetOrder());
+}
+
+
 cEventList::~cEventList()
 {
   cEventListEntry* current = NULL;
@@ -59,7 +88,7 @@ bool cEventList::AddEvent(eTriggerType trigger, double start, double interval,
   cAction* action = cActionLibrary::GetInstance().Create((const char*)name, m_world, args, feedback);
   
   if (action != NULL) {
-    cEventListEntry* entry = new cEventListEntry(action, name, trigger, start, interval, stop);
+    cEventListEntry* entry = new cEventListEntry(action, name, m_next_order++, trigger, start, interval, stop);
     
     // If there are no events in the list yet.
     if (m_tail == NULL) {
@@ -73,7 +102,7 @@ bool cEventList::AddEvent(eTriggerType trigger, double start, double interval,
       m_tail = entry;
     }
     
-    SyncEvent(entry);
+    if (SyncEvent(entry)) QueueEvent(entry);
 		
 		if (trigger == BIRTHS_INTERRUPT)  //Operates outside of usual event processing
 			QueueBirthInterruptEvent(start);
@@ -103,6 +132,67 @@ bool cEventList::LoadEventFile(const cString& filename, const cString& working_d
 }
 
 
+void cEventList::CheckpointState(cStateArchive& ar, Feedback& feedback)
+{
+  ar.Tag("cEventList");
+  
+  if (ar.IsSaving()) {
+    int num_entries = 0;
+    for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) num_entries++;
+    ar.Transfer(num_entries);
+    
+    for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) {
+      cString name = entry->GetName();
+      cString args = entry->GetArgs();
+      int trigger = entry->GetTrigger();
+      double start = entry->GetStart();
+      double interval = entry->GetInterval();
+      double stop = entry->GetStop();
+      ar.Transfer(name);
+      ar.Transfer(args);
+      ar.Transfer(trigger);
+      ar.Transfer(start);
+      ar.Transfer(interval);
+      ar.Transfer(stop);
+    }
+    return;
+  }
+  
+  int num_entries = 0;
+  ar.Transfer(num_entries);
+  if (!ar.IsGood()) return;
+  
+  // The saved list replaces the current one entirely; events that had already fired when the checkpoint was written
+  // are not in it, and so will not fire a second time.
+  ClearQueues();
+  while (m_head != NULL) Delete(m_head);
+  m_num_events = 0;
+  while (m_birth_interrupt_queue.GetSize()) delete m_birth_interrupt_queue.Pop();
+  
+  for (int i = 0; i < num_entries && ar.IsGood(); i++) {
+    cString name;
+    cString args;
+    int trigger = UPDATE;
+    double start = 0.0;
+    double interval = 0.0;
+    double stop = 0.0;
+    ar.Transfer(name);
+    ar.Transfer(args);
+    ar.Transfer(trigger);
+    ar.Transfer(start);
+    ar.Transfer(interval);
+    ar.Transfer(stop);
+    if (!ar.IsGood()) return;
+    if (trigger < UPDATE || trigger > BIRTHS_INTERRUPT) {
+      ar.Fail("invalid event trigger in checkpoint");
+      return;
+    }
+    if (!AddEvent((eTriggerType)trigger, start, interval, stop, name, args, feedback)) {
+      ar.Fail(cString("unable to restore event '") + name + "'");
+    }
+  }
+}
+
 void cEventList::Delete(cEventListEntry* entry) 
 {
   assert(entry != NULL);
@@ -151,53 +241,51 @@ double cEventList::GetTriggerValue(eTriggerType trigger) const
 
 void cEventList::Process(cAvidaContext& ctx)
 {
-  double t_val = 0; // trigger value
+  // Only events that have reached their trigger value come off the queues.  They are then run in list order, as a
+  // walk of the whole list would have run them, with each trigger value read once at the start of the pass.
+  Apto::Array<cEventListEntry*, Apto::Smart> due;
+  CollectDueEvents(IMMEDIATE, TRIGGER_BEGIN, false, due);
+  CollectDueEvents(UPDATE, GetTriggerValue(UPDATE), false, due);
+  CollectDueEvents(GENERATION, GetTriggerValue(GENERATION), false, due);
+  CollectDueEvents(BIRTHS, GetTriggerValue(BIRTHS), false, due);
+  //BIRTHS_INTERRUPT occur outside of update boundaries
+  //and should not alter the behavior of other events.
+  if (!due.GetSize()) return;
   
-  // Iterate through all entrys in event list
-  cEventListEntry* entry = m_head;
-  while (entry != NULL) {
-    cEventListEntry* next_entry = entry->GetNext();
+  std::sort(&due[0], &due[0] + due.GetSize(), orderBefore);
+  
+  for (int i = 0; i < due.GetSize(); i++) {
+    cEventListEntry* entry = due[i];
     
-    // Check trigger condition
+    // Process the Action
+    entry->GetAction()->Process(ctx);
     
     // IMMEDIATE Events always happen and are always deleted
     if (entry->GetTrigger() == IMMEDIATE) {
-      entry->GetAction()->Process(ctx);
       Delete(entry);
-    } else if (entry->GetTrigger() != BIRTHS_INTERRUPT) {
-      //BIRTHS_INTERRUPT occur outside of update boundaries
-	  //and should not alter the behavior of other events.
-	  
-	  // Get the value of the appropriate trigger varile
-      t_val = GetTriggerValue(entry->GetTrigger());
-      
-      if (t_val != DBL_MAX &&
-          (t_val >= entry->GetStart() || entry->GetStart() == TRIGGER_BEGIN) &&
-          (t_val <= entry->GetStop() || entry->GetStop() == TRIGGER_END)) {
-
-        // Process the Action
-        entry->GetAction()->Process(ctx);
-        
-        // Handle Interval Adjustment
-        if (entry->GetInterval() == TRIGGER_ALL) {
-          // Do Nothing
-        } else if (entry->GetInterval() == TRIGGER_ONCE) {
-          // If it is a onetime thing, remove it...
-          Delete(entry);
-          entry = NULL;
-        } else {
-          // There is an interval.. so add it
-          entry->NextInterval();
-        }
-        
-        // If the event can never happen now... excize it
-        if (entry != NULL && entry->GetStop() != TRIGGER_END &&
-            ((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
-             (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0)))
-            Delete(entry);
-      }
-    } 
-    entry = next_entry;
+      continue;
+    }
+    
+    // Handle Interval Adjustment
+    if (entry->GetInterval() == TRIGGER_ALL) {
+      // Do Nothing
+    } else if (entry->GetInterval() == TRIGGER_ONCE) {
+      // If it is a onetime thing, remove it...
+      Delete(entry);
+      continue;
+    } else {
+      // There is an interval.. so add it
+      entry->NextInterval();
+    }
+    
+    // If the event can never happen now... excize it
+    if (entry->GetStop() != TRIGGER_END &&
+        ((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
+         (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0))) {
+      Delete(entry);
+    } else {
+      QueueEvent(entry);
+    }
   }
 }
 
@@ -215,49 +303,41 @@ void cEventList::Process(cAvidaContext& ctx)
 */
 void cEventList::ProcessInterrupt(cAvidaContext& ctx)
 {
-	double t_val = 0; // trigger value
+	// BIRTHS_INTERRUPT events *must* happen at exactly their trigger value
+	Apto::Array<cEventListEntry*, Apto::Smart> due;
+	CollectDueEvents(BIRTHS_INTERRUPT, GetTriggerValue(BIRTHS_INTERRUPT), true, due);
+	if (!due.GetSize()) return;
 	
-	// Iterate through all entrys in event list
-	cEventListEntry* entry = m_head;
-	while (entry != NULL) {
-		cEventListEntry* next_entry = entry->GetNext();
+	std::sort(&due[0], &due[0] + due.GetSize(), orderBefore);
+	
+	for (int i = 0; i < due.GetSize(); i++) {
+		cEventListEntry* entry = due[i];
+		
+		// Process the Action
+		entry->GetAction()->Process(ctx);
+		
+		// Handle Interval Adjustment
+		if (entry->GetInterval() == TRIGGER_ALL) {
+			// Do Nothing
+		} else if (entry->GetInterval() == TRIGGER_ONCE) {
+			// If it is a onetime thing, remove it...
+			Delete(entry);
+			continue;
+		} else {
+			// There is an interval.. so add it
+			entry->NextInterval();
+		}
 		
-		//BIRTHS_INTERRUPT occur outside of update boundaries
-		//and should not alter the behavior of other events.
-		if (entry->GetTrigger() == BIRTHS_INTERRUPT) {
-			
-			// Get the value of the appropriate trigger varile
-			t_val = GetTriggerValue(entry->GetTrigger());
-			
-			if (t_val == entry->GetStart() ) {  //This event *must* happen at this value
-				
-				// Process the Action
-				entry->GetAction()->Process(ctx);
-				
-				// Handle Interval Adjustment
-				if (entry->GetInterval() == TRIGGER_ALL) {
-					// Do Nothing
-				} else if (entry->GetInterval() == TRIGGER_ONCE) {
-					// If it is a onetime thing, remove it...
-					Delete(entry);
-					entry = NULL;
-				} else {
-					// There is an interval.. so add it
-					entry->NextInterval();
-				}
-				
-				// If the event can never happen now... excize it
-				if (entry != NULL && entry->GetStop() != TRIGGER_END &&
-					((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
-					 (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0))){
-					Delete(entry);
-				} else {
-					// We have to add this entry to the BirthInterrupt queue
-					QueueBirthInterruptEvent(entry->GetStart());
-				}
-			}
-		} 
-		entry = next_entry;
+		// If the event can never happen now... excize it
+		if (entry->GetStop() != TRIGGER_END &&
+			((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
+			 (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0))){
+			Delete(entry);
+		} else {
+			// We have to add this entry to the BirthInterrupt queue
+			QueueBirthInterruptEvent(entry->GetStart());
+			QueueEvent(entry);
+		}
 	}
 }
 
@@ -271,26 +351,29 @@ void cEventList::Sync()
     SyncEvent(entry);
     entry = next_entry;
   }
+  
+  // Starts may have been rewound or fast forwarded, and trigger values may have jumped either way
+  RebuildQueues();
 }
 
 
-void cEventList::SyncEvent(cEventListEntry* entry)
+bool cEventList::SyncEvent(cEventListEntry* entry)
 {
   // Ignore events that are immdeiate
-  if (entry->GetTrigger() == IMMEDIATE) return;
+  if (entry->GetTrigger() == IMMEDIATE) return true;
   
   double t_val = GetTriggerValue(entry->GetTrigger());
   
   // If t_val has past the end, remove (even if it is TRIGGER_ALL)
   if (t_val > entry->GetStop()) {
     Delete(entry);
-    return;
+    return false;
   }
   
   // If it is a trigger once and has passed, remove
   if (t_val > entry->GetStart() && entry->GetInterval() == TRIGGER_ONCE) {
     Delete(entry);
-    return;
+    return false;
   }
   
   // If for some reason t_val has been reset or soemthing, rewind
@@ -299,10 +382,125 @@ void cEventList::SyncEvent(cEventListEntry* entry)
   }
   
   // Can't fast forward events that are Triger All
-  if (entry->GetInterval() == TRIGGER_ALL) return;
+  if (entry->GetInterval() == TRIGGER_ALL) return true;
   
   // Keep adding interval to start until we are caught up
   while (t_val > entry->GetStart()) entry->NextInterval();
+  return true;
+}
+
+
+double cEventList::GetNextTrigger(eTriggerType trigger) const
+{
+  if (!m_queue[trigger].GetSize()) return TRIGGER_END;
+  if (trigger == IMMEDIATE) return TRIGGER_BEGIN;
+  return m_queue[trigger][0]->GetStart();
+}
+
+
+bool cEventList::IsEventDue() const
+{
+  if (m_queue[IMMEDIATE].GetSize()) return true;
+  
+  const eTriggerType triggers[] = { UPDATE, GENERATION, BIRTHS };
+  for (int i = 0; i < 3; i++) {
+    const eTriggerType trigger = triggers[i];
+    if (!m_queue[trigger].GetSize() && !m_expired[trigger].GetSize()) continue;
+    
+    const double t_val = GetTriggerValue(trigger);
+    if (m_queue[trigger].GetSize() && queueKey(m_queue[trigger][0]) <= t_val) return true;
+    if (m_expired[trigger].GetSize() && t_val < m_last_trigger[trigger]) return true;
+  }
+  return false;
+}
+
+
+void cEventList::QueueEvent(cEventListEntry* entry)
+{
+  // UNDEFINED events can never fire
+  if (entry->GetTrigger() == UNDEFINED) return;
+  
+  Apto::Array<cEventListEntry*, Apto::Smart>& queue = m_queue[entry->GetTrigger()];
+  int pos = queue.GetSize();
+  queue.Push(entry);
+  while (pos > 0) {
+    const int parent = (pos - 1) / 2;
+    if (!queueBefore(entry, queue[parent])) break;
+    queue[pos] = queue[parent];
+    pos = parent;
+  }
+  queue[pos] = entry;
+}
+
+
+cEventList::cEventListEntry* cEventList::DequeueEvent(int trigger)
+{
+  Apto::Array<cEventListEntry*, Apto::Smart>& queue = m_queue[trigger];
+  assert(queue.GetSize() > 0);
+  
+  cEventListEntry* top = queue[0];
+  cEventListEntry* entry = queue[queue.GetSize() - 1];
+  queue.Resize(queue.GetSize() - 1);
+  
+  const int size = queue.GetSize();
+  if (size) {
+    int pos = 0;
+    while (true) {
+      int child = 2 * pos + 1;
+      if (child >= size) break;
+      if (child + 1 < size && queueBefore(queue[child + 1], queue[child])) child++;
+      if (!queueBefore(queue[child], entry)) break;
+      queue[pos] = queue[child];
+      pos = child;
+    }
+    queue[pos] = entry;
+  }
+  
+  return top;
+}
+
+
+// Moves every event of the trigger type that fires at t_val into due.  With exact set an event fires only when t_val is
+// its start value, otherwise whenever t_val has reached its start without passing its stop.
+void cEventList::CollectDueEvents(int trigger, double t_val, bool exact, Apto::Array<cEventListEntry*, Apto::Smart>& due)
+{
+  // Events set aside past their stop can only fire again after the trigger value has dropped
+  Apto::Array<cEventListEntry*, Apto::Smart>& expired = m_expired[trigger];
+  if (t_val < m_last_trigger[trigger] && expired.GetSize()) {
+    for (int i = 0; i < expired.GetSize(); i++) QueueEvent(expired[i]);
+    expired.Resize(0);
+  }
+  m_last_trigger[trigger] = t_val;
+  
+  if (t_val == DBL_MAX) return;
+  
+  while (m_queue[trigger].GetSize() && queueKey(m_queue[trigger][0]) <= t_val) {
+    cEventListEntry* entry = DequeueEvent(trigger);
+    
+    bool fires = false;
+    if (exact) fires = (t_val == entry->GetStart());
+    else fires = (trigger == IMMEDIATE || t_val <= entry->GetStop() || entry->GetStop() == TRIGGER_END);
+    
+    if (fires) due.Push(entry);
+    else expired.Push(entry);
+  }
+}
+
+
+void cEventList::ClearQueues()
+{
+  for (int i = 0; i < NUM_TRIGGER_TYPES; i++) {
+    m_queue[i].Resize(0);
+    m_expired[i].Resize(0);
+    m_last_trigger[i] = -DBL_MAX;
+  }
+}
+
+
+void cEventList::RebuildQueues()
+{
+  ClearQueues();
+  for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) QueueEvent(entry);
 }
 
 
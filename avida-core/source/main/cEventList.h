@@ -35,6 +35,7 @@ namespace Avida {
 };
 
 class cAvidaContext;
+class cStateArchive;
 class cString;
 class cWorld;
 
@@ -71,27 +72,46 @@ private:
   class cEventListEntry;  
   
 private:
+  static const int NUM_TRIGGER_TYPES = BIRTHS_INTERRUPT + 1;
+  
   cWorld* m_world;
   cEventListEntry* m_head;
   cEventListEntry* m_tail;
   int m_num_events;
+  int m_next_order;
+  
+  // Pending events of each trigger type, in a min-heap on the trigger value at which they next fire.  Events that
+  // have reached their start but are past their stop are set aside, and only return to the heap if the trigger
+  // value later falls back below where it was last seen.
+  Apto::Array<cEventListEntry*, Apto::Smart> m_queue[NUM_TRIGGER_TYPES];
+  Apto::Array<cEventListEntry*, Apto::Smart> m_expired[NUM_TRIGGER_TYPES];
+  double m_last_trigger[NUM_TRIGGER_TYPES];
   
   tList<double> m_birth_interrupt_queue;
   
   void QueueBirthInterruptEvent(double t_val);
   void DequeueBirthInterruptEvent(double t_val);
   
-  void SyncEvent(cEventListEntry* event);
+  bool SyncEvent(cEventListEntry* event);
   double GetTriggerValue(eTriggerType trigger) const;
   void Delete(cEventListEntry* entry);
   
+  void QueueEvent(cEventListEntry* entry);
+  cEventListEntry* DequeueEvent(int trigger);
+  void CollectDueEvents(int trigger, double t_val, bool exact, Apto::Array<cEventListEntry*, Apto::Smart>& due);
+  void ClearQueues();
+  void RebuildQueues();
+  static double queueKey(const cEventListEntry* entry);
+  static bool queueBefore(const cEventListEntry* entry1, const cEventListEntry* entry2);
+  static bool orderBefore(const cEventListEntry* entry1, const cEventListEntry* entry2);
+  
   cEventList(); // @not_implemented
   cEventList(const cEventList&); // @not_implemented
   cEventList& operator=(const cEventList&); // @not_implemented
   
   
 public:
-  cEventList(cWorld* world) : m_world(world), m_head(NULL), m_tail(NULL), m_num_events(0) { ; }
+  cEventList(cWorld* world);
   ~cEventList();
   
   
@@ -111,8 +131,17 @@ public:
   void Process(cAvidaContext& ctx);
   void Sync(); // Get all events caught up.
   
+  // Trigger value at which the next event of the given type will fire (TRIGGER_BEGIN if one is waiting to fire at
+  // once, TRIGGER_END if there is none), and whether Process would fire anything right now.
+  double GetNextTrigger(eTriggerType trigger) const;
+  bool IsEventDue() const;
+  
   void PrintEventList(std::ostream& os = std::cout);
   
+  // Saves the pending events, or replaces the current event list with the saved one.  Stats must already be loaded,
+  // since the restored events are synchronized to the checkpoint's update.
+  void CheckpointState(cStateArchive& ar, Feedback& feedback);
+  
   /**
    * Returns true if a particular org_id (or Stats::tot_creature) value is present
    * in the interrupt queue.
@@ -145,16 +174,17 @@ private:
     double m_interval;
     double m_stop;
     double m_original_start;
+    int m_order;
     
     cEventListEntry* m_prev;
     cEventListEntry* m_next;
     
   public:
-    cEventListEntry(cAction* action, const cString& name, eTriggerType trigger = UPDATE, double start = TRIGGER_BEGIN,
-                    double interval = TRIGGER_ONCE, double stop = TRIGGER_END, cEventListEntry* prev = NULL,
-                    cEventListEntry* next = NULL)
+    cEventListEntry(cAction* action, const cString& name, int order, eTriggerType trigger = UPDATE,
+                    double start = TRIGGER_BEGIN, double interval = TRIGGER_ONCE, double stop = TRIGGER_END,
+                    cEventListEntry* prev = NULL, cEventListEntry* next = NULL)
     : m_action(action), m_name(name), m_trigger(trigger), m_start(start), m_interval(interval), m_stop(stop)
-    , m_original_start(start), m_prev(prev), m_next(next)
+    , m_original_start(start), m_order(order), m_prev(prev), m_next(next)
     {
     }
     
@@ -176,6 +206,7 @@ private:
     double GetStart() const { return m_start; }
     double GetInterval() const { return m_interval; }
     double GetStop() const { return m_stop; }
+    int GetOrder() const { return m_order; }  // position in the list, events fire in this order
     
     cEventListEntry* GetPrev() const { return m_prev; }
     cEventListEntry* GetNext() const { return m_next; }
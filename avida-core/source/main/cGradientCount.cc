@@ -28,6 +28,7 @@
 
 #include "cAvidaContext.h"
 #include "cPopulation.h"
+#include "cStateArchive.h"
 #include "cStats.h"
 #include "cWorld.h"
 
@@ -125,6 +126,11 @@ cGradientCount::cGradientCount(cWorld* world, int peakx, int peaky, int height,
 
 cGradientCount::~cGradientCount() { ; }
 
+void cGradientCount::CheckpointState(cStateArchive& ar)
+{
+  ar.Fail("gradient resources can not be checkpointed");
+}
+
 void cGradientCount::StateAll()
 {
   return;
@@ -24,6 +24,7 @@
 
 #include "cWorld.h"
 #include "cAvidaConfig.h"
+#include "cStateArchive.h"
 
 
 void cMutationRates::Setup(cWorld* world)
@@ -124,6 +125,24 @@ void cMutationRates::Clear()
   update.death_prob = 0.0;
 }
 
+bool cMutationRates::IsZero() const
+{
+  return (copy.mut_prob == 0.0 && copy.ins_prob == 0.0 && copy.del_prob == 0.0 && copy.uniform_prob == 0.0 &&
+          copy.slip_prob == 0.0 &&
+          divide.ins_prob == 0.0 && divide.del_prob == 0.0 && divide.mut_prob == 0.0 && divide.uniform_prob == 0.0 &&
+          divide.slip_prob == 0.0 && divide.trans_prob == 0.0 && divide.lgt_prob == 0.0 &&
+          divide.divide_mut_prob == 0.0 && divide.divide_ins_prob == 0.0 && divide.divide_del_prob == 0.0 &&
+          divide.divide_uniform_prob == 0.0 && divide.divide_slip_prob == 0.0 && divide.divide_trans_prob == 0.0 &&
+          divide.divide_lgt_prob == 0.0 &&
+          divide.divide_poisson_mut_mean == 0.0 && divide.divide_poisson_ins_mean == 0.0 &&
+          divide.divide_poisson_del_mean == 0.0 && divide.divide_poisson_slip_mean == 0.0 &&
+          divide.divide_poisson_trans_mean == 0.0 && divide.divide_poisson_lgt_mean == 0.0 &&
+          divide.parent_mut_prob == 0.0 && divide.parent_ins_prob == 0.0 && divide.parent_del_prob == 0.0 &&
+          point.ins_prob == 0.0 && point.del_prob == 0.0 && point.mut_prob == 0.0 &&
+          inject.ins_prob == 0.0 && inject.del_prob == 0.0 && inject.mut_prob == 0.0 &&
+          meta.copy_mut_prob == 0.0 && update.death_prob == 0.0);
+}
+
 void cMutationRates::Copy(const cMutationRates& in_muts)
 {
   copy = in_muts.copy;
@@ -133,3 +152,46 @@ void cMutationRates::Copy(const cMutationRates& in_muts)
   meta = in_muts.meta;
   update = in_muts.update;
 }
+
+
+void cMutationRates::CheckpointState(cStateArchive& ar)
+{
+  ar.Tag("cMutationRates");
+  ar.Transfer(copy.mut_prob);
+  ar.Transfer(copy.ins_prob);
+  ar.Transfer(copy.del_prob);
+  ar.Transfer(copy.uniform_prob);
+  ar.Transfer(copy.slip_prob);
+  ar.Transfer(divide.ins_prob);
+  ar.Transfer(divide.del_prob);
+  ar.Transfer(divide.mut_prob);
+  ar.Transfer(divide.uniform_prob);
+  ar.Transfer(divide.slip_prob);
+  ar.Transfer(divide.trans_prob);
+  ar.Transfer(divide.lgt_prob);
+  ar.Transfer(divide.divide_mut_prob);
+  ar.Transfer(divide.divide_ins_prob);
+  ar.Transfer(divide.divide_del_prob);
+  ar.Transfer(divide.divide_uniform_prob);
+  ar.Transfer(divide.divide_slip_prob);
+  ar.Transfer(divide.divide_trans_prob);
+  ar.Transfer(divide.divide_lgt_prob);
+  ar.Transfer(divide.divide_poisson_mut_mean);
+  ar.Transfer(divide.divide_poisson_ins_mean);
+  ar.Transfer(divide.divide_poisson_del_mean);
+  ar.Transfer(divide.divide_poisson_slip_mean);
+  ar.Transfer(divide.divide_poisson_trans_mean);
+  ar.Transfer(divide.divide_poisson_lgt_mean);
+  ar.Transfer(divide.parent_mut_prob);
+  ar.Transfer(divide.parent_ins_prob);
+  ar.Transfer(divide.parent_del_prob);
+  ar.Transfer(point.ins_prob);
+  ar.Transfer(point.del_prob);
+  ar.Transfer(point.mut_prob);
+  ar.Transfer(inject.ins_prob);
+  ar.Transfer(inject.del_prob);
+  ar.Transfer(inject.mut_prob);
+  ar.Transfer(meta.copy_mut_prob);
+  ar.Transfer(meta.standard_dev);
+  ar.Transfer(update.death_prob);
+}
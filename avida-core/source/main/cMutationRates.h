@@ -25,6 +25,7 @@
 
 #include "cAvidaContext.h"
 
+class cStateArchive;
 class cWorld;
 
 class cMutationRates
@@ -107,6 +108,8 @@ public:
   void Setup(cWorld* world);
   void Clear();
   void Copy(const cMutationRates& in_muts);
+  bool IsZero() const;  // True when no mutation (or random death) can occur
+  void CheckpointState(cStateArchive& ar);
 
   // Copy muts should always check if they are 0.0 before consulting the random number generator for performance
   bool TestCopyMut(cAvidaContext& ctx) const { return (copy.mut_prob == 0.0) ? false : ctx.GetRandom().P(copy.mut_prob); }
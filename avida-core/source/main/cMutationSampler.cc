@@ -0,0 +1,71 @@
+/*
+ *  cMutationSampler.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cMutationSampler.h"
+
+#include "cAvidaContext.h"
+#include "cStateArchive.h"
+
+#include <cmath>
+
+
+// Skips are capped well below the range of m_skip; a run of that many trials never occurs in practice
+static const double MAX_SKIP = 4.0e18;
+
+
+int cMutationSampler::Count(cAvidaContext& ctx, double prob, int num_trials)
+{
+  int count = 0;
+  int pos = Next(ctx, prob, num_trials);
+  while (pos < num_trials) {
+    count++;
+    pos += 1 + Next(ctx, prob, num_trials - pos - 1);
+  }
+  return count;
+}
+
+
+void cMutationSampler::CheckpointState(cStateArchive& ar)
+{
+  // The pending skip was drawn from the generator, so a resumed run needs it to mutate the same copies
+  ar.Transfer(m_prob);
+  ar.Transfer(m_log_q);
+  ar.Transfer(m_skip);
+}
+
+
+void cMutationSampler::setProb(cAvidaContext& ctx, double prob)
+{
+  m_prob = prob;
+  m_log_q = (prob < 1.0) ? std::log1p(-prob) : 0.0;
+  m_skip = drawSkip(ctx);
+}
+
+
+int64_t cMutationSampler::drawSkip(cAvidaContext& ctx) const
+{
+  if (m_prob >= 1.0) return 0;
+  if (m_log_q == 0.0) return static_cast<int64_t>(MAX_SKIP);  // 1 - p rounds to 1
+
+  // With u uniform on (0, 1], floor(log(u) / log(1 - p)) is k with probability (1 - p)^k * p
+  const double u = 1.0 - ctx.GetRandom().GetDouble();
+  const double skip = std::floor(std::log(u) / m_log_q);
+  return (skip < MAX_SKIP) ? static_cast<int64_t>(skip) : static_cast<int64_t>(MAX_SKIP);
+}
@@ -0,0 +1,78 @@
+/*
+ *  cMutationSampler.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cMutationSampler_h
+#define cMutationSampler_h
+
+#include <stdint.h>
+
+class cAvidaContext;
+class cStateArchive;
+
+
+// cMutationSampler - a sequence of independent trials (sites, copies) that each mutate with a given probability
+//
+// Rather than consulting the random number generator once per trial, the number of trials up to the next mutation is
+// drawn from a geometric distribution, so the generator is only used when a mutation actually occurs.  Since the
+// geometric distribution is memoryless, the count is simply redrawn whenever the probability changes, and a sampler
+// may be discarded at any point; each trial still mutates independently with exactly the requested probability.
+//
+// A sampler must not be shared between sequences that should mutate independently (e.g. a parent and its offspring).
+
+class cMutationSampler
+{
+private:
+  double m_prob;
+  double m_log_q;       // log(1 - m_prob), as log1p(-m_prob) to keep precision at small rates
+  int64_t m_skip;       // trials that will not mutate before the next one that does
+
+public:
+  cMutationSampler() : m_prob(0.0), m_log_q(0.0), m_skip(0) { ; }
+
+  // Consumes the next num_trials trials up to the first that mutates.  Returns the index of that trial, or num_trials
+  // when none of them mutate.
+  inline int Next(cAvidaContext& ctx, double prob, int num_trials)
+  {
+    if (prob <= 0.0 || num_trials <= 0) return num_trials;
+    if (prob != m_prob) setProb(ctx, prob);
+
+    if (m_skip >= num_trials) {
+      m_skip -= num_trials;
+      return num_trials;
+    }
+    const int found = static_cast<int>(m_skip);
+    m_skip = drawSkip(ctx);
+    return found;
+  }
+
+  // Consumes a single trial, returning true if it mutates
+  inline bool Test(cAvidaContext& ctx, double prob) { return Next(ctx, prob, 1) == 0; }
+
+  // Number of the next num_trials trials that mutate
+  int Count(cAvidaContext& ctx, double prob, int num_trials);
+
+  void CheckpointState(cStateArchive& ar);
+
+private:
+  void setProb(cAvidaContext& ctx, double prob);
+  int64_t drawSkip(cAvidaContext& ctx) const;
+};
+
+#endif
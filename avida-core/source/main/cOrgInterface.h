@@ -115,6 +115,8 @@ public:
   virtual const Apto::Array<double>& GetDemeResources(int deme_id, cAvidaContext& ctx) = 0; 
   virtual const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx) = 0; 
   virtual double GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int res_id) = 0;
+  virtual int CountFrozenOccupiedCells(cAvidaContext& ctx, int res_id, int x1, int y1, int x2, int y2) = 0;
+  virtual int CountFrozenEdibleCells(cAvidaContext& ctx, int res_id, double threshold, int x1, int y1, int x2, int y2) = 0;
   virtual double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id) = 0;
   virtual const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) = 0;
   virtual const Apto::Array< Apto::Array<int> >& GetCellIdLists() = 0; 
@@ -23,6 +23,9 @@
 
 #include "cOrgSensor.h"
 
+#include "avida/core/Feedback.h"
+#include "avida/core/WorldDriver.h"
+
 #include "cEnvironment.h"
 #include "cPopulationCell.h"
 #include "cResource.h"
@@ -466,6 +469,9 @@ void cOrgSensor::WalkCells(cAvidaContext& ctx, sLookInit& in_defs, const int fac
   bool foundFirstVisible = false;
   
   bool stop_at_first_found = (search_type == 0) || (habitat_used == -2 && (search_type == -1 || search_type == 1));
+  bool skip_empty = CanSkipEmptyCells(in_defs, val_res);
+  // once something has been seen, a look for edible cells only stops on cells holding a whole unit
+  const bool edible_only = (search_type == 0 && (habitat_used == 0 || habitat_used == 4 || habitat_used > 5));
   
   // START WALKING
   bool first_step = true;
@@ -485,6 +491,17 @@ void cOrgSensor::WalkCells(cAvidaContext& ctx, sLookInit& in_defs, const int fac
       if (!do_left && direction == left) continue;
       if (!do_right && direction == right) break;
       
+      // a side lying wholly in bounds with none of the resources in it would be walked without seeing anything
+      if (skip_empty && num_cells_either_side > 0 && TestBounds(center_cell, tot_bounds)) {
+        const Apto::Coord<int> near_cell = center_cell + direction;
+        const Apto::Coord<int> far_cell = center_cell + direction * num_cells_either_side;
+        if (TestBounds(near_cell, worldBounds) && TestBounds(far_cell, worldBounds) && TestEmptyCells(ctx, near_cell, far_cell, val_res, edible_only && foundFirstVisible)) {
+          any_valid_side_cells = true;
+          first_step = false;
+          continue;
+        }
+      }
+      
       // walk in from the farthest cell on side towards the center
       for (int j = num_cells_either_side; j > 0; j--) {
         bool valid_cell = true;
@@ -676,6 +693,9 @@ void cOrgSensor::WalkTorus(cAvidaContext& ctx, sLookInit& in_defs, const int fac
   bool foundFirstVisible = false;
   
   bool stop_at_first_found = (search_type == 0) || (habitat_used == -2 && (search_type == -1 || search_type == 1));
+  bool skip_empty = CanSkipEmptyCells(in_defs, val_res);
+  // once something has been seen, a look for edible cells only stops on cells holding a whole unit
+  const bool edible_only = (search_type == 0 && (habitat_used == 0 || habitat_used == 4 || habitat_used > 5));
   
   // START WALKING
   bool first_step = true;
@@ -691,6 +711,15 @@ void cOrgSensor::WalkTorus(cAvidaContext& ctx, sLookInit& in_defs, const int fac
     for (int do_lr = 0; do_lr <= 1; do_lr++) {
       if (do_lr == 1) direction = right;
       
+      // an empty side can be passed over whole, wrapping around the world edges as the walk itself does
+      if (skip_empty && num_cells_either_side > 0 && TestBounds(center_cell, tot_bounds) &&
+          TestEmptyCells(ctx, center_cell + direction, center_cell + direction * num_cells_either_side, val_res,
+                         edible_only && foundFirstVisible)) {
+        any_valid_side_cells = true;
+        first_step = false;
+        continue;
+      }
+      
       // walk in from the farthest cell on side towards the center
       for (int j = num_cells_either_side; j > 0; j--) {
         bool valid_cell = true;
@@ -842,6 +871,66 @@ void cOrgSensor::WalkTorus(cAvidaContext& ctx, sLookInit& in_defs, const int fac
   return;
 }
 
+/* An empty cell can only go unseen when every resource looked for needs a positive amount to register.  Whether
+ * the resources are spatial is left to TestEmptyCells, which never reports global resources as empty.
+ */
+bool cOrgSensor::CanSkipEmptyCells(sLookInit& in_defs, const Apto::Array<int, Apto::Smart>& val_res)
+{
+  if (m_world->GetConfig().SENSOR_SKIP_METHOD.Get() == 0) return false;
+  if (in_defs.habitat == -2 || in_defs.habitat == 3) return false;
+  for (int k = 0; k < val_res.GetSize(); k++) {
+    if (!(m_res_lib.GetResource(val_res[k])->GetThreshold() > 0)) return false;
+  }
+  return true;
+}
+
+/* Tests whether none of the resources in val_res has a positive amount anywhere along the row or column of cells from
+ * first_cell to last_cell.  With edible_only, cells holding less than a whole edible unit are also treated as empty.
+ * Coordinates beyond the world edges wrap.
+ */
+bool cOrgSensor::TestEmptyCells(cAvidaContext& ctx, const Apto::Coord<int>& first_cell, const Apto::Coord<int>& last_cell,
+                                const Apto::Array<int, Apto::Smart>& val_res, bool edible_only)
+{
+  const int min_x = Apto::Min(first_cell.X(), last_cell.X());
+  const int max_x = Apto::Max(first_cell.X(), last_cell.X());
+  const int min_y = Apto::Min(first_cell.Y(), last_cell.Y());
+  const int max_y = Apto::Max(first_cell.Y(), last_cell.Y());
+  for (int k = 0; k < val_res.GetSize(); k++) {
+    int count = 0;
+    if (edible_only) {
+      const double threshold = m_res_lib.GetResource(val_res[k])->GetThreshold();
+      count = m_organism->GetOrgInterface().CountFrozenEdibleCells(ctx, val_res[k], threshold, min_x, min_y, max_x, max_y);
+    }
+    else count = m_organism->GetOrgInterface().CountFrozenOccupiedCells(ctx, val_res[k], min_x, min_y, max_x, max_y);
+    if (count != 0) return false;
+  }
+  
+  // SENSOR_SKIP_METHOD 2 walks the skipped cells anyway and stops the run if any of them would have been seen
+  if (m_world->GetConfig().SENSOR_SKIP_METHOD.Get() == 2) {
+    const int worldx = m_world->GetConfig().WORLD_X.Get();
+    const int worldy = m_world->GetConfig().WORLD_Y.Get();
+    const int step_x = (last_cell.X() > first_cell.X()) ? 1 : ((last_cell.X() < first_cell.X()) ? -1 : 0);
+    const int step_y = (last_cell.Y() > first_cell.Y()) ? 1 : ((last_cell.Y() < first_cell.Y()) ? -1 : 0);
+    Apto::Coord<int> cell = first_cell;
+    while (true) {
+      Apto::Coord<int> test_cell(((cell.X() % worldx) + worldx) % worldx, ((cell.Y() % worldy) + worldy) % worldy);
+      for (int k = 0; k < val_res.GetSize(); k++) {
+        const double cell_res = m_organism->GetOrgInterface().GetFrozenCellResVal(ctx, test_cell.X() + test_cell.Y() * worldx, val_res[k]);
+        const double threshold = m_res_lib.GetResource(val_res[k])->GetThreshold();
+        if ((!edible_only && cell_res > 0) || (edible_only && cell_res >= threshold)) {
+          m_world->GetDriver().Feedback().Error("sensor skipped cell %d,%d holding %f of resource %d",
+                                               test_cell.X(), test_cell.Y(), cell_res, val_res[k]);
+          m_world->GetDriver().Abort(Avida::INTERNAL_ERROR);
+          return false;
+        }
+      }
+      if (cell == last_cell) break;
+      cell = cell + Apto::Coord<int>(step_x, step_y);
+    }
+  }
+  return true;
+}
+
 void cOrgSensor::CorrectTorusEdge(Apto::Coord<int>& cell, sBounds& worldBounds)
 {
   if (cell.X() > worldBounds.max_x) { cell.X() = worldBounds.min_x + (cell.X() - worldBounds.max_x - 1); }
@@ -118,6 +118,7 @@ class cOrgSensor
   };
   
   void Reset() { ResetOrgSensor(); }
+  void Rebind(cOrganism* in_organism) { m_organism = in_organism; ResetOrgSensor(); }
   const sLookOut SetLooking(cAvidaContext& ctx, sLookInit& in_defs, int facing, int cell_id, bool use_ft);
   sSearchInfo TestCell(cAvidaContext& ctx, sLookInit& in_defs, const Apto::Coord<int>& target_cell_coords,
                       const Apto::Array<int, Apto::Smart>& val_res, bool first_step, bool stop_at_first_found);
@@ -129,6 +130,9 @@ class cOrgSensor
 
   void WalkTorus(cAvidaContext& ctx, sLookInit& in_defs, const int facing, const int cell_id, sWalkLimits& limits, sLookOut& stuff_seen, Apto::Coord<int>& center_cell, sBounds& tot_bounds, sBounds& worldBounds, const Apto::Array<int, Apto::Smart>& val_res, Apto::Coord<int>& this_cell, const Apto::Coord<int>& ahead_dir, const int& worldx);
   void CorrectTorusEdge(Apto::Coord<int>& cell, sBounds& worldBounds);
+  bool CanSkipEmptyCells(sLookInit& in_defs, const Apto::Array<int, Apto::Smart>& val_res);
+  bool TestEmptyCells(cAvidaContext& ctx, const Apto::Coord<int>& first_cell, const Apto::Coord<int>& last_cell,
+                      const Apto::Array<int, Apto::Smart>& val_res, bool edible_only);
   void GetTorusTravelDist(int& travel_dist, int& x_dist, int& y_dist, const int facing, const int worldx, const int worldy);
   void GetConfusionOddsDensity(cAvidaContext& ctx, double& odds, cOrganism* first_org);
   void GetConfusionOddsFacings(cAvidaContext& ctx, double& odds, cOrganism* first_org);
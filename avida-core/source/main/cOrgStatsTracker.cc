@@ -0,0 +1,574 @@
+/*
+ *  cOrgStatsTracker.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cOrgStatsTracker.h"
+
+#include "avida/core/Feedback.h"
+
+#include "cEnvironment.h"
+#include "cMutationRates.h"
+#include "cOrganism.h"
+#include "cPhenotype.h"
+#include "cStats.h"
+#include "cWorld.h"
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+
+static inline bool isFinite(double value) { return (value - value) == 0.0; }
+
+// Relative comparison used by Validate(); incremental sums accumulate round-off the full scan does not
+static inline bool closeEnough(double incremental, double full)
+{
+  if (!isFinite(incremental) || !isFinite(full)) return (incremental == full) || (incremental != incremental && full != full);
+  const double scale = fabs(incremental) > fabs(full) ? fabs(incremental) : fabs(full);
+  return fabs(incremental - full) <= 1e-6 * ((scale > 1.0) ? scale : 1.0);
+}
+
+
+cOrgStatsTracker::cOrgStatsTracker(cWorld* world)
+  : m_world(world)
+  , m_num_tasks(world->GetEnvironment().GetNumTasks())
+  , m_num_reactions(world->GetEnvironment().GetNumReactions())
+  , m_mut_rates_stale(false)
+  , m_age_n(0.0), m_age_s1(0.0), m_age_s2(0.0), m_age_passes(0)
+  , m_num_breed_true(0), m_num_no_birth(0)
+  , m_extremes_stale(false)
+  , m_tasks(m_num_tasks)
+  , m_reactions(m_num_reactions)
+  , m_task_max_stale(false)
+{
+  for (int j = 0; j < m_num_tasks; j++) {
+    sTaskTotals& totals = m_tasks[j];
+    totals.cur = totals.last = totals.host_cur = totals.host_last = 0;
+    totals.parasite_cur = totals.parasite_last = totals.internal_cur = totals.internal_last = 0;
+    totals.exe_count = 0;
+    totals.cur_quality = totals.last_quality = totals.internal_cur_quality = totals.internal_last_quality = 0.0;
+    totals.cur_max_quality.Reset(0.0);
+    totals.last_max_quality.Reset(0.0);
+    totals.internal_cur_max_quality.Reset(0.0);
+    totals.internal_last_max_quality.Reset(0.0);
+  }
+  for (int j = 0; j < m_num_reactions; j++) {
+    sReactionTotals& totals = m_reactions[j];
+    totals.cur = totals.last = totals.exe_count = 0;
+    totals.cur_add_reward = totals.last_add_reward = 0.0;
+  }
+  recomputeExtremes();
+}
+
+
+void cOrgStatsTracker::AddOrganism(cOrganism* org)
+{
+  int slot_id;
+  if (m_free_slots.GetSize()) {
+    slot_id = m_free_slots.Pop();
+  } else {
+    slot_id = m_slots.GetSize();
+    m_slots.Resize(slot_id + 1);
+    m_slots[slot_id].dirty = false;
+    m_slots[slot_id].contrib.tasks.Resize(m_num_tasks);
+    m_slots[slot_id].contrib.reactions.Resize(m_num_reactions);
+  }
+
+  sSlot& slot = m_slots[slot_id];
+  slot.org = org;
+  slot.counted = false;
+  org->SetStatsSlot(slot_id);
+
+  // A reused slot may still be queued from its previous organism
+  if (!slot.dirty) markDirty(slot_id);
+}
+
+
+void cOrgStatsTracker::RemoveOrganism(cOrganism* org)
+{
+  const int slot_id = org->GetStatsSlot();
+  if (slot_id < 0) return;
+
+  sSlot& slot = m_slots[slot_id];
+  if (slot.counted) subtractContribution(slot.contrib);
+  slot.org = NULL;
+  slot.counted = false;
+  org->SetStatsSlot(-1);
+  m_free_slots.Push(slot_id);
+}
+
+
+void cOrgStatsTracker::markDirty(int slot_id)
+{
+  m_slots[slot_id].dirty = true;
+  m_dirty.Push(slot_id);
+}
+
+
+void cOrgStatsTracker::Update()
+{
+  for (int i = 0; i < m_dirty.GetSize(); i++) {
+    sSlot& slot = m_slots[m_dirty[i]];
+    slot.dirty = false;
+    if (slot.org == NULL) continue;
+
+    if (slot.counted) subtractContribution(slot.contrib);
+    computeContribution(slot.org, slot.contrib);
+    addContribution(slot.contrib);
+    slot.counted = true;
+  }
+  m_dirty.Resize(0);
+
+  if (m_extremes_stale) recomputeExtremes();
+  if (m_task_max_stale) recomputeTaskMaxQualities();
+  if (m_mut_rates_stale) recomputeMutRates();
+}
+
+
+void cOrgStatsTracker::Publish(cStats& stats)
+{
+  stats.SumFitness() = m_fitness;
+  stats.SumMerit() = m_merit;
+  stats.SumGestation() = m_gestation;
+  stats.SumGeneration() = m_generation;
+  stats.SumNeutralMetric() = m_neutral_metric;
+  stats.SumLineageLabel() = m_lineage_label;
+  stats.SumCopySize() = m_copy_size;
+  stats.SumExeSize() = m_exe_size;
+  stats.SumCreatureAge().Set(m_age_n, m_age_s1, m_age_s2);
+
+  stats.SumCopyMutRate() = m_copy_mut_rate;
+  stats.SumLogCopyMutRate() = m_log_copy_mut_rate;
+  stats.SumDivMutRate() = m_div_mut_rate;
+  stats.SumLogDivMutRate() = m_log_div_mut_rate;
+
+  stats.SetBreedTrueCreatures(m_num_breed_true);
+  stats.SetNumNoBirthCreatures(m_num_no_birth);
+
+  stats.SetMaxMerit(m_max_merit.value);
+  stats.SetMaxFitness(m_max_fitness.value);
+  stats.SetMaxGestationTime((int)m_max_gestation_time.value);
+  stats.SetMaxGenomeLength((int)m_max_genome_length.value);
+
+  stats.SetMinMerit(m_min_merit.value);
+  stats.SetMinFitness(m_min_fitness.value);
+  stats.SetMinGestationTime((int)m_min_gestation_time.value);
+  stats.SetMinGenomeLength((int)m_min_genome_length.value);
+
+  for (int j = 0; j < m_num_tasks; j++) {
+    const sTaskTotals& totals = m_tasks[j];
+    stats.SetOrganismTaskTotals(j, totals.cur, totals.last, totals.exe_count, totals.cur_quality, totals.last_quality,
+                                totals.cur_max_quality.value, totals.last_max_quality.value);
+    stats.SetOrganismHostParasiteTaskTotals(j, totals.host_cur, totals.host_last, totals.parasite_cur,
+                                            totals.parasite_last);
+    stats.SetOrganismInternalTaskTotals(j, totals.internal_cur, totals.internal_last, totals.internal_cur_quality,
+                                        totals.internal_last_quality, totals.internal_cur_max_quality.value,
+                                        totals.internal_last_max_quality.value);
+  }
+  for (int j = 0; j < m_num_reactions; j++) {
+    const sReactionTotals& totals = m_reactions[j];
+    stats.SetOrganismReactionTotals(j, totals.cur, totals.last, totals.exe_count, totals.cur_add_reward,
+                                    totals.last_add_reward);
+  }
+}
+
+
+int cOrgStatsTracker::Validate(const cStats& stats, Avida::Feedback& feedback)
+{
+  int mismatches = 0;
+  const int update = stats.GetUpdate();
+
+#define CHECK_VALUE(NAME, INCREMENTAL, FULL) \
+  if (!closeEnough(INCREMENTAL, FULL)) { \
+    feedback.Warning("update %d: incremental %s is %g, full scan gives %g", update, NAME, (double)(INCREMENTAL), (double)(FULL)); \
+    mismatches++; \
+  }
+#define CHECK_SUM(NAME, INCREMENTAL, FULL) \
+  CHECK_VALUE(NAME " count", (INCREMENTAL).Count(), (FULL).Count()); \
+  CHECK_VALUE(NAME " sum", (INCREMENTAL).Sum(), (FULL).Sum()); \
+  CHECK_VALUE(NAME " variance", (INCREMENTAL).Variance(), (FULL).Variance());
+#define CHECK_RUNNING(NAME, INCREMENTAL, FULL) \
+  CHECK_VALUE(NAME " count", (INCREMENTAL).N(), (FULL).N()); \
+  CHECK_VALUE(NAME " mean", (INCREMENTAL).Mean(), (FULL).Mean()); \
+  CHECK_VALUE(NAME " variance", (INCREMENTAL).Variance(), (FULL).Variance());
+
+  CHECK_SUM("fitness", m_fitness, stats.SumFitness());
+  CHECK_SUM("merit", m_merit, stats.SumMerit());
+  CHECK_SUM("gestation", m_gestation, stats.SumGestation());
+  CHECK_SUM("generation", m_generation, stats.SumGeneration());
+  CHECK_SUM("neutral metric", m_neutral_metric, stats.SumNeutralMetric());
+  CHECK_SUM("lineage label", m_lineage_label, stats.SumLineageLabel());
+  CHECK_SUM("copy size", m_copy_size, stats.SumCopySize());
+  CHECK_SUM("exe size", m_exe_size, stats.SumExeSize());
+
+  cDoubleSum age;
+  age.Set(m_age_n, m_age_s1, m_age_s2);
+  CHECK_SUM("age", age, stats.SumCreatureAge());
+
+  CHECK_RUNNING("copy mut rate", m_copy_mut_rate, stats.SumCopyMutRate());
+  CHECK_RUNNING("log copy mut rate", m_log_copy_mut_rate, stats.SumLogCopyMutRate());
+  CHECK_RUNNING("div mut rate", m_div_mut_rate, stats.SumDivMutRate());
+  CHECK_RUNNING("log div mut rate", m_log_div_mut_rate, stats.SumLogDivMutRate());
+
+  CHECK_VALUE("breed true creatures", m_num_breed_true, stats.GetBreedTrueCreatures());
+  CHECK_VALUE("no birth creatures", m_num_no_birth, stats.GetNumNoBirthCreatures());
+
+  CHECK_VALUE("max merit", m_max_merit.value, stats.GetMaxMerit());
+  CHECK_VALUE("max fitness", m_max_fitness.value, stats.GetMaxFitness());
+  CHECK_VALUE("max gestation time", m_max_gestation_time.value, stats.GetMaxGestationTime());
+  CHECK_VALUE("max genome length", m_max_genome_length.value, stats.GetMaxGenomeLength());
+  CHECK_VALUE("min merit", m_min_merit.value, stats.GetMinMerit());
+  CHECK_VALUE("min fitness", m_min_fitness.value, stats.GetMinFitness());
+  CHECK_VALUE("min gestation time", m_min_gestation_time.value, stats.GetMinGestationTime());
+  CHECK_VALUE("min genome length", m_min_genome_length.value, stats.GetMinGenomeLength());
+
+  for (int j = 0; j < m_num_tasks; j++) {
+    const sTaskTotals& totals = m_tasks[j];
+    CHECK_VALUE("task cur count", totals.cur, stats.GetTaskCurCount(j));
+    CHECK_VALUE("task last count", totals.last, stats.GetTaskLastCount(j));
+    CHECK_VALUE("task exe count", totals.exe_count, stats.GetTaskExeCount(j));
+    CHECK_VALUE("host task cur count", totals.host_cur, stats.GetTaskHostCurCount(j));
+    CHECK_VALUE("host task last count", totals.host_last, stats.GetTaskLastHostCount(j));
+    CHECK_VALUE("parasite task cur count", totals.parasite_cur, stats.GetTaskParasiteCurCount(j));
+    CHECK_VALUE("parasite task last count", totals.parasite_last, stats.GetTaskLastParasiteCount(j));
+    CHECK_VALUE("internal task cur count", totals.internal_cur, stats.GetInternalTaskCurCount(j));
+    CHECK_VALUE("internal task last count", totals.internal_last, stats.GetInternalTaskLastCount(j));
+    CHECK_VALUE("task max cur quality", totals.cur_max_quality.value, stats.GetTaskMaxCurQuality(j));
+    CHECK_VALUE("task max last quality", totals.last_max_quality.value, stats.GetTaskMaxLastQuality(j));
+    CHECK_VALUE("internal task max cur quality", totals.internal_cur_max_quality.value, stats.GetInternalTaskMaxCurQuality(j));
+    CHECK_VALUE("internal task max last quality", totals.internal_last_max_quality.value, stats.GetInternalTaskMaxLastQuality(j));
+    if (totals.cur && totals.cur == stats.GetTaskCurCount(j)) {
+      CHECK_VALUE("task cur quality", totals.cur_quality / totals.cur, stats.GetTaskCurQuality(j));
+    }
+    if (totals.last && totals.last == stats.GetTaskLastCount(j)) {
+      CHECK_VALUE("task last quality", totals.last_quality / totals.last, stats.GetTaskLastQuality(j));
+    }
+    if (totals.internal_cur && totals.internal_cur == stats.GetInternalTaskCurCount(j)) {
+      CHECK_VALUE("internal task cur quality", totals.internal_cur_quality / totals.internal_cur, stats.GetInternalTaskCurQuality(j));
+    }
+    if (totals.internal_last && totals.internal_last == stats.GetInternalTaskLastCount(j)) {
+      CHECK_VALUE("internal task last quality", totals.internal_last_quality / totals.internal_last, stats.GetInternalTaskLastQuality(j));
+    }
+  }
+
+  for (int j = 0; j < m_num_reactions; j++) {
+    const sReactionTotals& totals = m_reactions[j];
+    CHECK_VALUE("reaction cur count", totals.cur, stats.GetReactionCurCount(j));
+    CHECK_VALUE("reaction last count", totals.last, stats.GetReactions()[j]);
+    CHECK_VALUE("reaction exe count", totals.exe_count, stats.GetReactionExeCount(j));
+    CHECK_VALUE("reaction cur add reward", totals.cur_add_reward, stats.GetReactionCurAddReward(j));
+    CHECK_VALUE("reaction last add reward", totals.last_add_reward, stats.GetReactionLastAddReward(j));
+  }
+
+#undef CHECK_RUNNING
+#undef CHECK_SUM
+#undef CHECK_VALUE
+
+  return mismatches;
+}
+
+
+void cOrgStatsTracker::AdvanceAge()
+{
+  // sum (a + 1)^2 = sum a^2 + 2 sum a + n
+  m_age_s2 += 2.0 * m_age_s1 + m_age_n;
+  m_age_s1 += m_age_n;
+  m_age_passes++;
+}
+
+
+void cOrgStatsTracker::computeContribution(cOrganism* org, sContribution& contrib) const
+{
+  const cPhenotype& phenotype = org->GetPhenotype();
+
+  contrib.fitness = phenotype.GetFitness();
+  contrib.merit = phenotype.GetMerit().GetDouble();
+  contrib.gestation = phenotype.GetGestationTime();
+  contrib.generation = phenotype.GetGeneration();
+  contrib.neutral_metric = phenotype.GetNeutralMetric();
+  contrib.lineage_label = org->GetLineageLabel();
+  contrib.copy_mut_rate = org->MutationRates().GetCopyMutProb();
+  contrib.log_copy_mut_rate = log(contrib.copy_mut_rate);
+  contrib.div_mut_rate = org->MutationRates().GetDivMutProb() / phenotype.GetDivType();
+  contrib.log_div_mut_rate = log(contrib.div_mut_rate);
+  contrib.copy_size = phenotype.GetCopiedSize();
+  contrib.exe_size = phenotype.GetExecutedSize();
+  contrib.genome_length = phenotype.GetGenomeLength();
+  contrib.age = phenotype.GetAge();
+  contrib.age_pass = m_age_passes;
+  contrib.breed_true = phenotype.ParentTrue();
+  contrib.no_birth = (phenotype.GetNumDivides() == 0);
+
+  for (int j = 0; j < m_num_tasks; j++) {
+    sTaskContribution& task = contrib.tasks[j];
+    task.cur = (phenotype.GetCurTaskCount()[j] > 0);
+    task.last = (phenotype.GetLastTaskCount()[j] > 0);
+    task.host_cur = (phenotype.GetCurHostTaskCount()[j] > 0);
+    task.host_last = (phenotype.GetLastHostTaskCount()[j] > 0);
+    task.parasite_cur = (phenotype.GetCurParasiteTaskCount()[j] > 0);
+    task.parasite_last = (phenotype.GetLastParasiteTaskCount()[j] > 0);
+    task.internal_cur = (phenotype.GetCurInternalTaskCount()[j] > 0);
+    task.internal_last = (phenotype.GetLastInternalTaskCount()[j] > 0);
+    task.exe_count = task.last ? phenotype.GetLastTaskCount()[j] : 0;
+    task.cur_quality = task.cur ? phenotype.GetCurTaskQuality()[j] : 0.0;
+    task.last_quality = task.last ? phenotype.GetLastTaskQuality()[j] : 0.0;
+    task.internal_cur_quality = task.internal_cur ? phenotype.GetCurInternalTaskQuality()[j] : 0.0;
+    task.internal_last_quality = task.internal_last ? phenotype.GetLastInternalTaskQuality()[j] : 0.0;
+  }
+
+  for (int j = 0; j < m_num_reactions; j++) {
+    sReactionContribution& reaction = contrib.reactions[j];
+    reaction.cur = (phenotype.GetCurReactionCount()[j] > 0);
+    reaction.last = (phenotype.GetLastReactionCount()[j] > 0);
+    reaction.exe_count = reaction.last ? phenotype.GetLastReactionCount()[j] : 0;
+    reaction.cur_add_reward = reaction.cur ? phenotype.GetCurReactionAddReward()[j] : 0.0;
+    reaction.last_add_reward = reaction.last ? phenotype.GetLastReactionAddReward()[j] : 0.0;
+  }
+}
+
+
+void cOrgStatsTracker::addContribution(const sContribution& contrib)
+{
+  m_fitness.Add(contrib.fitness);
+  m_merit.Add(contrib.merit);
+  m_gestation.Add(contrib.gestation);
+  m_generation.Add(contrib.generation);
+  m_neutral_metric.Add(contrib.neutral_metric);
+  m_lineage_label.Add(contrib.lineage_label);
+  m_copy_size.Add(contrib.copy_size);
+  m_exe_size.Add(contrib.exe_size);
+
+  m_copy_mut_rate.Push(contrib.copy_mut_rate);
+  m_log_copy_mut_rate.Push(contrib.log_copy_mut_rate);
+  m_div_mut_rate.Push(contrib.div_mut_rate);
+  m_log_div_mut_rate.Push(contrib.log_div_mut_rate);
+
+  const double age = contrib.age + (m_age_passes - contrib.age_pass);
+  m_age_n += 1.0;
+  m_age_s1 += age;
+  m_age_s2 += age * age;
+
+  if (contrib.breed_true) m_num_breed_true++;
+  if (contrib.no_birth) m_num_no_birth++;
+
+  addExtremes(contrib);
+  addTaskMaxQualities(contrib);
+
+  for (int j = 0; j < m_num_tasks; j++) {
+    const sTaskContribution& task = contrib.tasks[j];
+    sTaskTotals& totals = m_tasks[j];
+    if (task.cur) {
+      totals.cur++;
+      totals.cur_quality += task.cur_quality;
+    }
+    if (task.last) {
+      totals.last++;
+      totals.exe_count += task.exe_count;
+      totals.last_quality += task.last_quality;
+    }
+    if (task.host_cur) totals.host_cur++;
+    if (task.host_last) totals.host_last++;
+    if (task.parasite_cur) totals.parasite_cur++;
+    if (task.parasite_last) totals.parasite_last++;
+    if (task.internal_cur) {
+      totals.internal_cur++;
+      totals.internal_cur_quality += task.internal_cur_quality;
+    }
+    if (task.internal_last) {
+      totals.internal_last++;
+      totals.internal_last_quality += task.internal_last_quality;
+    }
+  }
+
+  for (int j = 0; j < m_num_reactions; j++) {
+    const sReactionContribution& reaction = contrib.reactions[j];
+    sReactionTotals& totals = m_reactions[j];
+    if (reaction.cur) {
+      totals.cur++;
+      totals.cur_add_reward += reaction.cur_add_reward;
+    }
+    if (reaction.last) {
+      totals.last++;
+      totals.exe_count += reaction.exe_count;
+      totals.last_add_reward += reaction.last_add_reward;
+    }
+  }
+}
+
+
+void cOrgStatsTracker::subtractContribution(const sContribution& contrib)
+{
+  m_fitness.Subtract(contrib.fitness);
+  m_merit.Subtract(contrib.merit);
+  m_gestation.Subtract(contrib.gestation);
+  m_generation.Subtract(contrib.generation);
+  m_neutral_metric.Subtract(contrib.neutral_metric);
+  m_lineage_label.Subtract(contrib.lineage_label);
+  m_copy_size.Subtract(contrib.copy_size);
+  m_exe_size.Subtract(contrib.exe_size);
+
+  // Non-finite values (e.g. the log of a zero rate) cannot be removed from the moments, rebuild them instead
+  if (m_mut_rates_stale || !isFinite(contrib.log_copy_mut_rate) || !isFinite(contrib.log_div_mut_rate) ||
+      !isFinite(contrib.div_mut_rate)) {
+    m_mut_rates_stale = true;
+  } else {
+    m_copy_mut_rate.Pop(contrib.copy_mut_rate);
+    m_log_copy_mut_rate.Pop(contrib.log_copy_mut_rate);
+    m_div_mut_rate.Pop(contrib.div_mut_rate);
+    m_log_div_mut_rate.Pop(contrib.log_div_mut_rate);
+  }
+
+  const double age = contrib.age + (m_age_passes - contrib.age_pass);
+  m_age_n -= 1.0;
+  m_age_s1 -= age;
+  m_age_s2 -= age * age;
+
+  if (contrib.breed_true) m_num_breed_true--;
+  if (contrib.no_birth) m_num_no_birth--;
+
+  if (!m_max_merit.Remove(contrib.merit)) m_extremes_stale = true;
+  if (!m_max_fitness.Remove(contrib.fitness)) m_extremes_stale = true;
+  if (!m_max_gestation_time.Remove(contrib.gestation)) m_extremes_stale = true;
+  if (!m_max_genome_length.Remove(contrib.genome_length)) m_extremes_stale = true;
+  if (!m_min_merit.Remove(contrib.merit)) m_extremes_stale = true;
+  if (!m_min_fitness.Remove(contrib.fitness)) m_extremes_stale = true;
+  if (!m_min_gestation_time.Remove(contrib.gestation)) m_extremes_stale = true;
+  if (!m_min_genome_length.Remove(contrib.genome_length)) m_extremes_stale = true;
+
+  for (int j = 0; j < m_num_tasks; j++) {
+    const sTaskContribution& task = contrib.tasks[j];
+    sTaskTotals& totals = m_tasks[j];
+    if (task.cur) {
+      totals.cur--;
+      totals.cur_quality -= task.cur_quality;
+      if (!totals.cur_max_quality.Remove(task.cur_quality)) m_task_max_stale = true;
+    }
+    if (task.last) {
+      totals.last--;
+      totals.exe_count -= task.exe_count;
+      totals.last_quality -= task.last_quality;
+      if (!totals.last_max_quality.Remove(task.last_quality)) m_task_max_stale = true;
+    }
+    if (task.host_cur) totals.host_cur--;
+    if (task.host_last) totals.host_last--;
+    if (task.parasite_cur) totals.parasite_cur--;
+    if (task.parasite_last) totals.parasite_last--;
+    if (task.internal_cur) {
+      totals.internal_cur--;
+      totals.internal_cur_quality -= task.internal_cur_quality;
+      if (!totals.internal_cur_max_quality.Remove(task.internal_cur_quality)) m_task_max_stale = true;
+    }
+    if (task.internal_last) {
+      totals.internal_last--;
+      totals.internal_last_quality -= task.internal_last_quality;
+      if (!totals.internal_last_max_quality.Remove(task.internal_last_quality)) m_task_max_stale = true;
+    }
+  }
+
+  for (int j = 0; j < m_num_reactions; j++) {
+    const sReactionContribution& reaction = contrib.reactions[j];
+    sReactionTotals& totals = m_reactions[j];
+    if (reaction.cur) {
+      totals.cur--;
+      totals.cur_add_reward -= reaction.cur_add_reward;
+    }
+    if (reaction.last) {
+      totals.last--;
+      totals.exe_count -= reaction.exe_count;
+      totals.last_add_reward -= reaction.last_add_reward;
+    }
+  }
+}
+
+
+void cOrgStatsTracker::addExtremes(const sContribution& contrib)
+{
+  m_max_merit.AddMax(contrib.merit);
+  m_max_fitness.AddMax(contrib.fitness);
+  m_max_gestation_time.AddMax(contrib.gestation);
+  m_max_genome_length.AddMax(contrib.genome_length);
+  m_min_merit.AddMin(contrib.merit);
+  m_min_fitness.AddMin(contrib.fitness);
+  m_min_gestation_time.AddMin(contrib.gestation);
+  m_min_genome_length.AddMin(contrib.genome_length);
+}
+
+
+void cOrgStatsTracker::addTaskMaxQualities(const sContribution& contrib)
+{
+  for (int j = 0; j < m_num_tasks; j++) {
+    const sTaskContribution& task = contrib.tasks[j];
+    sTaskTotals& totals = m_tasks[j];
+    if (task.cur) totals.cur_max_quality.AddMax(task.cur_quality);
+    if (task.last) totals.last_max_quality.AddMax(task.last_quality);
+    if (task.internal_cur) totals.internal_cur_max_quality.AddMax(task.internal_cur_quality);
+    if (task.internal_last) totals.internal_last_max_quality.AddMax(task.internal_last_quality);
+  }
+}
+
+
+void cOrgStatsTracker::recomputeExtremes()
+{
+  // Same initial values as the full scan in cPopulation::UpdateOrganismStats
+  m_max_merit.Reset(0.0);
+  m_max_fitness.Reset(0.0);
+  m_max_gestation_time.Reset(0.0);
+  m_max_genome_length.Reset(0.0);
+  m_min_merit.Reset(FLT_MAX);
+  m_min_fitness.Reset(FLT_MAX);
+  m_min_gestation_time.Reset(INT_MAX);
+  m_min_genome_length.Reset(INT_MAX);
+
+  for (int i = 0; i < m_slots.GetSize(); i++) if (m_slots[i].counted) addExtremes(m_slots[i].contrib);
+  m_extremes_stale = false;
+}
+
+
+void cOrgStatsTracker::recomputeTaskMaxQualities()
+{
+  for (int j = 0; j < m_num_tasks; j++) {
+    sTaskTotals& totals = m_tasks[j];
+    totals.cur_max_quality.Reset(0.0);
+    totals.last_max_quality.Reset(0.0);
+    totals.internal_cur_max_quality.Reset(0.0);
+    totals.internal_last_max_quality.Reset(0.0);
+  }
+
+  for (int i = 0; i < m_slots.GetSize(); i++) if (m_slots[i].counted) addTaskMaxQualities(m_slots[i].contrib);
+  m_task_max_stale = false;
+}
+
+
+void cOrgStatsTracker::recomputeMutRates()
+{
+  m_copy_mut_rate.Clear();
+  m_log_copy_mut_rate.Clear();
+  m_div_mut_rate.Clear();
+  m_log_div_mut_rate.Clear();
+
+  for (int i = 0; i < m_slots.GetSize(); i++) {
+    if (!m_slots[i].counted) continue;
+    const sContribution& contrib = m_slots[i].contrib;
+    m_copy_mut_rate.Push(contrib.copy_mut_rate);
+    m_log_copy_mut_rate.Push(contrib.log_copy_mut_rate);
+    m_div_mut_rate.Push(contrib.div_mut_rate);
+    m_log_div_mut_rate.Push(contrib.log_div_mut_rate);
+  }
+  m_mut_rates_stale = false;
+}
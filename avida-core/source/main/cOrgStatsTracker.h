@@ -0,0 +1,234 @@
+/*
+ *  cOrgStatsTracker.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cOrgStatsTracker_h
+#define cOrgStatsTracker_h
+
+#include "apto/core.h"
+
+#include "cDoubleSum.h"
+#include "cRunningStats.h"
+
+class cOrganism;
+class cStats;
+class cWorld;
+
+namespace Avida {
+  class Feedback;
+};
+
+
+// cOrgStatsTracker - incrementally maintained per organism population statistics (ORGANISM_STATS_METHOD 1 to 3).
+//
+// Each live organism owns a slot recording the values it last contributed to the population sums.  Organisms are
+// marked dirty when they are born, divide, change merit or mutation rates, or perform tasks; at the end of the update
+// only the dirty organisms are rescanned, their old contribution subtracted and the new one added.  Ages are advanced
+// analytically since every live organism ages by one each update.  Extremes and maximum task qualities count the contributions
+// equal to them and are recomputed from the stored contributions only when the last of those leaves.
+
+class cOrgStatsTracker
+{
+private:
+  struct sTaskContribution
+  {
+    bool cur;
+    bool last;
+    bool host_cur;
+    bool host_last;
+    bool parasite_cur;
+    bool parasite_last;
+    bool internal_cur;
+    bool internal_last;
+    int exe_count;
+    double cur_quality;
+    double last_quality;
+    double internal_cur_quality;
+    double internal_last_quality;
+  };
+
+  struct sReactionContribution
+  {
+    bool cur;
+    bool last;
+    int exe_count;
+    double cur_add_reward;
+    double last_add_reward;
+  };
+
+  struct sContribution
+  {
+    double fitness;
+    double merit;
+    double gestation;
+    double generation;
+    double neutral_metric;
+    double lineage_label;
+    double copy_mut_rate;
+    double log_copy_mut_rate;
+    double div_mut_rate;
+    double log_div_mut_rate;
+    double copy_size;
+    double exe_size;
+    int genome_length;
+    int age;
+    int age_pass;       // value of m_age_passes when age was recorded
+    bool breed_true;
+    bool no_birth;
+    Apto::Array<sTaskContribution> tasks;
+    Apto::Array<sReactionContribution> reactions;
+  };
+
+  struct sSlot
+  {
+    cOrganism* org;
+    bool counted;       // contribution is included in the sums
+    bool dirty;         // slot is queued in m_dirty
+    sContribution contrib;
+  };
+
+  struct sExtreme
+  {
+    double value;
+    int count;          // counted contributions equal to value
+
+    void Reset(double initial) { value = initial; count = 0; }
+    void AddMax(double v) { if (v > value) { value = v; count = 1; } else if (v == value) count++; }
+    void AddMin(double v) { if (v < value) { value = v; count = 1; } else if (v == value) count++; }
+    bool Remove(double v) { return !(v == value && --count == 0); }  // false once the extreme leaves
+  };
+
+  struct sTaskTotals
+  {
+    int cur;
+    int last;
+    int host_cur;
+    int host_last;
+    int parasite_cur;
+    int parasite_last;
+    int internal_cur;
+    int internal_last;
+    int exe_count;
+    double cur_quality;
+    double last_quality;
+    double internal_cur_quality;
+    double internal_last_quality;
+    sExtreme cur_max_quality;
+    sExtreme last_max_quality;
+    sExtreme internal_cur_max_quality;
+    sExtreme internal_last_max_quality;
+  };
+
+  struct sReactionTotals
+  {
+    int cur;
+    int last;
+    int exe_count;
+    double cur_add_reward;
+    double last_add_reward;
+  };
+
+  cWorld* m_world;
+  const int m_num_tasks;
+  const int m_num_reactions;
+
+  Apto::Array<sSlot, Apto::Smart> m_slots;
+  Apto::Array<int, Apto::Smart> m_free_slots;
+  Apto::Array<int, Apto::Smart> m_dirty;
+
+  // Population sums
+  cDoubleSum m_fitness;
+  cDoubleSum m_merit;
+  cDoubleSum m_gestation;
+  cDoubleSum m_generation;
+  cDoubleSum m_neutral_metric;
+  cDoubleSum m_lineage_label;
+  cDoubleSum m_copy_size;
+  cDoubleSum m_exe_size;
+  cRunningStats m_copy_mut_rate;
+  cRunningStats m_log_copy_mut_rate;
+  cRunningStats m_div_mut_rate;
+  cRunningStats m_log_div_mut_rate;
+  bool m_mut_rates_stale;
+
+  double m_age_n;
+  double m_age_s1;
+  double m_age_s2;
+  int m_age_passes;
+
+  int m_num_breed_true;
+  int m_num_no_birth;
+
+  sExtreme m_max_merit;
+  sExtreme m_max_fitness;
+  sExtreme m_max_gestation_time;
+  sExtreme m_max_genome_length;
+  sExtreme m_min_merit;
+  sExtreme m_min_fitness;
+  sExtreme m_min_gestation_time;
+  sExtreme m_min_genome_length;
+  bool m_extremes_stale;
+
+  Apto::Array<sTaskTotals> m_tasks;
+  Apto::Array<sReactionTotals> m_reactions;
+  bool m_task_max_stale;
+
+
+  cOrgStatsTracker(); // @not_implemented
+  cOrgStatsTracker(const cOrgStatsTracker&); // @not_implemented
+  cOrgStatsTracker& operator=(const cOrgStatsTracker&); // @not_implemented
+
+public:
+  cOrgStatsTracker(cWorld* world);
+
+  // Membership, called as organisms enter and leave the live organism list
+  void AddOrganism(cOrganism* org);
+  void RemoveOrganism(cOrganism* org);
+
+  // Queues the organism in the given slot (cOrganism::GetStatsSlot) to be rescanned at the end of the update
+  inline void MarkDirty(int slot_id) { if (slot_id >= 0 && !m_slots[slot_id].dirty) markDirty(slot_id); }
+
+  // Rescans the dirty organisms, bringing the sums up to date
+  void Update();
+
+  // Writes the sums into the stats object
+  void Publish(cStats& stats);
+
+  // Compares the sums against stats filled by the full scan, reporting each mismatch as a warning; returns the
+  // number of mismatches found
+  int Validate(const cStats& stats, Avida::Feedback& feedback);
+
+  // Ages every counted organism by one update, mirroring cPhenotype::IncAge in the per update organism pass
+  void AdvanceAge();
+
+  int GetNumDirty() const { return m_dirty.GetSize(); }
+
+private:
+  void markDirty(int slot_id);
+  void computeContribution(cOrganism* org, sContribution& contrib) const;
+  void addContribution(const sContribution& contrib);
+  void subtractContribution(const sContribution& contrib);
+  void addExtremes(const sContribution& contrib);
+  void addTaskMaxQualities(const sContribution& contrib);
+  void recomputeExtremes();
+  void recomputeTaskMaxQualities();
+  void recomputeMutRates();
+};
+
+#endif
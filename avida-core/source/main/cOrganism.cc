@@ -33,7 +33,9 @@
 #include "cHardwareManager.h"
 #include "cInstSet.h"
 #include "cOrgSensor.h"
+#include "cPopulation.h"
 #include "cPopulationCell.h"
+#include "cStateArchive.h"
 #include "cStateGrid.h"
 #include "cStringUtil.h"
 #include "cTaskContext.h"
@@ -150,10 +152,12 @@ cOrganism::cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, in
   , m_phenotype(world, parent_generation, world->GetHardwareManager().GetInstSet(genome.Properties().Get(s_ext_prop_name_instset).StringValue()).GetNumNops())
   , m_src(src)
   , m_initial_genome(genome)
+  , m_sample_copy_muts(world->GetConfig().MUTATION_SAMPLING_METHOD.Get() == 1)
   , m_interface(NULL)
   , m_lineage_label(-1)
   , m_lineage(NULL)
   , m_org_list_index(-1)
+  , m_stats_slot(-1)
   , m_org_display(NULL)
   , m_queued_display_data(NULL)
   , m_display(false)
@@ -247,15 +251,110 @@ void cOrganism::initialize(cAvidaContext& ctx)
 cOrganism::~cOrganism()
 {  
   assert(m_is_running == false);
-  delete m_hardware;
+  releaseOwned();
+}
+
+void cOrganism::releaseOwned()
+{
+  m_world->GetHardwareManager().Release(m_hardware);
+  m_hardware = NULL;
   delete m_interface;
-  
-  if(m_msg) delete m_msg;
-  if(m_opinion) delete m_opinion;  
-  if (m_neighborhood) delete m_neighborhood;
+  m_interface = NULL;
+  
+  delete m_msg;
+  m_msg = NULL;
+  delete m_opinion;
+  m_opinion = NULL;
+  delete m_neighborhood;
+  m_neighborhood = NULL;
   delete m_org_display;
+  m_org_display = NULL;
   delete m_queued_display_data;
-  if (m_string_map) delete m_string_map;
+  m_queued_display_data = NULL;
+  delete m_string_map;
+  m_string_map = NULL;
+  
+  m_parasites.Resize(0);
+}
+
+// Does what destruction would, but leaves the organism as inert storage for the organism pool.  The systematics
+// group memberships are dropped as the Systematics::Unit destructor drops them.
+void cOrganism::retire()
+{
+  releaseOwned();
+  
+  for (int i = 0; i < m_groups->GetSize(); i++) m_groups->Get(i)->RemoveUnit();
+  m_groups = Systematics::GroupMembershipPtr(new Systematics::GroupMembership);
+}
+
+// Reuse of a retired organism by the organism pool.  Every member the constructor sets is set again as the
+// constructor would for this genome; the phenotype is reset in place by cPhenotype::Recycle.
+void cOrganism::recycle(cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src)
+{
+  assert(m_hardware == NULL && m_interface == NULL);
+  
+  m_phenotype.Recycle(parent_generation, m_world->GetHardwareManager().GetInstSet(genome.Properties().Get(s_ext_prop_name_instset).StringValue()).GetNumNops());
+  m_src = src;
+  const_cast<Genome&>(m_initial_genome) = genome;
+  m_mut_rates.Clear();
+  m_copy_mut_sampler = cMutationSampler();
+  m_sample_copy_muts = (m_world->GetConfig().MUTATION_SAMPLING_METHOD.Get() == 1);
+  m_lineage_label = -1;
+  m_lineage = NULL;
+  m_org_list_index = -1;
+  m_stats_slot = -1;
+  m_display = false;
+  m_offspring_genome = Genome();
+  m_input_pointer = 0;
+  m_input_buf.Clear();
+  m_output_buf.Clear();
+  m_received_messages.Clear();
+  m_cur_sg = 0;
+  m_sent_value = 0;
+  m_sent_active = false;
+  m_test_receive_pos = 0;
+  m_pher_drop = false;
+  frac_energy_donating = m_world->GetConfig().ENERGY_SHARING_PCT.Get();
+  m_max_executed = -1;
+  m_is_running = false;
+  m_is_sleeping = false;
+  m_is_dead = false;
+  killed_event = false;
+  m_self_raw_materials = m_world->GetConfig().RAW_MATERIAL_AMOUNT.Get();
+  m_other_raw_materials = 0;
+  donor_list.clear();
+  donating_lineages.clear();
+  m_num_donate = 0;
+  m_num_donate_received = 0;
+  m_amount_donate_received = 0;
+  m_num_reciprocate = 0;
+  m_failed_reputation_increases = 0;
+  m_tag = make_pair(-1, 0);
+  m_northerly = 0;
+  m_easterly = 0;
+  m_forage_target = -1;
+  m_show_ft = -1;
+  m_has_set_ft = false;
+  m_teach = false;
+  m_parent_teacher = false;
+  m_parent_ft = -1;
+  m_parent_group = m_world->GetConfig().DEFAULT_GROUP.Get();
+  m_p_merit = 0;
+  m_beggar = false;
+  m_para_donate = m_world->GetConfig().PARASITE_VIRULENCE.Get();
+  m_guard = false;
+  m_num_guard = 0;
+  m_num_deposits = 0;
+  m_amount_deposited = 0;
+  m_num_point_mut = 0;
+  m_av_in_index = -1;
+  m_av_out_index = -1;
+  
+  m_id = m_world->GetStats().GetTotCreatures();
+  
+  m_hardware = m_world->GetHardwareManager().Create(ctx, this, m_initial_genome);
+  
+  initialize(ctx);
 }
 
 
@@ -269,6 +368,11 @@ void cOrganism::SetOrgInterface(cAvidaContext& ctx, cOrgInterface* org_interface
   HardwareReset(ctx);
 }
 
+void cOrganism::markStatsDirty()
+{
+  m_world->GetPopulation().MarkOrgStatsDirty(m_stats_slot);
+}
+
 const cStateGrid& cOrganism::GetStateGrid() const { return m_world->GetEnvironment().GetStateGrid(m_cur_sg); }
 
 double cOrganism::GetVitality() const {
@@ -484,6 +588,7 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   bool task_completed = m_phenotype.TestOutput(ctx, taskctx, globalAndDeme_resource_count, 
                                                m_phenotype.GetCurRBinsAvail(), globalAndDeme_res_change, 
                                                insts_triggered, is_parasite, context_phenotype);
+  MarkStatsDirty();
   
   // Handle merit increases that take the organism above it's current population merit
   if (m_world->GetConfig().MERIT_INC_APPLY_IMMEDIATE.Get()) {
@@ -597,6 +702,7 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   bool task_completed = m_phenotype.TestOutput(ctx, taskctx, avatarAndDeme_res_count, 
                                                m_phenotype.GetCurRBinsAvail(), avatarAndDeme_res_change, 
                                                insts_triggered, is_parasite, context_phenotype);
+  MarkStatsDirty();
   
   // Handle merit increases that take the organism above it's current population merit
   if (m_world->GetConfig().MERIT_INC_APPLY_IMMEDIATE.Get()) {
@@ -720,6 +826,85 @@ double cOrganism::GetNeutralMin() const { return m_world->GetConfig().NEUTRAL_MI
 double cOrganism::GetNeutralMax() const { return m_world->GetConfig().NEUTRAL_MAX.Get(); }
 
 
+void cOrganism::CheckpointState(cStateArchive& ar)
+{
+  // Lazily created support structures (messaging, opinions, neighborhoods, strings) are not checkpointed
+  if (m_msg || m_opinion || m_neighborhood || m_string_map || donor_list.size() || donating_lineages.size()) {
+    ar.Fail("organisms using messaging, opinions, neighborhoods, strings or donation lists can not be checkpointed");
+    return;
+  }
+  
+  ar.Tag("cOrganism");
+  ar.Transfer(m_id);
+  ar.Transfer(m_lineage_label);
+  ar.Transfer(cclade_id);
+  m_mut_rates.CheckpointState(ar);
+  m_copy_mut_sampler.CheckpointState(ar);
+  
+  ar.Transfer(m_input_pointer);
+  m_input_buf.CheckpointState(ar);
+  m_output_buf.CheckpointState(ar);
+  m_received_messages.CheckpointState(ar);
+  ar.Transfer(m_cur_sg);
+  ar.Transfer(m_sent_value);
+  ar.Transfer(m_sent_active);
+  ar.Transfer(m_test_receive_pos);
+  ar.Transfer(m_gradient_movement);
+  ar.Transfer(m_pher_drop);
+  ar.Transfer(frac_energy_donating);
+  ar.Transfer(m_max_executed);
+  ar.Transfer(m_is_sleeping);
+  ar.Transfer(m_is_dead);
+  ar.Transfer(killed_event);
+  
+  ar.Transfer(m_self_raw_materials);
+  ar.Transfer(m_other_raw_materials);
+  ar.Transfer(m_num_donate);
+  ar.Transfer(m_num_donate_received);
+  ar.Transfer(m_amount_donate_received);
+  ar.Transfer(m_num_reciprocate);
+  ar.Transfer(m_k);
+  ar.Transfer(m_failed_reputation_increases);
+  ar.Transfer(m_tag.first);
+  ar.Transfer(m_tag.second);
+  ar.Transfer(m_northerly);
+  ar.Transfer(m_easterly);
+  ar.Transfer(m_forage_target);
+  ar.Transfer(m_show_ft);
+  ar.Transfer(m_has_set_ft);
+  ar.Transfer(m_teach);
+  ar.Transfer(m_parent_teacher);
+  ar.Transfer(m_parent_ft);
+  ar.Transfer(m_parent_group);
+  ar.Transfer(m_p_merit);
+  ar.Transfer(m_p_mthread);
+  ar.Transfer(m_beggar);
+  ar.Transfer(m_para_donate);
+  ar.Transfer(m_guard);
+  ar.Transfer(m_num_guard);
+  ar.Transfer(m_num_deposits);
+  ar.Transfer(m_amount_deposited);
+  ar.Transfer(m_num_point_mut);
+  ar.Transfer(m_repair);
+  ar.Transfer(m_av_in_index);
+  ar.Transfer(m_av_out_index);
+  
+  int prev_seen_cell = m_interface->GetPrevSeenCellID();
+  int prev_task_cell = m_interface->GetPrevTaskCellID();
+  int num_task_cells = m_interface->GetNumTaskCellsReached();
+  ar.Transfer(prev_seen_cell);
+  ar.Transfer(prev_task_cell);
+  ar.Transfer(num_task_cells);
+  if (ar.IsLoading() && ar.IsGood()) {
+    m_interface->SetPrevSeenCellID(prev_seen_cell);
+    m_interface->SetPrevTaskCellID(prev_task_cell);
+    while (m_interface->GetNumTaskCellsReached() < num_task_cells) m_interface->AddReachedTaskCell();
+  }
+  
+  m_phenotype.CheckpointState(ar);
+  m_hardware->CheckpointState(ar);
+}
+
 void cOrganism::PrintStatus(ostream& fp)
 {
   fp << "---------------------------" << endl;
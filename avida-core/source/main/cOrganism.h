@@ -30,6 +30,7 @@
 
 #include "cCPUMemory.h"
 #include "cMutationRates.h"
+#include "cMutationSampler.h"
 #include "cPhenotype.h"
 #include "cOrgInterface.h"
 #include "cOrgMessage.h"
@@ -51,6 +52,7 @@ class cEnvironment;
 class cHardwareBase;
 class cInstSet;
 class cLineage;
+class cStateArchive;
 class cStateGrid;
 
 struct sOrgDisplay;
@@ -69,6 +71,8 @@ private:
   const Genome m_initial_genome;         // Initial genome; can never be changed!
   Apto::Array<Systematics::UnitPtr> m_parasites;   // List of all parasites associated with this organism.
   cMutationRates m_mut_rates;             // Rate of all possible mutations.
+  cMutationSampler m_copy_mut_sampler;    // Copies left until the next copy mutation
+  bool m_sample_copy_muts;                // Draw copy mutations with m_copy_mut_sampler (MUTATION_SAMPLING_METHOD 1)
   cOrgInterface* m_interface;             // Interface back to the population.
   int m_id;                               // unique id for each org, is just the number it was born
   int m_lineage_label;                    // a lineages tag; inherited unchanged in offspring
@@ -76,6 +80,7 @@ private:
   int cclade_id;				                  // @MRR Coalescence clade information (set in cPopulation)
 
   int m_org_list_index;
+  int m_stats_slot;                       // slot in the population's incremental stats tracker (-1 if untracked)
   
   sOrgDisplay* m_org_display;
   sOrgDisplay* m_queued_display_data;
@@ -112,6 +117,14 @@ private:
   cOrganism(const cOrganism&); // @not_implemented
   cOrganism& operator=(const cOrganism&); // @not_implemented
 
+  void markStatsDirty();
+
+  // Organism pool support, see cOrganismPool
+  friend class cOrganismPool;
+  void releaseOwned();
+  void retire();
+  void recycle(cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src);
+
 public:
   cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src);
   ~cOrganism();
@@ -136,6 +149,7 @@ public:
   void NotifyDeath(cAvidaContext& ctx);
 
   void PrintStatus(std::ostream& fp);
+  void CheckpointState(cStateArchive& ar);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp);
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success);
   void PrintFinalStatus(std::ostream& fp, int time_used, int time_allocated) const;
@@ -200,6 +214,11 @@ public:
 
   inline void SetOrgIndex(int index) { m_org_list_index = index; }
   inline int GetOrgIndex() { return m_org_list_index; }
+
+  // Incremental organism statistics (see cOrgStatsTracker)
+  inline void SetStatsSlot(int slot) { m_stats_slot = slot; }
+  inline int GetStatsSlot() const { return m_stats_slot; }
+  inline void MarkStatsDirty() { if (m_stats_slot >= 0) markStatsDirty(); }
   
   // Org displaying
   inline void ActivateDisplay() { m_display = true; }
@@ -302,7 +321,11 @@ public:
   void ClearParasites();
 
   // --------  Mutation Rate Convenience Methods  --------
-  bool TestCopyMut(cAvidaContext& ctx) const { return m_mut_rates.TestCopyMut(ctx); }
+  bool TestCopyMut(cAvidaContext& ctx)
+  {
+    if (m_sample_copy_muts) return m_copy_mut_sampler.Test(ctx, m_mut_rates.GetCopyMutProb());
+    return m_mut_rates.TestCopyMut(ctx);
+  }
   bool TestCopyIns(cAvidaContext& ctx) const { return m_mut_rates.TestCopyIns(ctx); }
   bool TestCopyDel(cAvidaContext& ctx) const { return m_mut_rates.TestCopyDel(ctx); }
   bool TestCopyUniform(cAvidaContext& ctx) const { return m_mut_rates.TestCopyUniform(ctx); }
@@ -331,8 +354,9 @@ public:
   double GetCopyUniformProb() const { return m_mut_rates.GetCopyUniformProb(); }
   double GetCopySlipProb() const { return m_mut_rates.GetCopySlipProb(); }
 
-  void SetCopyMutProb(double _p) { return m_mut_rates.SetCopyMutProb(_p); }
-  void SetDivMutProb(double _p) { return m_mut_rates.SetDivMutProb(_p); }
+  // Both rates are part of the per organism statistics, see MarkStatsDirty()
+  void SetCopyMutProb(double _p) { m_mut_rates.SetCopyMutProb(_p); MarkStatsDirty(); }
+  void SetDivMutProb(double _p) { m_mut_rates.SetDivMutProb(_p); MarkStatsDirty(); }
 
   double GetDivInsProb() const { return m_mut_rates.GetDivInsProb(); }
   double GetDivDelProb() const { return m_mut_rates.GetDivDelProb(); }
@@ -0,0 +1,92 @@
+/*
+ *  cOrganismPool.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cOrganismPool.h"
+
+#include "avida/core/Genome.h"
+
+#include "cAvidaContext.h"
+#include "cOrganism.h"
+#include "cWorld.h"
+
+#include <cassert>
+
+
+cOrganismPool::cOrganismPool(cWorld* world)
+: m_world(world), m_pool_size(world->GetConfig().ORGANISM_POOL_SIZE.Get())
+{
+  m_stats.allocated = 0; m_stats.reused = 0; m_stats.returned = 0; m_stats.freed = 0; m_stats.idle = 0;
+}
+
+cOrganismPool::~cOrganismPool()
+{
+  for (int i = 0; i < m_idle.GetSize(); i++) delete m_idle[i];
+}
+
+
+cOrganism* cOrganismPool::Create(cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src)
+{
+  cOrganism* org = NULL;
+  if (m_pool_size > 0) {
+    m_mutex.Lock();
+    if (m_idle.GetSize()) {
+      org = m_idle.Pop();
+      m_stats.reused++;
+      m_stats.idle--;
+    } else {
+      m_stats.allocated++;
+    }
+    m_mutex.Unlock();
+    
+    if (org) {
+      org->recycle(ctx, genome, parent_generation, src);
+      return org;
+    }
+  }
+  
+  return new cOrganism(m_world, ctx, genome, parent_generation, src);
+}
+
+void cOrganismPool::Release(cOrganism* org)
+{
+  if (org == NULL) return;
+  assert(!org->IsRunning());
+  
+  if (m_pool_size > 0) {
+    org->retire();
+    
+    Apto::MutexAutoLock lock(m_mutex);
+    if (m_idle.GetSize() < m_pool_size) {
+      m_idle.Push(org);
+      m_stats.returned++;
+      m_stats.idle++;
+      return;
+    }
+    m_stats.freed++;
+  }
+  
+  delete org;
+}
+
+cOrganismPool::sPoolStats cOrganismPool::GetPoolStats() const
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_stats;
+}
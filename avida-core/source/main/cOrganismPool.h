@@ -0,0 +1,82 @@
+/*
+ *  cOrganismPool.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cOrganismPool_h
+#define cOrganismPool_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+
+#include "avida/systematics/Unit.h"
+
+namespace Avida {
+  class Genome;
+};
+
+class cAvidaContext;
+class cOrganism;
+class cWorld;
+
+using namespace Avida;
+
+
+// cOrganismPool - idle organisms kept for reuse by newborns (ORGANISM_POOL_SIZE)
+//
+// A released organism gives up its hardware, interface and other owned objects at once, and keeps only its own
+// storage and that of its embedded phenotype.  Create resets a pooled organism through cOrganism::recycle and
+// cPhenotype::Recycle, which set every member the constructors set, so a recycled organism starts in the same state
+// as a newly constructed one.  Organisms may still be deleted directly; they are then simply not reused.
+
+class cOrganismPool
+{
+public:
+  struct sPoolStats
+  {
+    int allocated;      // organisms constructed by Create
+    int reused;         // pooled organisms handed out by Create
+    int returned;       // organisms placed in the pool by Release
+    int freed;          // organisms deleted by Release
+    int idle;           // organisms currently held in the pool
+  };
+
+private:
+  cWorld* m_world;
+  const int m_pool_size;
+  
+  mutable Apto::Mutex m_mutex;
+  Apto::Array<cOrganism*, Apto::Smart> m_idle;
+  sPoolStats m_stats;
+  
+  
+  cOrganismPool(); // @not_implemented
+  cOrganismPool(const cOrganismPool&); // @not_implemented
+  cOrganismPool& operator=(const cOrganismPool&); // @not_implemented
+  
+public:
+  cOrganismPool(cWorld* world);
+  ~cOrganismPool();
+  
+  // Organisms from Create should be handed back through Release once they are no longer running
+  cOrganism* Create(cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src);
+  void Release(cOrganism* org);
+  sPoolStats GetPoolStats() const;
+};
+
+#endif
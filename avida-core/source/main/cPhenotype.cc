@@ -27,6 +27,7 @@
 #include "cDeme.h"
 #include "cOrganism.h"
 #include "cReactionResult.h"
+#include "cStateArchive.h"
 #include "cTaskState.h"
 #include "cWorld.h"
 #include "tList.h"
@@ -94,6 +95,120 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
 , last_task_time(0)
 
 { 
+  setupBirth(parent_generation, num_nops);
+}
+
+cPhenotype::~cPhenotype()
+{
+  // Remove Task States
+  for (Apto::Map<void*, cTaskState*>::ValueIterator it = m_task_states.Values(); it.Next();) delete (*it.Get());
+  delete m_reaction_result;
+}
+
+
+// Returns a phenotype taken from a dead organism to the state the constructor leaves it in.  Members the constructor
+// sets are set again, and the arrays it sizes are resized in place so that their storage is kept while the
+// environment is unchanged.  Members the constructor leaves unset are left for SetupOffspring/SetupInject, as they
+// are for a new phenotype.
+void cPhenotype::Recycle(int parent_generation, int num_nops)
+{
+  for (Apto::Map<void*, cTaskState*>::ValueIterator it = m_task_states.Values(); it.Next();) delete (*it.Get());
+  m_task_states.Clear();
+  delete m_reaction_result;
+  m_reaction_result = NULL;
+  
+  const int num_tasks = m_world->GetEnvironment().GetNumTasks();
+  const int num_res = m_world->GetEnvironment().GetResourceLib().GetSize();
+  const int num_reactions = m_world->GetEnvironment().GetReactionLib().GetSize();
+  const int num_sense = m_world->GetStats().GetSenseSize();
+  
+  initialized = false;
+  merit = cMerit();
+  energy_store = 0.0;
+  
+  cur_task_count.Resize(num_tasks);
+  cur_para_tasks.Resize(num_tasks);
+  cur_host_tasks.Resize(num_tasks);
+  cur_internal_task_count.Resize(num_tasks);
+  eff_task_count.Resize(num_tasks);
+  cur_task_quality.Resize(num_tasks);
+  cur_task_value.Resize(num_tasks);
+  cur_internal_task_quality.Resize(num_tasks);
+  cur_rbins_total.Resize(num_res);
+  cur_rbins_avail.Resize(num_res);
+  cur_collect_spec_counts.Resize(0);
+  cur_reaction_count.Resize(num_reactions);
+  first_reaction_cycles.Resize(num_reactions);
+  first_reaction_execs.Resize(num_reactions);
+  cur_stolen_reaction_count.Resize(num_reactions);
+  cur_reaction_add_reward.Resize(num_reactions);
+  cur_inst_count.Resize(0);
+  cur_from_sensor_count.Resize(0);
+  cur_group_attack_count.Resize(0);
+  cur_top_pred_group_attack_count.Resize(0);
+  cur_killed_targets.Resize(0);
+  cur_sense_count.Resize(num_sense);
+  sensed_resources.Resize(num_res);
+  cur_task_time.Resize(num_tasks);
+  cur_trial_fitnesses.Resize(0);
+  cur_trial_bonuses.Resize(0);
+  cur_trial_times_used.Resize(0);
+  cur_from_message_count.Resize(0);
+  
+  while (m_tolerance_immigrants.GetSize()) delete m_tolerance_immigrants.Pop();
+  while (m_tolerance_offspring_own.GetSize()) delete m_tolerance_offspring_own.Pop();
+  while (m_tolerance_offspring_others.GetSize()) delete m_tolerance_offspring_others.Pop();
+  m_intolerances.ResizeClear((m_world->GetConfig().TOLERANCE_VARIATIONS.Get() > 0) ? 1 : 3);
+  m_intolerances.SetAll(pair<int, int>());
+  
+  mating_type = MATING_TYPE_JUVENILE;
+  mate_preference = MATE_PREFERENCE_RANDOM;
+  cur_mating_display_a = 0;
+  cur_mating_display_b = 0;
+  
+  last_task_count.Resize(num_tasks);
+  last_para_tasks.Resize(num_tasks);
+  last_host_tasks.Resize(num_tasks);
+  last_internal_task_count.Resize(num_tasks);
+  last_task_quality.Resize(num_tasks);
+  last_task_value.Resize(num_tasks);
+  last_internal_task_quality.Resize(num_tasks);
+  last_rbins_total.Resize(num_res);
+  last_rbins_avail.Resize(num_res);
+  last_collect_spec_counts.Resize(0);
+  last_reaction_count.Resize(num_reactions);
+  last_reaction_add_reward.Resize(num_reactions);
+  last_inst_count.Resize(0);
+  last_from_sensor_count.Resize(0);
+  last_sense_count.Resize(num_sense);
+  last_group_attack_count.Resize(0);
+  last_top_pred_group_attack_count.Resize(0);
+  last_killed_targets.Resize(0);
+  last_from_message_count.Resize(0);
+  last_mating_display_a = 0;
+  last_mating_display_b = 0;
+  
+  generation = 0;
+  birth_cell_id = 0;
+  av_birth_cell_id = 0;
+  birth_group_id = 0;
+  birth_forager_type = -1;
+  last_task_id = -1;
+  num_new_unique_reactions = 0;
+  res_consumed = 0;
+  is_germ_cell = m_world->GetConfig().DEMES_ORGS_START_IN_GERM.Get();
+  last_task_time = 0;
+  
+  fault_desc = "";
+  testCPU_inst_count.Resize(0);
+  is_donor_locus.Resize(0);
+  is_donor_locus_last.Resize(0);
+  
+  setupBirth(parent_generation, num_nops);
+}
+
+void cPhenotype::setupBirth(int parent_generation, int num_nops)
+{
   if (parent_generation >= 0) {
     generation = parent_generation;
     if (m_world->GetConfig().GENERATION_INC_METHOD.Get() != GENERATION_INC_BOTH) generation++;
@@ -105,13 +220,6 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
   cur_collect_spec_counts.Resize(int((pow((double)num_nops, most_nops_needed + 1.0) - 1.0) / ((double)num_nops - 1.0)));
 }
 
-cPhenotype::~cPhenotype()
-{
-  // Remove Task States
-  for (Apto::Map<void*, cTaskState*>::ValueIterator it = m_task_states.Values(); it.Next();) delete (*it.Get());
-  delete m_reaction_result;
-}
-
 
 cPhenotype::cPhenotype(const cPhenotype& in_phen) : m_reaction_result(NULL)
 {
@@ -1162,9 +1270,9 @@ void cPhenotype::TestDivideReset(const InstructionSequence& _genome)
   cur_trial_times_used.Resize(0); 
   trial_time_used = 0;
   trial_cpu_cycles_used = 0;
-  m_tolerance_immigrants.Clear();
-  m_tolerance_offspring_own.Clear();
-  m_tolerance_offspring_others.Clear();
+  while (m_tolerance_immigrants.GetSize()) delete m_tolerance_immigrants.Pop();
+  while (m_tolerance_offspring_own.GetSize()) delete m_tolerance_offspring_own.Pop();
+  while (m_tolerance_offspring_others.GetSize()) delete m_tolerance_offspring_others.Pop();
   m_intolerances.SetAll(make_pair(-1, -1));  
   cur_child_germline_propensity = m_world->GetConfig().DEMES_DEFAULT_GERMLINE_PROPENSITY.Get();
   
@@ -1713,6 +1821,253 @@ void cPhenotype::Sterilize()
 }
 
 
+void cPhenotype::CheckpointState(cStateArchive& ar)
+{
+  // Task states are owned by task library specific code and have no serialized form
+  if (m_task_states.GetSize()) {
+    ar.Fail("organisms with stateful tasks can not be checkpointed");
+    return;
+  }
+  
+  ar.Tag("cPhenotype");
+  ar.Transfer(initialized);
+  
+  double merit_value = merit.GetDouble();
+  ar.Transfer(merit_value);
+  if (ar.IsLoading()) merit.UpdateValue(merit_value);
+  
+  // 1. Values calculated at the last divide, and scalar "in progress" values
+  ar.Transfer(executionRatio);
+  ar.Transfer(energy_store);
+  ar.Transfer(fitness);
+  ar.Transfer(div_type);
+  ar.Transfer(cur_bonus);
+  ar.Transfer(cur_energy_bonus);
+  ar.Transfer(energy_tobe_applied);
+  ar.Transfer(energy_testament);
+  ar.Transfer(energy_received_buffer);
+  ar.Transfer(total_energy_donated);
+  ar.Transfer(total_energy_received);
+  ar.Transfer(total_energy_applied);
+  ar.Transfer(last_child_germline_propensity);
+  ar.Transfer(last_merit_base);
+  ar.Transfer(last_bonus);
+  ar.Transfer(last_energy_bonus);
+  ar.Transfer(last_fitness);
+  ar.Transfer(cur_child_germline_propensity);
+  ar.Transfer(neutral_metric);
+  ar.Transfer(life_fitness);
+  ar.Transfer(gmu_exec_time_born);
+  ar.Transfer(res_consumed);
+  ar.Transfer(permanent_germline_propensity);
+
+  ar.Transfer(genome_length);
+  ar.Transfer(bonus_instruction_count);
+  ar.Transfer(copied_size);
+  ar.Transfer(executed_size);
+  ar.Transfer(gestation_time);
+  ar.Transfer(gestation_start);
+  ar.Transfer(num_energy_requests);
+  ar.Transfer(num_energy_donations);
+  ar.Transfer(num_energy_receptions);
+  ar.Transfer(num_energy_applications);
+  ar.Transfer(cur_num_errors);
+  ar.Transfer(cur_num_donates);
+  ar.Transfer(cur_attacks);
+  ar.Transfer(cur_kills);
+  ar.Transfer(trial_time_used);
+  ar.Transfer(trial_cpu_cycles_used);
+  ar.Transfer(mating_type);
+  ar.Transfer(mate_preference);
+  ar.Transfer(cur_mating_display_a);
+  ar.Transfer(cur_mating_display_b);
+  ar.Transfer(last_num_errors);
+  ar.Transfer(last_num_donates);
+  ar.Transfer(last_attacks);
+  ar.Transfer(last_kills);
+  ar.Transfer(last_cpu_cycles_used);
+  ar.Transfer(last_mating_display_a);
+  ar.Transfer(last_mating_display_b);
+  ar.Transfer(num_divides_failed);
+  ar.Transfer(num_divides);
+  ar.Transfer(generation);
+  ar.Transfer(cpu_cycles_used);
+  ar.Transfer(time_used);
+  ar.Transfer(num_execs);
+  ar.Transfer(age);
+  ar.Transfer(exec_time_born);
+  ar.Transfer(birth_update);
+  ar.Transfer(birth_cell_id);
+  ar.Transfer(av_birth_cell_id);
+  ar.Transfer(birth_group_id);
+  ar.Transfer(birth_forager_type);
+  ar.Transfer(last_task_id);
+  ar.Transfer(num_new_unique_reactions);
+  ar.Transfer(last_task_time);
+  ar.Transfer(num_thresh_gb_donations);
+  ar.Transfer(num_thresh_gb_donations_last);
+  ar.Transfer(num_quanta_thresh_gb_donations);
+  ar.Transfer(num_quanta_thresh_gb_donations_last);
+  ar.Transfer(num_shaded_gb_donations);
+  ar.Transfer(num_shaded_gb_donations_last);
+  ar.Transfer(num_donations_locus);
+  ar.Transfer(num_donations_locus_last);
+  ar.Transfer(parent_cross_num);
+  ar.Transfer(mate_select_id);
+  ar.Transfer(cross_num);
+  ar.Transfer(child_copied_size);
+
+  // 2. and 3. Current and last gestation cycle accumulations
+  ar.Transfer(cur_task_count);
+  ar.Transfer(cur_para_tasks);
+  ar.Transfer(cur_host_tasks);
+  ar.Transfer(cur_internal_task_count);
+  ar.Transfer(eff_task_count);
+  ar.Transfer(cur_task_quality);
+  ar.Transfer(cur_task_value);
+  ar.Transfer(cur_internal_task_quality);
+  ar.Transfer(cur_rbins_total);
+  ar.Transfer(cur_rbins_avail);
+  ar.Transfer(cur_collect_spec_counts);
+  ar.Transfer(cur_reaction_count);
+  ar.Transfer(first_reaction_cycles);
+  ar.Transfer(first_reaction_execs);
+  ar.Transfer(cur_stolen_reaction_count);
+  ar.Transfer(cur_reaction_add_reward);
+  ar.Transfer(cur_inst_count);
+  ar.Transfer(cur_from_sensor_count);
+  ar.Transfer(cur_group_attack_count);
+  ar.Transfer(cur_top_pred_group_attack_count);
+  ar.Transfer(cur_killed_targets);
+  ar.Transfer(cur_sense_count);
+  ar.Transfer(sensed_resources);
+  ar.Transfer(cur_task_time);
+  ar.Transfer(cur_trial_fitnesses);
+  ar.Transfer(cur_trial_bonuses);
+  ar.Transfer(cur_trial_times_used);
+  ar.Transfer(cur_from_message_count);
+
+  ar.Transfer(last_task_count);
+  ar.Transfer(last_para_tasks);
+  ar.Transfer(last_host_tasks);
+  ar.Transfer(last_internal_task_count);
+  ar.Transfer(last_task_quality);
+  ar.Transfer(last_task_value);
+  ar.Transfer(last_internal_task_quality);
+  ar.Transfer(last_rbins_total);
+  ar.Transfer(last_rbins_avail);
+  ar.Transfer(last_collect_spec_counts);
+  ar.Transfer(last_reaction_count);
+  ar.Transfer(last_reaction_add_reward);
+  ar.Transfer(last_inst_count);
+  ar.Transfer(last_from_sensor_count);
+  ar.Transfer(last_sense_count);
+  ar.Transfer(last_group_attack_count);
+  ar.Transfer(last_top_pred_group_attack_count);
+  ar.Transfer(last_killed_targets);
+  ar.Transfer(last_from_message_count);
+  ar.Transfer(testCPU_inst_count);
+
+  checkpointTolerances(ar, m_tolerance_immigrants);
+  checkpointTolerances(ar, m_tolerance_offspring_own);
+  checkpointTolerances(ar, m_tolerance_offspring_others);
+  int num_intolerances = m_intolerances.GetSize();
+  ar.Transfer(num_intolerances);
+  if (!ar.IsGood()) return;
+  if (ar.IsLoading()) m_intolerances.Resize(num_intolerances);
+  for (int i = 0; i < num_intolerances; i++) {
+    ar.Transfer(m_intolerances[i].first);
+    ar.Transfer(m_intolerances[i].second);
+  }
+  
+  // 4. and 5. Life records and status flags
+  ar.Transfer(fault_desc);
+  ar.Transfer(is_germ_cell);
+  ar.Transfer(to_die);
+  ar.Transfer(to_delete);
+  ar.Transfer(is_injected);
+  ar.Transfer(is_clone);
+  ar.Transfer(is_donor_cur);
+  ar.Transfer(is_donor_last);
+  ar.Transfer(is_donor_rand);
+  ar.Transfer(is_donor_rand_last);
+  ar.Transfer(is_donor_null);
+  ar.Transfer(is_donor_null_last);
+  ar.Transfer(is_donor_kin);
+  ar.Transfer(is_donor_kin_last);
+  ar.Transfer(is_donor_edit);
+  ar.Transfer(is_donor_edit_last);
+  ar.Transfer(is_donor_gbg);
+  ar.Transfer(is_donor_gbg_last);
+  ar.Transfer(is_donor_truegb);
+  ar.Transfer(is_donor_truegb_last);
+  ar.Transfer(is_donor_threshgb);
+  ar.Transfer(is_donor_threshgb_last);
+  ar.Transfer(is_donor_quanta_threshgb);
+  ar.Transfer(is_donor_quanta_threshgb_last);
+  ar.Transfer(is_donor_shadedgb);
+  ar.Transfer(is_donor_shadedgb_last);
+  ar.Transfer(is_energy_requestor);
+  ar.Transfer(is_energy_donor);
+  ar.Transfer(is_energy_receiver);
+  ar.Transfer(has_used_donated_energy);
+  ar.Transfer(has_open_energy_request);
+  ar.Transfer(is_receiver);
+  ar.Transfer(is_receiver_last);
+  ar.Transfer(is_receiver_rand);
+  ar.Transfer(is_receiver_kin);
+  ar.Transfer(is_receiver_kin_last);
+  ar.Transfer(is_receiver_edit);
+  ar.Transfer(is_receiver_edit_last);
+  ar.Transfer(is_receiver_gbg);
+  ar.Transfer(is_receiver_truegb);
+  ar.Transfer(is_receiver_truegb_last);
+  ar.Transfer(is_receiver_threshgb);
+  ar.Transfer(is_receiver_threshgb_last);
+  ar.Transfer(is_receiver_quanta_threshgb);
+  ar.Transfer(is_receiver_quanta_threshgb_last);
+  ar.Transfer(is_receiver_shadedgb);
+  ar.Transfer(is_receiver_shadedgb_last);
+  ar.Transfer(is_receiver_gb_same_locus);
+  ar.Transfer(is_receiver_gb_same_locus_last);
+  ar.Transfer(is_modifier);
+  ar.Transfer(is_modified);
+  ar.Transfer(is_fertile);
+  ar.Transfer(is_mutated);
+  ar.Transfer(is_multi_thread);
+  ar.Transfer(parent_true);
+  ar.Transfer(parent_sex);
+  ar.Transfer(born_parent_group);
+  ar.Transfer(kaboom_executed);
+  ar.Transfer(kaboom_executed2);
+  ar.Transfer(copy_true);
+  ar.Transfer(divide_sex);
+  ar.Transfer(child_fertile);
+  ar.Transfer(last_child_fertile);
+  ar.Transfer(is_donor_locus);
+  ar.Transfer(is_donor_locus_last);
+}
+
+void cPhenotype::checkpointTolerances(cStateArchive& ar, tList<int>& updates)
+{
+  int size = updates.GetSize();
+  ar.Transfer(size);
+  if (!ar.IsGood()) return;
+  
+  if (ar.IsSaving()) {
+    tConstListIterator<int> it(updates);
+    while (it.Next() != NULL) ar.Transfer(*it.Get());
+    return;
+  }
+  
+  while (updates.GetSize()) delete updates.Pop();
+  for (int i = 0; i < size; i++) {
+    int update = 0;
+    ar.Transfer(update);
+    updates.PushRear(new int(update));
+  }
+}
+
 void cPhenotype::PrintStatus(ostream& fp) const
 {
   fp << "  MeritBase:"
@@ -68,6 +68,7 @@ class cTaskContext;
 class cTaskState;
 class cPhenPlastSummary;
 class cReactionResult;
+class cStateArchive;
 
 using namespace Avida;
 
@@ -311,6 +312,8 @@ private:
   
 
   inline void SetInstSetSize(int inst_set_size);
+  void checkpointTolerances(cStateArchive& ar, tList<int>& updates);
+  void setupBirth(int parent_generation, int num_nops);
   inline void SetGroupAttackInstSetSize(int num_group_attack_inst);
   
 public:
@@ -322,6 +325,9 @@ public:
   cPhenotype& operator=(const cPhenotype&); 
   ~cPhenotype();
   
+  // Reuse by a pooled organism; leaves the phenotype as the constructor would for a new organism
+  void Recycle(int parent_generation, int num_nops);
+  
   enum energy_levels {ENERGY_LEVEL_LOW = 0, ENERGY_LEVEL_MEDIUM, ENERGY_LEVEL_HIGH};
 	
   void ResetMerit();
@@ -350,6 +356,7 @@ public:
 
   // State saving and loading, and printing...
   void PrintStatus(std::ostream& fp) const;
+  void CheckpointState(cStateArchive& ar);
 
   // Some useful methods...
   int CalcSizeMerit() const;
@@ -29,35 +29,44 @@
 #include "avida/data/Package.h"
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
 
 #include "avida/private/systematics/GenomeTestMetrics.h"
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/GenotypeArbiter.h"
 
+#include "apto/core/FileSystem.h"
 #include "apto/rng.h"
 #include "apto/scheduler.h"
 #include "apto/stat/Accumulator.h"
 
 #include "AvidaTools.h"
 
+#include "cAliasSchedule.h"
 #include "cAvidaContext.h"
+#include "cBinaryPopulationFile.h"
 #include "cCPUTestInfo.h"
 #include "cCodeLabel.h"
 #include "cDemePlaceholderUnit.h"
 #include "cEnvironment.h"
+#include "cFenwickSchedule.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cInitFile.h"
 #include "cInstSet.h"
 #include "cMigrationMatrix.h"   
+#include "cMutationSampler.h"
 #include "cOrganism.h"
+#include "cOrganismPool.h"
 #include "cParasite.h"
 #include "cPhenotype.h"
 #include "cPopulationCell.h"
 #include "cResource.h"
 #include "cResourceCount.h"
+#include "cStateArchive.h"
 #include "cStats.h"
 #include "cTestCPU.h"
 #include "cTopology.h"
@@ -73,6 +82,8 @@
 #include <cfloat>
 #include <cmath>
 #include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 
 using namespace std;
@@ -265,6 +276,7 @@ public:
 cPopulation::cPopulation(cWorld* world)  
 : m_world(world)
 , m_scheduler(NULL)
+, m_org_stats(NULL)
 , birth_chamber(world)
 , print_mini_trace_genomes(false)
 , use_micro_traces(false)
@@ -298,6 +310,8 @@ cPopulation::cPopulation(cWorld* world)
   
   SetupCellGrid();
   
+  if (m_world->GetConfig().ORGANISM_STATS_METHOD.Get() != 0) m_org_stats = new cOrgStatsTracker(m_world);
+  
   Data::ArgumentedProviderActivateFunctor activate(m_world, &cWorld::GetPopulationProvider);
   m_world->GetDataManager()->Register("core.population.group_id[]", activate);
 
@@ -364,6 +378,7 @@ void cPopulation::SetupCellGrid()
       cell_array[cell_id].SetDemeID(deme_id);
     }
     deme_array[deme_id].Setup(deme_id, deme_cells, deme_size_x, m_world);
+    deme_array[deme_id].SetResourceClock(&m_deme_res_clock);
   }
   
   // Setup the topology.
@@ -602,8 +617,9 @@ bool cPopulation::IsValidArgument(const Data::DataID& data_id, Data::Argument ar
 
 cPopulation::~cPopulation()
 {
-  for (int i = 0; i < cell_array.GetSize(); i++) delete cell_array[i].GetOrganism(); 
+  for (int i = 0; i < cell_array.GetSize(); i++) m_world->GetOrganismPool().Release(cell_array[i].GetOrganism());
   delete m_scheduler;
+  delete m_org_stats;
 }
 
 
@@ -655,6 +671,7 @@ bool cPopulation::ActivateOffspring(cAvidaContext& ctx, const Genome& offspring_
   ConstInstructionSequencePtr seq;
   seq.DynamicCastFrom(parent_organism->GetGenome().Representation());
   parent_phenotype.DivideReset(*seq);
+  parent_organism->MarkStatsDirty();
   
   GeneticRepresentationPtr tmpHostGenome;
   
@@ -686,7 +703,7 @@ bool cPopulation::ActivateOffspring(cAvidaContext& ctx, const Genome& offspring_
       if (m_world->TestForMigration()) {
         // this offspring is outta here!
         m_world->MigrateOrganism(offspring_array[i], parent_cell, merit_array[i], parent_organism->GetLineageLabel());
-        delete offspring_array[i]; // this offspring isn't hanging around.
+        m_world->GetOrganismPool().Release(offspring_array[i]); // this offspring isn't hanging around.
       } else {
         // boring; stay here.
         non_migrants.Push(offspring_array[i]);
@@ -918,7 +935,7 @@ bool cPopulation::ActivateOffspring(cAvidaContext& ctx, const Genome& offspring_
         else KillOrganism(GetCell(target_cells[i]), ctx);
       }
     } else {
-      delete offspring_array[i];
+      m_world->GetOrganismPool().Release(offspring_array[i]);
     }
   }
   if (m_world->GetConfig().DIVIDE_METHOD.Get() == DIVIDE_METHOD_SPLIT && parent_alive && m_world->GetConfig().RESET_INPUTS_ON_DIVIDE.Get()) TestForMiniTrace(parent_organism);
@@ -1432,6 +1449,7 @@ void cPopulation::SetupMiniTrace(cOrganism* in_organism)
   else group_id = in_organism->GetParentGroup();
   
   cString filename = cStringUtil::Stringf("minitraces/org%d-ud%d-grp%d_ft%d-gt%d.trc", id, m_world->GetStats().GetUpdate(), group_id, target, in_organism->SystematicsGroup("genotype")->ID());
+  if (m_world->GetConfig().MINI_TRACE_FORMAT.Get() == 1) filename += "b";
   
   if (!use_micro_traces) in_organism->GetHardware().SetMiniTrace(filename);
   else in_organism->GetHardware().SetMicroTrace();
@@ -2200,7 +2218,7 @@ void cPopulation::KillOrganism(cPopulationCell& in_cell, cAvidaContext& ctx)
   
   // And clear it!
   in_cell.RemoveOrganism(ctx); 
-  if (!organism->IsRunning()) delete organism;
+  if (!organism->IsRunning()) m_world->GetOrganismPool().Release(organism);
   else organism->GetPhenotype().SetToDelete();
   
   // Alert the scheduler that this cell has a 0 merit.
@@ -3150,6 +3168,7 @@ void cPopulation::ReplaceDeme(cDeme& source_deme, cDeme& target_deme, cAvidaCont
           cPhenotype& phenotype = organism->GetPhenotype();
           phenotype.SetEnergy(phenotype.GetStoredEnergy() + offspring_deme_energy/static_cast<double>(target_deme.GetOrgCount()));
           phenotype.SetMerit(cMerit(phenotype.ConvertEnergyToMerit(phenotype.GetStoredEnergy() * phenotype.GetEnergyUsageRatio())));
+          organism->MarkStatsDirty();
           totalEnergyInjectedIntoOrganisms += phenotype.GetStoredEnergy();
         }
       }
@@ -3166,6 +3185,7 @@ void cPopulation::ReplaceDeme(cDeme& source_deme, cDeme& target_deme, cAvidaCont
           cPhenotype& phenotype = organism->GetPhenotype();
           phenotype.SetEnergy(phenotype.GetStoredEnergy() + parent_deme_energy/static_cast<double>(source_deme.GetOrgCount()));
           phenotype.SetMerit(cMerit(phenotype.ConvertEnergyToMerit(phenotype.GetStoredEnergy() * phenotype.GetEnergyUsageRatio())));
+          organism->MarkStatsDirty();
           totalEnergyInjectedIntoOrganisms += phenotype.GetStoredEnergy();
         }
       }
@@ -3837,7 +3857,7 @@ bool cPopulation::SeedDeme(cDeme& source_deme, cDeme& target_deme, cAvidaContext
         old_target_organisms[i]->SetRunning(false);
         // ONLY delete target orgs if seeding was successful
         // otherwise they still exist in the population!!!
-        if (successfully_seeded) delete old_target_organisms[i];
+        if (successfully_seeded) m_world->GetOrganismPool().Release(old_target_organisms[i]);
       }
       
       for(int i=0; i<old_source_organisms.GetSize(); ++i) {
@@ -3846,7 +3866,7 @@ bool cPopulation::SeedDeme(cDeme& source_deme, cDeme& target_deme, cAvidaContext
         // delete old source organisms ONLY if source was replaced
         if ( (m_world->GetConfig().DEMES_DIVIDE_METHOD.Get() == 0)
             || (m_world->GetConfig().DEMES_DIVIDE_METHOD.Get() == 1) ) {
-          delete old_source_organisms[i];
+          m_world->GetOrganismPool().Release(old_source_organisms[i]);
         }
       }
       
@@ -5528,6 +5548,22 @@ int cPopulation::ScheduleOrganism()
   return m_scheduler->Next();
 }
 
+
+inline void cPopulation::AdvanceDemeResourceClock(double step_size, int steps)
+{
+  if (!m_deme_res_clock.CanAdvance(step_size)) FlushDemeResourceClock();
+  m_deme_res_clock.Advance(step_size, steps);
+}
+
+
+void cPopulation::FlushDemeResourceClock()
+{
+  if (m_deme_res_clock.GetSteps() == 0) return;
+  for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].FlushResourceClock();
+  m_deme_res_clock.Reset();
+}
+
+
 void cPopulation::ProcessStep(cAvidaContext& ctx, double step_size, int cell_id)
 {
   assert(step_size > 0.0);
@@ -5545,16 +5581,14 @@ void cPopulation::ProcessStep(cAvidaContext& ctx, double step_size, int cell_id)
   double merit = cur_org->GetPhenotype().GetMerit().GetDouble();
   if (cur_org->GetPhenotype().GetToDelete() == true) {
     cur_org->GetHardware().DeleteMiniTrace(print_mini_trace_reacs);
-    delete cur_org;
+    m_world->GetOrganismPool().Release(cur_org);
   }
   
   m_world->GetStats().IncExecuted();
   resource_count.Update(step_size);
   
-  // These must be done even if there is only one deme.
-  for(int i = 0; i < GetNumDemes(); i++) {
-    GetDeme(i).Update(step_size);
-  }
+  // This must be done even if there is only one deme.
+  AdvanceDemeResourceClock(step_size);
   
   cDeme & deme = GetDeme(GetCell(cell_id).GetDemeID());
   deme.IncTimeUsed(merit);
@@ -5598,7 +5632,7 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
   
   // Deme specific
   if (GetNumDemes() > 1) {
-    for(int i = 0; i < GetNumDemes(); i++) GetDeme(i).Update(step_size);
+    AdvanceDemeResourceClock(step_size);
     
     cDeme& deme = GetDeme(GetCell(cell_id).GetDemeID());
     deme.IncTimeUsed(cur_org->GetPhenotype().GetMerit().GetDouble());
@@ -5607,7 +5641,7 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
   
   if (cur_org->GetPhenotype().GetToDelete() == true) {
     cur_org->GetHardware().DeleteMiniTrace(print_mini_trace_reacs);
-    delete cur_org;
+    m_world->GetOrganismPool().Release(cur_org);
     cur_org = NULL;
   }
   
@@ -5615,6 +5649,72 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
   resource_count.Update(step_size);
 }
 
+
+// Burst mode: the scheduled organism executes up to max_steps instructions in a row, and the per-step bookkeeping of
+// ProcessStep is applied once for the whole burst.  Since the scheduler selects organisms in proportion to merit, the
+// processor time each organism receives over an update matches single stepping, only the interleaving differs.
+int cPopulation::ProcessBurst(cAvidaContext& ctx, double step_size, int cell_id, int max_steps)
+{
+  assert(step_size > 0.0);
+  assert(max_steps > 0);
+  assert(cell_id < cell_array.GetSize());
+  
+  // If cell_id is negative, no cell could be found -- the step is consumed.
+  if (cell_id < 0) return 1;
+  
+  cPopulationCell& cell = GetCell(cell_id);
+  assert(cell.IsOccupied()); // Unoccupied cell getting processor time!
+  cOrganism* cur_org = cell.GetOrganism();
+  
+  const int executed = cell.GetHardware()->ProcessBurst(ctx, max_steps);
+  
+  double merit = cur_org->GetPhenotype().GetMerit().GetDouble();
+  if (cur_org->GetPhenotype().GetToDelete() == true) {
+    cur_org->GetHardware().DeleteMiniTrace(print_mini_trace_reacs);
+    m_world->GetOrganismPool().Release(cur_org);
+  }
+  
+  m_world->GetStats().IncExecuted(executed);
+  resource_count.Update(step_size * executed);
+  
+  // This must be done even if there is only one deme.
+  AdvanceDemeResourceClock(step_size, executed);
+  
+  cDeme& deme = GetDeme(GetCell(cell_id).GetDemeID());
+  deme.IncTimeUsed(merit, executed);
+  
+  if (GetNumDemes() >= 1) {
+    CheckImplicitDemeRepro(deme, ctx); 
+  }
+  
+  return executed;
+}
+
+
+// Under MUTATION_SAMPLING_METHOD 1 the genomes of all organisms are treated as one sequence of sites, with the distance
+// from one mutation to the next drawn by a cMutationSampler, so organisms that are not mutated cost no random numbers.
+void cPopulation::ProcessPointMutations(cAvidaContext& ctx)
+{
+  if (m_world->GetConfig().MUTATION_SAMPLING_METHOD.Get() != 1) {
+    for (int i = 0; i < cell_array.GetSize(); i++) {
+      if (cell_array[i].IsOccupied()) {
+        int num_mut = cell_array[i].GetOrganism()->GetHardware().PointMutate(ctx);
+        cell_array[i].GetOrganism()->IncPointMutations(num_mut);
+      }
+    }
+    return;
+  }
+  
+  cMutationSampler sub_sampler, ins_sampler, del_sampler;
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    if (cell_array[i].IsOccupied()) {
+      int num_mut = cell_array[i].GetOrganism()->GetHardware().PointMutate(ctx, sub_sampler, ins_sampler, del_sampler);
+      cell_array[i].GetOrganism()->IncPointMutations(num_mut);
+    }
+  }
+}
+
+
 // Loop through all the demes getting stats and doing calculations
 // which must be done on a deme by deme basis.
 void cPopulation::UpdateDemeStats(cAvidaContext& ctx) { 
@@ -5673,29 +5773,59 @@ void cPopulation::UpdateDemeStats(cAvidaContext& ctx) {
 
 
 void cPopulation::UpdateOrganismStats(cAvidaContext& ctx) 
+{
+  if (m_org_stats == NULL) {
+    scanOrganismStats(ctx, true);
+  } else {
+    // Only organisms marked dirty since the last update are rescanned for the incremental sums
+    m_org_stats->Update();
+    const int method = m_world->GetConfig().ORGANISM_STATS_METHOD.Get();
+    if (method == 2 || method == 3) {
+      scanOrganismStats(ctx, true);
+      if (m_org_stats->Validate(m_world->GetStats(), ctx.Driver().Feedback()) && method == 3) {
+        ctx.Driver().Feedback().Error("incremental organism statistics do not match the full scan");
+        ctx.Driver().Abort(Avida::INTERNAL_ERROR);
+      }
+    } else {
+      scanOrganismStats(ctx, false);
+    }
+    m_org_stats->AdvanceAge();
+  }
+  
+  resource_count.UpdateGlobalResources(ctx);   
+}
+
+void cPopulation::scanOrganismStats(cAvidaContext& ctx, bool full_scan)
 {
   // Loop through all the cells getting stats and doing calculations
-  // which must be done on a creature by creature basis.
+  // which must be done on a creature by creature basis.  Without a full scan, the sums maintained by
+  // m_org_stats are published instead and the loop only covers hardware state, providers and ages.
   
   cStats& stats = m_world->GetStats();
   
   // Clear out organism sums...
-  stats.SumFitness().Clear();
-  stats.SumGestation().Clear();
-  stats.SumMerit().Clear();
-  stats.SumCreatureAge().Clear();
-  stats.SumGeneration().Clear();
-  stats.SumNeutralMetric().Clear();
-  stats.SumLineageLabel().Clear();
-  stats.SumCopyMutRate().Clear();
-  stats.SumDivMutRate().Clear();
-  stats.SumCopySize().Clear();
-  stats.SumExeSize().Clear();
+  if (full_scan) {
+    stats.SumFitness().Clear();
+    stats.SumGestation().Clear();
+    stats.SumMerit().Clear();
+    stats.SumCreatureAge().Clear();
+    stats.SumGeneration().Clear();
+    stats.SumNeutralMetric().Clear();
+    stats.SumLineageLabel().Clear();
+    stats.SumCopyMutRate().Clear();
+    stats.SumLogCopyMutRate().Clear();
+    stats.SumDivMutRate().Clear();
+    stats.SumLogDivMutRate().Clear();
+    stats.SumCopySize().Clear();
+    stats.SumExeSize().Clear();
+  }
   stats.SumMemSize().Clear();
   
   stats.ZeroTasks();
   stats.ZeroReactions();
   
+  if (!full_scan) m_org_stats->Publish(stats);
+  
   for (int osp_idx = 0; osp_idx < m_org_stat_providers.GetSize(); osp_idx++) m_org_stat_providers[osp_idx]->UpdateReset();
 
   // Counts...
@@ -5737,67 +5867,69 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
       from_message_exec_counts[j].Add(organism->GetPhenotype().GetLastFromMessageInstCount()[j]);
     }
 
-    stats.SumFitness().Add(cur_fitness);
-    stats.SumMerit().Add(cur_merit.GetDouble());
-    stats.SumGestation().Add(phenotype.GetGestationTime());
-    stats.SumCreatureAge().Add(phenotype.GetAge());
-    stats.SumGeneration().Add(phenotype.GetGeneration());
-    stats.SumNeutralMetric().Add(phenotype.GetNeutralMetric());
-    stats.SumLineageLabel().Add(organism->GetLineageLabel());
-    stats.SumCopyMutRate().Push(organism->MutationRates().GetCopyMutProb());
-    stats.SumLogCopyMutRate().Push(log(organism->MutationRates().GetCopyMutProb()));
-    stats.SumDivMutRate().Push(organism->MutationRates().GetDivMutProb() / organism->GetPhenotype().GetDivType());
-    stats.SumLogDivMutRate().Push(log(organism->MutationRates().GetDivMutProb() / organism->GetPhenotype().GetDivType()));
-    stats.SumCopySize().Add(phenotype.GetCopiedSize());
-    stats.SumExeSize().Add(phenotype.GetExecutedSize());
-    
-    if (cur_merit > max_merit) max_merit = cur_merit;
-    if (cur_fitness > max_fitness) max_fitness = cur_fitness;
-    if (cur_gestation_time > max_gestation_time) max_gestation_time = cur_gestation_time;
-    if (cur_genome_length > max_genome_length) max_genome_length = cur_genome_length;
-    
-    if (cur_merit < min_merit) min_merit = cur_merit;
-    if (cur_fitness < min_fitness) min_fitness = cur_fitness;
-    if (cur_gestation_time < min_gestation_time) min_gestation_time = cur_gestation_time;
-    if (cur_genome_length < min_genome_length) min_genome_length = cur_genome_length;
-    
-    // Test what tasks this creatures has completed.
-    for (int j = 0; j < m_world->GetEnvironment().GetNumTasks(); j++) {
-      if (phenotype.GetCurTaskCount()[j] > 0) {
-        stats.AddCurTask(j);
-        stats.AddCurTaskQuality(j, phenotype.GetCurTaskQuality()[j]);
-      }
-      
-      if (phenotype.GetLastTaskCount()[j] > 0) {
-        stats.AddLastTask(j);
-        stats.AddLastTaskQuality(j, phenotype.GetLastTaskQuality()[j]);
-        stats.IncTaskExeCount(j, phenotype.GetLastTaskCount()[j]);
-      }
-      
-      if (phenotype.GetCurHostTaskCount()[j] > 0) {
-        stats.AddCurHostTask(j);
-      }
-      
-      if (phenotype.GetLastHostTaskCount()[j] > 0) {
-        stats.AddLastHostTask(j);
-      }
-      
-      if (phenotype.GetCurParasiteTaskCount()[j] > 0) {
-        stats.AddCurParasiteTask(j);
-      }
-      
-      if (phenotype.GetLastParasiteTaskCount()[j] > 0) {
-        stats.AddLastParasiteTask(j);
-      }
-      
-      if (phenotype.GetCurInternalTaskCount()[j] > 0) {
-        stats.AddCurInternalTask(j);
-        stats.AddCurInternalTaskQuality(j, phenotype.GetCurInternalTaskQuality()[j]);
-      }
-      
-      if (phenotype.GetLastInternalTaskCount()[j] > 0) {
-        stats.AddLastInternalTask(j);
-        stats.AddLastInternalTaskQuality(j, phenotype.GetLastInternalTaskQuality()[j]);
+    if (full_scan) {
+      stats.SumFitness().Add(cur_fitness);
+      stats.SumMerit().Add(cur_merit.GetDouble());
+      stats.SumGestation().Add(phenotype.GetGestationTime());
+      stats.SumCreatureAge().Add(phenotype.GetAge());
+      stats.SumGeneration().Add(phenotype.GetGeneration());
+      stats.SumNeutralMetric().Add(phenotype.GetNeutralMetric());
+      stats.SumLineageLabel().Add(organism->GetLineageLabel());
+      stats.SumCopyMutRate().Push(organism->MutationRates().GetCopyMutProb());
+      stats.SumLogCopyMutRate().Push(log(organism->MutationRates().GetCopyMutProb()));
+      stats.SumDivMutRate().Push(organism->MutationRates().GetDivMutProb() / organism->GetPhenotype().GetDivType());
+      stats.SumLogDivMutRate().Push(log(organism->MutationRates().GetDivMutProb() / organism->GetPhenotype().GetDivType()));
+      stats.SumCopySize().Add(phenotype.GetCopiedSize());
+      stats.SumExeSize().Add(phenotype.GetExecutedSize());
+
+      if (cur_merit > max_merit) max_merit = cur_merit;
+      if (cur_fitness > max_fitness) max_fitness = cur_fitness;
+      if (cur_gestation_time > max_gestation_time) max_gestation_time = cur_gestation_time;
+      if (cur_genome_length > max_genome_length) max_genome_length = cur_genome_length;
+
+      if (cur_merit < min_merit) min_merit = cur_merit;
+      if (cur_fitness < min_fitness) min_fitness = cur_fitness;
+      if (cur_gestation_time < min_gestation_time) min_gestation_time = cur_gestation_time;
+      if (cur_genome_length < min_genome_length) min_genome_length = cur_genome_length;
+
+      // Test what tasks this creatures has completed.
+      for (int j = 0; j < m_world->GetEnvironment().GetNumTasks(); j++) {
+        if (phenotype.GetCurTaskCount()[j] > 0) {
+          stats.AddCurTask(j);
+          stats.AddCurTaskQuality(j, phenotype.GetCurTaskQuality()[j]);
+        }
+
+        if (phenotype.GetLastTaskCount()[j] > 0) {
+          stats.AddLastTask(j);
+          stats.AddLastTaskQuality(j, phenotype.GetLastTaskQuality()[j]);
+          stats.IncTaskExeCount(j, phenotype.GetLastTaskCount()[j]);
+        }
+
+        if (phenotype.GetCurHostTaskCount()[j] > 0) {
+          stats.AddCurHostTask(j);
+        }
+
+        if (phenotype.GetLastHostTaskCount()[j] > 0) {
+          stats.AddLastHostTask(j);
+        }
+
+        if (phenotype.GetCurParasiteTaskCount()[j] > 0) {
+          stats.AddCurParasiteTask(j);
+        }
+
+        if (phenotype.GetLastParasiteTaskCount()[j] > 0) {
+          stats.AddLastParasiteTask(j);
+        }
+
+        if (phenotype.GetCurInternalTaskCount()[j] > 0) {
+          stats.AddCurInternalTask(j);
+          stats.AddCurInternalTaskQuality(j, phenotype.GetCurInternalTaskQuality()[j]);
+        }
+
+        if (phenotype.GetLastInternalTaskCount()[j] > 0) {
+          stats.AddLastInternalTask(j);
+          stats.AddLastInternalTaskQuality(j, phenotype.GetLastInternalTaskQuality()[j]);
+        }
       }
     }
 
@@ -5810,32 +5942,36 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
     }
     
     
-    // Record what add bonuses this organism garnered for different reactions
-    for (int j = 0; j < m_world->GetEnvironment().GetNumReactions(); j++) {
-      if (phenotype.GetCurReactionCount()[j] > 0) {
-        stats.AddCurReaction(j);
-        stats.AddCurReactionAddReward(j, phenotype.GetCurReactionAddReward()[j]);
-      }
-      
-      if (phenotype.GetLastReactionCount()[j] > 0) {
-        stats.AddLastReaction(j);
-        stats.IncReactionExeCount(j, phenotype.GetLastReactionCount()[j]);
-        stats.AddLastReactionAddReward(j, phenotype.GetLastReactionAddReward()[j]);
+    if (full_scan) {
+      // Record what add bonuses this organism garnered for different reactions
+      for (int j = 0; j < m_world->GetEnvironment().GetNumReactions(); j++) {
+        if (phenotype.GetCurReactionCount()[j] > 0) {
+          stats.AddCurReaction(j);
+          stats.AddCurReactionAddReward(j, phenotype.GetCurReactionAddReward()[j]);
+        }
+
+        if (phenotype.GetLastReactionCount()[j] > 0) {
+          stats.AddLastReaction(j);
+          stats.IncReactionExeCount(j, phenotype.GetLastReactionCount()[j]);
+          stats.AddLastReactionAddReward(j, phenotype.GetLastReactionAddReward()[j]);
+        }
       }
-    }
-    
-    // Test what resource combinations this creature has sensed
-    for (int j = 0; j < stats.GetSenseSize(); j++) {
-      if (phenotype.GetLastSenseCount()[j] > 0) {
-        stats.AddLastSense(j);
-        stats.IncLastSenseExeCount(j, phenotype.GetLastSenseCount()[j]);
+
+      // Test what resource combinations this creature has sensed
+      for (int j = 0; j < stats.GetSenseSize(); j++) {
+        if (phenotype.GetLastSenseCount()[j] > 0) {
+          stats.AddLastSense(j);
+          stats.IncLastSenseExeCount(j, phenotype.GetLastSenseCount()[j]);
+        }
       }
     }
     
     // Increment the counts for all qualities the organism has...
     num_parasites += organism->GetNumParasites();
-    if (phenotype.ParentTrue()) num_breed_true++;
-    if (phenotype.GetNumDivides() == 0) num_no_birth++;
+    if (full_scan) {
+      if (phenotype.ParentTrue()) num_breed_true++;
+      if (phenotype.GetNumDivides() == 0) num_no_birth++;
+    }
     if (phenotype.IsMultiThread()) num_multi_thread++;
     else num_single_thread++;
     
@@ -5849,25 +5985,26 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
     organism->GetPhenotype().IncAge();
   }
   
-  stats.SetBreedTrueCreatures(num_breed_true);
-  stats.SetNumNoBirthCreatures(num_no_birth);
   stats.SetNumParasites(num_parasites);
   stats.SetNumSingleThreadCreatures(num_single_thread);
   stats.SetNumMultiThreadCreatures(num_multi_thread);
   stats.SetNumThreads(num_threads);
   stats.SetNumModified(num_modified);
   
-  stats.SetMaxMerit(max_merit.GetDouble());
-  stats.SetMaxFitness(max_fitness);
-  stats.SetMaxGestationTime(max_gestation_time);
-  stats.SetMaxGenomeLength(max_genome_length);
-  
-  stats.SetMinMerit(min_merit.GetDouble());
-  stats.SetMinFitness(min_fitness);
-  stats.SetMinGestationTime(min_gestation_time);
-  stats.SetMinGenomeLength(min_genome_length);
-  
-  resource_count.UpdateGlobalResources(ctx);   
+  if (full_scan) {
+    stats.SetBreedTrueCreatures(num_breed_true);
+    stats.SetNumNoBirthCreatures(num_no_birth);
+    
+    stats.SetMaxMerit(max_merit.GetDouble());
+    stats.SetMaxFitness(max_fitness);
+    stats.SetMaxGestationTime(max_gestation_time);
+    stats.SetMaxGenomeLength(max_genome_length);
+    
+    stats.SetMinMerit(min_merit.GetDouble());
+    stats.SetMinFitness(min_fitness);
+    stats.SetMinGestationTime(min_gestation_time);
+    stats.SetMinGenomeLength(min_genome_length);
+  }
 }
 
 void cPopulation::UpdateFTOrgStats(cAvidaContext&) 
@@ -6063,6 +6200,8 @@ void cPopulation::ProcessPreUpdate()
 
 void cPopulation::ProcessPostUpdate(cAvidaContext& ctx)
 {
+  FlushDemeResourceClock();
+  
   ProcessUpdateCellActions(ctx);
   
   cStats& stats = m_world->GetStats();
@@ -6079,6 +6218,9 @@ void cPopulation::ProcessPostUpdate(cAvidaContext& ctx)
   }
   
   for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].ProcessUpdate(ctx);   
+  
+  // Output written during this update reaches the disk even when the asynchronous writer's blocks are not yet full
+  Avida::Output::Manager::Of(m_world->GetNewWorld())->HandOffAll();
 }
 
 void cPopulation::ProcessUpdateCellActions(cAvidaContext& ctx)
@@ -6119,17 +6261,9 @@ struct sGroupInfo {
   sGroupInfo(Systematics::GroupPtr in_bg, bool is_para = false) : bg(in_bg), parasite(is_para) { ; }
 };
 
-bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bool save_groupings, bool save_avatars, bool save_rebirth)
+void cPopulation::collectGenotypeGroups(Apto::Map<int, sGroupInfo*>& genotype_map, bool save_groupings, bool save_avatars,
+                                        bool save_rebirth)
 {
-  Apto::String file_path((const char*)filename);
-  Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), file_path);
-  df->SetFileType("genotype_data");
-  df->WriteComment("Structured Population Save");
-  df->WriteTimeStamp();
-  
-  // Build up hash table of all current genotypes and the cells in which the organisms reside
-  Apto::Map<int, sGroupInfo*> genotype_map;
-  
   for (int cell = 0; cell < cell_array.GetSize(); cell++) {
     if (cell_array[cell].IsOccupied()) {
       cOrganism* org = cell_array[cell].GetOrganism();
@@ -6221,6 +6355,19 @@ bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bo
       }
     }
   }
+}
+
+bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bool save_groupings, bool save_avatars, bool save_rebirth)
+{
+  Apto::String file_path((const char*)filename);
+  Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), file_path);
+  df->SetFileType("genotype_data");
+  df->WriteComment("Structured Population Save");
+  df->WriteTimeStamp();
+  
+  // Build up hash table of all current genotypes and the cells in which the organisms reside
+  Apto::Map<int, sGroupInfo*> genotype_map;
+  collectGenotypeGroups(genotype_map, save_groupings, save_avatars, save_rebirth);
   
   // Output all current genotypes
   for (Apto::Map<int, sGroupInfo*>::ValueIterator it = genotype_map.Values(); it.Next();) {
@@ -6323,6 +6470,85 @@ bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bo
 }
 
 
+// The genotype fields of a text save; the sequence is stored packed rather than as its instruction symbols
+static void addBinaryGenotypeFields(cBinaryPopulationFile::Writer& writer, Systematics::GenotypePtr genotype)
+{
+  Apto::Array<Systematics::Genotype::LegacyField, Apto::Smart> fields;
+  genotype->LegacySaveFields(fields);
+  for (int i = 0; i < fields.GetSize(); i++) {
+    if (fields[i].key == "sequence") writer.SetSequence(InstructionSequence(fields[i].value));
+    else writer.AddProperty(fields[i].key, fields[i].descr, fields[i].value);
+  }
+}
+
+bool cPopulation::SavePopulationBinary(const cString& filename, bool save_historic, bool save_groupings, bool save_avatars,
+                                       bool save_rebirth)
+{
+  // Store the same columns as SavePopulation would write with these options, so the two formats convert losslessly
+  unsigned int column_mask = (1u << cBinaryPopulationFile::COL_CELL) | (1u << cBinaryPopulationFile::COL_GEST_OFFSET) |
+                             (1u << cBinaryPopulationFile::COL_LINEAGE);
+  if (save_groupings || save_rebirth) {
+    column_mask |= (1u << cBinaryPopulationFile::COL_GROUP_ID) | (1u << cBinaryPopulationFile::COL_FORAGER_TYPE) |
+                   (1u << cBinaryPopulationFile::COL_BIRTH_CELL);
+  }
+  if (save_avatars || save_rebirth) {
+    column_mask |= (1u << cBinaryPopulationFile::COL_AVATAR_CELL) | (1u << cBinaryPopulationFile::COL_AV_BCELL);
+  }
+  if (save_rebirth) {
+    column_mask |= (1u << cBinaryPopulationFile::COL_PARENT_FT) | (1u << cBinaryPopulationFile::COL_PARENT_IS_TEACH) |
+                   (1u << cBinaryPopulationFile::COL_PARENT_MERIT);
+  }
+  
+  Apto::Map<int, sGroupInfo*> genotype_map;
+  collectGenotypeGroups(genotype_map, save_groupings, save_avatars, save_rebirth);
+  
+  cBinaryPopulationFile::Writer writer(column_mask);
+  
+  // Current genotypes
+  for (Apto::Map<int, sGroupInfo*>::ValueIterator it = genotype_map.Values(); it.Next();) {
+    sGroupInfo* group_info = *it.Get();
+    Systematics::GenotypePtr genotype;
+    genotype.DynamicCastFrom(group_info->bg);
+    assert(genotype);
+    
+    unsigned int flags = cBinaryPopulationFile::GENOTYPE_CURRENT;
+    if (group_info->parasite) flags |= cBinaryPopulationFile::GENOTYPE_PARASITE;
+    writer.BeginGenotype(flags);
+    
+    addBinaryGenotypeFields(writer, genotype);
+    
+    Apto::Array<sOrgInfo>& orgs = group_info->orgs;
+    for (int i = 0; i < orgs.GetSize(); i++) {
+      const sOrgInfo& org = orgs[i];
+      const int values[cBinaryPopulationFile::NUM_INT_COLUMNS] = {
+        org.cell_id, org.offset, org.lineage_label, org.curr_group, org.curr_forage, org.birth_cell, org.avatar_cell,
+        org.av_bcell, org.parent_ft, org.parent_is_teacher
+      };
+      writer.AddOrganism(values, org.parent_merit);
+    }
+    
+    delete group_info;
+  }
+  
+  // Historic genotypes
+  if (save_historic) {
+    Systematics::GenotypeArbiterPtr arbiter;
+    arbiter.DynamicCastFrom(Systematics::Manager::Of(m_world->GetNewWorld())->ArbiterForRole("genotype"));
+    assert(arbiter);
+    
+    Apto::Array<Systematics::GenotypePtr, Apto::Smart> historic;
+    arbiter->GetHistoricGenotypes(historic);
+    for (int g = 0; g < historic.GetSize(); g++) {
+      writer.BeginGenotype(0);
+      addBinaryGenotypeFields(writer, historic[g]);
+    }
+  }
+  
+  Apto::String file_path = Avida::Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath((const char*)filename);
+  return writer.Write(file_path, m_world->GetDriver().Feedback());
+}
+
+
 bool cPopulation::SaveStructuredSystematicsGroup(const Systematics::RoleID& role, const cString& filename)
 {
   Apto::String file_path((const char*)filename);
@@ -6490,7 +6716,9 @@ struct sTmpGenotype
 {
 public:
   int id_num;
-  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props;
+  Systematics::Genotype::LegacyLoadFields fields;
+  double merit;
+  double gest_time;
   
   int num_cpus;
   Apto::Array<int> cells;
@@ -6507,7 +6735,7 @@ public:
   Systematics::GroupPtr bg;
   
   
-  inline sTmpGenotype() : id_num(-1), props(NULL) { ; }
+  inline sTmpGenotype() : id_num(-1), merit(0.0), gest_time(0.0), num_cpus(0) { ; }
   inline bool operator<(const sTmpGenotype& rhs) const { return id_num > rhs.id_num; }
   inline bool operator>(const sTmpGenotype& rhs) const { return id_num < rhs.id_num; }
   inline bool operator<=(const sTmpGenotype& rhs) const { return id_num >= rhs.id_num; }
@@ -6548,6 +6776,174 @@ bool cPopulation::LoadHostGenotypeList(const cString& filename, cAvidaContext& c
 }
 
 
+// Genotype fields of a population save, as key and value strings
+static void setTmpGenotypeField(sTmpGenotype& tmp, const char* key, const char* value)
+{
+  if (strcmp(key, "id") == 0) tmp.id_num = atoi(value);
+  else if (strcmp(key, "num_units") == 0) tmp.num_cpus = atoi(value);
+  else if (strcmp(key, "merit") == 0) tmp.merit = atof(value);
+  else if (strcmp(key, "gest_time") == 0) tmp.gest_time = atof(value);
+  else tmp.fields.Set(key, value);
+}
+
+// Organism lists of a genotype in a text population save, stored as comma separated strings
+class cTextPopulationColumns
+{
+private:
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > m_props;
+  
+public:
+  cTextPopulationColumns(Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props) : m_props(props) { ; }
+  
+  bool Has(const char* key) const { return m_props->Has(key); }
+  void Get(const char* key, Apto::Array<int>& values) const
+  {
+    cString str(m_props->Get(key));
+    while (str.GetSize()) values.Push(str.Pop(',').AsInt());
+  }
+  void Get(const char* key, Apto::Array<bool>& values) const
+  {
+    cString str(m_props->Get(key));
+    while (str.GetSize()) values.Push((bool)(str.Pop(',').AsInt()));
+  }
+  void Get(const char* key, Apto::Array<double>& values) const
+  {
+    cString str(m_props->Get(key));
+    while (str.GetSize()) values.Push(str.Pop(',').AsDouble());
+  }
+};
+
+// Organism lists of a genotype in a binary population save, copied straight out of the mapped columns
+class cBinaryPopulationColumns
+{
+private:
+  const cBinaryPopulationFile::Reader& m_reader;
+  int m_genotype;
+  
+  template <typename T> void get(const char* key, Apto::Array<T>& values) const
+  {
+    const int col = cBinaryPopulationFile::ColumnForKey(key);
+    if (!Has(key) || (col == cBinaryPopulationFile::COL_GEST_OFFSET && m_reader.IsParasite(m_genotype))) return;
+    
+    const int num_orgs = m_reader.GetNumOrganisms(m_genotype);
+    values.Resize(num_orgs);
+    if (col == cBinaryPopulationFile::COL_PARENT_MERIT) {
+      const double* src = m_reader.GetParentMerit(m_genotype);
+      for (int i = 0; i < num_orgs; i++) values[i] = (T)src[i];
+    } else {
+      const int32_t* src = m_reader.GetColumn(m_genotype, col);
+      for (int i = 0; i < num_orgs; i++) values[i] = (T)src[i];
+    }
+  }
+  
+public:
+  cBinaryPopulationColumns(const cBinaryPopulationFile::Reader& reader, int genotype)
+    : m_reader(reader), m_genotype(genotype) { ; }
+  
+  bool Has(const char* key) const
+  {
+    const int col = cBinaryPopulationFile::ColumnForKey(key);
+    return col >= 0 && m_reader.HasColumn(col);
+  }
+  void Get(const char* key, Apto::Array<int>& values) const { get(key, values); }
+  void Get(const char* key, Apto::Array<bool>& values) const { get(key, values); }
+  void Get(const char* key, Apto::Array<double>& values) const { get(key, values); }
+};
+
+// Fills in the organism lists of a loaded genotype according to the load options, shared by the text and binary formats
+template <class ColumnSource>
+static void loadGenotypeColumns(sTmpGenotype& tmp, const ColumnSource& src, bool& structured, bool use_avatars,
+                                bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth,
+                                bool load_parent_dat)
+{
+  // Process resident cell ids
+  Apto::Array<int> cells;
+  src.Get("cells", cells);
+  if (structured || cells.GetSize()) {
+    structured = true;
+    tmp.cells = cells;
+    assert(tmp.cells.GetSize() == tmp.num_cpus);
+  }
+  
+  // Process gestation time offsets
+  if (!load_rebirth) {
+    src.Get("gest_offset", tmp.offsets);
+    assert(tmp.offsets.GetSize() == 0 || tmp.offsets.GetSize() == tmp.num_cpus);
+  }
+  // Lineage label (only set if given in file)
+  src.Get("lineage", tmp.lineage_labels);
+  // @blw preserve compatability with older .spop files that don't have lineage labels
+  assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
+  
+  // Other org specs (if given in file)
+  if (load_rebirth) {
+    if (src.Has("birth_cell")) {
+      src.Get("birth_cell", tmp.birth_cells);
+      assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);      
+    }
+    if (src.Has("av_bcell") && use_avatars) {
+      src.Get("av_bcell", tmp.avatar_cells);
+      assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+    }
+    if (src.Has("parent_is_teach")) {
+      src.Get("parent_is_teach", tmp.parent_teacher);
+      assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+    }
+    if (src.Has("parent_ft")) {
+      src.Get("parent_ft", tmp.parent_ft);
+      assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+    }
+    if (src.Has("parent_merit")) {
+      src.Get("parent_merit", tmp.parent_merit);
+      assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
+    }
+  }
+  else {
+    if (load_groups) {
+      if (src.Has("group_id")) {
+        src.Get("group_id", tmp.group_ids);
+        assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
+      }
+      if (src.Has("forager_type")) {
+        src.Get("forager_type", tmp.forager_types);
+        assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
+      }
+    }
+    if (load_birth_cells) {   
+      if (src.Has("birth_cell")) {
+        src.Get("birth_cell", tmp.birth_cells);
+        assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
+      }
+      if (src.Has("av_bcell") && use_avatars) {
+        src.Get("av_bcell", tmp.avatar_cells);
+        assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+      }
+    }
+    else if (!load_birth_cells && load_avatars && src.Has("avatar_cell")) {
+      src.Get("avatar_cell", tmp.avatar_cells);
+      assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+    }
+    if (load_parent_dat) {
+      if (src.Has("parent_is_teach")) {
+        src.Get("parent_is_teach", tmp.parent_teacher);
+        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+      }
+      if (src.Has("parent_ft")) {
+        src.Get("parent_ft", tmp.parent_ft);
+        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+      }
+      if (src.Has("parent_merit")) {
+        src.Get("parent_merit", tmp.parent_merit);
+        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
+      }
+    }
+  }
+  if (use_avatars && !tmp.avatar_cells.GetSize()) {
+    src.Get("avatar_cell", tmp.avatar_cells);
+    assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+  }
+}
+
 bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth, bool load_parent_dat, int traceq)
 {
   // @TODO - build in support for verifying population dimensions
@@ -6565,134 +6961,76 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   
   bool structured = false;
   for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
     // Setup the genotype for this line...
     sTmpGenotype& tmp = genotypes[line_id];
-    tmp.props = input_file.GetLineAsDict(line_id);
-    tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
+    Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props = input_file.GetLineAsDict(line_id);
+    for (Apto::Map<Apto::String, Apto::String>::Iterator it = props->Begin(); it.Next();) {
+      setTmpGenotypeField(tmp, (const char*)it.Get()->Value1(), (const char*)*it.Get()->Value2());
+    }
 
     // Loads "num_units" preferrentially, but will fall back to "num_cpus" if present
-    assert(tmp.props->Has("num_cpus") || tmp.props->Has("num_units"));
-    tmp.num_cpus = (tmp.props->Has("num_units")) ? Apto::StrAs(tmp.props->Get("num_units")) : Apto::StrAs(tmp.props->Get("num_cpus"));
+    assert(props->Has("num_cpus") || props->Has("num_units"));
+    if (!props->Has("num_units")) tmp.num_cpus = Apto::StrAs(props->Get("num_cpus"));
     
-    // Process resident cell ids
-    cString cellstr(tmp.props->Get("cells"));
-    if (structured || cellstr.GetSize()) {
-      structured = true;
-      while (cellstr.GetSize()) tmp.cells.Push(cellstr.Pop(',').AsInt());
-      assert(tmp.cells.GetSize() == tmp.num_cpus);
-    }
-    
-    // Process gestation time offsets
-    if (!load_rebirth) {
-      cString offsetstr(tmp.props->Get("gest_offset"));
-      if (offsetstr.GetSize()) {
-        while (offsetstr.GetSize()) tmp.offsets.Push(offsetstr.Pop(',').AsInt());
-        assert(tmp.offsets.GetSize() == tmp.num_cpus);
-      }
-    }
-    // Lineage label (only set if given in file)
-    cString lineagestr(tmp.props->Get("lineage"));
-    while (lineagestr.GetSize()) tmp.lineage_labels.Push(lineagestr.Pop(',').AsInt());
-    // @blw preserve compatability with older .spop files that don't have lineage labels
-    assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
-    
-    // Other org specs (if given in file)
-    if (load_rebirth) {
-      if (tmp.props->Has("birth_cell")) {
-        cString birthstr(tmp.props->Get("birth_cell"));
-        while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
-        assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);      
-      }
-      if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
-        cString avatarstr(tmp.props->Get("av_bcell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-        assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
-      }
-    }
-    else {
-      if (load_groups) {
-        if (tmp.props->Has("group_id")) {
-          cString groupstr(tmp.props->Get("group_id"));
-          while (groupstr.GetSize()) tmp.group_ids.Push(groupstr.Pop(',').AsInt());
-          assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
-        }
-        if (tmp.props->Has("forager_type")) {
-          cString foragestr(tmp.props->Get("forager_type"));
-          while (foragestr.GetSize()) tmp.forager_types.Push(foragestr.Pop(',').AsInt());
-          assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
-        }
-      }
-      if (load_birth_cells) {   
-        if (tmp.props->Has("birth_cell")) {
-          cString birthstr(tmp.props->Get("birth_cell"));
-          while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
-          assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
-        }
-        if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
-          cString avatarstr(tmp.props->Get("av_bcell"));
-          while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-          assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
-        }
-      }
-      else if (!load_birth_cells && load_avatars && tmp.props->Has("avatar_cell")) {
-        cString avatarstr(tmp.props->Get("avatar_cell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-        assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
-      }
-    if (load_parent_dat) {
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
-      }
-    }
+    loadGenotypeColumns(tmp, cTextPopulationColumns(props), structured, m_world->GetConfig().USE_AVATARS.Get(),
+                        load_groups, load_birth_cells, load_avatars, load_rebirth, load_parent_dat);
+  }
+  
+  return loadPopulationGenotypes(genotypes, structured, filename, ctx, cellid_offset, lineage_offset, load_groups,
+                                 load_birth_cells, load_rebirth, load_parent_dat, traceq);
+}
+
+
+bool cPopulation::LoadPopulationBinary(const cString& filename, cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth, bool load_parent_dat, int traceq)
+{
+  cBinaryPopulationFile::Reader reader;
+  Apto::String file_path = Apto::FileSystem::GetAbsolutePath(Apto::String((const char*)filename), Apto::String((const char*)m_world->GetWorkingDir()));
+  if (!reader.Open(file_path, ctx.Driver().Feedback())) return false;
+  
+  // Clear out the population, unless an offset is being used
+  if (cellid_offset == 0) {
+    for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx); 
+  }
+  
+  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes(reader.GetNumGenotypes());
+  
+  bool structured = false;
+  for (int g = 0; g < reader.GetNumGenotypes(); g++) {
+    sTmpGenotype& tmp = genotypes[g];
+    for (int i = 0; i < reader.GetNumProperties(g); i++) {
+      setTmpGenotypeField(tmp, reader.GetPropertyKey(g, i), reader.GetPropertyValue(g, i));
     }
-    if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
-      cString avatarstr(tmp.props->Get("avatar_cell"));
-      while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-      assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+    if (reader.HasSequence(g)) {
+      InstructionSequence* seq = new InstructionSequence;
+      reader.GetSequence(g, *seq);
+      tmp.fields.sequence = GeneticRepresentationPtr(seq);
     }
+    
+    loadGenotypeColumns(tmp, cBinaryPopulationColumns(reader, g), structured, m_world->GetConfig().USE_AVATARS.Get(),
+                        load_groups, load_birth_cells, load_avatars, load_rebirth, load_parent_dat);
   }
   
+  return loadPopulationGenotypes(genotypes, structured, filename, ctx, cellid_offset, lineage_offset, load_groups,
+                                 load_birth_cells, load_rebirth, load_parent_dat, traceq);
+}
+
+
+bool cPopulation::loadPopulationGenotypes(Apto::Array<sTmpGenotype, Apto::ManagedPointer>& genotypes, bool structured, const cString& filename, cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells, bool load_rebirth, bool load_parent_dat, int traceq)
+{
   // Sort genotypes in descending order according to their id_num
   Apto::QSort(genotypes);
   
   Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
-  Systematics::ArbiterPtr bgm = classmgr->ArbiterForRole("genotype");
+  Systematics::GenotypeArbiterPtr bgm;
+  bgm.DynamicCastFrom(classmgr->ArbiterForRole("genotype"));
+  assert(bgm);
   
   bool some_missing = false;
   for (int i = genotypes.GetSize() - 1; i >= 0; i--) {
     // Fix Parent IDs
     cString nparentstr;
     int pcount = 0;
-    cString lparentstr = (const char*)genotypes[i].props->Get("parents");
+    cString lparentstr = (const char*)genotypes[i].fields.parents;
     if (lparentstr == "(none)") lparentstr = "";
     cStringList opidlist(lparentstr, ',');
     while (opidlist.GetSize()) {
@@ -6712,9 +7050,9 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
       }
     }
     if (!nparentstr.GetSize() && !some_missing) some_missing = true;
-    genotypes[i].props->Set("parents", (const char*)nparentstr);
+    genotypes[i].fields.parents = (const char*)nparentstr;
     
-    genotypes[i].bg = bgm->LegacyLoad(&genotypes[i].props);
+    genotypes[i].bg = bgm->LegacyLoad(genotypes[i].fields);
   }  
 //  if (some_missing) m_world->GetDriver().Feedback().Warning("Some parents not found in loaded pop file. Defaulting to parent ID of '(none)' for those genomes.");
   
@@ -6736,7 +7074,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
       
       assert(tmp.bg->Properties().Has("genome"));
       Genome mg(tmp.bg->Properties().Get("genome"));
-      cOrganism* new_organism = new cOrganism(m_world, ctx, mg, -1, Systematics::Source(Systematics::DIVISION, (const char*)filename, true));
+      cOrganism* new_organism = m_world->GetOrganismPool().Create(ctx, mg, -1, Systematics::Source(Systematics::DIVISION, (const char*)filename, true));
       
       // Setup the phenotype...
       cPhenotype& phenotype = new_organism->GetPhenotype();
@@ -6759,9 +7097,8 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         phenotype.SetMerit(cMerit(phenotype.ConvertEnergyToMerit(phenotype.GetStoredEnergy())));
       } else {
         // Set the phenotype merit from the save file
-        assert(tmp.props->Has("merit"));
-        double merit = Apto::StrAs(tmp.props->Get("merit"));
-        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.props->Has("parent_merit")) {
+        double merit = tmp.merit;
+        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.parent_merit.GetSize()) {
           merit = tmp.parent_merit[cell_i]; 
         }
         
@@ -6775,7 +7112,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
           // Adjust initial merit to account for organism execution at the time the population was saved
           // - this factors the merit by the fraction of the gestation time remaining
           // - this will be approximate, since gestation time may vary for each organism, but it should work for many cases
-          double gest_time = Apto::StrAs(tmp.props->Get("gest_time"));
+          double gest_time = tmp.gest_time;
           double gest_remain = gest_time - (double)tmp.offsets[cell_i];
           if (gest_remain > 0.0 && gest_time > 0.0) {
             double new_merit = phenotype.GetMerit().GetDouble() * (gest_time / gest_remain);
@@ -6822,7 +7159,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         if (load_parent_dat) {
           new_organism->SetParentFT(tmp.parent_ft[cell_i]);
           new_organism->SetParentTeacher(tmp.parent_teacher[cell_i]);
-          if (tmp.props->Has("parent_merit")) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);        
+          if (tmp.parent_merit.GetSize()) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);        
         }
       }
       else if (load_rebirth) {
@@ -6855,6 +7192,188 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   return true;
 }
 
+static void saveCheckpointGenotypes(cStateArchive& ar, const Apto::Array<Systematics::GenotypePtr, Apto::Smart>& genotypes)
+{
+  int num_genotypes = genotypes.GetSize();
+  ar.Transfer(num_genotypes);
+  
+  Apto::Array<Systematics::Genotype::LegacyField, Apto::Smart> fields;
+  for (int g = 0; g < genotypes.GetSize(); g++) {
+    genotypes[g]->LegacySaveFields(fields);
+    int group_id = genotypes[g]->ID();
+    int num_fields = fields.GetSize();
+    ar.Transfer(group_id);
+    ar.Transfer(num_fields);
+    for (int i = 0; i < num_fields; i++) {
+      cString key((const char*)fields[i].key);
+      cString value((const char*)fields[i].value);
+      ar.Transfer(key);
+      ar.Transfer(value);
+    }
+  }
+}
+
+static void loadCheckpointGenotypes(cStateArchive& ar, Systematics::GenotypeArbiterPtr arbiter,
+                                    Apto::Map<int, Systematics::GroupPtr>& genotypes)
+{
+  int num_genotypes = 0;
+  ar.Transfer(num_genotypes);
+  
+  for (int g = 0; g < num_genotypes && ar.IsGood(); g++) {
+    int group_id = -1;
+    int num_fields = 0;
+    ar.Transfer(group_id);
+    ar.Transfer(num_fields);
+    
+    Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props(new Apto::Map<Apto::String, Apto::String>);
+    for (int i = 0; i < num_fields && ar.IsGood(); i++) {
+      cString key;
+      cString value;
+      ar.Transfer(key);
+      ar.Transfer(value);
+      props->Set((const char*)key, (const char*)value);
+    }
+    if (!ar.IsGood()) return;
+    if (group_id < 1 || genotypes.Has(group_id) || !props->Has("sequence") || !props->Has("update_born")) {
+      ar.Fail("invalid genotype in checkpoint");
+      return;
+    }
+    
+    genotypes.Set(group_id, arbiter->LegacyLoad(&props, group_id));
+  }
+}
+
+void cPopulation::CheckpointState(cStateArchive& ar, cAvidaContext& ctx)
+{
+  ar.Tag("cPopulation");
+  ar.TransferSize(cell_array.GetSize(), "world");
+  if (!ar.IsGood()) return;
+  
+  // Features whose state is held outside of the objects saved below are refused, rather than silently lost
+  if (deme_array.GetSize() > 1 || (deme_array.GetSize() && deme_array[0].GetDemeResourceCount().GetSize())) {
+    ar.Fail("checkpoints do not support demes or deme resources");
+    return;
+  }
+  if (m_world->GetConfig().USE_AVATARS.Get()) {
+    ar.Fail("checkpoints do not support avatars");
+    return;
+  }
+  if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST) {
+    ar.Fail("checkpoints do not support the full soup eldest birth method");
+    return;
+  }
+  if (ar.IsSaving() && birth_chamber.IsInUse()) {
+    ar.Fail("checkpoints do not support sexual reproduction (offspring waiting in the birth chamber would be lost)");
+    return;
+  }
+  
+  Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
+  Systematics::GenotypeArbiterPtr arbiter;
+  arbiter.DynamicCastFrom(classmgr->ArbiterForRole("genotype"));
+  if (!arbiter) {
+    ar.Fail("checkpoints require genotype systematics");
+    return;
+  }
+  
+  // Genotypes, current (in order of first appearance in the live organism list) and then historic
+  Apto::Map<int, Systematics::GroupPtr> genotypes;
+  if (ar.IsSaving()) {
+    Apto::Array<Systematics::GenotypePtr, Apto::Smart> current;
+    for (int i = 0; i < live_org_list.GetSize(); i++) {
+      cOrganism* org = live_org_list[i];
+      if (org->GetParasites().GetSize()) {
+        ar.Fail("checkpoints do not support parasites");
+        return;
+      }
+      Systematics::GenotypePtr genotype;
+      genotype.DynamicCastFrom(org->SystematicsGroup("genotype"));
+      assert(genotype);
+      if (!genotypes.Has(genotype->ID())) {
+        genotypes.Set(genotype->ID(), org->SystematicsGroup("genotype"));
+        current.Push(genotype);
+      }
+    }
+    Apto::Array<Systematics::GenotypePtr, Apto::Smart> historic;
+    arbiter->GetHistoricGenotypes(historic);
+    
+    saveCheckpointGenotypes(ar, current);
+    saveCheckpointGenotypes(ar, historic);
+  } else {
+    // Saved genotype ids are kept, so nothing may have been classified in this world yet
+    if (num_organisms || arbiter->GetNextID() != 1) {
+      ar.Fail("checkpoints must be loaded before any organisms are placed in the world");
+      return;
+    }
+    loadCheckpointGenotypes(ar, arbiter, genotypes);
+    loadCheckpointGenotypes(ar, arbiter, genotypes);
+  }
+  int next_id = arbiter->GetNextID();
+  ar.Transfer(next_id);
+  if (ar.IsLoading() && ar.IsGood()) arbiter->SetNextID(next_id);
+  
+  // Organisms are stored in live list order, and activated in that same order on load so that the list matches
+  int num_orgs = live_org_list.GetSize();
+  ar.Transfer(num_orgs);
+  for (int i = 0; i < num_orgs && ar.IsGood(); i++) {
+    int cell_id = -1;
+    int group_id = -1;
+    if (ar.IsSaving()) {
+      cell_id = live_org_list[i]->GetCellID();
+      group_id = live_org_list[i]->SystematicsGroup("genotype")->ID();
+    }
+    ar.Transfer(cell_id);
+    ar.Transfer(group_id);
+    if (!ar.IsGood()) return;
+    
+    cOrganism* org = NULL;
+    if (ar.IsSaving()) {
+      org = live_org_list[i];
+    } else {
+      Systematics::GroupPtr genotype;
+      if (cell_id < 0 || cell_id >= cell_array.GetSize() || cell_array[cell_id].IsOccupied() ||
+          !genotypes.Get(group_id, genotype)) {
+        ar.Fail("invalid organism placement in checkpoint");
+        return;
+      }
+      
+      Genome mg(genotype->Properties().Get("genome"));
+      org = m_world->GetOrganismPool().Create(ctx, mg, -1, Systematics::Source(Systematics::DIVISION, "checkpoint", true));
+      InstructionSequencePtr seq;
+      seq.DynamicCastFrom(mg.Representation());
+      org->GetPhenotype().SetupInject(*seq);
+      
+      Systematics::RoleClassificationHints hints;
+      hints["genotype"]["id"] = Apto::FormatStr("%d", group_id);
+      Systematics::UnitPtr unit(org);
+      org->AddReference(); // creating new smart pointer to org, explicitly add reference
+      classmgr->ClassifyNewUnit(unit, &hints);
+      
+      if (!ActivateOrganism(ctx, org, cell_array[cell_id], false, true)) {
+        ar.Fail("organism in checkpoint did not survive activation");
+        return;
+      }
+    }
+    org->CheckpointState(ar);
+  }
+  ar.Transfer(num_prey_organisms);
+  ar.Transfer(num_pred_organisms);
+  ar.Transfer(num_top_pred_organisms);
+  
+  for (int i = 0; i < cell_array.GetSize(); i++) cell_array[i].CheckpointState(ar);
+  resource_count.CheckpointState(ar);
+}
+
+void cPopulation::RebuildSchedule()
+{
+  // Scheduler internals are not accessible, so at checkpoint sync points (see cWorld::syncCheckpointState) every run
+  // continues from a freshly built scheduler holding the current merits
+  delete m_scheduler;
+  BuildTimeSlicer();
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    if (cell_array[i].IsOccupied()) AdjustSchedule(cell_array[i], cell_array[i].GetOrganism()->GetPhenotype().GetMerit());
+  }
+}
+
 /**
  * This function loads a genome from a given file, and initializes
  * a cpu with it.
@@ -7173,6 +7692,18 @@ void cPopulation::BuildTimeSlicer()
       m_scheduler = new Apto::Scheduler::ProbabilisticIntegrated(cell_array.GetSize(), rng);
     }
       break;
+    case SLICE_PROB_MERIT_FENWICK:
+    {
+      Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(0x7FFFFFFF)));
+      m_scheduler = new cFenwickSchedule(cell_array.GetSize(), rng);
+    }
+      break;
+    case SLICE_PROB_MERIT_ALIAS:
+    {
+      Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(0x7FFFFFFF)));
+      m_scheduler = new cAliasSchedule(cell_array.GetSize(), rng);
+    }
+      break;
     default:
       cout << "error: requested time slicer not found." << endl;
       m_world->GetDriver().Abort(Avida::INVALID_CONFIG);
@@ -7710,6 +8241,7 @@ bool cPopulation::UpdateMerit(cAvidaContext& ctx, int cell_id, double new_merit)
   
   phenotype.SetMerit( cMerit(new_merit) );
   phenotype.SetLifeFitness(new_merit/phenotype.GetGestationTime());
+  GetCell(cell_id).GetOrganism()->MarkStatsDirty();
   if (new_merit <= old_merit) {
     phenotype.SetIsDonorCur(); }
   else  { phenotype.SetIsReceiver(); }
@@ -7745,6 +8277,7 @@ void cPopulation::NewTrial(cAvidaContext& ctx)
         
         cell.GetOrganism()->NewTrial();
         cell.GetOrganism()->GetHardware().Reset(ctx);
+        cell.GetOrganism()->MarkStatsDirty();
         
         cell.SetSpeculativeState(0);
       }
@@ -8010,6 +8543,7 @@ void cPopulation::CompeteOrganisms(cAvidaContext& ctx, int competition_type, int
         //TrialReset has never been called so we need the entire routine to make "last" of "cur" stats.
         p.DivideReset(*seq);
       }
+      GetCell(i).GetOrganism()->MarkStatsDirty();
     }
   }
   
@@ -8457,6 +8991,7 @@ void  cPopulation::AddLiveOrg(cOrganism* org)
 {
   live_org_list.Push(org);
   org->SetOrgIndex(live_org_list.GetSize()-1);
+  if (m_org_stats) m_org_stats->AddOrganism(org);
 }
 
 // Remove an organism from live org list  
@@ -8467,6 +9002,7 @@ void  cPopulation::RemoveLiveOrg(cOrganism* org)
   exist_org->SetOrgIndex(org->GetOrgIndex());
   live_org_list.Swap(org->GetOrgIndex(), last);
   live_org_list.Pop();
+  if (m_org_stats) m_org_stats->RemoveOrganism(org);
 }
 
 // Adds an organism to a group
@@ -28,6 +28,7 @@
 #include "cBirthChamber.h"
 #include "cDeme.h"
 #include "cOrgInterface.h"
+#include "cOrgStatsTracker.h"
 #include "cPopulationInterface.h"
 #include "cResourceCount.h"
 #include "cString.h"
@@ -44,6 +45,9 @@ class cEnvironment;
 class cLineage;
 class cOrganism;
 class cPopulationCell;
+class cStateArchive;
+struct sGroupInfo;
+struct sTmpGenotype;
 
 using namespace Avida;
 
@@ -66,6 +70,7 @@ private:
   // Components...
   cWorld* m_world;
   Apto::PriorityScheduler* m_scheduler;                // Handles allocation of CPU cycles
+  cOrgStatsTracker* m_org_stats;                       // Incremental organism stats (NULL for the full scan)
   Apto::Array<cPopulationCell> cell_array;  // Local cells composing the population
   Apto::Array<int> empty_cell_id_array;     // Used for PREFER_EMPTY birth methods
   cResourceCount resource_count;       // Global resources available
@@ -112,6 +117,7 @@ private:
   int num_top_pred_organisms;
   
   Apto::Array<cDeme> deme_array;            // Deme structure of the population.
+  cDemeResourceClock m_deme_res_clock;      // Resource time not yet applied to the demes (see cDeme::SyncResourceClock)
  
   // Outside interactions...
   bool sync_events;   // Do we need to sync up the event list with population?
@@ -258,6 +264,10 @@ public:
   int ScheduleOrganism();          // Determine next organism to be processed.
   void ProcessStep(cAvidaContext& ctx, double step_size, int cell_id);
   void ProcessStepSpeculative(cAvidaContext& ctx, double step_size, int cell_id);
+  int ProcessBurst(cAvidaContext& ctx, double step_size, int cell_id, int max_steps);  // returns the steps consumed
+
+  // Apply per-update point mutations to every living organism
+  void ProcessPointMutations(cAvidaContext& ctx);
 
   // Calculate the statistics from the most recent update.
   void ProcessPostUpdate(cAvidaContext& ctx);
@@ -278,8 +288,18 @@ public:
   bool LoadStructuredSystematicsGroup(cAvidaContext& ctx, const Systematics::RoleID& role, const cString& filename);
   bool LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset=0, int lineage_offset=0,
                       bool load_groups = false, bool load_birth_cells = false, bool load_avatars = false, bool load_rebirth = false, bool load_parent_dat = false, int traceq = 0);
+  
+  // Binary (.bpop) equivalents of SavePopulation and LoadPopulation, see cBinaryPopulationFile
+  bool SavePopulationBinary(const cString& filename, bool save_historic, bool save_group_info = false, bool save_avatars = false,
+                            bool save_rebirth = false);
+  bool LoadPopulationBinary(const cString& filename, cAvidaContext& ctx, int cellid_offset=0, int lineage_offset=0,
+                            bool load_groups = false, bool load_birth_cells = false, bool load_avatars = false, bool load_rebirth = false, bool load_parent_dat = false, int traceq = 0);
   bool SaveFlameData(const cString& filename);
   
+  // Full state checkpoint support, driven by cWorld::SaveCheckpoint and cWorld::LoadCheckpoint
+  void CheckpointState(cStateArchive& ar, cAvidaContext& ctx);
+  void RebuildSchedule();
+  
   void SetMiniTraceQueue(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void AppendMiniTraces(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void LoadMiniTraceQ(const cString& filename, int orgs_per, bool print_genomes, bool print_reacs);
@@ -305,6 +325,8 @@ public:
   const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx) const { return resource_count.GetCellResources(cell_id, ctx); } 
   const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) const { return resource_count.GetFrozenResources(ctx, cell_id); }
   double GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int res_id) const { return resource_count.GetFrozenCellResVal(ctx, cell_id, res_id); }
+  int CountFrozenOccupiedCells(cAvidaContext&, int res_id, int x1, int y1, int x2, int y2) const { return resource_count.CountFrozenOccupiedCells(res_id, x1, y1, x2, y2); }
+  int CountFrozenEdibleCells(cAvidaContext&, int res_id, double threshold, int x1, int y1, int x2, int y2) const { return resource_count.CountFrozenEdibleCells(res_id, threshold, x1, y1, x2, y2); }
   double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id) const { return resource_count.GetCellResVal(ctx, cell_id, res_id); }
   const Apto::Array<double>& GetDemeResources(int deme_id, cAvidaContext& ctx) { return GetDeme(deme_id).GetDemeResourceCount().GetResources(ctx); }  
   const Apto::Array<double>& GetDemeCellResources(int deme_id, int cell_id, cAvidaContext& ctx) { return GetDeme(deme_id).GetDemeResourceCount().GetCellResources( GetDeme(deme_id).GetRelativeCellID(cell_id), ctx ); } 
@@ -399,6 +421,9 @@ public:
   // Remove an org from live org list
   void RemoveLiveOrg(cOrganism* org); 
   const Apto::Array<cOrganism*, Apto::Smart>& GetLiveOrgList() const { return live_org_list; }
+
+  // Queue an organism whose stats may have changed to be rescanned at the end of the update (see cOrgStatsTracker)
+  void MarkOrgStatsDirty(int stats_slot) { if (m_org_stats) m_org_stats->MarkDirty(stats_slot); }
 	
   // Adds an organism to a group  
   void JoinGroup(cOrganism* org, int group_id);
@@ -463,9 +488,14 @@ private:
   void FindEmptyCell(tList<cPopulationCell>& cell_list, tList<cPopulationCell>& found_list);
   int FindRandEmptyCell(cAvidaContext& ctx);
   
+  // Lazily advance deme resources by one step, applying all pending time to every deme when flushed
+  inline void AdvanceDemeResourceClock(double step_size, int steps = 1);
+  void FlushDemeResourceClock();
+  
   // Update statistics collecting...
   void UpdateDemeStats(cAvidaContext& ctx); 
   void UpdateOrganismStats(cAvidaContext& ctx); 
+  void scanOrganismStats(cAvidaContext& ctx, bool full_scan);
   void UpdateFTOrgStats(cAvidaContext& ctx); 
   void UpdateMaleFemaleOrgStats(cAvidaContext& ctx);
   
@@ -490,6 +520,11 @@ private:
   inline void AdjustSchedule(const cPopulationCell& cell, const cMerit& merit);
   
   bool LoadGenotypeList(const cString& filename, cAvidaContext& ctx, Apto::Array<GeneticRepresentationPtr>& list_obj);
+  
+  void collectGenotypeGroups(Apto::Map<int, sGroupInfo*>& genotype_map, bool save_groupings, bool save_avatars, bool save_rebirth);
+  bool loadPopulationGenotypes(Apto::Array<sTmpGenotype, Apto::ManagedPointer>& genotypes, bool structured, const cString& filename,
+                               cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells,
+                               bool load_rebirth, bool load_parent_dat, int traceq);
 };
 
 #endif
@@ -30,6 +30,7 @@
 #include "cEnvironment.h"
 #include "cPopulation.h"
 #include "cDeme.h"
+#include "cStateArchive.h"
 
 #include <cmath>
 #include <iterator>
@@ -140,6 +141,35 @@ void cPopulationCell::Rotate(cPopulationCell& new_facing)
   }
 }
 
+void cPopulationCell::CheckpointState(cStateArchive& ar)
+{
+  // Inputs are drawn at random when the world is built, so they must be restored for the environment to match
+  ar.Tag("cPopulationCell");
+  ar.Transfer(m_inputs);
+  ar.Transfer(m_cell_data.contents);
+  ar.Transfer(m_cell_data.org_id);
+  ar.Transfer(m_cell_data.update);
+  ar.Transfer(m_cell_data.territory);
+  ar.Transfer(m_cell_data.current);
+  ar.Transfer(m_cell_data.forager);
+  ar.Transfer(m_spec_state);
+  ar.Transfer(m_migrant);
+  ar.Transfer(m_visits);
+  
+  // Facing is saved as the id of the faced cell, which is independent of how the connection list was built
+  int faced_id = m_connections.GetSize() ? GetCellFaced().GetID() : -1;
+  ar.Transfer(faced_id);
+  if (ar.IsLoading() && ar.IsGood() && m_connections.GetSize()) {
+    for (int i = 0; GetCellFaced().GetID() != faced_id; i++) {
+      if (i == m_connections.GetSize()) {
+        ar.Fail("checkpoint facing is not a neighbor of the cell");
+        return;
+      }
+      m_connections.CircNext();
+    }
+  }
+}
+
 /*! This method recursively builds a set of cells that neighbor this cell, out to 
  the given depth.  The set must be passed in by-reference, as calls to this method 
  must share a common set of already-visited cells.
@@ -287,6 +317,7 @@ void cPopulationCell::InsertOrganism(cOrganism* new_org, cAvidaContext& ctx)
       cPhenotype& phenotype = m_organism->GetPhenotype();
       phenotype.ReduceEnergy(-1.0 * uptake_energy);
       phenotype.SetMerit(cMerit(phenotype.ConvertEnergyToMerit(phenotype.GetStoredEnergy() * phenotype.GetEnergyUsageRatio())));
+      m_organism->MarkStatsDirty();
     }
   }
 }
@@ -37,6 +37,7 @@ class cHardwareBase;
 class cPopulation;
 class cOrganism;
 class cPopulationCell;
+class cStateArchive;
 class cWorld;
 
 using namespace Avida;
@@ -95,6 +96,7 @@ public:
   void Setup(cWorld* world, int in_id, const cMutationRates& in_rates, int x, int y);
   void SetDemeID(int in_id) { m_deme_id = in_id; }
   void Rotate(cPopulationCell& new_facing);
+  void CheckpointState(cStateArchive& ar);
 
   //@AWC -- This is, admittedly, a hack to get migration between demes working under local copy...
   void SetMigrant() {m_migrant = true;} //@AWC -- this cell will contain a migrant genome
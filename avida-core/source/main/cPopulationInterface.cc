@@ -378,6 +378,16 @@ double cPopulationInterface::GetFrozenCellResVal(cAvidaContext& ctx, int cell_id
   return m_world->GetPopulation().GetFrozenCellResVal(ctx, cell_id, res_id);
 }
 
+int cPopulationInterface::CountFrozenOccupiedCells(cAvidaContext& ctx, int res_id, int x1, int y1, int x2, int y2)
+{
+  return m_world->GetPopulation().CountFrozenOccupiedCells(ctx, res_id, x1, y1, x2, y2);
+}
+
+int cPopulationInterface::CountFrozenEdibleCells(cAvidaContext& ctx, int res_id, double threshold, int x1, int y1, int x2, int y2)
+{
+  return m_world->GetPopulation().CountFrozenEdibleCells(ctx, res_id, threshold, x1, y1, x2, y2);
+}
+
 double cPopulationInterface::GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id)
 {
   return m_world->GetPopulation().GetCellResVal(ctx, cell_id, res_id);
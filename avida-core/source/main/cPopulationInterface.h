@@ -118,6 +118,8 @@ public:
   const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx); 
   const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id);
   double GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
+  int CountFrozenOccupiedCells(cAvidaContext& ctx, int res_id, int x1, int y1, int x2, int y2);
+  int CountFrozenEdibleCells(cAvidaContext& ctx, int res_id, double threshold, int x1, int y1, int x2, int y2);
   double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
   const Apto::Array<double>& GetDemeResources(int deme_id, cAvidaContext& ctx); 
   const Apto::Array< Apto::Array<int> >& GetCellIdLists();
@@ -21,10 +21,16 @@
  */
 
 #include "cResourceCount.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/core/WorldDriver.h"
+
 #include "cResource.h"
 #include "cGradientCount.h"
 #include "cWorld.h"
+#include "cStateArchive.h"
 #include "cStats.h"
+#include "cStringUtil.h"
 
 #include "nGeometry.h"
 
@@ -35,6 +41,7 @@ using namespace std;
 const double cResourceCount::UPDATE_STEP(1.0 / 10000.0);
 const double cResourceCount::EPSILON (1.0e-15);
 const int cResourceCount::PRECALC_DISTANCE(100);
+const double cResourceCount::MAX_FLOW_ERROR(1.0e-9);
 
 
 void FlowMatter(cSpatialCountElem &elem1, cSpatialCountElem &elem2, 
@@ -185,6 +192,39 @@ cResourceCount::~cResourceCount()
   }
 }
 
+void cResourceCount::CheckpointState(cStateArchive& ar)
+{
+  // Names and geometry come from the environment file; only the time varying values are saved
+  ar.Tag("cResourceCount");
+  ar.TransferSize(resource_count.GetSize(), "resource count");
+  if (!ar.IsGood()) return;
+  
+  for (int i = 0; i < resource_count.GetSize(); i++) {
+    cString name = resource_name[i];
+    ar.Transfer(name);
+    if (ar.IsGood() && name != resource_name[i]) {
+      ar.Fail(cStringUtil::Stringf("checkpoint resource '%s' does not match environment resource '%s'",
+                                   (const char*)name, (const char*)resource_name[i]));
+      return;
+    }
+    ar.Transfer(resource_count[i]);
+    ar.Transfer(decay_rate[i]);
+    ar.Transfer(inflow_rate[i]);
+    for (int j = 0; j < decay_precalc.GetNumCols(); j++) {
+      ar.Transfer(decay_precalc(i, j));
+      ar.Transfer(inflow_precalc(i, j));
+    }
+    ar.Transfer(curr_grid_res_cnt[i]);
+    ar.Transfer(curr_spatial_res_cnt[i]);
+    spatial_resource_count[i]->CheckpointState(ar);
+  }
+  
+  ar.Transfer(update_time);
+  ar.Transfer(spatial_update_time);
+  ar.Transfer(m_last_updated);
+  ar.Transfer(m_spatial_update);
+}
+
 void cResourceCount::SetCellResources(int cell_id, const Apto::Array<double> & res)
 {
   assert(resource_count.GetSize() == res.GetSize());
@@ -330,6 +370,8 @@ void cResourceCount::Setup(cWorld* world, const int& res_index, const cString& n
   inflow_rate[res_index] = inflow;
   geometry[res_index] = in_geometry;
   spatial_resource_count[res_index]->SetGeometry(in_geometry);
+  spatial_resource_count[res_index]->SetVectorizedFlow(world->GetConfig().SPATIAL_FLOW_METHOD.Get() == 1);
+  spatial_resource_count[res_index]->SetValidateFlow(world->GetConfig().SPATIAL_FLOW_METHOD.Get() == 2);
   spatial_resource_count[res_index]->SetPointers();
   spatial_resource_count[res_index]->SetCellList(in_cell_list_ptr);
 
@@ -590,6 +632,21 @@ double cResourceCount::GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int
   else return spatial_resource_count[res_id]->GetAmount(cell_id);
 }
 
+int cResourceCount::CountFrozenOccupiedCells(int res_id, int x1, int y1, int x2, int y2) const
+// Number of cells within the (wrapping) rectangle holding a positive amount of the resource, as seen by
+// GetFrozenCellResVal.  Returns -1 for global and partial resources, whose amount is shared by every cell.
+{
+  if (geometry[res_id] == nGeometry::GLOBAL || geometry[res_id]==nGeometry::PARTIAL) return -1;
+  return spatial_resource_count[res_id]->CountOccupied(x1, y1, x2, y2);
+}
+
+int cResourceCount::CountFrozenEdibleCells(int res_id, double threshold, int x1, int y1, int x2, int y2) const
+// As CountFrozenOccupiedCells, counting only the cells holding at least threshold (one or more whole edible units).
+{
+  if (geometry[res_id] == nGeometry::GLOBAL || geometry[res_id]==nGeometry::PARTIAL) return -1;
+  return spatial_resource_count[res_id]->CountEdible(x1, y1, x2, y2, threshold);
+}
+
 double cResourceCount::GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id) const
 // This differs from GetCellResources by only pulling for res of interest.
 {
@@ -655,7 +712,7 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
         resource_count[i] += res_change[i];
       assert(resource_count[i] >= 0.0);
     } else {
-      double temp = spatial_resource_count[i]->Element(cell_id).GetAmount();
+      double temp = spatial_resource_count[i]->GetAmount(cell_id);
       spatial_resource_count[i]->Rate(cell_id, res_change[i]);
       /* Ideally the state of the cell's resource should not be set till
          the end of the update so that all processes (inflow, outflow, 
@@ -664,10 +721,10 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
          the organism demand to work immediately on the state of the resource */ 
     
       spatial_resource_count[i]->State(cell_id);
-      if(spatial_resource_count[i]->Element(cell_id).GetAmount() != temp){
+      if(spatial_resource_count[i]->GetAmount(cell_id) != temp){
         spatial_resource_count[i]->SetModified(true);
       }
-      assert(spatial_resource_count[i]->Element(cell_id).GetAmount() >= 0.0);
+      assert(spatial_resource_count[i]->GetAmount(cell_id) >= 0.0);
     }
   }
 }
@@ -794,6 +851,11 @@ void cResourceCount::DoUpdates(cAvidaContext& ctx, bool global_only) const
           spatial_resource_count[i]->CellOutflow();
         }
         spatial_resource_count[i]->FlowAll();
+        if (spatial_resource_count[i]->GetValidateFlow() && spatial_resource_count[i]->GetFlowError() > MAX_FLOW_ERROR) {
+          ctx.Driver().Feedback().Error("vectorized flow of resource '%s' differs from the pairwise model by %g",
+                                        (const char*)resource_name[i], spatial_resource_count[i]->GetFlowError());
+          ctx.Driver().Abort(Avida::INTERNAL_ERROR);
+        }
         spatial_resource_count[i]->StateAll();
         // BDB: resource_count[i] = spatial_resource_count[i]->SumAll();
       }
@@ -31,6 +31,7 @@
 #include "tMatrix.h"
 #include "nGeometry.h"
 
+class cStateArchive;
 class cWorld;
 
 
@@ -63,6 +64,7 @@ private:
   static const double UPDATE_STEP;   // Fraction of an update per step
   static const double EPSILON;       // Tolorance for round off errors
   static const int PRECALC_DISTANCE; // Number of steps to precalculate
+  static const double MAX_FLOW_ERROR; // Largest relative flow difference accepted by SPATIAL_FLOW_METHOD 2
   
 public:
   cResourceCount(int num_resources = 0);
@@ -134,6 +136,8 @@ public:
   const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx) const;
   const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) const;
   double GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int res_id) const;
+  int CountFrozenOccupiedCells(int res_id, int x1, int y1, int x2, int y2) const;
+  int CountFrozenEdibleCells(int res_id, double threshold, int x1, int y1, int x2, int y2) const;
   double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id) const;
   const Apto::Array<int>& GetResourcesGeometry() const;
   int GetResourceGeometry(int res_id) const { return geometry[res_id]; }
@@ -166,6 +170,8 @@ public:
   void SetSpatialUpdate(int update) { m_spatial_update = update; }
   void UpdateGlobalResources(cAvidaContext& ctx) { DoUpdates(ctx, true); }
   void UpdateResources(cAvidaContext& ctx) { DoUpdates(ctx, false); }
+  
+  void CheckpointState(cStateArchive& ar);
 };
 
 #endif
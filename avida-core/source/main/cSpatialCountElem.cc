@@ -25,6 +25,8 @@
 
 #include "cSpatialCountElem.h"
 
+#include "cStateArchive.h"
+
 const int MAXFLOWPTS = 8;
 
 
@@ -63,3 +65,10 @@ void cSpatialCountElem::SetPtr(int innum, int inelempt, int inxdist, int inydist
   ydist[innum] = inydist;
   dist[innum] = indist;
 }
+
+void cSpatialCountElem::CheckpointState(cStateArchive& ar)
+{
+  ar.Transfer(amount);
+  ar.Transfer(delta);
+  ar.Transfer(initial);
+}
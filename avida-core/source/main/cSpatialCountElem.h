@@ -25,6 +25,8 @@
 
 #include "avida/core/Types.h"
 
+class cStateArchive;
+
 
 class cSpatialCountElem
 {
@@ -40,6 +42,7 @@ public:
   void Rate(double ratein) const { delta += ratein; }
   void State() { amount += delta; delta = 0.0; }
   double GetAmount() const { return amount; }
+  double GetDelta() const { return delta; }
   void SetAmount(double res) const { amount = res; }
   void SetPtr(int innum, int inelempt, int inxdist, int  inydist, double indist);
   int GetElemPtr(int innum) { return elempt[innum]; }
@@ -52,6 +55,7 @@ public:
   double GetInitial() { return initial; }
   
   inline void ResetResourceCount(double res_initial) { amount = res_initial + initial; }
+  void CheckpointState(cStateArchive& ar);
 };
 
 #endif
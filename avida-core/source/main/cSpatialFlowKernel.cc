@@ -0,0 +1,188 @@
+/*
+ *  cSpatialFlowKernel.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cSpatialFlowKernel.h"
+
+#include <cmath>
+
+#if defined(__AVX__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+
+// out[i] = alpha * a1[i] + beta * a2[i]
+static inline void flowRow(double* out, const double* a1, const double* a2, int n, double alpha, double beta)
+{
+  int i = 0;
+#if defined(__AVX__)
+  const __m256d valpha = _mm256_set1_pd(alpha);
+  const __m256d vbeta = _mm256_set1_pd(beta);
+  for (; i + 4 <= n; i += 4) {
+    const __m256d v1 = _mm256_mul_pd(valpha, _mm256_loadu_pd(a1 + i));
+    const __m256d v2 = _mm256_mul_pd(vbeta, _mm256_loadu_pd(a2 + i));
+    _mm256_storeu_pd(out + i, _mm256_add_pd(v1, v2));
+  }
+#elif defined(__SSE2__)
+  const __m128d valpha = _mm_set1_pd(alpha);
+  const __m128d vbeta = _mm_set1_pd(beta);
+  for (; i + 2 <= n; i += 2) {
+    const __m128d v1 = _mm_mul_pd(valpha, _mm_loadu_pd(a1 + i));
+    const __m128d v2 = _mm_mul_pd(vbeta, _mm_loadu_pd(a2 + i));
+    _mm_storeu_pd(out + i, _mm_add_pd(v1, v2));
+  }
+#endif
+  for (; i < n; i++) out[i] = alpha * a1[i] + beta * a2[i];
+}
+
+// out[i] = (in0[i] + in1[i]) + (in2[i] + in3[i]) - ((out0[i] + out1[i]) + (out2[i] + out3[i]))
+static inline void accumulateRow(double* out, const double* in0, const double* in1, const double* in2, const double* in3,
+                                 const double* out0, const double* out1, const double* out2, const double* out3, int n)
+{
+  int i = 0;
+#if defined(__AVX__)
+  for (; i + 4 <= n; i += 4) {
+    const __m256d vin = _mm256_add_pd(_mm256_add_pd(_mm256_loadu_pd(in0 + i), _mm256_loadu_pd(in1 + i)),
+                                      _mm256_add_pd(_mm256_loadu_pd(in2 + i), _mm256_loadu_pd(in3 + i)));
+    const __m256d vout = _mm256_add_pd(_mm256_add_pd(_mm256_loadu_pd(out0 + i), _mm256_loadu_pd(out1 + i)),
+                                       _mm256_add_pd(_mm256_loadu_pd(out2 + i), _mm256_loadu_pd(out3 + i)));
+    _mm256_storeu_pd(out + i, _mm256_sub_pd(vin, vout));
+  }
+#elif defined(__SSE2__)
+  for (; i + 2 <= n; i += 2) {
+    const __m128d vin = _mm_add_pd(_mm_add_pd(_mm_loadu_pd(in0 + i), _mm_loadu_pd(in1 + i)),
+                                   _mm_add_pd(_mm_loadu_pd(in2 + i), _mm_loadu_pd(in3 + i)));
+    const __m128d vout = _mm_add_pd(_mm_add_pd(_mm_loadu_pd(out0 + i), _mm_loadu_pd(out1 + i)),
+                                    _mm_add_pd(_mm_loadu_pd(out2 + i), _mm_loadu_pd(out3 + i)));
+    _mm_storeu_pd(out + i, _mm_sub_pd(vin, vout));
+  }
+#endif
+  for (; i < n; i++) out[i] = ((in0[i] + in1[i]) + (in2[i] + in3[i])) - ((out0[i] + out1[i]) + (out2[i] + out3[i]));
+}
+
+
+void cSpatialFlowKernel::Configure(int world_x, int world_y, bool torus, double xdiffuse, double ydiffuse,
+                                   double xgravity, double ygravity)
+{
+  if (world_x != m_x || world_y != m_y) {
+    m_x = world_x;
+    m_y = world_y;
+    m_amount.ResizeClear(m_x * m_y);
+    m_delta.ResizeClear(m_x * m_y);
+    for (int d = 0; d < NUM_DIRS; d++) m_flow[d].ResizeClear(m_x * m_y);
+  }
+  m_torus = torus;
+
+  // Expand FlowMatter into the coefficients of elem1.amount (alpha) and elem2.amount (beta) for each direction
+  const int xdists[NUM_DIRS] = { 1, 1, 0, -1 };
+  const int ydists[NUM_DIRS] = { 0, 1, 1, 1 };
+  const double SQRT2 = sqrt(2.0);
+
+  for (int d = 0; d < NUM_DIRS; d++) {
+    const int xdist = xdists[d];
+    const int ydist = ydists[d];
+    const double dist = (xdist != 0 && ydist != 0) ? SQRT2 : 1.0;
+    double alpha = 0.0;
+    double beta = 0.0;
+
+    if (xdist != 0) {
+      alpha += xdiffuse / 16.0;
+      beta -= xdiffuse / 16.0;
+      if ((xdist > 0 && xgravity > 0.0) || (xdist < 0 && xgravity < 0.0)) alpha += fabs(xgravity) / 3.0;
+      else beta -= fabs(xgravity) / 3.0;
+    }
+    if (ydist != 0) {
+      alpha += ydiffuse / 16.0;
+      beta -= ydiffuse / 16.0;
+      if ((ydist > 0 && ygravity > 0.0) || (ydist < 0 && ygravity < 0.0)) alpha += fabs(ygravity) / 3.0;
+      else beta -= fabs(ygravity) / 3.0;
+    }
+
+    const double norm = (fabs(xdist * 1.0) + fabs(ydist * 1.0)) * dist;
+    m_alpha[d] = alpha / norm;
+    m_beta[d] = beta / norm;
+  }
+}
+
+
+void cSpatialFlowKernel::Flow()
+{
+  const int X = m_x;
+  const int Y = m_y;
+  if (X == 0 || Y == 0) return;
+
+  const double* amount = &m_amount[0];
+
+  // Pass 1: flow leaving each cell toward its forward neighbors.  Pairs that cross the edge of a bounded grid have
+  // no neighbor pointer in the pairwise model, so their flow is zero.
+  for (int y = 0; y < Y; y++) {
+    const double* row = amount + y * X;
+    double* f_e = &m_flow[EAST][y * X];
+    double* f_se = &m_flow[SOUTHEAST][y * X];
+    double* f_s = &m_flow[SOUTH][y * X];
+    double* f_sw = &m_flow[SOUTHWEST][y * X];
+
+    flowRow(f_e, row, row + 1, X - 1, m_alpha[EAST], m_beta[EAST]);
+    f_e[X - 1] = (m_torus) ? m_alpha[EAST] * row[X - 1] + m_beta[EAST] * row[0] : 0.0;
+
+    if (m_torus || y < Y - 1) {
+      const double* next = amount + ((y + 1) % Y) * X;
+
+      flowRow(f_s, row, next, X, m_alpha[SOUTH], m_beta[SOUTH]);
+
+      flowRow(f_se, row, next + 1, X - 1, m_alpha[SOUTHEAST], m_beta[SOUTHEAST]);
+      f_se[X - 1] = (m_torus) ? m_alpha[SOUTHEAST] * row[X - 1] + m_beta[SOUTHEAST] * next[0] : 0.0;
+
+      flowRow(f_sw + 1, row + 1, next, X - 1, m_alpha[SOUTHWEST], m_beta[SOUTHWEST]);
+      f_sw[0] = (m_torus) ? m_alpha[SOUTHWEST] * row[0] + m_beta[SOUTHWEST] * next[X - 1] : 0.0;
+    } else {
+      for (int x = 0; x < X; x++) f_s[x] = f_se[x] = f_sw[x] = 0.0;
+    }
+  }
+
+  // Pass 2: each cell loses its outgoing flows and gains the flows from the cells that have it as a forward neighbor.
+  // Flows across a bounded edge are already zero, so the incoming indices can always wrap.
+  for (int y = 0; y < Y; y++) {
+    const int yp = (y + Y - 1) % Y;
+    const double* f_e = &m_flow[EAST][y * X];
+    const double* f_se = &m_flow[SOUTHEAST][y * X];
+    const double* f_s = &m_flow[SOUTH][y * X];
+    const double* f_sw = &m_flow[SOUTHWEST][y * X];
+    const double* p_se = &m_flow[SOUTHEAST][yp * X];
+    const double* p_s = &m_flow[SOUTH][yp * X];
+    const double* p_sw = &m_flow[SOUTHWEST][yp * X];
+    double* delta = &m_delta[y * X];
+
+    // Interior columns, neighbors do not wrap
+    if (X > 2) {
+      accumulateRow(delta + 1, f_e, p_se, p_s + 1, p_sw + 2, f_e + 1, f_se + 1, f_s + 1, f_sw + 1, X - 2);
+    }
+
+    // First and last columns, neighbors wrap around the row
+    const int edge_cols[2] = { 0, X - 1 };
+    for (int i = 0; i < ((X > 1) ? 2 : 1); i++) {
+      const int x = edge_cols[i];
+      const int xl = (x + X - 1) % X;
+      const int xr = (x + 1) % X;
+      delta[x] = ((f_e[xl] + p_se[xl]) + (p_s[x] + p_sw[xr])) - ((f_e[x] + f_se[x]) + (f_s[x] + f_sw[x]));
+    }
+  }
+}
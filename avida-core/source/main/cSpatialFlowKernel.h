@@ -0,0 +1,63 @@
+/*
+ *  cSpatialFlowKernel.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*! Grid native diffusion/gravity stencil for spatial resources.  Computes the same per-cell deltas as calling
+    FlowMatter on every neighbor pair (see cSpatialResCount::FlowAll), but works on contiguous arrays of amounts
+    so that the inner loops can be vectorized.  Results match the pairwise model up to floating point round-off. */
+
+#ifndef cSpatialFlowKernel_h
+#define cSpatialFlowKernel_h
+
+#include "apto/core.h"
+
+
+class cSpatialFlowKernel
+{
+private:
+  // The four "forward" neighbor directions, matching neighbor pointers 3 through 6 of cSpatialCountElem
+  enum { EAST = 0, SOUTHEAST, SOUTH, SOUTHWEST, NUM_DIRS };
+
+  int m_x;
+  int m_y;
+  bool m_torus;
+
+  // Flow from a cell to its neighbor in each direction is linear in the two amounts: alpha * a1 + beta * a2
+  double m_alpha[NUM_DIRS];
+  double m_beta[NUM_DIRS];
+
+  Apto::Array<double> m_amount;
+  Apto::Array<double> m_flow[NUM_DIRS];
+  Apto::Array<double> m_delta;
+
+public:
+  cSpatialFlowKernel() : m_x(0), m_y(0), m_torus(true) { ; }
+
+  void Configure(int world_x, int world_y, bool torus, double xdiffuse, double ydiffuse, double xgravity, double ygravity);
+
+  int GetSize() const { return m_amount.GetSize(); }
+
+  // Callers fill the amounts (row major, world_x * world_y), call Flow(), then apply the resulting deltas
+  double* GetAmounts() { return &m_amount[0]; }
+  const double* GetDeltas() const { return &m_delta[0]; }
+
+  void Flow();
+};
+
+#endif
@@ -22,6 +22,7 @@
 #include "cSpatialResCount.h"
 
 #include "AvidaTools.h"
+#include "cStateArchive.h"
 #include "nGeometry.h"
 
 #include <cmath>
@@ -33,7 +34,7 @@ using namespace AvidaTools;
 
 cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry, double inxdiffuse, double inydiffuse,
                                    double inxgravity, double inygravity)
-: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false)
+: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false), m_vectorized_flow(false), m_validate_flow(false), m_flow_error(0.0), m_edible_threshold(0.0), m_counts_valid(false)
 {
   int i;
  
@@ -55,7 +56,7 @@ cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry,
 /* Setup a single spatial resource using default flow amounts  */
 
 cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry)
-: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false)
+: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false), m_vectorized_flow(false), m_validate_flow(false), m_flow_error(0.0), m_edible_threshold(0.0), m_counts_valid(false)
 {
   int i;
  
@@ -74,7 +75,7 @@ cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry)
    SetPointers();
 }
 
-cSpatialResCount::cSpatialResCount() : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), m_modified(false)
+cSpatialResCount::cSpatialResCount() : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), m_modified(false), m_vectorized_flow(false), m_validate_flow(false), m_flow_error(0.0), m_edible_threshold(0.0), m_counts_valid(false)
 {
   geometry = nGeometry::GLOBAL;
 }
@@ -96,6 +97,7 @@ void cSpatialResCount::ResizeClear(int inworld_x, int inworld_y, int ingeometry)
     grid[i] = tmpelem;
    } 
    SetPointers();
+   m_counts_valid = false;
 }
 
 void cSpatialResCount::SetPointers()
@@ -255,7 +257,9 @@ void cSpatialResCount::Rate(int x, int y, double ratein) const {
    
 void cSpatialResCount::State(int x) { 
   if (x >= 0 && x < grid.GetSize()) {
+    const double old_amount = grid[x].GetAmount();
     grid[x].State();
+    updateCounts(x, old_amount);
   } else {
     assert(false); // x not valid id
   }
@@ -266,7 +270,9 @@ void cSpatialResCount::State(int x) {
    
 void cSpatialResCount::State(int x, int y) { 
   if (x >= 0 && x < world_x && y >= 0 && y < world_y) {
+    const double old_amount = grid[y*world_x + x].GetAmount();
     grid[y*world_x + x].State();
+    updateCounts(y*world_x + x, old_amount);
   } else {
     assert(false); // x or y not valid id
   }
@@ -292,6 +298,74 @@ double cSpatialResCount::GetAmount(int x, int y) const {
   }
 }
 
+/* Fenwick tree helpers for the cell count tables.  A tree of n counts is stored in n ints; fenwickSum returns the sum of
+   the first n counts. */
+
+static inline void fenwickAdd(int* tree, int size, int pos, int change)
+{
+  for (int i = pos + 1; i <= size; i += i & -i) tree[i - 1] += change;
+}
+
+static inline int fenwickSum(const int* tree, int n)
+{
+  int sum = 0;
+  for (int i = n; i > 0; i -= i & -i) sum += tree[i - 1];
+  return sum;
+}
+
+static inline int fenwickRange(const int* tree, int size, int first, int last)
+{
+  if (first <= last) return fenwickSum(tree, last + 1) - fenwickSum(tree, first);
+  return (fenwickSum(tree, size) - fenwickSum(tree, first)) + fenwickSum(tree, last + 1);  // wrapped span
+}
+
+static inline void fenwickBuild(int* tree, int size)
+{
+  for (int i = 1; i <= size; i++) {
+    const int parent = i + (i & -i);
+    if (parent <= size) tree[parent - 1] += tree[i - 1];
+  }
+}
+
+/* Count the cells holding a positive amount within a rectangle.  Coordinates wrap around the edges of the world, and
+   cells covered more than once by a rectangle wider or taller than the world are counted once. */
+
+int cSpatialResCount::CountOccupied(int x1, int y1, int x2, int y2) const {
+  if (num_cells <= 0) return 0;
+  if (!m_counts_valid) buildCounts();
+  return countCells(m_row_occupied, m_col_occupied, x1, y1, x2, y2);
+}
+
+/* Count the cells within a rectangle holding at least threshold, i.e. those with at least one whole edible unit. */
+
+int cSpatialResCount::CountEdible(int x1, int y1, int x2, int y2, double threshold) const {
+  if (num_cells <= 0) return 0;
+  if (threshold != m_edible_threshold) {
+    m_edible_threshold = threshold;
+    m_counts_valid = false;
+  }
+  if (!m_counts_valid) buildCounts();
+  return countCells(m_row_edible, m_col_edible, x1, y1, x2, y2);
+}
+
+int cSpatialResCount::countCells(const Apto::Array<int>& rows, const Apto::Array<int>& cols, int x1, int y1, int x2, int y2) const
+{
+  if (x2 - x1 + 1 >= world_x) { x1 = 0; x2 = world_x - 1; }
+  else { x1 = Mod(x1, world_x); x2 = Mod(x2, world_x); }
+  if (y2 - y1 + 1 >= world_y) { y1 = 0; y2 = world_y - 1; }
+  else { y1 = Mod(y1, world_y); y2 = Mod(y2, world_y); }
+
+  // Single columns use the column counts, everything else is summed a row at a time
+  if (x1 == x2) return fenwickRange(&cols[x1 * world_y], world_y, y1, y2);
+  
+  int count = 0;
+  for (int y = y1; ; y = (y + 1) % world_y) {
+    count += fenwickRange(&rows[y * world_x], world_x, x1, x2);
+    if (y == y2) break;
+  }
+  return count;
+}
+
 void cSpatialResCount::RateAll(double ratein) {
 
   int i;
@@ -311,6 +385,7 @@ void cSpatialResCount::StateAll() {
   for (i = 0; i < num_cells; i++) {
     grid[i].State();
   } 
+  m_counts_valid = false;
 }
 
 void cSpatialResCount::FlowAll() {
@@ -318,6 +393,55 @@ void cSpatialResCount::FlowAll() {
   // @JEB save time if diffusion and gravity off...
   if ((xdiffuse == 0.0) && (ydiffuse == 0.0) && (xgravity == 0.0) && (ygravity == 0.0)) return;
 
+  if (m_validate_flow) flowAllValidated();
+  else if (m_vectorized_flow) flowAllVectorized();
+  else flowAllPairwise();
+}
+
+/* Flow with the pairwise model, computing the vectorized deltas alongside.  The largest difference between the two,
+   relative to the largest amount in the grid (or 1), is left in m_flow_error. */
+
+void cSpatialResCount::flowAllValidated() {
+  m_flow_error = 0.0;
+  if (num_cells == 0) return;
+  
+  m_flow_kernel.Configure(world_x, world_y, (geometry != nGeometry::GRID), xdiffuse, ydiffuse, xgravity, ygravity);
+  
+  double* amounts = m_flow_kernel.GetAmounts();
+  double scale = 1.0;
+  Apto::Array<double> prior_deltas(num_cells);
+  for (int i = 0; i < num_cells; i++) {
+    amounts[i] = grid[i].GetAmount();
+    if (fabs(amounts[i]) > scale) scale = fabs(amounts[i]);
+    prior_deltas[i] = grid[i].GetDelta();
+  }
+  
+  m_flow_kernel.Flow();
+  flowAllPairwise();
+  
+  const double* deltas = m_flow_kernel.GetDeltas();
+  for (int i = 0; i < num_cells; i++) {
+    const double error = fabs((grid[i].GetDelta() - prior_deltas[i]) - deltas[i]) / scale;
+    if (error > m_flow_error) m_flow_error = error;
+  }
+}
+
+void cSpatialResCount::flowAllVectorized() {
+  if (num_cells == 0) return;
+  
+  m_flow_kernel.Configure(world_x, world_y, (geometry != nGeometry::GRID), xdiffuse, ydiffuse, xgravity, ygravity);
+  
+  double* amounts = m_flow_kernel.GetAmounts();
+  for (int i = 0; i < num_cells; i++) amounts[i] = grid[i].GetAmount();
+  
+  m_flow_kernel.Flow();
+  
+  const double* deltas = m_flow_kernel.GetDeltas();
+  for (int i = 0; i < num_cells; i++) grid[i].Rate(deltas[i]);
+}
+
+void cSpatialResCount::flowAllPairwise() {
+
   int     i,k,ii,xdist,ydist;
   double  dist;
  
@@ -426,7 +550,9 @@ void cSpatialResCount::SetCellAmount(int cell_id, double res)
 {
   if (cell_id >= 0 && cell_id < grid.GetSize())
   {
-    Element(cell_id).SetAmount(res);
+    const double old_amount = grid[cell_id].GetAmount();
+    grid[cell_id].SetAmount(res);
+    updateCounts(cell_id, old_amount);
   }
 }
 
@@ -434,4 +560,71 @@ void cSpatialResCount::SetCellAmount(int cell_id, double res)
 void cSpatialResCount::ResetResourceCounts()
 {
   for (int i = 0; i < grid.GetSize(); i++) grid[i].ResetResourceCount(m_initial);
+  m_counts_valid = false;
+}
+
+void cSpatialResCount::CheckpointState(cStateArchive& ar)
+{
+  // Flow parameters are included since actions may change them during a run
+  ar.Tag("cSpatialResCount");
+  ar.TransferSize(grid.GetSize(), "resource grid");
+  if (!ar.IsGood()) return;
+  for (int i = 0; i < grid.GetSize(); i++) grid[i].CheckpointState(ar);
+  m_counts_valid = false;
+  ar.Transfer(m_initial);
+  ar.Transfer(xdiffuse);
+  ar.Transfer(ydiffuse);
+  ar.Transfer(xgravity);
+  ar.Transfer(ygravity);
+  ar.Transfer(curr_peakx);
+  ar.Transfer(curr_peaky);
+  ar.Transfer(m_modified);
+}
+
+void cSpatialResCount::buildCounts() const
+{
+  m_row_occupied.Resize(num_cells);
+  m_col_occupied.Resize(num_cells);
+  m_row_edible.Resize(num_cells);
+  m_col_edible.Resize(num_cells);
+
+  for (int y = 0; y < world_y; y++) {
+    for (int x = 0; x < world_x; x++) {
+      const double amount = grid[y * world_x + x].GetAmount();
+      m_row_occupied[y * world_x + x] = m_col_occupied[x * world_y + y] = (amount > 0) ? 1 : 0;
+      m_row_edible[y * world_x + x] = m_col_edible[x * world_y + y] = (amount >= m_edible_threshold && amount > 0) ? 1 : 0;
+    }
+  }
+  for (int y = 0; y < world_y; y++) {
+    fenwickBuild(&m_row_occupied[y * world_x], world_x);
+    fenwickBuild(&m_row_edible[y * world_x], world_x);
+  }
+  for (int x = 0; x < world_x; x++) {
+    fenwickBuild(&m_col_occupied[x * world_y], world_y);
+    fenwickBuild(&m_col_edible[x * world_y], world_y);
+  }
+
+  m_counts_valid = true;
+}
+
+/* Patch the cell counts after a single cell has changed, rather than rebuilding them */
+
+void cSpatialResCount::updateCounts(int cell_id, double old_amount)
+{
+  if (!m_counts_valid) return;
+  const double amount = grid[cell_id].GetAmount();
+  const int x = cell_id % world_x;
+  const int y = cell_id / world_x;
+
+  const int occupied_change = ((amount > 0) ? 1 : 0) - ((old_amount > 0) ? 1 : 0);
+  if (occupied_change) {
+    fenwickAdd(&m_row_occupied[y * world_x], world_x, x, occupied_change);
+    fenwickAdd(&m_col_occupied[x * world_y], world_y, y, occupied_change);
+  }
+  const int edible_change = ((amount >= m_edible_threshold && amount > 0) ? 1 : 0) -
+                            ((old_amount >= m_edible_threshold && old_amount > 0) ? 1 : 0);
+  if (edible_change) {
+    fenwickAdd(&m_row_edible[y * world_x], world_x, x, edible_change);
+    fenwickAdd(&m_col_edible[x * world_y], world_y, y, edible_change);
+  }
 }
@@ -27,6 +27,7 @@
 
 #include "cAvidaContext.h"
 #include "cSpatialCountElem.h"
+#include "cSpatialFlowKernel.h"
 #include "cResource.h"
 
 
@@ -45,6 +46,27 @@ private:
   /* instead of creating a new array use the existing one from cResource */
   Apto::Array<cCellResource> *cell_list_ptr;
   bool m_modified;
+  bool m_vectorized_flow;
+  bool m_validate_flow;
+  double m_flow_error;  // largest difference between the flow models at the last validated FlowAll
+  cSpatialFlowKernel m_flow_kernel;
+  
+  // Counts of occupied (amount > 0) and edible (amount >= m_edible_threshold) cells along each row and each column,
+  // held as Fenwick trees so that a single cell change costs O(log world_x + log world_y).  Rebuilt on demand after
+  // bulk changes, and when asked for a different edible threshold.
+  mutable Apto::Array<int> m_row_occupied;  // world_x entries per row
+  mutable Apto::Array<int> m_col_occupied;  // world_y entries per column
+  mutable Apto::Array<int> m_row_edible;
+  mutable Apto::Array<int> m_col_edible;
+  mutable double m_edible_threshold;
+  mutable bool m_counts_valid;
+  
+  void flowAllPairwise();
+  void flowAllVectorized();
+  void flowAllValidated();
+  void buildCounts() const;
+  void updateCounts(int cell_id, double old_amount);
+  int countCells(const Apto::Array<int>& rows, const Apto::Array<int>& cols, int x1, int y1, int x2, int y2) const;
   
 public:
   cSpatialResCount();
@@ -62,15 +84,18 @@ public:
   int GetX() const { return world_x; }
   int GetY() const { return world_y; }
   int GetCellListSize() const { return cell_list_ptr->GetSize(); }
-  cSpatialCountElem& Element(int x) { return grid[x]; }
+  cSpatialCountElem& Element(int x) { m_counts_valid = false; return grid[x]; }
   void Rate(int x, double ratein) const;
   void Rate(int x, int y, double ratein) const;
   void State(int x);
   void State(int x, int y);
   double GetAmount(int x) const;
   double GetAmount(int x, int y) const;
+  int CountOccupied(int x1, int y1, int x2, int y2) const;
+  int CountEdible(int x1, int y1, int x2, int y2, double threshold) const;
   void RateAll(double ratein); 
   virtual void StateAll();
+  virtual void CheckpointState(cStateArchive& ar);
   void FlowAll(); 
   double SumAll() const;
   void Source(double amount) const;
@@ -96,6 +121,11 @@ public:
   virtual void UpdateCount(cAvidaContext&) { ; }
   void ResetResourceCounts();
   void SetModified(bool in_modified) { m_modified = in_modified; }
+  void SetVectorizedFlow(bool enabled) { m_vectorized_flow = enabled; }
+  bool GetVectorizedFlow() const { return m_vectorized_flow; }
+  void SetValidateFlow(bool enabled) { m_validate_flow = enabled; }
+  bool GetValidateFlow() const { return m_validate_flow; }
+  double GetFlowError() const { return m_flow_error; }
   bool GetModified() { return m_modified; }
   
   virtual void SetGradInitialPlat(double) { ; }
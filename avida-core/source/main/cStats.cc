@@ -35,6 +35,7 @@
 #include "cInstSet.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
+#include "cStateArchive.h"
 #include "cDeme.h"
 #include "cMigrationMatrix.h"
 #include "cStringUtil.h"
@@ -499,6 +500,47 @@ void cStats::ZeroReactions()
   m_reaction_last_add_reward.SetAll(0);
 }
 
+void cStats::SetOrganismTaskTotals(int task_num, int cur_count, int last_count, int exe_count, double cur_quality,
+                                   double last_quality, double cur_max_quality, double last_max_quality)
+{
+  task_cur_count[task_num] = cur_count;
+  task_last_count[task_num] = last_count;
+  task_exe_count[task_num] = exe_count;
+  task_cur_quality[task_num] = cur_quality;
+  task_last_quality[task_num] = last_quality;
+  task_cur_max_quality[task_num] = cur_max_quality;
+  task_last_max_quality[task_num] = last_max_quality;
+}
+
+void cStats::SetOrganismHostParasiteTaskTotals(int task_num, int host_cur, int host_last, int parasite_cur, int parasite_last)
+{
+  tasks_host_current[task_num] = host_cur;
+  tasks_host_last[task_num] = host_last;
+  tasks_parasite_current[task_num] = parasite_cur;
+  tasks_parasite_last[task_num] = parasite_last;
+}
+
+void cStats::SetOrganismInternalTaskTotals(int task_num, int cur_count, int last_count, double cur_quality,
+                                           double last_quality, double cur_max_quality, double last_max_quality)
+{
+  task_internal_cur_count[task_num] = cur_count;
+  task_internal_last_count[task_num] = last_count;
+  task_internal_cur_quality[task_num] = cur_quality;
+  task_internal_last_quality[task_num] = last_quality;
+  task_internal_cur_max_quality[task_num] = cur_max_quality;
+  task_internal_last_max_quality[task_num] = last_max_quality;
+}
+
+void cStats::SetOrganismReactionTotals(int reaction, int cur_count, int last_count, int exe_count, double cur_add_reward,
+                                       double last_add_reward)
+{
+  m_reaction_cur_count[reaction] = cur_count;
+  m_reaction_last_count[reaction] = last_count;
+  m_reaction_exe_count[reaction] = exe_count;
+  m_reaction_cur_add_reward[reaction] = cur_add_reward;
+  m_reaction_last_add_reward[reaction] = last_add_reward;
+}
+
 void cStats::ZeroMessageInst()
 {
 
@@ -567,6 +609,92 @@ void cStats::RecordBirth(bool breed_true)
   else num_breed_in++;
 }
 
+void cStats::CheckpointState(cStateArchive& ar)
+{
+  // Organism and genotype sums are cleared and resummed by the population each update, so only the counters that
+  // carry over from one update to the next are saved
+  ar.Tag("cStats");
+  ar.Transfer(m_update);
+  ar.Transfer(last_update);
+  ar.Transfer(num_births);
+  ar.Transfer(cumulative_births);
+  ar.Transfer(num_deaths);
+  ar.Transfer(num_breed_in);
+  ar.Transfer(num_breed_true);
+  ar.Transfer(num_breed_true_creatures);
+  ar.Transfer(num_creatures);
+  ar.Transfer(num_executed);
+  ar.Transfer(num_parasites);
+  ar.Transfer(num_no_birth_creatures);
+  ar.Transfer(num_single_thread_creatures);
+  ar.Transfer(num_multi_thread_creatures);
+  ar.Transfer(m_num_threads);
+  ar.Transfer(num_modified);
+  ar.Transfer(tot_organisms);
+  ar.Transfer(tot_executed);
+  ar.Transfer(max_gestation_time);
+  ar.Transfer(max_genome_length);
+  ar.Transfer(min_gestation_time);
+  ar.Transfer(min_genome_length);
+  ar.Transfer(num_kabooms);
+  ar.Transfer(num_kabooms_pre);
+  ar.Transfer(num_kabooms_post);
+  ar.Transfer(num_kaboom_kills);
+  ar.Transfer(num_stop_explode);
+  ar.Transfer(ave_threshold_ub);
+  ar.Transfer(num_quorum);
+  ar.Transfer(juv_killed);
+  ar.Transfer(num_guard_fail);
+  ar.Transfer(num_resamplings);
+  ar.Transfer(num_failedResamplings);
+  ar.Transfer(m_spec_total);
+  ar.Transfer(m_spec_num);
+  ar.Transfer(m_spec_waste);
+  ar.Transfer(num_migrations);
+  ar.Transfer(m_num_successful_mates);
+
+  ar.Transfer(avida_time);
+  ar.Transfer(max_viable_fitness);
+  ar.Transfer(max_fitness);
+  ar.Transfer(max_merit);
+  ar.Transfer(min_fitness);
+  ar.Transfer(min_merit);
+  ar.Transfer(sum_perc_lyse);
+  ar.Transfer(sum_cpu_cycles);
+
+  ar.Transfer(tasks_host_current);
+  ar.Transfer(tasks_host_last);
+  ar.Transfer(tasks_parasite_current);
+  ar.Transfer(tasks_parasite_last);
+  ar.Transfer(hd_list);
+  ar.Transfer(task_cur_count);
+  ar.Transfer(task_last_count);
+  ar.Transfer(task_test_count);
+  ar.Transfer(task_cur_quality);
+  ar.Transfer(task_last_quality);
+  ar.Transfer(task_cur_max_quality);
+  ar.Transfer(task_last_max_quality);
+  ar.Transfer(task_exe_count);
+  ar.Transfer(new_task_count);
+  ar.Transfer(prev_task_count);
+  ar.Transfer(cur_task_count);
+  ar.Transfer(new_reaction_count);
+  ar.Transfer(task_internal_cur_count);
+  ar.Transfer(task_internal_last_count);
+  ar.Transfer(task_internal_cur_quality);
+  ar.Transfer(task_internal_last_quality);
+  ar.Transfer(task_internal_cur_max_quality);
+  ar.Transfer(task_internal_last_max_quality);
+  ar.Transfer(m_reaction_cur_count);
+  ar.Transfer(m_reaction_last_count);
+  ar.Transfer(m_reaction_cur_add_reward);
+  ar.Transfer(m_reaction_last_add_reward);
+  ar.Transfer(m_reaction_exe_count);
+  ar.Transfer(sense_last_count);
+  ar.Transfer(sense_last_exe_count);
+  rave_true_replication_rate.CheckpointState(ar);
+}
+
 void cStats::ProcessUpdate()
 {
   // Increment the "avida_time"
@@ -433,6 +433,7 @@ public:
   
   // cStats
   void ProcessUpdate();
+  void CheckpointState(cStateArchive& ar);
 
   inline void SetCurrentUpdate(int new_update) { m_update = new_update; }
   inline void IncCurrentUpdate() { m_update++; }
@@ -644,7 +645,7 @@ public:
   void RecordBirth(bool breed_true);
   void RecordDeath() { num_deaths++; }
 
-  void IncExecuted() { num_executed++; }
+  void IncExecuted(int count = 1) { num_executed += count; }
 
   void AddNumOrgsKilled(long num) { sum_orgs_killed.Add(num); }
 	void AddNumUnoccupiedCellAttemptedToKill(long num) { sum_unoccupied_cell_kill_attempts.Add(num); }
@@ -705,6 +706,15 @@ public:
   void IncReactionExeCount(int reaction, int count) { m_reaction_exe_count[reaction] += count; }
   void ZeroReactions();
 
+  // Per organism task and reaction totals gathered elsewhere (see cOrgStatsTracker)
+  void SetOrganismTaskTotals(int task_num, int cur_count, int last_count, int exe_count, double cur_quality,
+                             double last_quality, double cur_max_quality, double last_max_quality);
+  void SetOrganismHostParasiteTaskTotals(int task_num, int host_cur, int host_last, int parasite_cur, int parasite_last);
+  void SetOrganismInternalTaskTotals(int task_num, int cur_count, int last_count, double cur_quality,
+                                     double last_quality, double cur_max_quality, double last_max_quality);
+  void SetOrganismReactionTotals(int reaction, int cur_count, int last_count, int exe_count, double cur_add_reward,
+                                 double last_add_reward);
+
   void SetResources(const Apto::Array<double> &_in) { resource_count = _in; }
   void SetResourcesGeometry(const Apto::Array<int> &_in) { resource_geometry = _in;}
   void SetSpatialRes(const Apto::Array< Apto::Array<double> > &_in) { spatial_res_count = _in; }
@@ -768,6 +778,10 @@ public:
   double GetInternalTaskMaxLastQuality(int task_num) const { return task_internal_last_max_quality[task_num]; }
 
   const Apto::Array<int>& GetReactions() const { return m_reaction_last_count; }
+  int GetReactionCurCount(int reaction) const { return m_reaction_cur_count[reaction]; }
+  int GetReactionExeCount(int reaction) const { return m_reaction_exe_count[reaction]; }
+  double GetReactionCurAddReward(int reaction) const { return m_reaction_cur_add_reward[reaction]; }
+  double GetReactionLastAddReward(int reaction) const { return m_reaction_last_add_reward[reaction]; }
   const Apto::Array<double> & GetResources() const { return resource_count; }
 
   double GetAveReproRate() const  { return sum_repro_rate.Average(); }
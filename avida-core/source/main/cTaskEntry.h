@@ -44,11 +44,15 @@ private:
   cArgContainer* m_args;
   Apto::String m_prop_id_ave;
   Apto::String m_prop_id_count;
+  
+  bool m_logic_task;             // quality depends only on the logic id (1.0 when matched, 0.0 otherwise)
+  unsigned int m_logic_ids[8];   // bit set of the 256 logic ids that satisfy a logic task
 
 public:
   cTaskEntry(const cString& name, const cString& desc, int in_id, tTaskTest fun, cArgContainer* args)
-    : m_name(name), m_desc(desc), m_id(in_id), m_test_fun(fun), m_args(args)
+    : m_name(name), m_desc(desc), m_id(in_id), m_test_fun(fun), m_args(args), m_logic_task(false)
   {
+    for (int i = 0; i < 8; i++) m_logic_ids[i] = 0;
     m_prop_id_ave = Apto::FormatStr("environment.triggers.%s.average", (const char*)name);
     m_prop_id_count = Apto::FormatStr("environment.triggers.%s.count", (const char*)name);
   }
@@ -68,6 +72,11 @@ public:
   
   bool HasArguments() const { return (m_args != NULL); }
   cArgContainer& GetArguments() const { return *m_args; }
+  
+  bool IsLogicTask() const { return m_logic_task; }
+  void SetLogicTask() { m_logic_task = true; }
+  void AddLogicId(int logic_id) { m_logic_ids[logic_id >> 5] |= 1u << (logic_id & 31); }
+  bool MatchesLogicId(int logic_id) const { return logic_id >= 0 && ((m_logic_ids[logic_id >> 5] >> (logic_id & 31)) & 1u); }
 };
 
 #endif
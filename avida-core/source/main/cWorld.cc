@@ -39,19 +39,26 @@
 #include "cHardwareManager.h"
 #include "cMigrationMatrix.h"  
 #include "cInstSet.h"
+#include "cOrganismPool.h"
 #include "cPopulation.h"
+#include "cStateArchive.h"
 #include "cStats.h"
+#include "cStringUtil.h"
 #include "cTestCPU.h"
+#include "cTestResultCache.h"
 #include "cUserFeedback.h"
 
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 
 using namespace AvidaTools;
 
 
 cWorld::cWorld(cAvidaConfig* cfg, const cString& wd)
   : m_working_dir(wd), m_analyze(NULL), m_conf(cfg), m_ctx(NULL)
-  , m_env(NULL), m_event_list(NULL), m_hw_mgr(NULL), m_pop(NULL), m_stats(NULL), m_mig_mat(NULL), m_driver(NULL), m_data_mgr(NULL)
+  , m_env(NULL), m_event_list(NULL), m_hw_mgr(NULL), m_org_pool(NULL), m_pop(NULL), m_stats(NULL), m_mig_mat(NULL), m_test_cache(NULL), m_driver(NULL)
+  , m_data_mgr(NULL), m_base_seed(0)
   , m_own_driver(false)
 {
 }
@@ -76,11 +83,15 @@ cWorld::~cWorld()
   // Forcefully clean up population before classification manager
   m_pop = Apto::SmartPtr<cPopulation, Apto::InternalRCObject>();
   
+  // Dead organisms are released into the pool, so it must outlive the population
+  delete m_org_pool; m_org_pool = NULL;
+  
   delete m_env; m_env = NULL;
   delete m_event_list; m_event_list = NULL;
   delete m_hw_mgr; m_hw_mgr = NULL;
 
   delete m_mig_mat; 
+  delete m_test_cache;
   
   // Delete Last
   delete m_conf; m_conf = NULL;
@@ -100,7 +111,7 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   bool success = true;
   
   // Setup Random Number Generator
-  m_rng.ResetSeed(m_conf->RANDOM_SEED.Get());
+  ResetRandomSeed(m_conf->RANDOM_SEED.Get());
   m_ctx = new cAvidaContext(NULL, m_rng);
   
   // Initialize new API-based data structures here for now
@@ -114,7 +125,9 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
     
     // Output Manager
     Apto::String opath = Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->DATA_DIR.Get()), Apto::String(m_working_dir));
-    Output::ManagerPtr(new Output::Manager(opath))->AttachTo(new_world);
+    Output::ManagerPtr output_mgr(new Output::Manager(opath));
+    if (m_conf->ASYNC_OUTPUT_BLOCKS.Get() > 0) output_mgr->EnableAsyncWriter(m_conf->ASYNC_OUTPUT_BLOCKS.Get());
+    output_mgr->AttachTo(new_world);
   }
   
 
@@ -172,6 +185,18 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   // If there were errors loading at this point, it is perilous to try to go further (pop depends on an instruction set)
   if (!success) return success;
   
+  m_org_pool = new cOrganismPool(this);
+  
+  // Test CPU result cache, keyed in part by the environment and instruction sets loaded above
+  if (m_conf->TEST_CACHE_SIZE.Get() > 0 || m_conf->TEST_CACHE_FILE.Get() != "") {
+    cString cache_path;
+    if (m_conf->TEST_CACHE_FILE.Get() != "") {
+      cache_path = (const char*)Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->TEST_CACHE_FILE.Get()), Apto::String(m_working_dir));
+    }
+    m_test_cache = new cTestResultCache(this);
+    if (!m_test_cache->Open(m_conf->TEST_CACHE_SIZE.Get(), cache_path, *feedback)) return false;
+  }
+  
   
   // @MRR CClade Tracking
 //	if (m_conf->TRACK_CCLADES.Get() > 0)
@@ -221,7 +246,129 @@ void cWorld::GetEvents(cAvidaContext& ctx)
     m_event_list->Sync();
     m_pop->SetSyncEvents(false);
   }
-  m_event_list->Process(ctx);
+  if (m_event_list->IsEventDue()) m_event_list->Process(ctx);
+  
+  // Checkpoints are deferred until the event pass is complete, so that a resumed run does not repeat this update's
+  // events, and saves further until the next sync point
+  const int sync_interval = m_conf->CHECKPOINT_SYNC_INTERVAL.Get();
+  if (sync_interval > 0 && m_stats->GetUpdate() % sync_interval == 0) {
+    syncCheckpointState();
+    if (m_checkpoint_save.GetSize()) {
+      cString path = cStringUtil::Stringf("%s-%d.ckpt", (const char*)m_checkpoint_save, m_stats->GetUpdate());
+      m_checkpoint_save = "";
+      saveCheckpoint(ctx, path);
+    }
+  } else if (sync_interval <= 0 && m_checkpoint_save.GetSize()) {
+    ctx.Driver().Feedback().Error("SaveCheckpoint requires CHECKPOINT_SYNC_INTERVAL to be set");
+    m_checkpoint_save = "";
+  }
+  if (m_checkpoint_load.GetSize()) {
+    cString path(m_checkpoint_load);
+    m_checkpoint_load = "";
+    loadCheckpoint(ctx, path);
+  }
+}
+
+
+void cWorld::ResetRandomSeed(int seed)
+{
+  m_rng.ResetSeed(seed);
+  m_base_seed = m_rng.Seed();
+}
+
+
+// Neither the generator state nor the scheduler internals can be read back out of Apto.  Instead, every
+// CHECKPOINT_SYNC_INTERVAL updates (whether or not a checkpoint is saved) the generator is reseeded with a value that
+// depends only on the run's seed and the update, and the scheduler is rebuilt from the current merits.  At these points
+// the complete state is known, so a checkpoint written there does not alter the saving run, and a run resumed from it
+// performs the same resynchronization and continues exactly as the saving run does.
+void cWorld::syncCheckpointState()
+{
+  uint64_t hash = ((uint64_t)(unsigned int)m_base_seed << 32) | (unsigned int)m_stats->GetUpdate();
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDull;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ull;
+  hash ^= hash >> 33;
+  
+  // Seeds of zero or below would be replaced by a time based seed
+  m_rng.ResetSeed(1 + (int)(hash % (uint64_t)(m_rng.MaxSeed() - 1)));
+  m_pop->RebuildSchedule();
+}
+
+bool cWorld::checkpointState(cStateArchive& ar, cAvidaContext& ctx)
+{
+  const int CHECKPOINT_VERSION = 2;
+  
+  ar.Tag("AvidaCheckpoint");
+  int version = CHECKPOINT_VERSION;
+  ar.Transfer(version);
+  if (ar.IsGood() && version != CHECKPOINT_VERSION) ar.Fail(cStringUtil::Stringf("unsupported checkpoint version %d", version));
+  
+  // The resumed run continues from the saving run's seed and must resynchronize at the same updates
+  ar.Transfer(m_base_seed);
+  int sync_interval = m_conf->CHECKPOINT_SYNC_INTERVAL.Get();
+  ar.Transfer(sync_interval);
+  if (ar.IsGood() && sync_interval != m_conf->CHECKPOINT_SYNC_INTERVAL.Get()) {
+    ar.Fail(cStringUtil::Stringf("checkpoint was saved with CHECKPOINT_SYNC_INTERVAL %d", sync_interval));
+  }
+  
+  // Stats must precede the event list, loading events resolves their triggers against the current update
+  m_pop->CheckpointState(ar, ctx);
+  m_stats->CheckpointState(ar);
+  m_event_list->CheckpointState(ar, ctx.Driver().Feedback());
+  if (!ar.IsGood()) return false;
+  
+  if (ar.IsLoading()) syncCheckpointState();
+  return true;
+}
+
+void cWorld::saveCheckpoint(cAvidaContext& ctx, const cString& path)
+{
+  // Written to a temporary file first, so that a failed save never leaves a partial checkpoint under the final name
+  cString temp_path(path);
+  temp_path += ".tmp";
+  std::ofstream fp((const char*)temp_path);
+  if (!fp.good()) {
+    ctx.Driver().Feedback().Error("unable to open checkpoint file '%s' for writing", (const char*)temp_path);
+    return;
+  }
+  
+  cStateArchive ar(fp);
+  if (!checkpointState(ar, ctx)) {
+    ctx.Driver().Feedback().Error("unable to save checkpoint '%s': %s", (const char*)path, (const char*)ar.GetError());
+    fp.close();
+    std::remove(temp_path);
+    return;
+  }
+  fp << std::endl;
+  fp.close();
+  if (fp.fail()) {
+    ctx.Driver().Feedback().Error("error writing checkpoint file '%s'", (const char*)temp_path);
+    std::remove(temp_path);
+    return;
+  }
+  if (std::rename(temp_path, path) != 0) {
+    ctx.Driver().Feedback().Error("unable to move checkpoint file '%s' into place", (const char*)temp_path);
+    std::remove(temp_path);
+  }
+}
+
+void cWorld::loadCheckpoint(cAvidaContext& ctx, const cString& path)
+{
+  std::ifstream fp((const char*)path);
+  if (!fp.good()) {
+    ctx.Driver().Feedback().Error("unable to open checkpoint file '%s'", (const char*)path);
+    ctx.Driver().Abort(Avida::IO_ERROR);
+    return;
+  }
+  
+  // A partially loaded world is unusable, so any failure here ends the run
+  cStateArchive ar(fp);
+  if (!checkpointState(ar, ctx)) {
+    ctx.Driver().Feedback().Error("unable to load checkpoint '%s': %s", (const char*)path, (const char*)ar.GetError());
+    ctx.Driver().Abort(Avida::INVALID_CONFIG);
+  }
 }
 
 int cWorld::GetNumResources()
@@ -39,11 +39,14 @@ class cEventList;
 class cHardwareManager;
 class cMigrationMatrix; 
 class cOrganism;
+class cOrganismPool;
 class cPopulation;
 class cMerit;
 class cPopulationCell;
+class cStateArchive;
 class cStats;
 class cTestCPU;
+class cTestResultCache;
 class cUserFeedback;
 template<class T> class tDataEntry;
 
@@ -62,19 +65,25 @@ protected:
   cEnvironment* m_env;
   cEventList* m_event_list;
   cHardwareManager* m_hw_mgr;
+  cOrganismPool* m_org_pool;
   Apto::SmartPtr<cPopulation, Apto::InternalRCObject> m_pop;
   Apto::SmartPtr<cStats, Apto::InternalRCObject> m_stats;
   cMigrationMatrix* m_mig_mat;  
+  cTestResultCache* m_test_cache;
   WorldDriver* m_driver;
   
   Data::ManagerPtr m_data_mgr;
 
   Apto::RNG::AvidaRNG m_rng;
+  int m_base_seed;        // seed the run started from, see syncCheckpointState()
   
   bool m_test_on_div;     // flag derived from a collection of configuration settings
   bool m_test_sterilize;  // flag derived from a collection of configuration settings
   
   bool m_own_driver;      // specifies whether this world object should manage its driver object
+  
+  cString m_checkpoint_save;  // pending checkpoint save (written at the next sync point) and load (at the end of the
+  cString m_checkpoint_load;  // current event pass)
 
   cWorld(cAvidaConfig* cfg, const cString& wd);
   
@@ -94,9 +103,12 @@ public:
   cEnvironment& GetEnvironment() { return *m_env; }
   cHardwareManager& GetHardwareManager() { return *m_hw_mgr; }
   cMigrationMatrix& GetMigrationMatrix(){ return *m_mig_mat; };
+  cOrganismPool& GetOrganismPool() { return *m_org_pool; }
   cPopulation& GetPopulation() { return *m_pop; }
   Apto::Random& GetRandom() { return m_rng; }
+  void ResetRandomSeed(int seed);
   cStats& GetStats() { return *m_stats; }
+  cTestResultCache* GetTestResultCache() { return m_test_cache; }  // NULL unless TEST_CACHE_SIZE is set
   WorldDriver& GetDriver() { return *m_driver; }
   World* GetNewWorld() { return m_new_world; }
   
@@ -117,6 +129,11 @@ public:
   void GetEvents(cAvidaContext& ctx);
 	
 	cEventList* GetEventsList() { return m_event_list; }
+  
+  // Full state checkpoints, taken once the events of an update have been processed (paths must be absolute).  Saves
+  // are written at the next checkpoint sync point (see CHECKPOINT_SYNC_INTERVAL), with "-<update>.ckpt" appended.
+  void RequestCheckpointSave(const cString& path) { m_checkpoint_save = path; }
+  void RequestCheckpointLoad(const cString& path) { m_checkpoint_load = path; }
 
 	//! Migrate this organism to a different world (does nothing here; see cMultiProcessWorld).
 	virtual void MigrateOrganism(cOrganism* org, const cPopulationCell& cell, const cMerit& merit, int lineage);
@@ -139,6 +156,11 @@ public:
 protected:
   // Internal Methods
   bool setup(World* new_world, cUserFeedback* errors,  const Apto::Map<Apto::String, Apto::String>* mappings);
+  
+  void syncCheckpointState();
+  bool checkpointState(cStateArchive& ar, cAvidaContext& ctx);
+  void saveCheckpoint(cAvidaContext& ctx, const cString& path);
+  void loadCheckpoint(cAvidaContext& ctx, const cString& path);
 
 };
 
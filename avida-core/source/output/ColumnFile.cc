@@ -0,0 +1,291 @@
+/*
+ *  output/ColumnFile.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/ColumnFile.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/output/Manager.h"
+
+#include "avida/private/output/ColumnFormat.h"
+
+#include <cstring>
+
+using namespace Avida::Output::ColumnFormat;
+
+
+Avida::Output::ColumnFilePtr Avida::Output::ColumnFile::CreateWithPath(World* world, Apto::String path, Feedback* feedback,
+                                                                       int chunk_rows)
+{
+  Output::ManagerPtr mgr = Output::Manager::Of(world);
+  OutputID oid = mgr->OutputIDFromPath(path);
+
+  if (oid.GetSize() == 0) {
+    if (feedback) feedback->Error("unable to translate path '%s' to output id", (const char*)path);
+    return ColumnFilePtr(NULL);
+  }
+
+  if (mgr->IsOpen(oid)) {
+    if (feedback) feedback->Error("file '%s' already open", (const char*)oid);
+    return ColumnFilePtr(NULL);
+  }
+
+  ColumnFilePtr rtn(new ColumnFile(world, oid, chunk_rows));
+
+  if (!rtn->Good()) {
+    if (feedback) feedback->Error("unable to open file '%s' for writing", (const char*)oid);
+    return ColumnFilePtr(NULL);
+  }
+
+  return rtn;
+}
+
+
+Avida::Output::ColumnFile::ColumnFile(World* world, const OutputID& output_id, int chunk_rows)
+  : Socket(world, output_id), m_fp(fopen(output_id, "wb")), m_good(m_fp != NULL)
+  , m_chunk_rows((chunk_rows > 0) ? chunk_rows : DEFAULT_CHUNK_ROWS), m_header_written(false), m_data_end(0)
+{
+}
+
+Avida::Output::ColumnFile::~ColumnFile()
+{
+  Flush();
+  if (m_fp) fclose(m_fp);
+  for (int i = 0; i < m_columns.GetSize(); i++) delete m_columns[i];
+}
+
+
+int Avida::Output::ColumnFile::AddColumn(const Apto::String& name, ColumnType type)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (m_header_written || m_updates.size()) return -1;
+
+  Column* col = new Column;
+  col->name = name;
+  col->type = type;
+  m_columns.Push(col);
+  return m_columns.GetSize() - 1;
+}
+
+
+void Avida::Output::ColumnFile::Write(int column, int value)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  Column& col = *m_columns[column];
+  switch (col.type) {
+    case INT_COLUMN:    col.ints.push_back(value); break;
+    case DOUBLE_COLUMN: col.doubles.push_back(value); break;
+    case STRING_COLUMN: col.strings.push_back(Apto::AsStr(value)); break;
+  }
+}
+
+void Avida::Output::ColumnFile::Write(int column, double value)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  Column& col = *m_columns[column];
+  switch (col.type) {
+    case INT_COLUMN:    col.ints.push_back((int)value); break;
+    case DOUBLE_COLUMN: col.doubles.push_back(value); break;
+    case STRING_COLUMN: col.strings.push_back(Apto::AsStr(value)); break;
+  }
+}
+
+void Avida::Output::ColumnFile::Write(int column, const Apto::String& value)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  Column& col = *m_columns[column];
+  switch (col.type) {
+    case INT_COLUMN:    col.ints.push_back(Apto::StrAs(value)); break;
+    case DOUBLE_COLUMN: col.doubles.push_back(Apto::StrAs(value)); break;
+    case STRING_COLUMN: col.strings.push_back(value); break;
+  }
+}
+
+
+void Avida::Output::ColumnFile::Endl(Update update)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+
+  // Columns that were not written this row receive a default value, keeping all columns the same length
+  const size_t num_rows = m_updates.size() + 1;
+  for (int i = 0; i < m_columns.GetSize(); i++) {
+    Column& col = *m_columns[i];
+    switch (col.type) {
+      case INT_COLUMN:    assert(col.ints.size() <= num_rows); col.ints.resize(num_rows, 0); break;
+      case DOUBLE_COLUMN: assert(col.doubles.size() <= num_rows); col.doubles.resize(num_rows, 0.0); break;
+      case STRING_COLUMN: assert(col.strings.size() <= num_rows); col.strings.resize(num_rows); break;
+    }
+  }
+  m_updates.push_back(update);
+
+  if ((int)m_updates.size() >= m_chunk_rows) writeChunk();
+}
+
+
+void Avida::Output::ColumnFile::Flush()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_good) return;
+
+  if (!m_header_written) writeHeader();
+  if (m_updates.size()) writeChunk();
+  writeIndex();
+}
+
+
+bool Avida::Output::ColumnFile::writeHeader()
+{
+  sFileHeader header;
+  memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+  header.version = VERSION;
+  header.byte_order = BYTE_ORDER_MARK;
+  header.num_columns = m_columns.GetSize();
+  header.reserved = 0;
+
+  bool ok = (fwrite(&header, sizeof(header), 1, m_fp) == 1);
+  m_data_end = sizeof(header);
+
+  for (int i = 0; ok && i < m_columns.GetSize(); i++) {
+    sColumnHeader col_header;
+    col_header.type = m_columns[i]->type;
+    col_header.name_size = m_columns[i]->name.GetSize();
+    ok = (fwrite(&col_header, sizeof(col_header), 1, m_fp) == 1);
+    if (ok && col_header.name_size) ok = (fwrite((const char*)m_columns[i]->name, col_header.name_size, 1, m_fp) == 1);
+    m_data_end += sizeof(col_header) + col_header.name_size;
+  }
+
+  m_header_written = true;
+  if (!ok) m_good = false;
+  return ok;
+}
+
+
+bool Avida::Output::ColumnFile::writeChunk()
+{
+  if (m_good && !m_header_written) writeHeader();
+
+  const int num_rows = m_updates.size();
+  const int num_blocks = m_columns.GetSize() + 1;
+
+  // Encode and compress each column
+  std::vector<std::vector<char> > blocks(num_blocks);
+  std::vector<sBlockHeader> block_headers(num_blocks);
+
+  EncodeInts(m_updates, blocks[0]);
+  for (int i = 0; i < m_columns.GetSize(); i++) {
+    Column& col = *m_columns[i];
+    std::vector<char>& block = blocks[i + 1];
+    switch (col.type) {
+      case INT_COLUMN:    EncodeInts(col.ints, block); break;
+      case DOUBLE_COLUMN: EncodeDoubles(col.doubles, block); break;
+      case STRING_COLUMN:
+        {
+          std::vector<uint32_t> lengths(num_rows);
+          size_t total = 0;
+          for (int r = 0; r < num_rows; r++) {
+            lengths[r] = col.strings[r].GetSize();
+            total += lengths[r];
+          }
+          block.resize(num_rows * sizeof(uint32_t) + total);
+          if (num_rows) memcpy(&block[0], &lengths[0], num_rows * sizeof(uint32_t));
+          size_t pos = num_rows * sizeof(uint32_t);
+          for (int r = 0; r < num_rows; r++) {
+            if (lengths[r]) memcpy(&block[pos], (const char*)col.strings[r], lengths[r]);
+            pos += lengths[r];
+          }
+        }
+        break;
+    }
+  }
+  for (int b = 0; b < num_blocks; b++) {
+    block_headers[b].raw_size = blocks[b].size();
+    block_headers[b].stored_size = Compress(blocks[b]);
+  }
+
+  sChunkHeader header;
+  memcpy(header.magic, CHUNK_MAGIC, sizeof(header.magic));
+  header.num_rows = num_rows;
+  header.first_update = m_updates.front();
+  header.last_update = m_updates.back();
+
+  // Chunks are written at the end of the previous one, over any index written by an earlier flush
+  bool ok = m_good && Seek(m_fp, m_data_end);
+  ok = ok && (fwrite(&header, sizeof(header), 1, m_fp) == 1);
+  ok = ok && (fwrite(&block_headers[0], sizeof(sBlockHeader), num_blocks, m_fp) == (size_t)num_blocks);
+  uint64_t chunk_size = sizeof(header) + sizeof(sBlockHeader) * num_blocks;
+  for (int b = 0; ok && b < num_blocks; b++) {
+    if (blocks[b].size()) ok = (fwrite(&blocks[b][0], blocks[b].size(), 1, m_fp) == 1);
+    chunk_size += blocks[b].size();
+  }
+
+  if (ok) {
+    ChunkEntry entry;
+    entry.offset = m_data_end;
+    entry.num_rows = num_rows;
+    entry.first_update = header.first_update;
+    entry.last_update = header.last_update;
+    m_chunks.Push(entry);
+    m_data_end += chunk_size;
+  } else {
+    m_good = false;
+  }
+
+  m_updates.clear();
+  for (int i = 0; i < m_columns.GetSize(); i++) {
+    m_columns[i]->ints.clear();
+    m_columns[i]->doubles.clear();
+    m_columns[i]->strings.clear();
+  }
+
+  return ok;
+}
+
+
+bool Avida::Output::ColumnFile::writeIndex()
+{
+  sIndexHeader header;
+  memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+  header.num_chunks = m_chunks.GetSize();
+
+  std::vector<sIndexEntry> entries(m_chunks.GetSize());
+  for (int i = 0; i < m_chunks.GetSize(); i++) {
+    entries[i].offset = m_chunks[i].offset;
+    entries[i].num_rows = m_chunks[i].num_rows;
+    entries[i].first_update = m_chunks[i].first_update;
+    entries[i].last_update = m_chunks[i].last_update;
+    entries[i].reserved = 0;
+  }
+
+  sTrailer trailer;
+  trailer.index_offset = m_data_end;
+  memcpy(trailer.magic, TRAILER_MAGIC, sizeof(trailer.magic));
+
+  bool ok = Seek(m_fp, m_data_end);
+  ok = ok && (fwrite(&header, sizeof(header), 1, m_fp) == 1);
+  if (entries.size()) ok = ok && (fwrite(&entries[0], sizeof(sIndexEntry), entries.size(), m_fp) == entries.size());
+  ok = ok && (fwrite(&trailer, sizeof(trailer), 1, m_fp) == 1);
+
+  // Drop anything left past the trailer by an earlier, longer index
+  const uint64_t file_size = m_data_end + sizeof(header) + sizeof(sIndexEntry) * entries.size() + sizeof(trailer);
+  ok = ok && Truncate(m_fp, file_size);
+
+  if (!ok) m_good = false;
+  return ok;
+}
@@ -0,0 +1,352 @@
+/*
+ *  output/ColumnFileReader.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/ColumnFileReader.h"
+
+#include "avida/core/Feedback.h"
+
+#include "avida/private/output/ColumnFormat.h"
+
+#include <cstring>
+#include <sys/types.h>
+
+using namespace Avida::Output::ColumnFormat;
+
+
+// Value conversions used when a column is read as a type other than its own
+static inline void assignValue(int& out, int32_t value) { out = value; }
+static inline void assignValue(int& out, double value) { out = (int)value; }
+static inline void assignValue(int& out, const Apto::String& value) { out = Apto::StrAs(value); }
+static inline void assignValue(double& out, int32_t value) { out = value; }
+static inline void assignValue(double& out, double value) { out = value; }
+static inline void assignValue(double& out, const Apto::String& value) { out = Apto::StrAs(value); }
+static inline void assignValue(Apto::String& out, int32_t value) { out = Apto::AsStr((int)value); }
+static inline void assignValue(Apto::String& out, double value) { out = Apto::AsStr(value); }
+static inline void assignValue(Apto::String& out, const Apto::String& value) { out = value; }
+
+
+static uint64_t fileSize(FILE* fp)
+{
+#if APTO_PLATFORM(WINDOWS)
+  _fseeki64(fp, 0, SEEK_END);
+  return _ftelli64(fp);
+#else
+  fseeko(fp, 0, SEEK_END);
+  return ftello(fp);
+#endif
+}
+
+
+Avida::Output::ColumnFileReader::ColumnFileReader()
+  : m_fp(NULL), m_file_size(0), m_data_start(0), m_recovered(false), m_num_rows(0)
+{
+}
+
+
+bool Avida::Output::ColumnFileReader::Open(const Apto::String& path, Feedback& feedback)
+{
+  Close();
+
+  m_fp = fopen(path, "rb");
+  if (!m_fp) {
+    feedback.Error("unable to open '%s'", (const char*)path);
+    return false;
+  }
+  m_file_size = fileSize(m_fp);
+
+  sFileHeader header;
+  if (!Seek(m_fp, 0) || fread(&header, sizeof(header), 1, m_fp) != 1 ||
+      memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0) {
+    feedback.Error("'%s' is not a columnar data file", (const char*)path);
+    Close();
+    return false;
+  }
+  if (header.byte_order != BYTE_ORDER_MARK) {
+    feedback.Error("'%s' was written on a machine with a different byte order", (const char*)path);
+    Close();
+    return false;
+  }
+  if (header.version != VERSION) {
+    feedback.Error("'%s' has unsupported version %u", (const char*)path, header.version);
+    Close();
+    return false;
+  }
+
+  m_data_start = sizeof(header);
+  for (uint32_t i = 0; i < header.num_columns; i++) {
+    sColumnHeader col_header;
+    if (fread(&col_header, sizeof(col_header), 1, m_fp) != 1 || col_header.type > ColumnFile::STRING_COLUMN ||
+        m_data_start + sizeof(col_header) + col_header.name_size > m_file_size) {
+      feedback.Error("'%s' has a damaged column table", (const char*)path);
+      Close();
+      return false;
+    }
+    std::vector<char> name(col_header.name_size + 1, '\0');
+    if (col_header.name_size && fread(&name[0], col_header.name_size, 1, m_fp) != 1) {
+      feedback.Error("'%s' has a damaged column table", (const char*)path);
+      Close();
+      return false;
+    }
+    m_names.Push(Apto::String(&name[0]));
+    m_types.Push((ColumnFile::ColumnType)col_header.type);
+    m_data_start += sizeof(col_header) + col_header.name_size;
+  }
+
+  if (!readIndex()) {
+    m_chunks.Resize(0);
+    m_recovered = true;
+    if (!scanChunks()) {
+      feedback.Error("'%s' could not be indexed", (const char*)path);
+      Close();
+      return false;
+    }
+    feedback.Warning("'%s' has no index (incomplete run?), recovered %d chunks", (const char*)path, m_chunks.GetSize());
+  }
+
+  m_num_rows = 0;
+  for (int i = 0; i < m_chunks.GetSize(); i++) m_num_rows += m_chunks[i].num_rows;
+
+  return true;
+}
+
+
+void Avida::Output::ColumnFileReader::Close()
+{
+  if (m_fp) fclose(m_fp);
+  m_fp = NULL;
+  m_file_size = 0;
+  m_data_start = 0;
+  m_recovered = false;
+  m_names.Resize(0);
+  m_types.Resize(0);
+  m_chunks.Resize(0);
+  m_num_rows = 0;
+}
+
+
+int Avida::Output::ColumnFileReader::ColumnIndex(const Apto::String& name) const
+{
+  for (int i = 0; i < m_names.GetSize(); i++) if (m_names[i] == name) return i;
+  return -1;
+}
+
+Avida::Update Avida::Output::ColumnFileReader::FirstUpdate() const
+{
+  return (m_chunks.GetSize()) ? m_chunks[0].first_update : -1;
+}
+
+Avida::Update Avida::Output::ColumnFileReader::LastUpdate() const
+{
+  return (m_chunks.GetSize()) ? m_chunks[m_chunks.GetSize() - 1].last_update : -1;
+}
+
+
+template <class T>
+bool Avida::Output::ColumnFileReader::readColumn(int column, Update first, Update last, Apto::Array<T, Apto::Smart>& values)
+{
+  if (column < 0 || column >= m_names.GetSize()) return false;
+
+  std::vector<int32_t> updates;
+  std::vector<char> raw;
+  std::vector<int32_t> ints;
+  std::vector<double> doubles;
+
+  for (int c = 0; c < m_chunks.GetSize(); c++) {
+    const ChunkInfo& chunk = m_chunks[c];
+    if (chunk.last_update < first || chunk.first_update > last) continue;
+
+    const int num_rows = chunk.num_rows;
+    if (!readChunkUpdates(chunk, updates)) return false;
+    if (!readBlock(chunk, column + 1, raw)) return false;
+
+    T value;
+    switch (m_types[column]) {
+      case ColumnFile::INT_COLUMN:
+        if (raw.size() != num_rows * sizeof(int32_t)) return false;
+        DecodeInts(raw, num_rows, ints);
+        for (int r = 0; r < num_rows; r++) {
+          if (updates[r] < first || updates[r] > last) continue;
+          assignValue(value, ints[r]);
+          values.Push(value);
+        }
+        break;
+
+      case ColumnFile::DOUBLE_COLUMN:
+        if (raw.size() != num_rows * sizeof(double)) return false;
+        DecodeDoubles(raw, num_rows, doubles);
+        for (int r = 0; r < num_rows; r++) {
+          if (updates[r] < first || updates[r] > last) continue;
+          assignValue(value, doubles[r]);
+          values.Push(value);
+        }
+        break;
+
+      case ColumnFile::STRING_COLUMN:
+        {
+          if (raw.size() < num_rows * sizeof(uint32_t)) return false;
+          const uint32_t* lengths = (const uint32_t*)&raw[0];
+          size_t pos = num_rows * sizeof(uint32_t);
+          std::vector<char> str;
+          for (int r = 0; r < num_rows; r++) {
+            if (pos + lengths[r] > raw.size()) return false;
+            if (updates[r] >= first && updates[r] <= last) {
+              str.assign(raw.begin() + pos, raw.begin() + pos + lengths[r]);
+              str.push_back('\0');
+              assignValue(value, Apto::String(&str[0]));
+              values.Push(value);
+            }
+            pos += lengths[r];
+          }
+        }
+        break;
+    }
+  }
+
+  return true;
+}
+
+
+bool Avida::Output::ColumnFileReader::ReadUpdates(Update first, Update last, Apto::Array<Update, Apto::Smart>& updates)
+{
+  std::vector<int32_t> chunk_updates;
+  for (int c = 0; c < m_chunks.GetSize(); c++) {
+    const ChunkInfo& chunk = m_chunks[c];
+    if (chunk.last_update < first || chunk.first_update > last) continue;
+
+    if (!readChunkUpdates(chunk, chunk_updates)) return false;
+    for (int r = 0; r < chunk.num_rows; r++) {
+      if (chunk_updates[r] >= first && chunk_updates[r] <= last) updates.Push(chunk_updates[r]);
+    }
+  }
+  return true;
+}
+
+bool Avida::Output::ColumnFileReader::ReadInts(int column, Update first, Update last, Apto::Array<int, Apto::Smart>& values)
+{
+  return readColumn(column, first, last, values);
+}
+
+bool Avida::Output::ColumnFileReader::ReadDoubles(int column, Update first, Update last,
+                                                  Apto::Array<double, Apto::Smart>& values)
+{
+  return readColumn(column, first, last, values);
+}
+
+bool Avida::Output::ColumnFileReader::ReadStrings(int column, Update first, Update last,
+                                                  Apto::Array<Apto::String, Apto::Smart>& values)
+{
+  return readColumn(column, first, last, values);
+}
+
+
+bool Avida::Output::ColumnFileReader::readIndex()
+{
+  if (m_file_size < m_data_start + sizeof(sIndexHeader) + sizeof(sTrailer)) return false;
+
+  sTrailer trailer;
+  if (!Seek(m_fp, m_file_size - sizeof(trailer)) || fread(&trailer, sizeof(trailer), 1, m_fp) != 1) return false;
+  if (memcmp(trailer.magic, TRAILER_MAGIC, sizeof(trailer.magic)) != 0) return false;
+  if (trailer.index_offset < m_data_start || trailer.index_offset > m_file_size - sizeof(trailer) - sizeof(sIndexHeader)) {
+    return false;
+  }
+
+  sIndexHeader header;
+  if (!Seek(m_fp, trailer.index_offset) || fread(&header, sizeof(header), 1, m_fp) != 1) return false;
+  if (memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0) return false;
+  if (trailer.index_offset + sizeof(header) + (uint64_t)header.num_chunks * sizeof(sIndexEntry) + sizeof(trailer) !=
+      m_file_size) {
+    return false;
+  }
+
+  std::vector<sIndexEntry> entries(header.num_chunks);
+  if (header.num_chunks && fread(&entries[0], sizeof(sIndexEntry), header.num_chunks, m_fp) != header.num_chunks) {
+    return false;
+  }
+
+  m_chunks.Resize(header.num_chunks);
+  for (uint32_t i = 0; i < header.num_chunks; i++) {
+    if (entries[i].offset < m_data_start || entries[i].offset >= trailer.index_offset) return false;
+    m_chunks[i].offset = entries[i].offset;
+    m_chunks[i].num_rows = entries[i].num_rows;
+    m_chunks[i].first_update = entries[i].first_update;
+    m_chunks[i].last_update = entries[i].last_update;
+  }
+  return true;
+}
+
+
+bool Avida::Output::ColumnFileReader::scanChunks()
+{
+  const int num_blocks = m_names.GetSize() + 1;
+  std::vector<sBlockHeader> block_headers(num_blocks);
+
+  uint64_t offset = m_data_start;
+  while (offset + sizeof(sChunkHeader) <= m_file_size) {
+    sChunkHeader header;
+    if (!Seek(m_fp, offset) || fread(&header, sizeof(header), 1, m_fp) != 1) break;
+    if (memcmp(header.magic, CHUNK_MAGIC, sizeof(header.magic)) != 0) break;
+    if (fread(&block_headers[0], sizeof(sBlockHeader), num_blocks, m_fp) != (size_t)num_blocks) break;
+
+    uint64_t chunk_size = sizeof(header) + sizeof(sBlockHeader) * num_blocks;
+    for (int b = 0; b < num_blocks; b++) chunk_size += block_headers[b].stored_size;
+    if (offset + chunk_size > m_file_size) break;  // partially written chunk
+
+    ChunkInfo chunk;
+    chunk.offset = offset;
+    chunk.num_rows = header.num_rows;
+    chunk.first_update = header.first_update;
+    chunk.last_update = header.last_update;
+    m_chunks.Push(chunk);
+
+    offset += chunk_size;
+  }
+
+  // An index or a partial chunk may follow the recovered chunks, anything else indicates a damaged file
+  return (offset == m_data_start || m_chunks.GetSize() > 0);
+}
+
+
+bool Avida::Output::ColumnFileReader::readBlock(const ChunkInfo& chunk, int block, std::vector<char>& raw)
+{
+  const int num_blocks = m_names.GetSize() + 1;
+  std::vector<sBlockHeader> block_headers(num_blocks);
+  if (!Seek(m_fp, chunk.offset + sizeof(sChunkHeader))) return false;
+  if (fread(&block_headers[0], sizeof(sBlockHeader), num_blocks, m_fp) != (size_t)num_blocks) return false;
+
+  uint64_t offset = chunk.offset + sizeof(sChunkHeader) + sizeof(sBlockHeader) * num_blocks;
+  for (int b = 0; b < block; b++) offset += block_headers[b].stored_size;
+  if (offset + block_headers[block].stored_size > m_file_size) return false;
+
+  std::vector<char> stored(block_headers[block].stored_size);
+  if (!Seek(m_fp, offset)) return false;
+  if (stored.size() && fread(&stored[0], stored.size(), 1, m_fp) != 1) return false;
+
+  return Decompress(stored, block_headers[block].raw_size, raw);
+}
+
+
+bool Avida::Output::ColumnFileReader::readChunkUpdates(const ChunkInfo& chunk, std::vector<int32_t>& updates)
+{
+  std::vector<char> raw;
+  if (!readBlock(chunk, 0, raw) || raw.size() != chunk.num_rows * sizeof(int32_t)) return false;
+  DecodeInts(raw, chunk.num_rows, updates);
+  return true;
+}
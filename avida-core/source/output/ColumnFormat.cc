@@ -0,0 +1,155 @@
+/*
+ *  output/ColumnFormat.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/private/output/ColumnFormat.h"
+
+#include "apto/platform.h"
+
+#include <sys/types.h>
+
+#if APTO_PLATFORM(WINDOWS)
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+#ifdef AVIDA_ZLIB
+# include <zlib.h>
+#endif
+
+
+const char Avida::Output::ColumnFormat::FILE_MAGIC[8] = { 'A', 'V', 'D', 'C', 'O', 'L', '0', '1' };
+const char Avida::Output::ColumnFormat::CHUNK_MAGIC[4] = { 'C', 'H', 'N', 'K' };
+const char Avida::Output::ColumnFormat::INDEX_MAGIC[4] = { 'I', 'N', 'D', 'X' };
+const char Avida::Output::ColumnFormat::TRAILER_MAGIC[8] = { 'A', 'V', 'D', 'C', 'E', 'N', 'D', '1' };
+
+
+// Transposes num_values values of width bytes, so that byte b of value i lands at b * num_values + i
+static void transposeBytes(const char* in, char* out, int num_values, int width)
+{
+  for (int i = 0; i < num_values; i++) {
+    for (int b = 0; b < width; b++) out[b * num_values + i] = in[i * width + b];
+  }
+}
+
+static void untransposeBytes(const char* in, char* out, int num_values, int width)
+{
+  for (int i = 0; i < num_values; i++) {
+    for (int b = 0; b < width; b++) out[i * width + b] = in[b * num_values + i];
+  }
+}
+
+
+void Avida::Output::ColumnFormat::EncodeInts(const std::vector<int32_t>& values, std::vector<char>& out)
+{
+  const int num_values = values.size();
+  std::vector<uint32_t> deltas(num_values);
+  uint32_t prev = 0;
+  for (int i = 0; i < num_values; i++) {
+    // unsigned arithmetic, so that differences wrap rather than overflow
+    deltas[i] = (uint32_t)values[i] - prev;
+    prev = (uint32_t)values[i];
+  }
+
+  out.resize(num_values * sizeof(uint32_t));
+  if (num_values) transposeBytes((const char*)&deltas[0], &out[0], num_values, sizeof(uint32_t));
+}
+
+void Avida::Output::ColumnFormat::DecodeInts(const std::vector<char>& in, int num_rows, std::vector<int32_t>& values)
+{
+  std::vector<uint32_t> deltas(num_rows);
+  if (num_rows) untransposeBytes(&in[0], (char*)&deltas[0], num_rows, sizeof(uint32_t));
+
+  values.resize(num_rows);
+  uint32_t prev = 0;
+  for (int i = 0; i < num_rows; i++) {
+    prev += deltas[i];
+    values[i] = (int32_t)prev;
+  }
+}
+
+
+void Avida::Output::ColumnFormat::EncodeDoubles(const std::vector<double>& values, std::vector<char>& out)
+{
+  const int num_values = values.size();
+  out.resize(num_values * sizeof(double));
+  if (num_values) transposeBytes((const char*)&values[0], &out[0], num_values, sizeof(double));
+}
+
+void Avida::Output::ColumnFormat::DecodeDoubles(const std::vector<char>& in, int num_rows, std::vector<double>& values)
+{
+  values.resize(num_rows);
+  if (num_rows) untransposeBytes(&in[0], (char*)&values[0], num_rows, sizeof(double));
+}
+
+
+uint32_t Avida::Output::ColumnFormat::Compress(std::vector<char>& raw)
+{
+#ifdef AVIDA_ZLIB
+  if (raw.size()) {
+    uLongf stored_size = compressBound(raw.size());
+    std::vector<char> stored(stored_size);
+    if (compress2((Bytef*)&stored[0], &stored_size, (const Bytef*)&raw[0], raw.size(), Z_DEFAULT_COMPRESSION) == Z_OK &&
+        stored_size < raw.size()) {
+      stored.resize(stored_size);
+      raw.swap(stored);
+    }
+  }
+#endif
+  return raw.size();
+}
+
+bool Avida::Output::ColumnFormat::Decompress(const std::vector<char>& stored, uint32_t raw_size, std::vector<char>& raw)
+{
+  if (stored.size() == raw_size) {
+    raw = stored;
+    return true;
+  }
+
+#ifdef AVIDA_ZLIB
+  raw.resize(raw_size);
+  uLongf size = raw_size;
+  if (uncompress((Bytef*)&raw[0], &size, (const Bytef*)&stored[0], stored.size()) != Z_OK) return false;
+  return (size == raw_size);
+#else
+  return false;
+#endif
+}
+
+
+bool Avida::Output::ColumnFormat::Seek(FILE* fp, uint64_t offset)
+{
+#if APTO_PLATFORM(WINDOWS)
+  return (_fseeki64(fp, offset, SEEK_SET) == 0);
+#else
+  return (fseeko(fp, (off_t)offset, SEEK_SET) == 0);
+#endif
+}
+
+bool Avida::Output::ColumnFormat::Truncate(FILE* fp, uint64_t size)
+{
+  if (fflush(fp) != 0) return false;
+#if APTO_PLATFORM(WINDOWS)
+  return (_chsize_s(_fileno(fp), size) == 0);
+#else
+  return (ftruncate(fileno(fp), (off_t)size) == 0);
+#endif
+}
@@ -89,13 +89,24 @@ Avida::Output::FilePtr Avida::Output::File::StaticWithPath(World* world, Apto::S
 
 
 Avida::Output::File::File(World* world, const OutputID& name, bool append)
-  : Socket(world, name), m_descr_written(false), m_num_cols(0)
+  : Socket(world, name), m_descr_written(false), m_num_cols(0), m_buffer(NULL)
 {
-  m_fp.open(name, (append) ? (std::ios::out | std::ios::app) : std::ios::out);
+  // With an asynchronous writer, m_fp formats into the writer's buffer and is never opened itself
+  WriterPtr writer = Output::Manager::Of(world)->AsyncWriter();
+  if (writer) m_buffer = writer->Open(name, append);
+  
+  if (m_buffer) m_fp.std::ios::rdbuf(m_buffer);
+  else m_fp.open(name, (append) ? (std::ios::out | std::ios::app) : std::ios::out);
   assert(m_fp.good());
 }
 
-Avida::Output::File::~File() { ; }
+Avida::Output::File::~File()
+{
+  if (m_buffer) {
+    m_fp.std::ios::rdbuf(NULL);
+    delete m_buffer;
+  }
+}
 
 
 
@@ -254,5 +265,6 @@ void Avida::Output::File::Endl()
 
 void Avida::Output::File::Flush()
 {
-  m_fp.flush();
+  if (m_buffer) m_buffer->HandOff(true);
+  else m_fp.flush();
 }
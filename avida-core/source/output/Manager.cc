@@ -112,6 +112,23 @@ void Avida::Output::Manager::FlushAll()
     (*it.Get())->Flush();
   }
   m_mutex.Unlock();
+  
+  if (m_writer) m_writer->Wait();
+}
+
+void Avida::Output::Manager::HandOffAll()
+{
+  if (!m_writer) return;
+  
+  Apto::MutexAutoLock lock(m_mutex);
+  for (Apto::Map<OutputID, SocketWeakRef>::ValueIterator it = m_sockets.Values(); it.Next();) {
+    (*it.Get())->Flush();
+  }
+}
+
+void Avida::Output::Manager::EnableAsyncWriter(int num_blocks, int block_size)
+{
+  if (!m_writer) m_writer = WriterPtr(new Writer(num_blocks, block_size));
 }
 
 
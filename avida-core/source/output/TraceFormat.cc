@@ -0,0 +1,138 @@
+/*
+ *  output/TraceFormat.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/private/output/TraceFormat.h"
+
+#include <cstring>
+#include <vector>
+
+
+const char Avida::Output::TraceFormat::FILE_MAGIC[8] = { '\0', 'A', 'V', 'D', 'T', 'R', 'C', '1' };
+
+
+// Entries decoded per read
+static const int DECODE_BATCH = 1024;
+
+
+void Avida::Output::TraceFormat::PrintStatus(std::ostream& fp, const sStatus& status, const char* inst_name)
+{
+  // basic status info
+  fp << status.cycle << " ";
+  if (status.layout != LAYOUT_EXPERIMENTAL) fp << status.micro_op << " ";
+  fp << status.update << " ";
+  if (status.layout == LAYOUT_GP8) {
+    fp << status.queue_eat << " ";
+    fp << status.queue_move << " ";
+    fp << status.queue_rotate;
+    fp << (status.queue_rotate_reverse ? " (-" : " (");
+    fp << status.queue_rotate_num << ") ";
+  }
+  for (int i = 0; i < status.num_registers; i++) {
+    fp << status.registers[i] << " ";
+    fp << "(" << status.reg_origins[i] << ") ";
+  }
+  // genome loc info
+  fp << status.thread << " ";
+  for (int i = 0; i < 4; i++) fp << status.heads[i] << " ";
+  // last output
+  fp << status.last_output << " ";
+  // phenotype/org status info
+  fp << status.merit << " ";
+  fp << status.bonus << " ";
+  fp << status.forage_target << " ";
+  fp << status.group << " ";
+  // environment info / things that affect movement
+  fp << status.cell << " ";
+  if (status.use_avatar) fp << status.av_cell << " ";
+  fp << status.facing << " ";
+  fp << status.faced_occupied << " ";
+  fp << static_cast<int>(status.faced_hill) << " ";
+  fp << static_cast<int>(status.faced_wall) << " ";
+  // instruction about to be executed, and any trailing nops
+  fp << inst_name << " ";
+  if (status.num_nops) fp.write(status.nops, status.num_nops) << " ";
+  else fp << "NoMods" << " ";
+}
+
+
+bool Avida::Output::TraceFormat::Decode(FILE* in, std::ostream& out, std::string& error)
+{
+  // The text header is copied through up to the NUL that starts the binary part
+  int ch;
+  while ((ch = fgetc(in)) != EOF && ch != '\0') out.put(static_cast<char>(ch));
+  if (ch == EOF) {
+    error = "no binary trace data found";
+    return false;
+  }
+
+  sFileHeader header;
+  header.magic[0] = '\0';
+  if (fread(header.magic + 1, sizeof(header) - 1, 1, in) != 1 || memcmp(header.magic, FILE_MAGIC, 8) != 0) {
+    error = "not a binary trace file";
+    return false;
+  }
+  if (header.byte_order != BYTE_ORDER_MARK) {
+    error = "trace was written with a different byte order";
+    return false;
+  }
+  if (header.version != VERSION || header.entry_size != sizeof(sEntry)) {
+    error = "unsupported trace format version";
+    return false;
+  }
+
+  std::vector<std::string> inst_names(header.num_insts);
+  for (uint32_t i = 0; i < header.num_insts; i++) {
+    uint32_t name_size = 0;
+    if (fread(&name_size, sizeof(name_size), 1, in) != 1) {
+      error = "truncated instruction names";
+      return false;
+    }
+    inst_names[i].resize(name_size);
+    if (name_size && fread(&inst_names[i][0], name_size, 1, in) != 1) {
+      error = "truncated instruction names";
+      return false;
+    }
+  }
+
+  std::vector<sEntry> entries(DECODE_BATCH);
+  size_t num_read;
+  while ((num_read = fread(&entries[0], sizeof(sEntry), DECODE_BATCH, in)) > 0) {
+    for (size_t i = 0; i < num_read; i++) {
+      const sEntry& entry = entries[i];
+      if (entry.has_status) {
+        if (entry.status.num_registers > MAX_REGISTERS || entry.status.num_nops > MAX_NOPS) {
+          error = "corrupt trace entry";
+          return false;
+        }
+        const uint32_t inst = static_cast<uint32_t>(entry.status.inst);
+        PrintStatus(out, entry.status, (inst < inst_names.size()) ? inst_names[inst].c_str() : "?");
+      }
+      if (entry.has_success) out << entry.exec_success << "\n";
+    }
+    if (num_read < static_cast<size_t>(DECODE_BATCH)) break;
+  }
+  if (ferror(in)) {
+    error = "error reading trace entries";
+    return false;
+  }
+
+  return true;
+}
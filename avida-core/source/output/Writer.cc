@@ -0,0 +1,326 @@
+/*
+ *  output/Writer.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/Writer.h"
+
+#include <cstdio>
+
+#if APTO_PLATFORM(WINDOWS)
+# include <ctime>
+#else
+# include <sys/time.h>
+#endif
+
+#ifdef AVIDA_ZLIB
+# include <zlib.h>
+#endif
+
+
+struct Avida::Output::Writer::Target
+{
+  OutputID output_id;
+  FILE* fp;
+#ifdef AVIDA_ZLIB
+  gzFile gz;
+#endif
+};
+
+
+Avida::Output::Writer::Writer(int num_blocks, int block_size)
+  : m_block_size(block_size), m_free(num_blocks), m_num_free(num_blocks), m_queue(num_blocks), m_queue_head(0)
+  , m_queue_count(0), m_busy(false), m_terminate(false)
+{
+  assert(num_blocks > 0);
+  for (int i = 0; i < num_blocks; i++) m_free[i] = newBlock();
+  ResetStats();
+
+  m_thread = new IOThread(this);
+  m_thread->Start();
+}
+
+Avida::Output::Writer::~Writer()
+{
+  // The I/O thread drains the queue before exiting
+  m_mutex.Lock();
+  m_terminate = true;
+  m_mutex.Unlock();
+  m_work_cond.Signal();
+
+  m_thread->Join();
+  delete m_thread;
+
+  for (int i = 0; i < m_num_free; i++) deleteBlock(m_free[i]);
+}
+
+
+Avida::Output::Writer::Buffer* Avida::Output::Writer::Open(const OutputID& output_id, bool append)
+{
+  // A previous stream to the same file must be closed first, otherwise its remaining writes could land after this open
+  m_mutex.Lock();
+  while (m_closing.Has(output_id)) m_idle_cond.Wait(m_mutex);
+  m_mutex.Unlock();
+
+  Target* target = new Target;
+  target->output_id = output_id;
+  target->fp = NULL;
+#ifdef AVIDA_ZLIB
+  target->gz = NULL;
+  if (output_id.GetSize() > 3 && output_id.Substring(output_id.GetSize() - 3, 3) == ".gz") {
+    target->gz = gzopen(output_id, append ? "ab" : "wb");
+    if (target->gz == NULL) {
+      delete target;
+      return NULL;
+    }
+  } else
+#endif
+  {
+    target->fp = fopen(output_id, append ? "a" : "w");
+    if (target->fp == NULL) {
+      delete target;
+      return NULL;
+    }
+  }
+
+  WriterPtr self(this);
+  AddReference();  // explicitly add reference, since this is internally creating a smart pointer to itself
+  return new Buffer(self, target);
+}
+
+
+void Avida::Output::Writer::Wait()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  while (m_queue_count > 0 || m_busy) m_idle_cond.Wait(m_mutex);
+}
+
+
+Avida::Output::Writer::Stats Avida::Output::Writer::GetStats()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_stats;
+}
+
+int Avida::Output::Writer::GetNumQueued()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_queue_count;
+}
+
+void Avida::Output::Writer::ResetStats()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  m_stats.blocks_written = 0;
+  m_stats.bytes_written = 0.0;
+  m_stats.max_queued = 0;
+  m_stats.stalls = 0;
+  m_stats.stall_time = 0.0;
+  m_stats.write_errors = 0;
+}
+
+
+Avida::Output::Writer::Block* Avida::Output::Writer::newBlock()
+{
+  Block* block = new Block;
+  block->data = new char[m_block_size];
+  block->size = 0;
+  block->target = NULL;
+  block->flush = false;
+  block->close = false;
+  return block;
+}
+
+void Avida::Output::Writer::deleteBlock(Block* block)
+{
+  delete [] block->data;
+  delete block;
+}
+
+
+// Queues a filled block.  Unless the file is closing, a replacement block is taken from the pool, waiting for the I/O
+// thread to free one if necessary.  The total number of blocks is the pool size plus one per open file.
+Avida::Output::Writer::Block* Avida::Output::Writer::submit(Block* block, Target* target, bool flush, bool close)
+{
+  block->target = target;
+  block->flush = flush;
+  block->close = close;
+
+  Apto::MutexAutoLock lock(m_mutex);
+
+  if (close) m_closing[target->output_id]++;
+  pushQueue(block);
+  m_work_cond.Signal();
+
+  if (close) return NULL;
+
+  if (m_num_free == 0) {
+    m_stats.stalls++;
+    const double start = currentTime();
+    while (m_num_free == 0) m_free_cond.Wait(m_mutex);
+    m_stats.stall_time += currentTime() - start;
+  }
+
+  Block* replacement = m_free[--m_num_free];
+  replacement->size = 0;
+  return replacement;
+}
+
+void Avida::Output::Writer::pushQueue(Block* block)
+{
+  if (m_queue_count == m_queue.GetSize()) {
+    // Unwrap the circular queue into a larger array
+    Apto::Array<Block*> queue(m_queue.GetSize() * 2);
+    for (int i = 0; i < m_queue_count; i++) queue[i] = m_queue[(m_queue_head + i) % m_queue.GetSize()];
+    m_queue = queue;
+    m_queue_head = 0;
+  }
+
+  m_queue[(m_queue_head + m_queue_count) % m_queue.GetSize()] = block;
+  m_queue_count++;
+  if (m_queue_count > m_stats.max_queued) m_stats.max_queued = m_queue_count;
+}
+
+
+void Avida::Output::Writer::processBlocks()
+{
+  m_mutex.Lock();
+  while (true) {
+    while (m_queue_count == 0 && !m_terminate) m_work_cond.Wait(m_mutex);
+    if (m_queue_count == 0) break;  // terminating, and all queued blocks have been written
+
+    Block* block = m_queue[m_queue_head];
+    m_queue_head = (m_queue_head + 1) % m_queue.GetSize();
+    m_queue_count--;
+    m_busy = true;
+    m_mutex.Unlock();
+
+    writeBlock(*block);
+
+    m_mutex.Lock();
+    m_busy = false;
+    m_stats.blocks_written++;
+    m_stats.bytes_written += block->size;
+
+    if (block->close) {
+      // The closing file's block is retired rather than returned to the pool, keeping the pool size fixed
+      int& closing = m_closing[block->target->output_id];
+      if (--closing == 0) m_closing.Remove(block->target->output_id);
+      delete block->target;
+      deleteBlock(block);
+    } else {
+      m_free[m_num_free++] = block;
+      m_free_cond.Signal();
+    }
+    m_idle_cond.Broadcast();
+  }
+  m_mutex.Unlock();
+}
+
+void Avida::Output::Writer::writeBlock(Block& block)
+{
+  Target* target = block.target;
+  bool ok = true;
+
+#ifdef AVIDA_ZLIB
+  if (target->gz) {
+    if (block.size) ok = (gzwrite(target->gz, block.data, block.size) == block.size);
+    if (block.close) {
+      if (gzclose(target->gz) != Z_OK) ok = false;
+    } else if (block.flush) {
+      gzflush(target->gz, Z_SYNC_FLUSH);
+    }
+  } else
+#endif
+  {
+    if (block.size) ok = (fwrite(block.data, 1, block.size, target->fp) == (size_t)block.size);
+    if (block.close) {
+      if (fclose(target->fp) != 0) ok = false;
+    } else if (block.flush) {
+      fflush(target->fp);
+    }
+  }
+
+  if (!ok) {
+    m_mutex.Lock();
+    m_stats.write_errors++;
+    m_mutex.Unlock();
+  }
+}
+
+
+double Avida::Output::Writer::currentTime()
+{
+#if APTO_PLATFORM(WINDOWS)
+  return (double)clock() / (double)CLOCKS_PER_SEC;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec + (double)tv.tv_usec * 1.0e-6;
+#endif
+}
+
+
+void Avida::Output::Writer::IOThread::Run()
+{
+  m_writer->processBlocks();
+}
+
+
+
+Avida::Output::Writer::Buffer::Buffer(WriterPtr writer, Target* target)
+  : m_writer(writer), m_target(target), m_block(writer->newBlock()), m_unflushed(false)
+{
+  setp(m_block->data, m_block->data + m_writer->m_block_size);
+}
+
+Avida::Output::Writer::Buffer::~Buffer()
+{
+  m_block->size = pptr() - pbase();
+  m_writer->submit(m_block, m_target, false, true);
+}
+
+
+void Avida::Output::Writer::Buffer::HandOff(bool flush)
+{
+  m_block->size = pptr() - pbase();
+  if (m_block->size == 0 && (!flush || !m_unflushed)) return;
+
+  m_block = m_writer->submit(m_block, m_target, flush, false);
+  m_unflushed = !flush;
+  setp(m_block->data, m_block->data + m_writer->m_block_size);
+}
+
+
+int Avida::Output::Writer::Buffer::overflow(int c)
+{
+  HandOff(false);
+  if (c == traits_type::eof()) return traits_type::not_eof(c);
+
+  *pptr() = traits_type::to_char_type(c);
+  pbump(1);
+  return c;
+}
+
+int Avida::Output::Writer::Buffer::sync()
+{
+  // Stream flushes (i.e. std::endl) do not force a write, data is handed off when the block fills, on File::Flush()
+  // and at the end of every update (Manager::HandOffAll)
+  return 0;
+}
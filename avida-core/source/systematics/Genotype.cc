@@ -33,6 +33,10 @@
 #include "cStringList.h"
 #include "cStringUtil.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
 
 static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_copied_size("last_copied_size");
 static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_executed_size("last_executed_size");
@@ -183,16 +187,17 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
 }
 
 
-Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, void* prop_p)
+Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, const LegacyLoadFields& fields)
 : Group(in_id)
 , m_mgr(mgr)
 , m_handle(NULL)
 , m_name("001-no_name")
 , m_threshold(false)
 , m_active(false)
-, m_update_born(-1)
-, m_update_deactivated(-1)
-, m_depth(0)
+, m_generation_born(fields.gen_born)
+, m_update_born(fields.update_born)
+, m_update_deactivated(fields.update_deactivated)
+, m_depth(fields.depth)
 , m_active_offspring_genotypes(0)
 , m_num_organisms(0)
 , m_last_num_organisms(0)
@@ -203,40 +208,21 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 , m_task_counts(mgr->NumEnvironmentActionTriggers())
 , m_prop_map(NULL)
 {
-  Apto::Map<Apto::String, Apto::String>& props = *(*static_cast<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >*>(prop_p));
-  
   m_src.transmission_type = DIVISION;
   m_src.external = true;
-  m_src.arguments = props.Get("src_args");
+  m_src.arguments = fields.src_args;
   if (m_src.arguments == "(none)") m_src.arguments = "";
   
   HashPropertyMap prop_map;
-  cString inst_set = (const char*)props.Get("inst_set");
+  cString inst_set = (const char*)fields.inst_set;
   if (inst_set == "") inst_set = "(default)";
   
   cHardwareManager::SetupPropertyMap(prop_map, (const char*)inst_set);
-  m_genome = Avida::Genome(Apto::StrAs(props.Get("hw_type")), prop_map, GeneticRepresentationPtr(new InstructionSequence((const char*)props.Get("sequence"))));
-  
-  if (props.Has("gen_born")) {
-    m_generation_born = Apto::StrAs(props.Get("gen_born"));
-  } else {
-    m_generation_born = -1;
-  }
-  assert(props.Has("update_born"));
-  m_update_born = Apto::StrAs(props.Get("update_born"));
-  if (props.Has("update_deactivated")) {
-    m_update_deactivated = Apto::StrAs(props.Get("update_deactivated"));
-  } else {
-    m_update_deactivated = -1;
-  }
-  assert(props.Has("depth"));
-  m_depth = Apto::StrAs(props.Get("depth"));
+  GeneticRepresentationPtr seq = fields.sequence;
+  if (!seq) seq = GeneticRepresentationPtr(new InstructionSequence);
+  m_genome = Avida::Genome(fields.hw_type, prop_map, seq);
   
-  if (props.Has("parents")) {
-    m_parent_str = (const char*)props.Get("parents");
-  } else if (props.Has("parent_id")) { // Backwards compatible load
-    m_parent_str = (const char*)props.Get("parent_id");
-  }
+  m_parent_str = fields.parents;
   if (m_parent_str == "(none)") m_parent_str = "";
   cStringList parents((const char*)m_parent_str,',');
   
@@ -344,11 +330,23 @@ bool Avida::Systematics::Genotype::Serialize(ArchivePtr) const
 bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
 {
   Avida::Output::File& df = *static_cast<Avida::Output::File*>(dfp);
-  df.Write(m_id, "ID", "id");
   
-  df.Write(m_src.AsString(), "Source", "src");
+  Apto::Array<LegacyField, Apto::Smart> fields;
+  LegacySaveFields(fields);
+  for (int i = 0; i < fields.GetSize(); i++) df.Write(fields[i].value, fields[i].descr, fields[i].key);
+  
+  return false;
+}
+
+void Avida::Systematics::Genotype::LegacySaveFields(Apto::Array<LegacyField, Apto::Smart>& fields) const
+{
+  fields.Resize(0);
   
-  df.Write(m_src.arguments.GetSize() ? (const char*)m_src.arguments : "(none)", "Source Args", "src_args");
+  fields.Push(LegacyField("id", "ID", Apto::AsStr(m_id)));
+  
+  fields.Push(LegacyField("src", "Source", m_src.AsString()));
+  
+  fields.Push(LegacyField("src_args", "Source Args", m_src.arguments.GetSize() ? m_src.arguments : Apto::String("(none)")));
   
   cString str("");
   if (m_parents.GetSize()) {
@@ -357,26 +355,50 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
       str += cStringUtil::Stringf(",%d", m_parents[i]->ID());
     }
   }
-  df.Write((str.GetSize()) ? str : "(none)", "Parent ID(s)", "parents");
+  fields.Push(LegacyField("parents", "Parent ID(s)", (str.GetSize()) ? (const char*)str : "(none)"));
   
-  df.Write(m_num_organisms, "Number of currently living organisms", "num_units");
-  df.Write(m_total_organisms, "Total number of organisms that ever existed", "total_units");
+  fields.Push(LegacyField("num_units", "Number of currently living organisms", Apto::AsStr(m_num_organisms)));
+  fields.Push(LegacyField("total_units", "Total number of organisms that ever existed", Apto::AsStr(m_total_organisms)));
   
   ConstInstructionSequencePtr seq;
   seq.DynamicCastFrom(m_genome.Representation());
-  df.Write(seq->GetSize(), "Genome Length", "length");
-  
-  df.Write(m_merit.Average(), "Average Merit", "merit");
-  df.Write(m_gestation_time.Average(), "Average Gestation Time", "gest_time");
-  df.Write(m_fitness.Average(), "Average Fitness", "fitness");
-  
-  df.Write(m_generation_born, "Generation Born", "gen_born");
-  df.Write(m_update_born, "Update Born", "update_born");
-  df.Write(m_update_deactivated, "Update Deactivated", "update_deactivated");
-  df.Write(m_depth, "Phylogenetic Depth", "depth");
-  m_genome.LegacySave(dfp);
-  
-  return false;
+  fields.Push(LegacyField("length", "Genome Length", Apto::AsStr(seq->GetSize())));
+  
+  // Doubles are formatted with the stream defaults, matching Output::File
+  std::ostringstream merit, gest_time, fitness;
+  merit << m_merit.Average();
+  gest_time << m_gestation_time.Average();
+  fitness << m_fitness.Average();
+  fields.Push(LegacyField("merit", "Average Merit", merit.str().c_str()));
+  fields.Push(LegacyField("gest_time", "Average Gestation Time", gest_time.str().c_str()));
+  fields.Push(LegacyField("fitness", "Average Fitness", fitness.str().c_str()));
+  
+  fields.Push(LegacyField("gen_born", "Generation Born", Apto::AsStr(m_generation_born)));
+  fields.Push(LegacyField("update_born", "Update Born", Apto::AsStr(m_update_born)));
+  fields.Push(LegacyField("update_deactivated", "Update Deactivated", Apto::AsStr(m_update_deactivated)));
+  fields.Push(LegacyField("depth", "Phylogenetic Depth", Apto::AsStr(m_depth)));
+  
+  // Genome fields, as written by Genome::LegacySave
+  fields.Push(LegacyField("hw_type", "Hardware Type ID", Apto::AsStr(m_genome.HardwareType())));
+  fields.Push(LegacyField("inst_set", "Inst Set Name", m_genome.Properties().Get("instset").StringValue()));
+  fields.Push(LegacyField("sequence", "Genome Sequence", m_genome.Representation()->AsString()));
+}
+
+
+bool Avida::Systematics::Genotype::LegacyLoadFields::Set(const char* key, const char* value)
+{
+  if (strcmp(key, "src_args") == 0) src_args = value;
+  else if (strcmp(key, "hw_type") == 0) hw_type = atoi(value);
+  else if (strcmp(key, "inst_set") == 0) inst_set = value;
+  else if (strcmp(key, "sequence") == 0) sequence = GeneticRepresentationPtr(new InstructionSequence(value));
+  else if (strcmp(key, "gen_born") == 0) gen_born = atoi(value);
+  else if (strcmp(key, "update_born") == 0) update_born = atoi(value);
+  else if (strcmp(key, "update_deactivated") == 0) update_deactivated = atoi(value);
+  else if (strcmp(key, "depth") == 0) depth = atoi(value);
+  else if (strcmp(key, "parents") == 0) parents = value;
+  else if (strcmp(key, "parent_id") == 0) { if (!parents.GetSize()) parents = value; } // Backwards compatible load
+  else return false;
+  return true;
 }
 
 
@@ -40,6 +40,9 @@ Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID&
   : Arbiter(role)
   , m_threshold(threshold)
   , m_disable_class(disable_class)
+  , m_active_table(INITIAL_TABLE_SIZE)
+  , m_active_used(0)
+  , m_active_removed(0)
   , m_active_sz(1)
   , m_coalescent(NULL)
   , m_best(0)
@@ -86,16 +89,16 @@ void Avida::Systematics::GenotypeArbiter::PerformUpdate(Context&, Update current
 {
   m_cur_update = current_update + 1; // +1 since PerformUpdate happens at end of updates, but m_cur_update is used during
   
-  if (m_active_sz.GetSize() < HASH_SIZE) {
+  if (m_active_sz.GetSize() < m_active_table.GetSize()) {
     for (int i = 0; i < m_active_sz.GetSize(); i++) {
       Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
       while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
     }
   } else {
-    for (int i = 0; i < HASH_SIZE; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[i].Begin());
-      while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
-    }    
+    for (int i = 0; i < m_active_table.GetSize(); i++) {
+      GenotypePtr genotype = m_active_table[i].genotype;
+      if (genotype && genotype->IsThreshold()) genotype->UpdateReset();
+    }
   }
 
   Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
@@ -130,10 +133,48 @@ bool Avida::Systematics::GenotypeArbiter::LegacySave(void* dfp) const
   return true;
 }
 
+void Avida::Systematics::GenotypeArbiter::GetHistoricGenotypes(Apto::Array<GenotypePtr, Apto::Smart>& genotypes) const
+{
+  genotypes.Resize(0);
+  Apto::List<GenotypePtr, Apto::SparseVector>::ConstIterator list_it(m_historic.Begin());
+  while (list_it.Next() != NULL) genotypes.Push(*list_it.Get());
+}
+
+// Genotype fields from a text population save, keyed by field name
+static void legacyLoadFields(void* prop_p, Avida::Systematics::Genotype::LegacyLoadFields& fields)
+{
+  const Apto::Map<Apto::String, Apto::String>& props = *(*static_cast<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >*>(prop_p));
+  assert(props.Has("update_born"));
+  assert(props.Has("depth"));
+  
+  for (Apto::Map<Apto::String, Apto::String>::ConstIterator it = props.Begin(); it.Next();) {
+    fields.Set((const char*)it.Get()->Value1(), (const char*)*it.Get()->Value2());
+  }
+}
+
 Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(void* props)
 {
-  GenotypePtr g(new Genotype(thisPtr(), m_next_id++, props));
+  Genotype::LegacyLoadFields fields;
+  legacyLoadFields(props, fields);
+  return LegacyLoad(fields);
+}
+
+Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(const Genotype::LegacyLoadFields& fields)
+{
+  GenotypePtr g(new Genotype(thisPtr(), m_next_id++, fields));
   m_historic.Push(g, &g->m_handle);
+  m_id_index.Set(g->ID(), g);
+  return g;
+}
+
+Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(void* props, int group_id)
+{
+  Genotype::LegacyLoadFields fields;
+  legacyLoadFields(props, fields);
+  GenotypePtr g(new Genotype(thisPtr(), group_id, fields));
+  m_historic.Push(g, &g->m_handle);
+  m_id_index.Set(group_id, g);
+  if (group_id >= m_next_id) m_next_id = group_id + 1;
   return g;
 }
 
@@ -141,14 +182,8 @@ Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(voi
 
 Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::Group(GroupID g_id)
 {
-  for (int i = m_best; i >= 0; i--) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-    while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
-  }
-  
-  Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-  while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
-  
+  GenotypePtr found;
+  if (m_id_index.Get(g_id, found)) return found;
   return GroupPtr(NULL);
 }
 
@@ -283,7 +318,7 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   ConstInstructionSequencePtr seq;
   seq.DynamicCastFrom(u->UnitGenome().Representation());
   assert(seq);
-  int list_num = hashGenome(*seq);
+  const uint64_t hash = seq->Hash();
   
   GenotypePtr found;
 
@@ -291,41 +326,28 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   if (hints && hints->Get("id", gid_str)) {
     int gid = Apto::StrAs(gid_str);
     
-    // Search all lists attempting to locate the referenced genotype by ID
-    for (int i = 0; i < m_active_sz.GetSize() && !found; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          found->NotifyNewUnit(u);
-          break;
-        }
-      }
-    }
-    
-    if (!found) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          seq.DynamicCastFrom(found->GroupGenome().Representation());
-          assert(seq);
-          
-          m_active_hash[hashGenome(*seq)].Push(found);
-          found->m_handle->Remove(); // Remove from historic list
-          resizeActiveList(found->NumUnits());
-          m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
-          found->Reactivate();
-          found->NotifyNewUnit(u);
-          m_tot_genotypes++;
-          if (found->NumUnits() > m_best) {
-            m_best = found->NumUnits();
-            found->SetThreshold();
-            found->SetName(nameGenotype(seq->GetSize()));
-            m_num_threshold++;
-            m_tot_threshold++;
-            notifyListeners(found, EVENT_ADD_THRESHOLD);
-          }          
+    // Locate the referenced genotype by ID, reactivating it if it is currently historic
+    if (m_id_index.Get(gid, found)) {
+      if (found->IsActive()) {
+        found->NotifyNewUnit(u);
+      } else {
+        seq.DynamicCastFrom(found->GroupGenome().Representation());
+        assert(seq);
+        
+        insertActive(found, seq->Hash());
+        found->m_handle->Remove(); // Remove from historic list
+        resizeActiveList(found->NumUnits());
+        m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
+        found->Reactivate();
+        found->NotifyNewUnit(u);
+        m_tot_genotypes++;
+        if (found->NumUnits() > m_best) {
+          m_best = found->NumUnits();
+          found->SetThreshold();
+          found->SetName(nameGenotype(seq->GetSize()));
+          m_num_threshold++;
+          m_tot_threshold++;
+          notifyListeners(found, EVENT_ADD_THRESHOLD);
         }
       }
     }
@@ -333,14 +355,8 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   
   // No hints or unable to locate hinted genome, search for a matching genotype
   if (!found) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[list_num].Begin());
-    while (list_it.Next() != NULL) {
-      if ((*list_it.Get())->Matches(u)) {
-        found = *list_it.Get();
-        found->NotifyNewUnit(u);
-        break;
-      }
-    }
+    found = findActive(u, hash);
+    if (found) found->NotifyNewUnit(u);
   }
   
   // No matching genotype (hinted or otherwise), so create a new one
@@ -350,7 +366,8 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
     } else {
       found = GenotypePtr(new Genotype(thisPtr(), m_next_id++, u, m_cur_update, ConstGroupMembershipPtr(NULL)));
     }
-    m_active_hash[list_num].Push(found);
+    insertActive(found, hash);
+    m_id_index.Set(found->ID(), found);
     resizeActiveList(found->NumUnits());
     m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
     m_tot_genotypes++;
@@ -468,15 +485,77 @@ void Avida::Systematics::GenotypeArbiter::setupProvidedData(World* world)
 
 
 
-unsigned int Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome) const
+uint64_t Avida::Systematics::GenotypeArbiter::hashGenome(GenotypePtr genotype) const
 {
-  unsigned int total = 0;
-  
-  for (int i = 0; i < genome.GetSize(); i++) {
-    total += (genome[i].GetOp() + 3) * i;
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genotype->GroupGenome().Representation());
+  assert(seq);
+  return seq->Hash();
+}
+
+void Avida::Systematics::GenotypeArbiter::insertActive(GenotypePtr genotype, uint64_t hash)
+{
+  // Keep the table at most 3/4 full, counting tombstones, since they lengthen probe sequences just as live entries do
+  if ((m_active_used + m_active_removed + 1) * 4 > m_active_table.GetSize() * 3) {
+    int capacity = m_active_table.GetSize();
+    if ((m_active_used + 1) * 2 > capacity) capacity *= 2;
+    rehashActive(capacity);
   }
   
-  return total % HASH_SIZE;
+  const int mask = m_active_table.GetSize() - 1;
+  int idx = (int)(hash & mask);
+  while (m_active_table[idx].genotype) idx = (idx + 1) & mask;
+  
+  ActiveEntry& entry = m_active_table[idx];
+  if (entry.removed) m_active_removed--;
+  entry.hash = hash;
+  entry.genotype = genotype;
+  entry.removed = false;
+  m_active_used++;
+}
+
+void Avida::Systematics::GenotypeArbiter::removeActive(GenotypePtr genotype, uint64_t hash)
+{
+  const int mask = m_active_table.GetSize() - 1;
+  for (int idx = (int)(hash & mask); m_active_table[idx].genotype || m_active_table[idx].removed; idx = (idx + 1) & mask) {
+    ActiveEntry& entry = m_active_table[idx];
+    if (entry.genotype == genotype) {
+      entry.genotype = GenotypePtr(NULL);
+      entry.removed = true;
+      m_active_used--;
+      m_active_removed++;
+      return;
+    }
+  }
+  assert(false); // active genotypes must be in the table
+}
+
+Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::findActive(UnitPtr u, uint64_t hash) const
+{
+  const int mask = m_active_table.GetSize() - 1;
+  for (int idx = (int)(hash & mask); m_active_table[idx].genotype || m_active_table[idx].removed; idx = (idx + 1) & mask) {
+    const ActiveEntry& entry = m_active_table[idx];
+    if (entry.genotype && entry.hash == hash && entry.genotype->Matches(u)) return entry.genotype;
+  }
+  return GenotypePtr(NULL);
+}
+
+void Avida::Systematics::GenotypeArbiter::rehashActive(int capacity)
+{
+  Apto::Array<ActiveEntry> old_table(m_active_table);
+  m_active_table.ResizeClear(capacity);
+  for (int i = 0; i < capacity; i++) m_active_table[i] = ActiveEntry();
+  m_active_used = 0;
+  m_active_removed = 0;
+  
+  const int mask = capacity - 1;
+  for (int i = 0; i < old_table.GetSize(); i++) {
+    if (!old_table[i].genotype) continue;
+    int idx = (int)(old_table[i].hash & mask);
+    while (m_active_table[idx].genotype) idx = (idx + 1) & mask;
+    m_active_table[idx] = old_table[i];
+    m_active_used++;
+  }
 }
 
 Apto::String Avida::Systematics::GenotypeArbiter::nameGenotype(int size)
@@ -500,10 +579,7 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   if (genotype->ActiveReferenceCount()) return;    
   
   if (genotype->IsActive()) {
-    ConstInstructionSequencePtr seq;
-    seq.DynamicCastFrom(genotype->GroupGenome().Representation());
-    int list_num = hashGenome(*seq);
-    m_active_hash[list_num].Remove(genotype);
+    removeActive(genotype, hashGenome(genotype));
     genotype->Deactivate(m_cur_update);
     m_historic.Push(genotype, &genotype->m_handle);
   }
@@ -530,6 +606,7 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   
   delete genotype->m_handle;
   genotype->m_handle = NULL;
+  m_id_index.Remove(genotype->ID());
 }
 
 void Avida::Systematics::GenotypeArbiter::updateCoalescent()
@@ -0,0 +1,144 @@
+/*
+ *  main.cc
+ *  avida-columns
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Reads columnar data files written by the RecordColumns action.
+//
+//   avida-columns <file>                                   list the columns, row count and update range
+//   avida-columns <file> [-u first:last] [-d sep] <column> ...
+//                                                          print the update followed by the selected columns, one row
+//                                                          per recorded update (columns by name or index)
+
+#include "avida/output/ColumnFileReader.h"
+
+#include "cUserFeedback.h"
+
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+
+static void printFeedback(const cUserFeedback& feedback)
+{
+  for (int i = 0; i < feedback.GetNumMessages(); i++) {
+    switch (feedback.GetMessageType(i)) {
+      case cUserFeedback::UF_ERROR:    cerr << "error: "; break;
+      case cUserFeedback::UF_WARNING:  cerr << "warning: "; break;
+      default: break;
+    }
+    cerr << feedback.GetMessage(i) << endl;
+  }
+}
+
+static void usage()
+{
+  cerr << "usage: avida-columns <file> [-u first:last] [-d separator] [column ...]" << endl;
+}
+
+static const char* typeName(Avida::Output::ColumnFile::ColumnType type)
+{
+  switch (type) {
+    case Avida::Output::ColumnFile::INT_COLUMN:    return "int";
+    case Avida::Output::ColumnFile::DOUBLE_COLUMN: return "double";
+    case Avida::Output::ColumnFile::STRING_COLUMN: return "string";
+  }
+  return "unknown";
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    usage();
+    return 1;
+  }
+
+  Avida::Update first = INT_MIN;
+  Avida::Update last = INT_MAX;
+  Apto::String separator(" ");
+  Apto::Array<Apto::String> column_args;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+      Apto::String range(argv[++i]);
+      Apto::String first_str = range.Pop(':');
+      if (first_str.GetSize()) first = Apto::StrAs(first_str);
+      if (range.GetSize()) last = Apto::StrAs(range);
+    } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+      separator = argv[++i];
+    } else if (argv[i][0] == '-') {
+      usage();
+      return 1;
+    } else {
+      column_args.Push(argv[i]);
+    }
+  }
+
+  cUserFeedback feedback;
+  Avida::Output::ColumnFileReader reader;
+  const bool opened = reader.Open(argv[1], feedback);
+  printFeedback(feedback);
+  if (!opened) return 1;
+
+  if (column_args.GetSize() == 0) {
+    cout << argv[1] << ": " << reader.NumRows() << " rows in " << reader.NumChunks() << " chunks";
+    if (reader.NumRows()) cout << ", updates " << reader.FirstUpdate() << " - " << reader.LastUpdate();
+    cout << endl;
+    for (int i = 0; i < reader.NumColumns(); i++) {
+      cout << "  " << i << ": " << (const char*)reader.ColumnName(i) << " (" << typeName(reader.ColumnDataType(i)) << ")" << endl;
+    }
+    return 0;
+  }
+
+  // Resolve the requested columns and read each of them over the update range
+  Apto::Array<Avida::Update, Apto::Smart> updates;
+  if (!reader.ReadUpdates(first, last, updates)) {
+    cerr << "error: unable to read updates" << endl;
+    return 1;
+  }
+
+  Apto::Array<Apto::Array<Apto::String, Apto::Smart> > columns(column_args.GetSize());
+  for (int c = 0; c < column_args.GetSize(); c++) {
+    int column = reader.ColumnIndex(column_args[c]);
+    if (column < 0 && column_args[c].GetSize() && column_args[c][0] >= '0' && column_args[c][0] <= '9') {
+      column = Apto::StrAs(column_args[c]);
+      if (column >= reader.NumColumns()) column = -1;
+    }
+    if (column < 0) {
+      cerr << "error: unknown column '" << (const char*)column_args[c] << "'" << endl;
+      return 1;
+    }
+    if (!reader.ReadStrings(column, first, last, columns[c])) {
+      cerr << "error: unable to read column '" << (const char*)column_args[c] << "'" << endl;
+      return 1;
+    }
+  }
+
+  cout << "update";
+  for (int c = 0; c < column_args.GetSize(); c++) cout << (const char*)separator << (const char*)column_args[c];
+  cout << endl;
+  for (int r = 0; r < updates.GetSize(); r++) {
+    cout << updates[r];
+    for (int c = 0; c < columns.GetSize(); c++) cout << (const char*)separator << (const char*)columns[c][r];
+    cout << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ *  main.cc
+ *  avida-trace
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Decodes binary mini traces (MINI_TRACE_FORMAT 1) into the text mini trace format.
+//
+//   avida-trace <file.trcb>                    print the text trace
+//   avida-trace <file.trcb> ... -o <dir>       write each trace into dir, named as the text trace (.trc) would be
+
+#include "avida/private/output/TraceFormat.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+static void usage()
+{
+  cerr << "usage: avida-trace <file.trcb> [file.trcb ...] [-o directory]" << endl;
+}
+
+static string textTraceName(const string& path, const string& dir)
+{
+  string name = path.substr(path.find_last_of('/') + 1);
+  if (name.size() > 5 && name.compare(name.size() - 5, 5, ".trcb") == 0) name.erase(name.size() - 1);
+  else name += ".trc";
+  return dir + "/" + name;
+}
+
+static bool decodeFile(const string& path, ostream& out)
+{
+  FILE* in = fopen(path.c_str(), "rb");
+  if (!in) {
+    cerr << "error: unable to open '" << path << "'" << endl;
+    return false;
+  }
+
+  string error;
+  const bool decoded = Avida::Output::TraceFormat::Decode(in, out, error);
+  fclose(in);
+  if (!decoded) cerr << "error: " << path << ": " << error << endl;
+  return decoded;
+}
+
+
+int main(int argc, char* argv[])
+{
+  vector<string> paths;
+  string out_dir;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      out_dir = argv[++i];
+    } else if (argv[i][0] == '-') {
+      usage();
+      return 1;
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty() || (paths.size() > 1 && out_dir.empty())) {
+    usage();
+    return 1;
+  }
+
+  int failed = 0;
+  for (size_t i = 0; i < paths.size(); i++) {
+    if (out_dir.empty()) {
+      if (!decodeFile(paths[i], cout)) failed++;
+      continue;
+    }
+
+    const string out_path = textTraceName(paths[i], out_dir);
+    ofstream out(out_path.c_str());
+    if (!out) {
+      cerr << "error: unable to write '" << out_path << "'" << endl;
+      failed++;
+      continue;
+    }
+    if (!decodeFile(paths[i], out)) failed++;
+  }
+
+  return (failed) ? 1 : 0;
+}
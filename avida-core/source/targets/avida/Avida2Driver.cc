@@ -26,6 +26,7 @@
 
 #include "avida/core/Context.h"
 #include "avida/core/World.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Group.h"
 
 #include "cAnalyze.h"
@@ -68,6 +69,7 @@ void Avida2Driver::Run()
     cAnalyze& analyze = m_world->GetAnalyze();
     analyze.RunFile(m_world->GetConfig().ANALYZE_FILE.Get());
     if (m_world->GetConfig().ANALYZE_MODE.Get() == 2) analyze.RunInteractive();
+    Avida::Output::Manager::Of(m_new_world)->FlushAll();
     return;
   }
   
@@ -84,6 +86,7 @@ void Avida2Driver::Run()
       m_world->GetConfig().THREAD_SLICING_METHOD.Get() != 1 && !m_world->GetConfig().IMPLICIT_REPRO_END.Get() && point_mut_prob == 0.0) {
     ActiveProcessStep = &cPopulation::ProcessStepSpeculative;
   }
+  const int burst_size = m_world->GetConfig().BURST_SIZE.Get();
   
   cAvidaContext& ctx = m_world->GetDefaultContext();
   Avida::Context new_ctx(this, &m_world->GetRandom());
@@ -108,11 +111,18 @@ void Avida2Driver::Run()
     const int UD_size = m_world->CalculateUpdateSize();
     const double step_size = 1.0 / (double) UD_size;
     
-    for (int i = 0; i < UD_size; i++) {
-      if(population.GetNumOrganisms() == 0) {
-        break;
+    if (burst_size > 1) {
+      for (int i = 0; i < UD_size;) {
+        if (population.GetNumOrganisms() == 0) break;
+        i += population.ProcessBurst(ctx, step_size, population.ScheduleOrganism(), Apto::Min(burst_size, UD_size - i));
+      }
+    } else {
+      for (int i = 0; i < UD_size; i++) {
+        if(population.GetNumOrganisms() == 0) {
+          break;
+        }
+        (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
       }
-      (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
     }
     
     // end of update stats...
@@ -144,14 +154,7 @@ void Avida2Driver::Run()
     
     
     // Do Point Mutations
-    if (point_mut_prob > 0 ) {
-      for (int i = 0; i < population.GetSize(); i++) {
-        if (population.GetCell(i).IsOccupied()) {
-          int num_mut = population.GetCell(i).GetOrganism()->GetHardware().PointMutate(ctx);
-          population.GetCell(i).GetOrganism()->IncPointMutations(num_mut);
-        }
-      }
-    }
+    if (point_mut_prob > 0 ) population.ProcessPointMutations(ctx);
     
     m_new_world->PerformUpdate(new_ctx, stats.GetUpdate());
     
@@ -160,10 +163,14 @@ void Avida2Driver::Run()
 			m_done = true;
 		}
   }
+  
+  // Output files may still hold data queued for the output writer thread
+  Avida::Output::Manager::Of(m_new_world)->FlushAll();
 }
 
 void Avida2Driver::Abort(Avida::AbortCondition condition)
 {
+  Avida::Output::Manager::Of(m_new_world)->FlushAll();
   exit(condition);
 }
 
@@ -0,0 +1,44 @@
+/*
+ *  BenchmarkUtil.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BenchmarkUtil_h
+#define BenchmarkUtil_h
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+
+// Processor time used by the benchmark so far, in seconds
+inline double BenchmarkSeconds()
+{
+  return (double)clock() / (double)CLOCKS_PER_SEC;
+}
+
+// Prints a single result line: label, total seconds, and the cost of a single operation in nanoseconds
+inline void BenchmarkReport(const char* label, double seconds, double operations)
+{
+  std::cout << std::left << std::setw(40) << label << std::right
+            << std::setw(10) << std::setprecision(4) << seconds << " s"
+            << std::setw(14) << std::setprecision(6) << ((operations > 0.0) ? (seconds * 1.0e9 / operations) : 0.0) << " ns/op"
+            << std::endl;
+}
+
+#endif
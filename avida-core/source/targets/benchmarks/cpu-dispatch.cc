@@ -0,0 +1,123 @@
+/*
+ *  cpu-dispatch.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Measures original CPU instruction throughput on the default heads instruction set, running the default ancestor
+// through a test CPU with SPECIALIZED_DISPATCH off (the generic loop) and on.  Must be run from a directory containing
+// avida.cfg and its dependent files (i.e. the installed work directory).
+
+#include "BenchmarkUtil.h"
+
+#include "apto/core/FileSystem.h"
+#include "avida/Avida.h"
+#include "avida/core/World.h"
+#include "avida/core/WorldDriver.h"
+#include "avida/private/util/GenomeLoader.h"
+
+#include "cAvidaConfig.h"
+#include "cAvidaContext.h"
+#include "cCPUTestInfo.h"
+#include "cHardwareManager.h"
+#include "cPhenotype.h"
+#include "cTestCPU.h"
+#include "cUserFeedback.h"
+#include "cWorld.h"
+
+#include <cstdlib>
+
+using namespace std;
+using namespace Avida;
+
+
+class BenchDriver : public WorldDriver
+{
+private:
+  cUserFeedback m_feedback;
+
+public:
+  void Pause() { ; }
+  void Finish() { ; }
+  void Abort(AbortCondition condition) { exit(condition); }
+
+  Avida::Feedback& Feedback() { return m_feedback; }
+
+  void RegisterCallback(DriverCallback) { ; }
+};
+
+
+static double runTests(cWorld* world, cAvidaContext& ctx, const Genome& genome, int num_tests, double& num_inst)
+{
+  cTestCPU* test_cpu = world->GetHardwareManager().CreateTestCPU(ctx);
+
+  num_inst = 0.0;
+  const double start = BenchmarkSeconds();
+  for (int i = 0; i < num_tests; i++) {
+    cCPUTestInfo test_info;
+    test_cpu->TestGenome(ctx, test_info, genome);
+    num_inst += test_info.GetTestPhenotype().GetGestationTime();
+  }
+  const double elapsed = BenchmarkSeconds() - start;
+
+  delete test_cpu;
+  return elapsed;
+}
+
+
+int main(int argc, char* argv[])
+{
+  int num_tests = 2000;
+  if (argc > 1) num_tests = atoi(argv[1]);
+
+  Avida::Initialize();
+
+  const cString working_dir(Apto::FileSystem::GetCWD());
+  cUserFeedback feedback;
+  cAvidaConfig* cfg = new cAvidaConfig();
+  cfg->Load("avida.cfg", working_dir, &feedback);
+
+  World* new_world = new World();
+  cWorld* world = cWorld::Initialize(cfg, working_dir, new_world, &feedback);
+  for (int i = 0; i < feedback.GetNumMessages(); i++) cerr << feedback.GetMessage(i) << endl;
+  if (!world) return -1;
+
+  BenchDriver driver;
+  cAvidaContext ctx(&driver, world->GetRandom());
+
+  GenomePtr genome = Util::LoadGenomeDetailFile("default-heads.org", working_dir, world->GetHardwareManager(), driver.Feedback());
+  if (!genome) return -1;
+
+  cout << "Original CPU dispatch, default-heads.org ancestor, " << num_tests << " test CPU runs" << endl << endl;
+
+  double generic_inst = 0.0;
+  world->GetConfig().SPECIALIZED_DISPATCH.Set(0);
+  const double generic_time = runTests(world, ctx, *genome, num_tests, generic_inst);
+  BenchmarkReport("  generic loop (per instruction)", generic_time, generic_inst);
+
+  double specialized_inst = 0.0;
+  world->GetConfig().SPECIALIZED_DISPATCH.Set(1);
+  const double specialized_time = runTests(world, ctx, *genome, num_tests, specialized_inst);
+  BenchmarkReport("  specialized loop (per instruction)", specialized_time, specialized_inst);
+
+  cout << endl;
+  if (generic_time > 0.0) cout << "  generic     " << setprecision(4) << (generic_inst / generic_time) << " inst/s" << endl;
+  if (specialized_time > 0.0) cout << "  specialized " << setprecision(4) << (specialized_inst / specialized_time) << " inst/s" << endl;
+  if (generic_inst != specialized_inst) cout << "  instruction counts differ: " << generic_inst << " vs " << specialized_inst << endl;
+
+  return 0;
+}
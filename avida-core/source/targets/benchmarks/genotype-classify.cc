@@ -0,0 +1,180 @@
+/*
+ *  genotype-classify.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Measures the cost of classifying a new organism into an existing genotype as the number of active genotypes grows,
+// both by genome match and by hinted genotype id (the population load path).  The genome lookup is compared against a
+// reference model of the previous index: a positional sum hash into 3203 chained buckets, each scanned linearly.
+
+#include "BenchmarkUtil.h"
+
+#include "avida/core/InstructionSequence.h"
+#include "avida/core/Properties.h"
+#include "avida/core/World.h"
+#include "avida/data/Manager.h"
+#include "avida/environment/Manager.h"
+
+#include "avida/private/systematics/GenotypeArbiter.h"
+
+#include "cHardwareManager.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace Avida;
+
+
+static PropertyDescriptionMap s_prop_desc_map;
+
+class BenchUnit : public Systematics::Unit
+{
+private:
+  Genome m_genome;
+  HashPropertyMap m_props;
+
+public:
+  BenchUnit(const Genome& genome) : m_genome(genome)
+  {
+    m_props.Define(PropertyPtr(new IntProperty("generation", Property::Null, s_prop_desc_map, 0)));
+  }
+
+  Systematics::Source UnitSource() const { return Systematics::Source(Systematics::DIVISION, ""); }
+  const Genome& UnitGenome() const { return m_genome; }
+  const PropertyMap& Properties() const { return m_props; }
+};
+
+
+static Genome randomGenome(int length)
+{
+  InstructionSequencePtr seq(new InstructionSequence(length));
+  for (int i = 0; i < length; i++) (*seq)[i] = Instruction(rand() % 26);
+
+  HashPropertyMap props;
+  cHardwareManager::SetupPropertyMap(props, "(default)");
+  return Genome(0, props, seq);
+}
+
+static const InstructionSequence& sequenceOf(const Genome& genome)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+  return *seq;
+}
+
+
+// Reference model of the previous genotype index
+static const int LEGACY_HASH_SIZE = 3203;
+
+static int legacyHash(const InstructionSequence& seq)
+{
+  unsigned int total = 0;
+  for (int i = 0; i < seq.GetSize(); i++) total += (seq[i].GetOp() + 3) * i;
+  return total % LEGACY_HASH_SIZE;
+}
+
+static double runLegacy(const vector<Genome>& genomes, const vector<int>& queries)
+{
+  vector<vector<const InstructionSequence*> > buckets(LEGACY_HASH_SIZE);
+  for (size_t i = 0; i < genomes.size(); i++) {
+    const InstructionSequence& seq = sequenceOf(genomes[i]);
+    buckets[legacyHash(seq)].push_back(&seq);
+  }
+
+  int found = 0;
+  const double start = BenchmarkSeconds();
+  for (size_t q = 0; q < queries.size(); q++) {
+    const InstructionSequence& seq = sequenceOf(genomes[queries[q]]);
+    const vector<const InstructionSequence*>& bucket = buckets[legacyHash(seq)];
+    for (size_t i = 0; i < bucket.size(); i++) {
+      if (*bucket[i] == seq) {
+        found++;
+        break;
+      }
+    }
+  }
+  const double elapsed = BenchmarkSeconds() - start;
+  if (found != (int)queries.size()) cout << "  legacy lookup missed " << (queries.size() - found) << " genomes" << endl;
+  return elapsed;
+}
+
+
+int main(int argc, char* argv[])
+{
+  const int counts[] = { 100, 1000, 10000, 100000 };
+  const int num_counts = sizeof(counts) / sizeof(int);
+  const int genome_length = 100;
+
+  int num_queries = 200000;
+  if (argc > 1) num_queries = atoi(argv[1]);
+
+  cHardwareManager::Initialize();
+  World* world = new World;
+  Data::ManagerPtr(new Data::Manager)->AttachTo(world);
+  Environment::ManagerPtr(new Environment::Manager)->AttachTo(world);
+
+  cout << "Genotype classification, " << genome_length << " instruction genomes, " << num_queries << " births" << endl;
+
+  for (int c = 0; c < num_counts; c++) {
+    const int num_genotypes = counts[c];
+    srand(1);
+
+    // Genotypes are intentionally never released; the arbiter is not torn down at the end of the benchmark
+    Systematics::GenotypeArbiterPtr arbiter(new Systematics::GenotypeArbiter(world, "genotype", 3));
+
+    vector<Genome> genomes;
+    vector<int> ids;
+    for (int i = 0; i < num_genotypes; i++) {
+      genomes.push_back(randomGenome(genome_length));
+      Systematics::UnitPtr unit(new BenchUnit(genomes.back()));
+      ids.push_back(arbiter->ClassifyNewUnit(unit, NULL)->ID());
+    }
+
+    vector<int> queries(num_queries);
+    for (int q = 0; q < num_queries; q++) queries[q] = rand() % num_genotypes;
+
+    // Units are created ahead of time so that only classification is timed
+    vector<Systematics::UnitPtr> units(num_queries);
+    for (int q = 0; q < num_queries; q++) units[q] = Systematics::UnitPtr(new BenchUnit(genomes[queries[q]]));
+
+    cout << endl << num_genotypes << " active genotypes" << endl;
+
+    const double legacy_time = runLegacy(genomes, queries);
+    BenchmarkReport("  legacy chained lookup (per birth)", legacy_time, num_queries);
+
+    int mismatched = 0;
+    double start = BenchmarkSeconds();
+    for (int q = 0; q < num_queries; q++) {
+      if (arbiter->ClassifyNewUnit(units[q], NULL)->ID() != ids[queries[q]]) mismatched++;
+    }
+    BenchmarkReport("  classify by genome (per birth)", BenchmarkSeconds() - start, num_queries);
+
+    Systematics::RoleClassificationHints hints;
+    start = BenchmarkSeconds();
+    for (int q = 0; q < num_queries; q++) {
+      hints["genotype"]["id"] = Apto::FormatStr("%d", ids[queries[q]]);
+      if (arbiter->ClassifyNewUnit(units[q], &hints["genotype"])->ID() != ids[queries[q]]) mismatched++;
+    }
+    BenchmarkReport("  classify by hinted id (per birth)", BenchmarkSeconds() - start, num_queries);
+
+    if (mismatched) cout << "  " << mismatched << " births classified into the wrong genotype" << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ *  logic-tasks.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Measures the cost of evaluating the 77 tasks of the logic-77 environment (support/config/misc/environment-all-logic.cfg)
+// for a single output.  The reference model derives the logic id one bit position at a time and then calls every task
+// function; the current path derives it with SetupTests and resolves each task with its logic id bit set.
+
+#include "BenchmarkUtil.h"
+
+#include "cEnvReqs.h"
+#include "cTaskContext.h"
+#include "cTaskEntry.h"
+#include "cTaskLib.h"
+#include "cUserFeedback.h"
+#include "tBuffer.h"
+#include "tList.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+
+// Reference model of the previous logic id computation
+static int legacyLogicId(const tBuffer<int>& input_buffer, int test_output)
+{
+  const int num_inputs = input_buffer.GetNumStored();
+  int test_inputs[3];
+  for (int i = 0; i < 3; i++) test_inputs[i] = (num_inputs > i) ? input_buffer[i] : 0;
+
+  int logic_out[8];
+  for (int i = 0; i < 8; i++) logic_out[i] = -1;
+
+  for (int test_pos = 0; test_pos < 32; test_pos++) {
+    int logic_pos = 0;
+    for (int i = 0; i < 3; i++) logic_pos += (test_inputs[i] & 1) << i;
+    if (logic_out[logic_pos] != -1 && logic_out[logic_pos] != (test_output & 1)) return -1;
+    logic_out[logic_pos] = test_output & 1;
+    test_output >>= 1;
+    for (int i = 0; i < 3; i++) test_inputs[i] >>= 1;
+  }
+
+  int logicid = 0;
+  for (int i = 0; i < 8; i++) logicid += logic_out[i] << i;
+  return logicid;
+}
+
+
+int main(int argc, char* argv[])
+{
+  int num_outputs = 1000000;
+  if (argc > 1) num_outputs = atoi(argv[1]);
+
+  // The logic-77 environment: all 1- and 2-input functions, followed by the 3-input functions logic_3AA - logic_3CP
+  const char* two_input[] = { "not", "nand", "and", "orn", "or", "andn", "nor", "xor", "equ" };
+  cTaskLib tasklib(NULL);
+  cEnvReqs envreqs;
+  cUserFeedback feedback;
+  for (int i = 0; i < 9; i++) tasklib.AddTask(two_input[i], "", envreqs, feedback);
+  for (int i = 0; i < 68; i++) {
+    const char name[] = { 'l', 'o', 'g', 'i', 'c', '_', '3', (char)('A' + i / 26), (char)('A' + i % 26), '\0' };
+    tasklib.AddTask(name, "", envreqs, feedback);
+  }
+  const int num_tasks = tasklib.GetSize();
+
+  // Inputs follow the usual layout, with the top byte of each fixed so that every input combination is present.  Half
+  // of the outputs are computed from the inputs by a random logic function, the remainder are random.
+  srand(1);
+  tBuffer<int> inputs(3);
+  inputs.Add(0x0f000000 | (rand() & 0xffffff));
+  inputs.Add(0x33000000 | (rand() & 0xffffff));
+  inputs.Add(0x55000000 | (rand() & 0xffffff));
+
+  vector<int> outputs(num_outputs);
+  for (int i = 0; i < num_outputs; i++) {
+    if (rand() & 1) {
+      const int logic_id = rand() & 0xff;
+      int out = 0;
+      for (int bit = 0; bit < 32; bit++) {
+        const int pos = ((inputs[0] >> bit) & 1) | (((inputs[1] >> bit) & 1) << 1) | (((inputs[2] >> bit) & 1) << 2);
+        out |= ((logic_id >> pos) & 1) << bit;
+      }
+      outputs[i] = out;
+    } else {
+      outputs[i] = rand();
+    }
+  }
+
+  tBuffer<int> output_buffer(1);
+  tList<tBuffer<int> > other_buffers;
+  Apto::Array<int, Apto::Smart> ext_mem;
+  cTaskContext taskctx(NULL, inputs, output_buffer, other_buffers, other_buffers, ext_mem);
+
+  cout << "Logic task evaluation, " << num_tasks << " tasks, " << num_outputs << " outputs" << endl << endl;
+
+  double legacy_total = 0.0;
+  double start = BenchmarkSeconds();
+  for (int i = 0; i < num_outputs; i++) {
+    output_buffer.Clear();
+    output_buffer.Add(outputs[i]);
+    taskctx.SetLogicId(legacyLogicId(inputs, outputs[i]));
+    for (int t = 0; t < num_tasks; t++) {
+      taskctx.SetTaskEntry(tasklib.GetTaskReference(t));
+      legacy_total += tasklib.TestOutput(taskctx);
+    }
+  }
+  BenchmarkReport("  per bit, all task functions (per output)", BenchmarkSeconds() - start, num_outputs);
+
+  double total = 0.0;
+  int mismatched = 0;
+  start = BenchmarkSeconds();
+  for (int i = 0; i < num_outputs; i++) {
+    output_buffer.Clear();
+    output_buffer.Add(outputs[i]);
+    tasklib.SetupTests(taskctx);
+    const int logic_id = taskctx.GetLogicId();
+    for (int t = 0; t < num_tasks; t++) {
+      if (tasklib.GetTask(t).MatchesLogicId(logic_id)) total += 1.0;
+    }
+  }
+  BenchmarkReport("  bit parallel, logic id lookup (per output)", BenchmarkSeconds() - start, num_outputs);
+
+  for (int i = 0; i < num_outputs; i++) {
+    output_buffer.Clear();
+    output_buffer.Add(outputs[i]);
+    tasklib.SetupTests(taskctx);
+    if (taskctx.GetLogicId() != legacyLogicId(inputs, outputs[i])) mismatched++;
+  }
+
+  if (total != legacy_total) cout << "  task totals differ: " << legacy_total << " vs " << total << endl;
+  if (mismatched) cout << "  " << mismatched << " outputs assigned a different logic id" << endl;
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *  scheduler.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Compares the merit schedulers selectable by SLICING_METHOD (Apto's Probabilistic, cFenwickSchedule and
+// cAliasSchedule) at several population sizes: the cost of Next() with fixed merits, of AdjustPriority() followed by
+// Next(), and of a high-turnover mix with a merit change every 30 draws (the default AVE_TIME_SLICE).
+
+#include "BenchmarkUtil.h"
+
+#include "apto/rng.h"
+#include "apto/scheduler.h"
+
+#include "cAliasSchedule.h"
+#include "cFenwickSchedule.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+static const int TURNOVER_DRAWS = 30;
+
+
+static Apto::PriorityScheduler* createScheduler(int kind, int num_cells)
+{
+  Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(1));
+  switch (kind) {
+    case 0: return new Apto::Scheduler::Probabilistic(num_cells, rng);
+    case 1: return new cFenwickSchedule(num_cells, rng);
+    default: return new cAliasSchedule(num_cells, rng);
+  }
+}
+
+// Merits span several orders of magnitude, as they do in an evolving population; a tenth of the cells are empty
+static void randomMerits(vector<double>& merits)
+{
+  for (size_t i = 0; i < merits.size(); i++) {
+    merits[i] = (rand() % 10 == 0) ? 0.0 : (double)(1 << (rand() % 16)) * (1.0 + (double)rand() / RAND_MAX);
+  }
+}
+
+
+int main(int argc, char* argv[])
+{
+  const int sizes[] = { 10000, 100000, 1000000 };
+  const int num_sizes = sizeof(sizes) / sizeof(int);
+  const char* kind_names[] = { "probabilistic", "fenwick", "alias" };
+  const int num_kinds = 3;
+
+  int num_ops = 5000000;
+  if (argc > 1) num_ops = atoi(argv[1]);
+
+  cout << "Merit schedulers, " << num_ops << " operations per measurement" << endl;
+
+  for (int s = 0; s < num_sizes; s++) {
+    const int num_cells = sizes[s];
+    srand(1);
+    vector<double> merits(num_cells);
+    randomMerits(merits);
+    vector<int> change_cells(num_ops);
+    vector<double> change_merits(num_ops);
+    for (int i = 0; i < num_ops; i++) {
+      change_cells[i] = rand() % num_cells;
+      change_merits[i] = merits[rand() % num_cells];
+    }
+
+    cout << endl << num_cells << " cells" << endl;
+
+    for (int k = 0; k < num_kinds; k++) {
+      Apto::PriorityScheduler* scheduler = createScheduler(k, num_cells);
+      for (int i = 0; i < num_cells; i++) scheduler->AdjustPriority(i, merits[i]);
+      scheduler->Next();
+
+      long checksum = 0;
+      double start = BenchmarkSeconds();
+      for (int i = 0; i < num_ops; i++) checksum += scheduler->Next();
+      BenchmarkReport((string("  ") + kind_names[k] + " Next").c_str(), BenchmarkSeconds() - start, num_ops);
+
+      start = BenchmarkSeconds();
+      for (int i = 0; i < num_ops; i++) {
+        scheduler->AdjustPriority(change_cells[i], change_merits[i]);
+        checksum += scheduler->Next();
+      }
+      BenchmarkReport((string("  ") + kind_names[k] + " AdjustPriority + Next").c_str(), BenchmarkSeconds() - start,
+                      num_ops);
+
+      start = BenchmarkSeconds();
+      for (int i = 0; i < num_ops; i++) {
+        if (i % TURNOVER_DRAWS == 0) scheduler->AdjustPriority(change_cells[i], change_merits[i]);
+        checksum += scheduler->Next();
+      }
+      BenchmarkReport((string("  ") + kind_names[k] + " turnover (per draw)").c_str(), BenchmarkSeconds() - start,
+                      num_ops);
+
+      if (checksum == 0) cout << "  (no cells drawn)" << endl;
+      delete scheduler;
+    }
+  }
+
+  return 0;
+}
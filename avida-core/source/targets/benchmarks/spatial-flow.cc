@@ -0,0 +1,93 @@
+/*
+ *  spatial-flow.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Compares the per-update cost of the pairwise (FlowMatter) and vectorized (cSpatialFlowKernel) spatial resource
+// flow models at several grid sizes, and reports the largest difference between the two after the timed updates.
+
+#include "BenchmarkUtil.h"
+
+#include "cSpatialResCount.h"
+#include "nGeometry.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+
+static void fillGrid(cSpatialResCount& res)
+{
+  srand(1);
+  for (int i = 0; i < res.GetSize(); i++) res.SetCellAmount(i, (double)rand() / (double)RAND_MAX * 100.0);
+}
+
+static double runUpdates(cSpatialResCount& res, int num_updates)
+{
+  const double start = BenchmarkSeconds();
+  for (int i = 0; i < num_updates; i++) {
+    res.FlowAll();
+    res.StateAll();
+  }
+  return BenchmarkSeconds() - start;
+}
+
+
+int main(int argc, char* argv[])
+{
+  const int sizes[] = { 60, 100, 200, 400, 1000 };
+  const int num_sizes = sizeof(sizes) / sizeof(int);
+  const int geometries[] = { nGeometry::TORUS, nGeometry::GRID };
+  const char* geometry_names[] = { "torus", "grid" };
+
+  int total_cells = 4000000;  // approximate number of cell updates to time for each configuration
+  if (argc > 1) total_cells = atoi(argv[1]);
+
+  cout << "Spatial resource flow (xdiffuse=1.0 ydiffuse=0.5 xgravity=0.1 ygravity=-0.2)" << endl;
+
+  for (int g = 0; g < 2; g++) {
+    for (int s = 0; s < num_sizes; s++) {
+      const int side = sizes[s];
+      const int num_updates = Apto::Max(1, total_cells / (side * side));
+
+      cSpatialResCount pairwise(side, side, geometries[g], 1.0, 0.5, 0.1, -0.2);
+      cSpatialResCount vectorized(side, side, geometries[g], 1.0, 0.5, 0.1, -0.2);
+      vectorized.SetVectorizedFlow(true);
+      fillGrid(pairwise);
+      fillGrid(vectorized);
+
+      cout << endl << geometry_names[g] << " " << side << "x" << side << ", " << num_updates << " updates" << endl;
+
+      const double pairwise_time = runUpdates(pairwise, num_updates);
+      BenchmarkReport("  pairwise (per cell update)", pairwise_time, (double)num_updates * side * side);
+
+      const double vectorized_time = runUpdates(vectorized, num_updates);
+      BenchmarkReport("  vectorized (per cell update)", vectorized_time, (double)num_updates * side * side);
+
+      double max_diff = 0.0;
+      for (int i = 0; i < pairwise.GetSize(); i++) {
+        max_diff = Apto::Max(max_diff, fabs(pairwise.GetAmount(i) - vectorized.GetAmount(i)));
+      }
+      cout << "  speedup " << setprecision(3) << ((vectorized_time > 0.0) ? pairwise_time / vectorized_time : 0.0)
+           << "x, max difference " << setprecision(3) << max_diff << endl;
+    }
+  }
+
+  return 0;
+}
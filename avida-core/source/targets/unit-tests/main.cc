@@ -312,6 +312,94 @@ protected:
 };
 
 
+#include "avida/core/World.h"
+#include "avida/output/ColumnFile.h"
+#include "avida/output/ColumnFileReader.h"
+#include "avida/output/Manager.h"
+#include "avida/private/output/ColumnFormat.h"
+#include "cUserFeedback.h"
+#include <climits>
+#include <cstdio>
+#include <vector>
+class cColumnFileTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "Output::ColumnFile"; }
+protected:
+  // Spreads rows over the whole int32 range, with extremes placed so that neighboring differences overflow
+  static int intValue(int row)
+  {
+    if (row % 7 == 3) return (row % 2) ? INT_MAX : INT_MIN;
+    return (int)((unsigned int)row * 2654435761u);
+  }
+  
+  void RunTests()
+  {
+    using namespace Avida;
+    
+    std::vector<int32_t> values;
+    const int32_t extremes[] = { 0, INT_MAX, INT_MIN, -1, 1, INT_MIN, INT_MAX, INT_MAX, -987654321, 123456789, 0 };
+    for (unsigned int i = 0; i < sizeof(extremes) / sizeof(int32_t); i++) values.push_back(extremes[i]);
+    std::vector<char> encoded;
+    std::vector<int32_t> decoded;
+    Output::ColumnFormat::EncodeInts(values, encoded);
+    Output::ColumnFormat::DecodeInts(encoded, values.size(), decoded);
+    ReportTestResult("Int Encoding (wrapping differences)", decoded == values);
+    
+    
+    // Write 1000 rows in chunks of 64 rows, so that reads span partial chunks at both ends
+    const int num_rows = 1000;
+    const Apto::String path("./unit-tests-columns.dat");
+    cUserFeedback feedback;
+    World* world = new World();
+    Output::ManagerPtr mgr(new Output::Manager("."));
+    mgr->AttachTo(world);
+    
+    bool result = true;
+    {
+      Output::ColumnFilePtr file = Output::ColumnFile::CreateWithPath(world, path, &feedback, 64);
+      if (!file) {
+        result = false;
+      } else {
+        const int int_col = file->AddColumn("ints", Output::ColumnFile::INT_COLUMN);
+        const int double_col = file->AddColumn("doubles", Output::ColumnFile::DOUBLE_COLUMN);
+        for (int row = 0; row < num_rows; row++) {
+          file->Write(int_col, intValue(row));
+          file->Write(double_col, row * 0.5);
+          file->Endl(row * 2);
+        }
+        file->Flush();
+        result = file->Good() && int_col == 0 && double_col == 1;
+      }
+    }
+    ReportTestResult("Write Int Column", result);
+    
+    Output::ColumnFileReader reader;
+    result = reader.Open(path, feedback) && reader.NumRows() == num_rows &&
+      reader.ColumnDataType(0) == Output::ColumnFile::INT_COLUMN;
+    ReportTestResult("Open", result);
+    
+    Apto::Array<int, Apto::Smart> ints;
+    result = result && reader.ReadInts(0, 0, (num_rows - 1) * 2, ints) && ints.GetSize() == num_rows;
+    for (int row = 0; result && row < num_rows; row++) if (ints[row] != intValue(row)) result = false;
+    ReportTestResult("Read Int Column", result);
+    
+    // Updates 301..1299 are rows 151..649, starting and ending part way through chunks
+    Apto::Array<Update, Apto::Smart> updates;
+    result = reader.ReadInts(0, 301, 1299, ints) && reader.ReadUpdates(301, 1299, updates) && ints.GetSize() == 499 &&
+      updates.GetSize() == 499;
+    for (int i = 0; result && i < ints.GetSize(); i++) {
+      if (ints[i] != intValue(151 + i) || updates[i] != (151 + i) * 2) result = false;
+    }
+    ReportTestResult("Read Int Column (update range)", result);
+    
+    reader.Close();
+    remove((const char*)path);
+    delete world;
+  }
+};
+
+
 
 
 #define TEST(CLASS) \
@@ -333,6 +421,7 @@ int main(int argc, const char* argv[])
   
   TEST(cRawBitArray);
   TEST(cBitArray);
+  TEST(cColumnFile);
   
   if (failed == 0)
     cout << "All unit tests passed." << endl;
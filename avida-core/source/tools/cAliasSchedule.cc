@@ -0,0 +1,141 @@
+/*
+ *  cAliasSchedule.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cAliasSchedule.h"
+
+#include <cassert>
+
+
+cAliasSchedule::cAliasSchedule(int entry_count, Apto::SmartPtr<Apto::Random> rng)
+  : m_rng(rng), m_size(entry_count), m_entries(entry_count), m_columns(entry_count), m_work(entry_count)
+  , m_table_total(0.0), m_lost(0.0), m_num_active(0), m_draws(0), m_changed(false), m_excess(entry_count, rng)
+{
+  for (int i = 0; i < m_size; i++) m_entries[i].priority = 0.0;
+  buildTable();
+}
+
+cAliasSchedule::~cAliasSchedule()
+{
+}
+
+
+void cAliasSchedule::AdjustPriority(int entry_id, double priority)
+{
+  assert(entry_id >= 0 && entry_id < m_size);
+
+  sEntry& entry = m_entries[entry_id];
+  if (priority < 0.0) priority = 0.0;
+  const double old_priority = entry.priority;
+  if (priority == old_priority) return;
+
+  if (old_priority > 0.0 && priority == 0.0) m_num_active--;
+  else if (old_priority == 0.0) m_num_active++;
+  entry.priority = priority;
+
+  // Split the priority into the part the table can provide and the part it can not
+  m_lost += Apto::Min(old_priority, entry.table_priority) - Apto::Min(priority, entry.table_priority);
+  const double excess = (priority > entry.table_priority) ? (priority - entry.table_priority) : 0.0;
+  if (excess != m_excess.GetPriority(entry_id)) m_excess.AdjustPriority(entry_id, excess);
+
+  m_changed = true;
+}
+
+
+int cAliasSchedule::Next()
+{
+  if (m_changed && (++m_draws > m_num_active || m_lost > 0.5 * m_table_total)) buildTable();
+
+  // Draws are repeated until one is kept.  The table part keeps at least half of its draws, see above.
+  while (true) {
+    const double excess_total = (m_changed) ? m_excess.GetTotalPriority() : 0.0;
+    if (excess_total > m_table_total) {
+      buildTable();
+      continue;
+    }
+
+    const double total = m_table_total + excess_total;
+    if (total <= 0.0) return -1;
+    const double position = m_rng->GetDouble(total);
+
+    if (position >= m_table_total) {
+      const int entry_id = m_excess.FindPosition(position - m_table_total);
+      if (m_entries[entry_id].priority > m_entries[entry_id].table_priority) return entry_id;
+
+      // Round-off in the excess sums led to an entry without excess; start over from a fresh table
+      buildTable();
+      continue;
+    }
+
+    // The position, scaled to the table, picks a column and the point within it
+    const double point = position * m_size / m_table_total;
+    int entry_id = static_cast<int>(point);
+    if (entry_id >= m_size) entry_id = m_size - 1;
+    const sColumn& column = m_columns[entry_id];
+    if (point - entry_id >= column.keep) entry_id = column.alias;
+    if (!m_changed) return entry_id;
+
+    // Keep the draw with the share of the table priority that the entry still holds
+    const sEntry& entry = m_entries[entry_id];
+    if (entry.priority >= entry.table_priority || m_rng->GetDouble(entry.table_priority) < entry.priority) {
+      return entry_id;
+    }
+  }
+}
+
+
+void cAliasSchedule::buildTable()
+{
+  m_table_total = 0.0;
+  for (int i = 0; i < m_size; i++) {
+    m_entries[i].table_priority = m_entries[i].priority;
+    m_table_total += m_entries[i].priority;
+    if (m_excess.GetPriority(i) != 0.0) m_excess.AdjustPriority(i, 0.0);
+    m_columns[i].keep = 1.0;
+    m_columns[i].alias = i;
+  }
+  m_lost = 0.0;
+  m_draws = 0;
+  m_changed = false;
+  if (m_table_total <= 0.0) return;
+
+  // Vose's method: columns short of the average are topped up from those above it.  m_work holds the short columns
+  // from the front and the tall ones from the back.
+  int num_short = 0;
+  int num_tall = 0;
+  for (int i = 0; i < m_size; i++) {
+    m_columns[i].keep = m_entries[i].table_priority * m_size / m_table_total;
+    if (m_columns[i].keep < 1.0) m_work[num_short++] = i;
+    else m_work[m_size - 1 - num_tall++] = i;
+  }
+  while (num_short && num_tall) {
+    const int short_id = m_work[--num_short];
+    const int tall_id = m_work[m_size - num_tall];
+    m_columns[short_id].alias = tall_id;
+    m_columns[tall_id].keep -= 1.0 - m_columns[short_id].keep;
+    if (m_columns[tall_id].keep < 1.0) {
+      num_tall--;
+      m_work[num_short++] = tall_id;
+    }
+  }
+
+  // Whatever remains is within round-off of the average
+  while (num_short) m_columns[m_work[--num_short]].keep = 1.0;
+  while (num_tall) m_columns[m_work[m_size - num_tall--]].keep = 1.0;
+}
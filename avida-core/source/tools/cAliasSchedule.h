@@ -0,0 +1,88 @@
+/*
+ *  cAliasSchedule.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cAliasSchedule_h
+#define cAliasSchedule_h
+
+#include "avida/core/Types.h"
+
+#include "apto/rng.h"
+#include "apto/scheduler.h"
+
+#include "cFenwickSchedule.h"
+
+
+// cAliasSchedule - probabilistic scheduler drawing from an alias table (Walker/Vose) of priorities
+//
+// Entries are chosen with probability proportional to their current priority, as by Apto::Scheduler::Probabilistic.
+// Most draws take constant time from an alias table built from a snapshot of the priorities.  Priority changes since
+// the snapshot are corrected for exactly: a draw of an entry whose priority dropped is rejected with the lost share,
+// and priority gained beyond the snapshot is drawn from a cFenwickSchedule of the excess.
+//
+// Once priorities have changed, the table is rebuilt lazily: by the first draw after as many draws as there are entries
+// with priority, which spreads the cost of the rebuild over those draws, or sooner when half of the table's priority
+// has been lost or the excess exceeds it.
+
+class cAliasSchedule : public Apto::PriorityScheduler
+{
+private:
+  struct sEntry
+  {
+    double priority;
+    double table_priority;      // priority the table was built from
+  };
+
+  struct sColumn
+  {
+    double keep;                // chance that a draw landing on the column keeps its entry, rather than the alias
+    int alias;
+  };
+
+  Apto::SmartPtr<Apto::Random> m_rng;
+  int m_size;
+  Apto::Array<sEntry> m_entries;
+  Apto::Array<sColumn> m_columns;
+  Apto::Array<int> m_work;
+  double m_table_total;
+  double m_lost;                          // table priority no longer held by the entries, see AdjustPriority()
+  int m_num_active;                       // entries with priority
+  int m_draws;                            // draws since the table was built
+  bool m_changed;
+  cFenwickSchedule m_excess;              // priority held beyond the table
+
+  cAliasSchedule(); // @not_implemented
+  cAliasSchedule(const cAliasSchedule&); // @not_implemented
+  cAliasSchedule& operator=(const cAliasSchedule&); // @not_implemented
+
+public:
+  cAliasSchedule(int entry_count, Apto::SmartPtr<Apto::Random> rng);
+  ~cAliasSchedule();
+
+  void AdjustPriority(int entry_id, double priority);
+  int Next();
+
+  int GetSize() const { return m_size; }
+  double GetPriority(int entry_id) const { return m_entries[entry_id].priority; }
+
+private:
+  void buildTable();
+};
+
+#endif
@@ -69,6 +69,15 @@ public:
     s1 -= w_val;
     s2 -= w_val * w_val;
   }
+
+  // Replaces the accumulated moments with values maintained elsewhere (Max is reset)
+  void Set(double count, double sum, double sum_sq)
+  {
+    n = count;
+    s1 = sum;
+    s2 = sum_sq;
+    max = std::numeric_limits<double>::min();
+  }
 };
 
 #endif
@@ -0,0 +1,142 @@
+/*
+ *  cFenwickSchedule.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cFenwickSchedule.h"
+
+#include <cassert>
+
+
+// Batches of more than GetSize() / REBUILD_DIVISOR changes rebuild the tree rather than update it entry by entry
+static const int REBUILD_DIVISOR = 16;
+
+
+cFenwickSchedule::cFenwickSchedule(int entry_count, Apto::SmartPtr<Apto::Random> rng)
+  : m_rng(rng), m_size(entry_count), m_top_step(1), m_weights(entry_count), m_tree(entry_count + 1)
+  , m_total(0.0), m_pending(entry_count), m_is_pending(entry_count), m_num_updates(0)
+{
+  while (m_top_step * 2 <= m_size) m_top_step *= 2;
+  m_weights.SetAll(0.0);
+  m_tree.SetAll(0.0);
+  m_pending.SetAll(0.0);
+  m_is_pending.SetAll(false);
+}
+
+cFenwickSchedule::~cFenwickSchedule()
+{
+}
+
+
+void cFenwickSchedule::AdjustPriority(int entry_id, double priority)
+{
+  assert(entry_id >= 0 && entry_id < m_size);
+
+  m_pending[entry_id] = (priority > 0.0) ? priority : 0.0;
+  if (!m_is_pending[entry_id]) {
+    m_is_pending[entry_id] = true;
+    m_pending_ids.Push(entry_id);
+  }
+}
+
+
+int cFenwickSchedule::Next()
+{
+  double total = GetTotalPriority();
+  if (total <= 0.0) return -1;
+
+  int entry_id = FindPosition(m_rng->GetDouble(total));
+  if (m_weights[entry_id] <= 0.0) {
+    // Round-off in the partial sums led to an entry without priority; draw again from exact sums
+    rebuild();
+    total = GetTotalPriority();
+    if (total <= 0.0) return -1;
+    entry_id = FindPosition(m_rng->GetDouble(total));
+  }
+  return entry_id;
+}
+
+
+double cFenwickSchedule::GetTotalPriority()
+{
+  applyPending();
+  return m_total;
+}
+
+
+int cFenwickSchedule::FindPosition(double position)
+{
+  applyPending();
+
+  // Descend from the largest partial sum, skipping every range that lies wholly at or below position
+  int pos = 0;
+  for (int step = m_top_step; step > 0; step >>= 1) {
+    const int next = pos + step;
+    if (next <= m_size && m_tree[next] <= position) {
+      pos = next;
+      position -= m_tree[next];
+    }
+  }
+  return (pos < m_size) ? pos : (m_size - 1);
+}
+
+
+void cFenwickSchedule::applyPending()
+{
+  const int num_pending = m_pending_ids.GetSize();
+  if (!num_pending) return;
+
+  if (num_pending > m_size / REBUILD_DIVISOR || m_num_updates + num_pending > m_size) {
+    rebuild();
+    return;
+  }
+
+  for (int p = 0; p < num_pending; p++) {
+    const int entry_id = m_pending_ids[p];
+    m_is_pending[entry_id] = false;
+
+    const double delta = m_pending[entry_id] - m_weights[entry_id];
+    if (delta == 0.0) continue;
+    m_weights[entry_id] = m_pending[entry_id];
+    m_total += delta;
+    for (int i = entry_id + 1; i <= m_size; i += i & -i) m_tree[i] += delta;
+    m_num_updates++;
+  }
+  m_pending_ids.Resize(0);
+}
+
+
+void cFenwickSchedule::rebuild()
+{
+  for (int p = 0; p < m_pending_ids.GetSize(); p++) m_is_pending[m_pending_ids[p]] = false;
+  m_pending_ids.Resize(0);
+
+  // Each node adds its sum into its parent, which always comes later
+  m_tree[0] = 0.0;
+  m_total = 0.0;
+  for (int i = 1; i <= m_size; i++) {
+    m_weights[i - 1] = m_pending[i - 1];
+    m_tree[i] = m_weights[i - 1];
+    m_total += m_weights[i - 1];
+  }
+  for (int i = 1; i <= m_size; i++) {
+    const int parent = i + (i & -i);
+    if (parent <= m_size) m_tree[parent] += m_tree[i];
+  }
+  m_num_updates = 0;
+}
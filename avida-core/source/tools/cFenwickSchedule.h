@@ -0,0 +1,76 @@
+/*
+ *  cFenwickSchedule.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cFenwickSchedule_h
+#define cFenwickSchedule_h
+
+#include "avida/core/Types.h"
+
+#include "apto/rng.h"
+#include "apto/scheduler.h"
+
+
+// cFenwickSchedule - probabilistic scheduler over a Fenwick (binary indexed) tree of priorities
+//
+// Entries are chosen with probability proportional to their priority, as by Apto::Scheduler::Probabilistic.
+// Priority changes are only recorded when made; they are applied to the tree in a batch by the next call to Next(),
+// so that repeated changes to an entry cost a single tree update, and large batches rebuild the tree in linear time.
+// The tree is also rebuilt after every GetSize() incremental updates, which keeps round-off from accumulating in the
+// partial sums.
+
+class cFenwickSchedule : public Apto::PriorityScheduler
+{
+private:
+  Apto::SmartPtr<Apto::Random> m_rng;
+  int m_size;
+  int m_top_step;                       // highest power of two not above m_size
+  Apto::Array<double> m_weights;        // priority of each entry, as last applied to the tree
+  Apto::Array<double> m_tree;           // one based partial sums
+  double m_total;
+  Apto::Array<double> m_pending;        // priority of each entry, including changes not yet applied
+  Apto::Array<bool> m_is_pending;
+  Apto::Array<int, Apto::Smart> m_pending_ids;
+  int m_num_updates;                    // incremental updates since the last rebuild
+
+  cFenwickSchedule(); // @not_implemented
+  cFenwickSchedule(const cFenwickSchedule&); // @not_implemented
+  cFenwickSchedule& operator=(const cFenwickSchedule&); // @not_implemented
+
+public:
+  cFenwickSchedule(int entry_count, Apto::SmartPtr<Apto::Random> rng);
+  ~cFenwickSchedule();
+
+  void AdjustPriority(int entry_id, double priority);
+  int Next();
+
+  int GetSize() const { return m_size; }
+  double GetPriority(int entry_id) const { return m_pending[entry_id]; }
+
+  // Sum of all priorities, and the entry in whose share of that sum position (0 <= position < total) falls; used by
+  // schedulers that draw from this one as part of a larger distribution
+  double GetTotalPriority();
+  int FindPosition(double position);
+
+private:
+  void applyPending();
+  void rebuild();
+};
+
+#endif
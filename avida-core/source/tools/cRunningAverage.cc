@@ -22,6 +22,8 @@
 
 #include "cRunningAverage.h"
 
+#include "cStateArchive.h"
+
 #include <cassert>
 
 
@@ -61,3 +63,19 @@ void cRunningAverage::Clear() {
   m_pointer = 0;
   m_n = 0;
 }
+
+
+void cRunningAverage::CheckpointState(cStateArchive& ar)
+{
+  ar.TransferSize(m_window_size, "running average window");
+  ar.Transfer(m_s1);
+  ar.Transfer(m_s2);
+  ar.Transfer(m_pointer);
+  ar.Transfer(m_n);
+  if (!ar.IsGood()) return;
+  if (m_n < 0 || m_n > m_window_size || m_pointer < 0 || m_pointer >= m_window_size) {
+    ar.Fail("invalid running average in checkpoint");
+    return;
+  }
+  for (int i = 0; i < m_n; i++) ar.Transfer(m_values[i]);
+}
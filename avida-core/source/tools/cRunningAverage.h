@@ -25,6 +25,8 @@
 
 #include <cmath>
 
+class cStateArchive;
+
 class cRunningAverage
 {
 private:
@@ -48,6 +50,7 @@ public:
   //manipulators
   void Add(double value);
   void Clear();
+  void CheckpointState(cStateArchive& ar);
   
   
   //accessors
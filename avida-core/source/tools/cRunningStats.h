@@ -40,6 +40,7 @@ public:
   inline void Clear() { m_n = 0.0; m_m1 = 0.0; m_m2 = 0.0; m_m3 = 0.0; m_m4 = 0.0; }
   
   inline void Push(double x);
+  inline void Pop(double x);  // removes a previously pushed value
 
   inline double N() const { return m_n; }
   inline double Mean() const { return m_m1; }
@@ -64,4 +65,26 @@ inline void cRunningStats::Push(double x)
   m_m1 += d_n;
 }
 
+inline void cRunningStats::Pop(double x)
+{
+  if (m_n <= 1.0) {
+    Clear();
+    return;
+  }
+
+  // Inverts Push(); the moments are symmetric, so any previously pushed value may be removed
+  double m1 = (m_n * m_m1 - x) / (m_n - 1);
+  double d = (x - m1);
+  double d_n = d / m_n;
+  double d_n2 = d_n * d_n;
+
+  double m2 = m_m2 - d * d_n * (m_n - 1);
+  double m3 = m_m3 - d * d_n2 * ((m_n - 1) * (m_n - 2)) + 3 * d_n * m2;
+  m_m4 -= d * d_n2 * d_n * ((m_n - 1) * ((m_n * m_n) - 3 * m_n + 3)) + 6 * d_n2 * m2 - 4 * d_n * m3;
+  m_m3 = m3;
+  m_m2 = m2;
+  m_m1 = m1;
+  m_n--;
+}
+
 #endif
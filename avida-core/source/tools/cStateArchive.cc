@@ -0,0 +1,160 @@
+/*
+ *  cStateArchive.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cStateArchive.h"
+
+#include "cStringUtil.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+
+
+void cStateArchive::Fail(const cString& error)
+{
+  if (m_error.GetSize() == 0) m_error = error;
+}
+
+bool cStateArchive::readToken(cString& token)
+{
+  string str;
+  if (!(*m_in >> str)) {
+    Fail("unexpected end of checkpoint");
+    return false;
+  }
+  token = str.c_str();
+  return true;
+}
+
+void cStateArchive::Tag(const char* name)
+{
+  if (!IsGood()) return;
+  if (IsSaving()) {
+    *m_out << endl << name;
+    return;
+  }
+
+  cString token;
+  if (readToken(token) && token != name) {
+    Fail(cStringUtil::Stringf("checkpoint mismatch, expected '%s' found '%s'", name, (const char*)token));
+  }
+}
+
+void cStateArchive::Transfer(int& value)
+{
+  if (!IsGood()) return;
+  if (IsSaving()) {
+    *m_out << ' ' << value;
+    return;
+  }
+  if (!(*m_in >> value)) Fail("invalid integer in checkpoint");
+}
+
+void cStateArchive::Transfer(unsigned int& value)
+{
+  if (!IsGood()) return;
+  if (IsSaving()) {
+    *m_out << ' ' << value;
+    return;
+  }
+  if (!(*m_in >> value)) Fail("invalid integer in checkpoint");
+}
+
+void cStateArchive::Transfer(int64_t& value)
+{
+  if (!IsGood()) return;
+  if (IsSaving()) {
+    *m_out << ' ' << (long long)value;
+    return;
+  }
+  long long wide = 0;
+  if (!(*m_in >> wide)) Fail("invalid integer in checkpoint");
+  value = wide;
+}
+
+void cStateArchive::Transfer(unsigned char& value)
+{
+  unsigned int wide = value;
+  Transfer(wide);
+  value = (unsigned char)wide;
+}
+
+void cStateArchive::Transfer(bool& value)
+{
+  int wide = value;
+  Transfer(wide);
+  value = (wide != 0);
+}
+
+void cStateArchive::Transfer(double& value)
+{
+  if (!IsGood()) return;
+  if (IsSaving()) {
+    // 17 significant digits round trip any double exactly; inf and nan are written by name
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", value);
+    *m_out << ' ' << buf;
+    return;
+  }
+
+  cString token;
+  if (!readToken(token)) return;
+  char* end = NULL;
+  value = strtod(token, &end);
+  if (end == NULL || *end != '\0') Fail(cStringUtil::Stringf("invalid number '%s' in checkpoint", (const char*)token));
+}
+
+void cStateArchive::Transfer(cString& value)
+{
+  // Strings are length prefixed so that they may contain whitespace
+  int size = value.GetSize();
+  Transfer(size);
+  if (!IsGood()) return;
+
+  if (IsSaving()) {
+    *m_out << ' ';
+    m_out->write(value, size);
+    return;
+  }
+
+  if (size < 0) {
+    Fail("invalid string length in checkpoint");
+    return;
+  }
+  m_in->get();  // separator
+  string str(size, '\0');
+  if (size) m_in->read(&str[0], size);
+  if (!*m_in) {
+    Fail("unexpected end of checkpoint");
+    return;
+  }
+  value = str.c_str();
+}
+
+void cStateArchive::TransferSize(int size, const char* what)
+{
+  int saved = size;
+  Transfer(saved);
+  if (IsGood() && saved != size) {
+    Fail(cStringUtil::Stringf("checkpoint %s size %d does not match the current configuration (%d)", what, saved, size));
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ *  cStateArchive.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cStateArchive_h
+#define cStateArchive_h
+
+#include "apto/core.h"
+#include "cString.h"
+
+#include <iostream>
+#include <stdint.h>
+
+
+// cStateArchive - bidirectional stream used by the full state checkpoint
+//
+// Classes implement a single CheckpointState(cStateArchive&) method that names every field once; the archive either
+// writes the fields or reads them back into place, so the save and load paths can not drift apart.  Values are written
+// as whitespace separated text tokens, and doubles are written with enough precision to reload bit-exactly.
+//
+// Tag() marks the start of each object's state, so that a checkpoint written by a different layout is rejected at the
+// first mismatch instead of loading garbage.  Once an error has occurred all further transfers are ignored; callers
+// check IsGood() (or GetError()) when they are done.
+
+class cStateArchive
+{
+private:
+  std::ostream* m_out;
+  std::istream* m_in;
+  cString m_error;
+
+  cStateArchive(); // @not_implemented
+  cStateArchive(const cStateArchive&); // @not_implemented
+  cStateArchive& operator=(const cStateArchive&); // @not_implemented
+
+  bool readToken(cString& token);
+
+public:
+  explicit cStateArchive(std::ostream& out) : m_out(&out), m_in(NULL) { ; }
+  explicit cStateArchive(std::istream& in) : m_out(NULL), m_in(&in) { ; }
+
+  inline bool IsSaving() const { return m_out != NULL; }
+  inline bool IsLoading() const { return m_in != NULL; }
+  inline bool IsGood() const { return m_error.GetSize() == 0; }
+  inline const cString& GetError() const { return m_error; }
+
+  // Records the first error encountered, later errors are generally consequences of the first
+  void Fail(const cString& error);
+
+  void Tag(const char* name);
+
+  void Transfer(int& value);
+  void Transfer(unsigned int& value);
+  void Transfer(int64_t& value);
+  void Transfer(unsigned char& value);
+  void Transfer(bool& value);
+  void Transfer(double& value);
+  void Transfer(cString& value);
+
+  // Bit-field members can not be bound to references, so they are transferred through a temporary
+  template <typename T> inline T TransferValue(T value) { Transfer(value); return value; }
+
+  template <typename T, template <class> class S> void Transfer(Apto::Array<T, S>& values)
+  {
+    int size = values.GetSize();
+    Transfer(size);
+    if (!IsGood()) return;
+    if (IsLoading()) values.ResizeClear(size);
+    for (int i = 0; i < size; i++) Transfer(values[i]);
+  }
+
+  // Transfers a size that must match the already configured size of the object being loaded
+  void TransferSize(int size, const char* what);
+};
+
+#endif
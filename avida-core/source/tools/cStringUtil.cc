@@ -129,6 +129,24 @@ int cStringUtil::Distance(const cString & string1, const cString & string2,
 }
 
 
+uint64_t cStringUtil::Hash(const cString& str)
+{
+  return Hash(str, 0xCBF29CE484222325ull);
+}
+
+uint64_t cStringUtil::Hash(const cString& str, uint64_t hash)
+{
+  const uint64_t FNV_PRIME = 0x100000001B3ull;
+  for (int i = 0; i < str.GetSize(); i++) {
+    hash ^= (unsigned char)str[i];
+    hash *= FNV_PRIME;
+  }
+  
+  // Include the terminating NUL, so that consecutive strings can not run together
+  return hash * FNV_PRIME;
+}
+
+
 int cStringUtil::EditDistance(const cString & string1, const cString & string2)
 {
   const int size1 = string1.GetSize();
@@ -25,6 +25,8 @@
 
 #include "cString.h"
 
+#include <stdint.h>
+
 
 class cStringUtil
 {
@@ -58,6 +60,16 @@ public:
   static int EditDistance(const cString& string1, const cString& string2);
   static int EditDistance(const cString& string1, const cString& string2, cString& info, const char gap = ' '); 
 
+  /**
+   * Calculate a 64-bit (FNV-1a) hash of a string.
+   *
+   * @return The hash value.
+   * @param str the string to hash.
+   * @param hash a previous result to continue from, so that several strings can be hashed as one sequence.
+   **/
+  static uint64_t Hash(const cString& str);
+  static uint64_t Hash(const cString& str, uint64_t hash);
+
   /**
    * Various, overloaded conversion functions for use in templates.  Note
    * that in all cases, the second argument is simply to set the return type.
@@ -23,6 +23,7 @@
 #ifndef tBuffer_h
 #define tBuffer_h
 
+#include "cStateArchive.h"
 #include "cString.h"
 
 #include <cassert>
@@ -81,6 +82,15 @@ public:
   int GetTotal() const { return total; }
   int GetNumStored() const { return (total <= data.GetSize()) ? total : data.GetSize(); }
   int GetNum() const { return total - last_total; }
+
+  void CheckpointState(cStateArchive& ar)
+  {
+    ar.Tag("tBuffer");
+    ar.Transfer(data);
+    ar.Transfer(offset);
+    ar.Transfer(total);
+    ar.Transfer(last_total);
+  }
 };
 
 #endif
@@ -27,6 +27,7 @@
 #include "avida/data/Manager.h"
 #include "avida/environment/ActionTrigger.h"
 #include "avida/environment/Manager.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Manager.h"
 #include "avida/viewer/Map.h"
 #include "avida/viewer/Listener.h"
@@ -213,7 +214,7 @@ int Avida::Viewer::Driver::RandomSeed()
 void Avida::Viewer::Driver::SetRandomSeed(int seed)
 {
   m_world->GetConfig().RANDOM_SEED.Set(seed);
-  m_world->GetRandom().ResetSeed(seed);
+  m_world->ResetRandomSeed(seed);
   
   // When resetting the random seed, the timeslicer also needs to be rebuilt, since it may use the RNG
   // Resizing the cell grid triggers the reconstruction of the timeslicer, so...
@@ -342,6 +343,7 @@ void Avida::Viewer::Driver::Run()
         m_world->GetConfig().THREAD_SLICING_METHOD.Get() != 1 && !m_world->GetConfig().IMPLICIT_REPRO_END.Get()) {
       ActiveProcessStep = &cPopulation::ProcessStepSpeculative;
     }
+    const int burst_size = m_world->GetConfig().BURST_SIZE.Get();
     
     cAvidaContext ctx(this, m_world->GetRandom());
     Avida::Context new_ctx(this, &m_world->GetRandom());
@@ -393,7 +395,13 @@ void Avida::Viewer::Driver::Run()
   //      }
   //    }
   //    else {
-        for (int i = 0; i < UD_size; i++) (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
+        if (burst_size > 1) {
+          for (int i = 0; i < UD_size;) {
+            i += population.ProcessBurst(ctx, step_size, population.ScheduleOrganism(), Apto::Min(burst_size, UD_size - i));
+          }
+        } else {
+          for (int i = 0; i < UD_size; i++) (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
+        }
   //    }
       
       
@@ -464,6 +472,7 @@ void Avida::Viewer::Driver::Run()
   } catch (Avida::AbortCondition condition) {
     cerr << "abort: " << condition << endl;
   }
+  Avida::Output::Manager::Of(m_new_world)->FlushAll();
   m_callback(THREAD_END);
 }
 
@@ -128,6 +128,431 @@ Private::InstructionColorChartPtr Private::InstructionColorChart::OfInstSetForGr
 
 
 
+// Private::SnapshotArena
+// --------------------------------------------------------------------------------------------------------------  
+//
+// The snapshots of a trace, stored back to back in a single array of words.  Every KEYFRAME_INTERVAL snapshots a
+// keyframe holds the complete encoded state and jump table; the snapshots in between hold only the encoded words that
+// changed since the one before, plus the jump taken.  A snapshot is rebuilt by playing forward from the nearest
+// keyframe, or from the last snapshot rebuilt when stepping forward through the trace.
+//
+// Encoded state (strings are stored once, and referred to by index):
+//   post_divide, next_inst, selected_buffer
+//   num_registers, values...
+//   num_buffers, { description, size, values... }...
+//   num_functions, { function, count }...
+//   num_heads, { label, mem_space, index }...
+//   num_mem_spaces, { label, length, { inst << 1 | mutated }... }...
+//
+// The memory spaces come last, so that a growing offspring only adds words to the end of the state.
+//
+// Records:
+//   keyframe:  state_length, state..., num_jumps, { from_mem_space, from_idx, to_mem_space, to_idx, freq }...
+//   delta:     has_jump, [from_mem_space, from_idx, to_mem_space, to_idx], state_length, num_changes,
+//              { offset, value }...
+
+class Private::SnapshotArena
+{
+private:
+  static const int KEYFRAME_INTERVAL = 256;
+  static const int CACHE_SIZE = 4;
+  static const int JUMP_WORDS = 5;
+  
+  const cInstSet* m_inst_set;
+  Apto::Array<Apto::String, Apto::Smart> m_strings;
+  Apto::Map<Apto::String, int> m_string_ids;
+  
+  Apto::Array<int, Apto::Smart> m_words;
+  Apto::Array<int, Apto::Smart> m_records;    // offset of each snapshot in m_words
+  
+  // Recording
+  Apto::Array<int, Apto::Smart> m_state;
+  Apto::Array<int, Apto::Smart> m_last_state;
+  Apto::Array<int, Apto::Smart> m_jumps;
+  
+  // Playback
+  int m_cursor;
+  Apto::Array<int, Apto::Smart> m_cur_state;
+  Apto::Array<int, Apto::Smart> m_cur_jumps;
+  
+  struct CachedSnapshot
+  {
+    int idx;
+    unsigned int last_use;
+    ConstHardwareSnapshotPtr snapshot;
+  };
+  CachedSnapshot m_cache[CACHE_SIZE];
+  unsigned int m_use_count;
+  
+  
+  LIB_LOCAL SnapshotArena(const SnapshotArena&); // @not_implemented
+  LIB_LOCAL SnapshotArena& operator=(const SnapshotArena&); // @not_implemented
+  
+public:
+  LIB_LOCAL SnapshotArena();
+  LIB_LOCAL ~SnapshotArena();
+  
+  LIB_LOCAL inline int GetSize() const { return m_records.GetSize(); }
+  
+  LIB_LOCAL void AddSnapshot(const HardwareSnapshot& snapshot);
+  LIB_LOCAL void AddSnapshot(const HardwareSnapshot& snapshot, int from_mem_space, int from_idx, int to_mem_space,
+                             int to_idx);
+  
+  LIB_LOCAL ConstHardwareSnapshotPtr Snapshot(int idx);
+  LIB_LOCAL int FirstWithFunction(const Apto::String& function) const;
+  
+private:
+  LIB_LOCAL int stringID(const Apto::String& str);
+  LIB_LOCAL void encode(const HardwareSnapshot& snapshot, Apto::Array<int, Apto::Smart>& state);
+  LIB_LOCAL HardwareSnapshot* decode(const Apto::Array<int, Apto::Smart>& state,
+                                     const Apto::Array<int, Apto::Smart>& jumps) const;
+  LIB_LOCAL void record(const HardwareSnapshot& snapshot, bool has_jump, int from_mem_space, int from_idx,
+                        int to_mem_space, int to_idx);
+  LIB_LOCAL void seek(int idx);
+  
+  LIB_LOCAL static int locateFunction(const Apto::Array<int, Apto::Smart>& state, int function_id,
+                                      Apto::Array<bool>& layout);
+  LIB_LOCAL static void addJump(Apto::Array<int, Apto::Smart>& jumps, int from_mem_space, int from_idx,
+                                int to_mem_space, int to_idx);
+};
+
+
+
+
+// Private::SnapshotArena Implementation
+// --------------------------------------------------------------------------------------------------------------  
+
+Private::SnapshotArena::SnapshotArena() : m_inst_set(NULL), m_cursor(-1), m_use_count(0)
+{
+  for (int i = 0; i < CACHE_SIZE; i++) {
+    m_cache[i].idx = -1;
+    m_cache[i].last_use = 0;
+  }
+}
+
+
+Private::SnapshotArena::~SnapshotArena()
+{
+}
+
+
+void Private::SnapshotArena::AddSnapshot(const HardwareSnapshot& snapshot)
+{
+  record(snapshot, false, 0, 0, 0, 0);
+}
+
+
+void Private::SnapshotArena::AddSnapshot(const HardwareSnapshot& snapshot, int from_mem_space, int from_idx,
+                                         int to_mem_space, int to_idx)
+{
+  record(snapshot, true, from_mem_space, from_idx, to_mem_space, to_idx);
+}
+
+
+ConstHardwareSnapshotPtr Private::SnapshotArena::Snapshot(int idx)
+{
+  assert(idx >= 0 && idx < m_records.GetSize());
+  
+  // Reuse a snapshot still in the cache, otherwise replace the least recently used one.  Callers still holding the
+  // replaced snapshot keep it alive.
+  m_use_count++;
+  CachedSnapshot* slot = &m_cache[0];
+  for (int i = 0; i < CACHE_SIZE; i++) {
+    if (m_cache[i].snapshot && m_cache[i].idx == idx) {
+      m_cache[i].last_use = m_use_count;
+      return m_cache[i].snapshot;
+    }
+    if (m_cache[i].last_use < slot->last_use) slot = &m_cache[i];
+  }
+  
+  seek(idx);
+  slot->snapshot = ConstHardwareSnapshotPtr(decode(m_cur_state, m_cur_jumps));
+  slot->idx = idx;
+  slot->last_use = m_use_count;
+  
+  return slot->snapshot;
+}
+
+
+int Private::SnapshotArena::FirstWithFunction(const Apto::String& function) const
+{
+  int function_id = -1;
+  if (!m_string_ids.Get(function, function_id)) return -1;
+  
+  // Play the records forward over the encoded words alone, without rebuilding any snapshot.  The position of the count
+  // is only looked up again when a word that the layout of the state depends on changes.
+  Apto::Array<int, Apto::Smart> state;
+  Apto::Array<bool> layout;
+  int count_pos = -1;
+  for (int idx = 0; idx < m_records.GetSize(); idx++) {
+    int pos = m_records[idx];
+    bool relocate = false;
+    if (idx % KEYFRAME_INTERVAL == 0) {
+      state.Resize(m_words[pos++]);
+      for (int i = 0; i < state.GetSize(); i++) state[i] = m_words[pos++];
+      relocate = true;
+    } else {
+      if (m_words[pos++]) pos += 4;
+      state.Resize(m_words[pos++]);
+      const int num_changes = m_words[pos++];
+      for (int i = 0; i < num_changes; i++, pos += 2) {
+        const int offset = m_words[pos];
+        state[offset] = m_words[pos + 1];
+        if (offset < layout.GetSize() && layout[offset]) relocate = true;
+      }
+    }
+    
+    if (relocate) count_pos = locateFunction(state, function_id, layout);
+    if (count_pos >= 0 && state[count_pos] > 0) return idx;
+  }
+  
+  return -1;
+}
+
+
+int Private::SnapshotArena::stringID(const Apto::String& str)
+{
+  int id = -1;
+  if (!m_string_ids.Get(str, id)) {
+    id = m_strings.GetSize();
+    m_strings.Push(str);
+    m_string_ids.Set(str, id);
+  }
+  return id;
+}
+
+
+void Private::SnapshotArena::encode(const HardwareSnapshot& snapshot, Apto::Array<int, Apto::Smart>& state)
+{
+  state.Resize(0);
+  
+  state.Push(snapshot.m_post_divide ? 1 : 0);
+  state.Push(snapshot.m_next_inst.GetOp());
+  state.Push(stringID(snapshot.m_selected_buffer));
+  
+  state.Push(snapshot.m_registers.GetSize());
+  for (int i = 0; i < snapshot.m_registers.GetSize(); i++) state.Push(snapshot.m_registers[i]);
+  
+  state.Push(snapshot.m_buffers.GetSize());
+  for (Apto::Map<Apto::String, Apto::Array<int> >::ConstIterator it = snapshot.m_buffers.Begin(); it.Next(); ) {
+    const Apto::Array<int>& values = *it.Get()->Value2();
+    state.Push(stringID(it.Get()->Value1()));
+    state.Push(values.GetSize());
+    for (int i = 0; i < values.GetSize(); i++) state.Push(values[i]);
+  }
+  
+  state.Push(snapshot.m_function_counts.GetSize());
+  for (Apto::Map<Apto::String, int>::ConstIterator it = snapshot.m_function_counts.Begin(); it.Next(); ) {
+    state.Push(stringID(it.Get()->Value1()));
+    state.Push(*it.Get()->Value2());
+  }
+  
+  int num_heads = 0;
+  for (int ms = 0; ms < snapshot.m_mem_spaces.GetSize(); ms++) num_heads += snapshot.m_mem_spaces[ms].heads.GetSize();
+  state.Push(num_heads);
+  for (int ms = 0; ms < snapshot.m_mem_spaces.GetSize(); ms++) {
+    const Apto::Map<Apto::String, int>& heads = snapshot.m_mem_spaces[ms].heads;
+    for (Apto::Map<Apto::String, int>::ConstIterator it = heads.Begin(); it.Next(); ) {
+      state.Push(stringID(it.Get()->Value1()));
+      state.Push(ms);
+      state.Push(*it.Get()->Value2());
+    }
+  }
+  
+  state.Push(snapshot.m_mem_spaces.GetSize());
+  for (int ms = 0; ms < snapshot.m_mem_spaces.GetSize(); ms++) {
+    const HardwareSnapshot::MemSpace& mem_space = snapshot.m_mem_spaces[ms];
+    state.Push(stringID(mem_space.label));
+    state.Push(mem_space.memory.GetSize());
+    for (int i = 0; i < mem_space.memory.GetSize(); i++) {
+      state.Push((mem_space.memory[i].GetOp() << 1) | (mem_space.mutated[i] ? 1 : 0));
+    }
+  }
+}
+
+
+HardwareSnapshot* Private::SnapshotArena::decode(const Apto::Array<int, Apto::Smart>& state,
+                                                 const Apto::Array<int, Apto::Smart>& jumps) const
+{
+  int pos = 0;
+  
+  const bool post_divide = state[pos++];
+  const Instruction next_inst(state[pos++]);
+  const Apto::String& selected_buffer = m_strings[state[pos++]];
+  
+  const int num_regs = state[pos++];
+  HardwareSnapshot* snapshot = new HardwareSnapshot(num_regs);
+  snapshot->SetInstSet(*m_inst_set);
+  if (post_divide) snapshot->SetPostDivide();
+  snapshot->SetNextInst(next_inst);
+  snapshot->SetSelectedBuffer(selected_buffer);
+  
+  for (int i = 0; i < num_regs; i++) snapshot->SetRegister(i, state[pos++]);
+  
+  const int num_buffers = state[pos++];
+  Apto::Array<int> values;
+  for (int b = 0; b < num_buffers; b++) {
+    const Apto::String& description = m_strings[state[pos++]];
+    values.Resize(state[pos++]);
+    for (int i = 0; i < values.GetSize(); i++) values[i] = state[pos++];
+    snapshot->AddBuffer(description, values);
+  }
+  
+  const int num_functions = state[pos++];
+  for (int f = 0; f < num_functions; f++, pos += 2) snapshot->SetFunctionCount(m_strings[state[pos]], state[pos + 1]);
+  
+  // Heads are added once their memory spaces exist
+  const int num_heads = state[pos++];
+  const int heads_pos = pos;
+  pos += num_heads * 3;
+  
+  const int num_mem_spaces = state[pos++];
+  Apto::Array<Instruction> memory;
+  Apto::Array<bool> mutated;
+  for (int ms = 0; ms < num_mem_spaces; ms++) {
+    const Apto::String& label = m_strings[state[pos++]];
+    memory.Resize(state[pos++]);
+    mutated.Resize(memory.GetSize());
+    for (int i = 0; i < memory.GetSize(); i++, pos++) {
+      memory[i] = Instruction(state[pos] >> 1);
+      mutated[i] = state[pos] & 1;
+    }
+    snapshot->AddMemSpace(label, memory, mutated);
+  }
+  
+  for (int h = 0; h < num_heads; h++) {
+    const int head_pos = heads_pos + h * 3;
+    snapshot->AddHead(m_strings[state[head_pos]], state[head_pos + 1], state[head_pos + 2]);
+  }
+  
+  for (int j = 0; j < jumps.GetSize(); j += JUMP_WORDS) {
+    snapshot->m_jumps.Push(HardwareSnapshot::Jump(jumps[j], jumps[j + 1], jumps[j + 2], jumps[j + 3], jumps[j + 4]));
+  }
+  
+  return snapshot;
+}
+
+
+void Private::SnapshotArena::record(const HardwareSnapshot& snapshot, bool has_jump, int from_mem_space, int from_idx,
+                                    int to_mem_space, int to_idx)
+{
+  assert(m_inst_set == NULL || m_inst_set == snapshot.m_inst_set);
+  m_inst_set = snapshot.m_inst_set;
+  
+  encode(snapshot, m_state);
+  if (has_jump) addJump(m_jumps, from_mem_space, from_idx, to_mem_space, to_idx);
+  
+  const int idx = m_records.GetSize();
+  m_records.Push(m_words.GetSize());
+  
+  if (idx % KEYFRAME_INTERVAL == 0) {
+    m_words.Push(m_state.GetSize());
+    for (int i = 0; i < m_state.GetSize(); i++) m_words.Push(m_state[i]);
+    m_words.Push(m_jumps.GetSize() / JUMP_WORDS);
+    for (int i = 0; i < m_jumps.GetSize(); i++) m_words.Push(m_jumps[i]);
+  } else {
+    m_words.Push(has_jump ? 1 : 0);
+    if (has_jump) {
+      m_words.Push(from_mem_space);
+      m_words.Push(from_idx);
+      m_words.Push(to_mem_space);
+      m_words.Push(to_idx);
+    }
+    m_words.Push(m_state.GetSize());
+    
+    // Count of changes is filled in once they have been written
+    const int count_pos = m_words.GetSize();
+    m_words.Push(0);
+    int num_changes = 0;
+    for (int i = 0; i < m_state.GetSize(); i++) {
+      if (i < m_last_state.GetSize() && m_state[i] == m_last_state[i]) continue;
+      m_words.Push(i);
+      m_words.Push(m_state[i]);
+      num_changes++;
+    }
+    m_words[count_pos] = num_changes;
+  }
+  
+  m_last_state = m_state;
+}
+
+
+void Private::SnapshotArena::seek(int idx)
+{
+  const int keyframe = idx - idx % KEYFRAME_INTERVAL;
+  
+  if (m_cursor < keyframe || m_cursor > idx) {
+    int pos = m_records[keyframe];
+    m_cur_state.Resize(m_words[pos++]);
+    for (int i = 0; i < m_cur_state.GetSize(); i++) m_cur_state[i] = m_words[pos++];
+    m_cur_jumps.Resize(m_words[pos++] * JUMP_WORDS);
+    for (int i = 0; i < m_cur_jumps.GetSize(); i++) m_cur_jumps[i] = m_words[pos++];
+    m_cursor = keyframe;
+  }
+  
+  while (m_cursor < idx) {
+    int pos = m_records[++m_cursor];
+    if (m_words[pos++]) {
+      addJump(m_cur_jumps, m_words[pos], m_words[pos + 1], m_words[pos + 2], m_words[pos + 3]);
+      pos += 4;
+    }
+    m_cur_state.Resize(m_words[pos++]);
+    const int num_changes = m_words[pos++];
+    for (int i = 0; i < num_changes; i++, pos += 2) m_cur_state[m_words[pos]] = m_words[pos + 1];
+  }
+}
+
+
+int Private::SnapshotArena::locateFunction(const Apto::Array<int, Apto::Smart>& state, int function_id,
+                                           Apto::Array<bool>& layout)
+{
+  // Marks the words that determine where the function counts are: the register and buffer sizes, and the functions
+  layout.Resize(state.GetSize());
+  layout.SetAll(false);
+  
+  int pos = 3;
+  layout[pos] = true;
+  pos += state[pos] + 1;
+  
+  const int num_buffers = state[pos];
+  layout[pos++] = true;
+  for (int b = 0; b < num_buffers; b++) {
+    layout[++pos] = true;
+    pos += state[pos] + 1;
+  }
+  
+  int count_pos = -1;
+  const int num_functions = state[pos];
+  layout[pos++] = true;
+  for (int f = 0; f < num_functions; f++, pos += 2) {
+    layout[pos] = true;
+    if (state[pos] == function_id) count_pos = pos + 1;
+  }
+  
+  return count_pos;
+}
+
+
+void Private::SnapshotArena::addJump(Apto::Array<int, Apto::Smart>& jumps, int from_mem_space, int from_idx,
+                                     int to_mem_space, int to_idx)
+{
+  for (int j = 0; j < jumps.GetSize(); j += JUMP_WORDS) {
+    if (jumps[j] == from_mem_space && jumps[j + 1] == from_idx &&
+        jumps[j + 2] == to_mem_space && jumps[j + 3] == to_idx) {
+      jumps[j + 4]++;
+      return;
+    }
+  }
+  jumps.Push(from_mem_space);
+  jumps.Push(from_idx);
+  jumps.Push(to_mem_space);
+  jumps.Push(to_idx);
+  jumps.Push(1);
+}
+
+
+
+
 // Private::SnapshotTracer
 // --------------------------------------------------------------------------------------------------------------  
 
@@ -143,21 +568,21 @@ private:
     void Notify(const char* fmt, ...) { (void)fmt; }
   } m_feedback;
 
-  Apto::Array<HardwareSnapshot*>* m_snapshots;
-  int m_snapshot_count;
+  SnapshotArena* m_arena;
   
   int m_genome_length;
   Instruction m_first_inst;
   int m_last_mem_space;
   int m_last_idx;
+  Apto::Array<bool> m_offspring_mutated;
   GenomePtr m_genome;
   GenomePtr m_offspring_genome;
   
 
 public:
-  LIB_LOCAL inline SnapshotTracer(cWorld* world) : m_world(world), m_snapshots(NULL) { ; }
+  LIB_LOCAL inline SnapshotTracer(cWorld* world) : m_world(world), m_arena(NULL) { ; }
   
-  LIB_LOCAL void TraceGenome(GenomePtr genome, Apto::Array<HardwareSnapshot*>& snapshots, double mut_rate, int seed);
+  LIB_LOCAL void TraceGenome(GenomePtr genome, SnapshotArena& arena, double mut_rate, int seed);
   
   LIB_LOCAL GenomePtr OffspringGenome() { return m_offspring_genome; }
   
@@ -183,15 +608,12 @@ public:
 // Private::SnapshotTracer Implementation
 // --------------------------------------------------------------------------------------------------------------  
 
-void Private::SnapshotTracer::TraceGenome(GenomePtr genome, Apto::Array<HardwareSnapshot*>& snapshots, double mut_rate, int seed)
+void Private::SnapshotTracer::TraceGenome(GenomePtr genome, SnapshotArena& arena, double mut_rate, int seed)
 {
-  // Create internal reference to the snapshot array so that the tracing methods can create snapshots
-  m_snapshots = &snapshots;
-  m_snapshots->Resize(300);
+  // Create internal reference to the snapshot arena so that the tracing methods can record snapshots
+  m_arena = &arena;
   
   // Set up tracking objects and variables
-  m_snapshot_count = 0;
-  
   InstructionSequencePtr seq;
   seq.DynamicCastFrom(genome->Representation());
   m_genome_length = seq->GetSize();
@@ -222,8 +644,8 @@ void Private::SnapshotTracer::TraceGenome(GenomePtr genome, Apto::Array<Hardware
   // Test the actual genome
   testcpu->TestGenome(ctx, test_info, *genome);
   
-  // Clear internal reference to the snapshot array
-  m_snapshots = NULL;
+  // Clear internal reference to the snapshot arena
+  m_arena = NULL;
   
   m_genome = GenomePtr();
 }
@@ -237,45 +659,39 @@ void Private::SnapshotTracer::TraceHardware(cAvidaContext& ctx, cHardwareBase& h
   
   if (mini) return;
   
-  // Create snapshot based on current hardware state
-  m_snapshot_count++;
-  
-  // Make sure snapshot array is big enough (just in case bonus cycles or threads are in use)
-  if (m_snapshots->GetSize() < m_snapshot_count) m_snapshots->Resize(m_snapshots->GetSize() * 2);
+  // Create snapshot based on current hardware state, it is recorded into the arena once complete
+  HardwareSnapshot snapshot(hw.GetNumRegisters());
+  m_offspring_mutated.Resize(0);
   
-  HardwareSnapshot* prev_snapshot = (m_snapshot_count > 1) ? (*m_snapshots)[m_snapshot_count - 2] : NULL;
-  HardwareSnapshot* snapshot = new HardwareSnapshot(hw.GetNumRegisters(), prev_snapshot);
-  (*m_snapshots)[m_snapshot_count - 1] = snapshot;
-  
-  snapshot->SetInstSet(hw.GetInstSet());
+  snapshot.SetInstSet(hw.GetInstSet());
   
   // Store register states
-  for (int reg = 0; reg < hw.GetNumRegisters(); reg++) snapshot->SetRegister(reg, hw.GetRegister(reg));
+  for (int reg = 0; reg < hw.GetNumRegisters(); reg++) snapshot.SetRegister(reg, hw.GetRegister(reg));
   
   Apto::Array<int> buffer_values;
 
   // Handle Input Buffer
   buffer_values.Resize(hw.GetInputBuf().GetCapacity());
   for (int i = 0; i < hw.GetInputBuf().GetCapacity(); i++) buffer_values[i] = hw.GetInputBuf()[i];
-  snapshot->AddBuffer("input", buffer_values);
+  snapshot.AddBuffer("input", buffer_values);
   
   // Handle Output Buffer
   buffer_values.Resize(hw.GetOutputBuf().GetCapacity());
   for (int i = 0; i < hw.GetOutputBuf().GetCapacity(); i++) buffer_values[i] = hw.GetOutputBuf()[i];
-  snapshot->AddBuffer("output", buffer_values);
+  snapshot.AddBuffer("output", buffer_values);
   
   // Handle Stacks
   buffer_values.Resize(nHardware::STACK_SIZE);
   for (int stk = 0; stk < hw.GetNumStacks(); stk++) {
     for (int i = 0; i < nHardware::STACK_SIZE; i++) buffer_values[i] = hw.GetStack(i, stk);
-    snapshot->AddBuffer(Apto::FormatStr("stack %c", 'A' + stk), buffer_values);
+    snapshot.AddBuffer(Apto::FormatStr("stack %c", 'A' + stk), buffer_values);
   }
-  snapshot->SetSelectedBuffer(Apto::FormatStr("stack %c", 'A' + hw.GetCurStack()));
+  snapshot.SetSelectedBuffer(Apto::FormatStr("stack %c", 'A' + hw.GetCurStack()));
   
   // Handle function counts
   const Apto::Array<int>& task_counts = hw.GetOrganism()->GetPhenotype().GetCurTaskCount();
   for (int i = 0; i < task_counts.GetSize(); i++) {
-    snapshot->SetFunctionCount((const char*)m_world->GetEnvironment().GetTask(i).GetName(), task_counts[i]);
+    snapshot.SetFunctionCount((const char*)m_world->GetEnvironment().GetTask(i).GetName(), task_counts[i]);
   }
   
   // Handle memory spaces
@@ -289,7 +705,7 @@ void Private::SnapshotTracer::TraceHardware(cAvidaContext& ctx, cHardwareBase& h
     memory[i] = hw.GetMemory()[i];
     mutated[i] = hw.GetMemory().FlagMutated(i);
   }
-  snapshot->AddMemSpace("genome", memory, mutated);
+  snapshot.AddMemSpace("genome", memory, mutated);
   
   // - handle all heads that are in the first part of the memory space
   for (int i = 0; i < hw.GetNumHeads(); i++) {
@@ -297,7 +713,7 @@ void Private::SnapshotTracer::TraceHardware(cAvidaContext& ctx, cHardwareBase& h
     if (i == 0) name = "IP";
     if (i == 1) name = "READ";
     if (i == 2) name = "WRITE";
-    if (hw.GetHead(i).GetPosition() < m_genome_length) snapshot->AddHead(name, 0, hw.GetHead(i).GetPosition());
+    if (hw.GetHead(i).GetPosition() < m_genome_length) snapshot.AddHead(name, 0, hw.GetHead(i).GetPosition());
   }
   // - handle the offspring part of the memory
   memory.Resize(hw.GetMemory().GetSize() - memory.GetSize());
@@ -323,7 +739,8 @@ void Private::SnapshotTracer::TraceHardware(cAvidaContext& ctx, cHardwareBase& h
     // truncate the offspring part of the memory to the position of the last head
     memory.Resize(max_head_pos - m_genome_length + 1);
     mutated.Resize(memory.GetSize());
-    snapshot->AddMemSpace("offspring", memory, mutated);
+    snapshot.AddMemSpace("offspring", memory, mutated);
+    m_offspring_mutated = mutated;
     
     // handle all heads that are in the second part of the memory space
     for (int i = 0; i < hw.GetNumHeads(); i++) {
@@ -331,19 +748,19 @@ void Private::SnapshotTracer::TraceHardware(cAvidaContext& ctx, cHardwareBase& h
       if (i == 0) name = "IP";
       if (i == 1) name = "READ";
       if (i == 2) name = "WRITE";
-      if (hw.GetHead(i).GetPosition() >= m_genome_length) snapshot->AddHead(name, 1, hw.GetHead(i).GetPosition() - m_genome_length);
+      if (hw.GetHead(i).GetPosition() >= m_genome_length) snapshot.AddHead(name, 1, hw.GetHead(i).GetPosition() - m_genome_length);
     }
   }  
   
-  // Add/Update jump based on this current instruction execution
-  snapshot->AddJump(m_last_mem_space, m_last_idx, hw.IP().GetMemSpace(), hw.IP().GetPosition());
+  // Store next instruction that will be executed
+  snapshot.SetNextInst(hw.IP().GetInst());
+  
+  // Record the snapshot, along with the jump made by this current instruction execution
+  m_arena->AddSnapshot(snapshot, m_last_mem_space, m_last_idx, hw.IP().GetMemSpace(), hw.IP().GetPosition());
   
   // Cache the head position for calculating the next jump
   m_last_mem_space = hw.IP().GetMemSpace();
   m_last_idx = hw.IP().GetPosition();  
-  
-  // Store next instruction that will be executed
-  snapshot->SetNextInst(hw.IP().GetInst());
 }
 
 
@@ -358,47 +775,40 @@ void Private::SnapshotTracer::TraceTestCPU(int time_used, int time_allocated, co
   // Did the organism successfully reproduce before running out of time?
   if (time_used != time_allocated) {
     // Create snapshot based on current hardware state
-    m_snapshot_count++;
-    
-    // Make sure snapshot array is big enough (just in case bonus cycles or threads are in use)
-    if (m_snapshots->GetSize() < m_snapshot_count) m_snapshots->Resize(m_snapshots->GetSize() * 2);
-    
     cHardwareBase& hw = const_cast<cHardwareBase&>(organism.GetHardware());
     
-    HardwareSnapshot* prev_snapshot = (m_snapshot_count > 1) ? (*m_snapshots)[m_snapshot_count - 2] : NULL;
-    HardwareSnapshot* snapshot = new HardwareSnapshot(hw.GetNumRegisters(), prev_snapshot);
-    (*m_snapshots)[m_snapshot_count - 1] = snapshot;
+    HardwareSnapshot snapshot(hw.GetNumRegisters());
     
-    snapshot->SetInstSet(organism.GetHardware().GetInstSet());
-    snapshot->SetPostDivide();
+    snapshot.SetInstSet(organism.GetHardware().GetInstSet());
+    snapshot.SetPostDivide();
     
     // Store register states
-    for (int reg = 0; reg < hw.GetNumRegisters(); reg++) snapshot->SetRegister(reg, hw.GetRegister(reg));
+    for (int reg = 0; reg < hw.GetNumRegisters(); reg++) snapshot.SetRegister(reg, hw.GetRegister(reg));
     
     Apto::Array<int> buffer_values;
     
     // Handle Input Buffer
     buffer_values.Resize(hw.GetInputBuf().GetCapacity());
     for (int i = 0; i < hw.GetInputBuf().GetCapacity(); i++) buffer_values[i] = hw.GetInputBuf()[i];
-    snapshot->AddBuffer("input", buffer_values);
+    snapshot.AddBuffer("input", buffer_values);
     
     // Handle Output Buffer
     buffer_values.Resize(hw.GetOutputBuf().GetCapacity());
     for (int i = 0; i < hw.GetOutputBuf().GetCapacity(); i++) buffer_values[i] = hw.GetOutputBuf()[i];
-    snapshot->AddBuffer("output", buffer_values);
+    snapshot.AddBuffer("output", buffer_values);
     
     // Handle Stacks
     buffer_values.Resize(nHardware::STACK_SIZE);
     for (int stk = 0; stk < hw.GetNumStacks(); stk++) {
       for (int i = 0; i < nHardware::STACK_SIZE; i++) buffer_values[i] = hw.GetStack(i, stk);
-      snapshot->AddBuffer(Apto::FormatStr("stack %c", 'A' + stk), buffer_values);
+      snapshot.AddBuffer(Apto::FormatStr("stack %c", 'A' + stk), buffer_values);
     }
-    snapshot->SetSelectedBuffer(Apto::FormatStr("stack %c", 'A' + hw.GetCurStack()));
+    snapshot.SetSelectedBuffer(Apto::FormatStr("stack %c", 'A' + hw.GetCurStack()));
     
     // Handle function counts
     const Apto::Array<int>& task_counts = organism.GetPhenotype().GetLastTaskCount();
     for (int i = 0; i < task_counts.GetSize(); i++) {
-      snapshot->SetFunctionCount((const char*)m_world->GetEnvironment().GetTask(i).GetName(), task_counts[i]);
+      snapshot.SetFunctionCount((const char*)m_world->GetEnvironment().GetTask(i).GetName(), task_counts[i]);
     }
 
     
@@ -417,7 +827,7 @@ void Private::SnapshotTracer::TraceTestCPU(int time_used, int time_allocated, co
     for (int i = 0; i < m_genome_length && i < seq->GetSize(); i++) {
       memory[i] = (*seq)[i];
     }
-    snapshot->AddMemSpace("genome", memory, mutated);
+    snapshot.AddMemSpace("genome", memory, mutated);
     
     // - handle the offspring part of the memory
     m_offspring_genome = GenomePtr(new Genome(organism.OffspringGenome()));
@@ -430,15 +840,13 @@ void Private::SnapshotTracer::TraceTestCPU(int time_used, int time_allocated, co
     }
     
     // Hack to get mutated state into the final state... potential for offset, etc.
-    const Apto::Array<bool>& prev_mutated = prev_snapshot->MutatedStateOfMemSpace(1);
-    for (int i = 0; i < mutated.GetSize() && i < prev_mutated.GetSize(); i++) {
-      mutated[i] = prev_mutated[i];
+    for (int i = 0; i < mutated.GetSize() && i < m_offspring_mutated.GetSize(); i++) {
+      mutated[i] = m_offspring_mutated[i];
     }
-    snapshot->AddMemSpace("offspring", memory, mutated);
+    snapshot.AddMemSpace("offspring", memory, mutated);
+    
+    m_arena->AddSnapshot(snapshot);
   }
-  
-  // Resize the snapshot array to the actual number of snapshots
-  m_snapshots->Resize(m_snapshot_count);
 }
 
 
@@ -699,15 +1107,33 @@ const Apto::Array<bool>& Avida::Viewer::HardwareSnapshot::MutatedStateOfMemSpace
 // --------------------------------------------------------------------------------------------------------------  
 
 OrganismTrace::OrganismTrace(cWorld* world, GenomePtr genome, double mut_rate, int seed)
-  : m_genome(genome)
+  : m_genome(genome), m_arena(new Private::SnapshotArena)
 {
   Private::SnapshotTracer tracer(world);
-  tracer.TraceGenome(genome, m_snapshots, mut_rate, seed);
+  tracer.TraceGenome(genome, *m_arena, mut_rate, seed);
   m_offspring_genome = tracer.OffspringGenome();
 }
 
 
 OrganismTrace::~OrganismTrace()
 {
-  for (int i = 0; i < m_snapshots.GetSize(); i++) delete m_snapshots[i];
+  delete m_arena;
+}
+
+
+int OrganismTrace::SnapshotCount() const
+{
+  return m_arena->GetSize();
+}
+
+
+ConstHardwareSnapshotPtr OrganismTrace::Snapshot(int idx) const
+{
+  return m_arena->Snapshot(idx);
+}
+
+
+int OrganismTrace::FirstSnapshotWithFunction(const Apto::String& function) const
+{
+  return m_arena->FirstWithFunction(function);
 }